@@ -0,0 +1,240 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "MemoryAssetIoInterface.h"
+
+#include <AssetLib/Io/Compression/Lz4AssetCompressor.h>
+#include <AssetLib/Io/Compression/RawAssetCompressor.h>
+#include <AssetLib/Io/Compression/ZstdAssetCompressor.h>
+#include <AssetLib/Shaders/ShaderAsset.h>
+#include <CoreLib/Utils/FileUtils.h>
+#include <CoreLib/Utils/HashUtils.h>
+
+#include <algorithm>
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+using namespace lux::assetlib;
+
+/* repetitive enough to compress, but not trivially */
+std::vector<std::byte> randomData(std::mt19937& rng, u64 sizeBytes)
+{
+    std::vector<std::byte> data(sizeBytes);
+    for (auto& byte : data)
+        byte = (std::byte)(rng() % 13);
+
+    return data;
+}
+
+std::vector<std::byte> randomBytes(std::mt19937& rng, u64 sizeBytes)
+{
+    std::vector<std::byte> data(sizeBytes);
+    for (auto& byte : data)
+        byte = (std::byte)rng();
+
+    return data;
+}
+
+/* small assets of the same kind, that share most of their content */
+std::vector<std::byte> similarAsset(std::mt19937& rng, const std::vector<std::byte>& common)
+{
+    std::vector<std::byte> asset = common;
+    for (u32 i = 0; i < 64; i++)
+        asset[rng() % asset.size()] = (std::byte)rng();
+
+    return asset;
+}
+
+void requireRoundTrip(io::AssetCompressor& compressor, const std::vector<std::byte>& data)
+{
+    const std::vector<std::byte> compressed = compressor.Compress(data);
+    REQUIRE(compressor.Decompress(compressed, data.size()) == data);
+}
+}
+
+TEST_CASE("Asset compressors", "[Assets][AssetCompressor]")
+{
+    std::mt19937 rng(5);
+
+    SECTION("Every compressor round trips")
+    {
+        io::RawAssetCompressor raw;
+        io::Lz4AssetCompressor lz4;
+        io::ZstdAssetCompressor zstd;
+        for (u64 size : {0llu, 1llu, 1000llu, 300llu * 1024})
+        {
+            const std::vector<std::byte> data = randomData(rng, size);
+            requireRoundTrip(raw, data);
+            requireRoundTrip(lz4, data);
+            requireRoundTrip(zstd, data);
+        }
+    }
+    SECTION("Zstd levels round trip")
+    {
+        const std::vector<std::byte> data = randomData(rng, 100 * 1024);
+        for (i32 level : {1, io::ZstdAssetCompressor::DEFAULT_LEVEL, 19})
+        {
+            io::ZstdAssetCompressor zstd({.Level = level});
+            requireRoundTrip(zstd, data);
+        }
+    }
+    SECTION("Zstd dictionary shrinks small assets of its type")
+    {
+        const AssetTypeMetadata type = {.Name = "shader"};
+        const AssetTypeMetadata otherType = {.Name = "image"};
+        const std::vector<std::byte> common = randomBytes(rng, 2048);
+
+        std::vector<std::vector<std::byte>> samples;
+        for (u32 i = 0; i < 200; i++)
+            samples.push_back(similarAsset(rng, common));
+        const std::vector<std::byte> dictionary = io::ZstdAssetCompressor::TrainDictionary(samples, 16 * 1024);
+        REQUIRE_FALSE(dictionary.empty());
+
+        io::ZstdAssetCompressor zstd;
+        zstd.AddDictionary(type.Name, dictionary);
+        const std::vector<std::byte> asset = similarAsset(rng, common);
+        const std::vector<std::byte> compressed = zstd.CompressForType(asset, type);
+        REQUIRE(compressed.size() * 4 < zstd.Compress(asset).size());
+        REQUIRE(zstd.Decompress(compressed, asset.size()) == asset);
+        /* the other types do not use the dictionary */
+        REQUIRE(zstd.Decompress(zstd.CompressForType(asset, otherType), asset.size()) == asset);
+
+        /* the dictionary is found by the id in the compressed data */
+        io::ZstdAssetCompressor reader;
+        REQUIRE(reader.Decompress(compressed, asset.size()).empty());
+        reader.AddDictionary("any", dictionary);
+        REQUIRE(reader.Decompress(compressed, asset.size()) == asset);
+    }
+    SECTION("Zstd trains dictionaries on the assets it compressed")
+    {
+        const AssetTypeMetadata type = {.Name = "shader"};
+        const std::vector<std::byte> common = randomBytes(rng, 2048);
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "lux_zstd_dictionaries";
+        std::filesystem::remove_all(directory);
+
+        io::ZstdAssetCompressor trainer({.CollectSamples = true});
+        for (u32 i = 0; i < 200; i++)
+            trainer.CompressForType(similarAsset(rng, common), type);
+        REQUIRE(trainer.TrainDictionaries(directory, 16 * 1024).has_value());
+        REQUIRE(std::filesystem::exists(directory / "shader.zdict"));
+
+        const std::vector<std::byte> asset = similarAsset(rng, common);
+        const std::vector<std::byte> compressed = trainer.CompressForType(asset, type);
+        REQUIRE(compressed.size() * 4 < trainer.Compress(asset).size());
+
+        io::ZstdAssetCompressor reader;
+        REQUIRE(reader.LoadDictionaries(directory).has_value());
+        REQUIRE(reader.Decompress(compressed, asset.size()) == asset);
+        std::filesystem::remove_all(directory);
+    }
+    SECTION("Zstd dictionaries do not depend on the order the assets were compressed in")
+    {
+        const AssetTypeMetadata type = {.Name = "shader"};
+        const std::vector<std::byte> common = randomBytes(rng, 2048);
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "lux_zstd_dictionaries";
+        std::filesystem::remove_all(directory);
+
+        /* assets of mixed sizes, that overflow the samples budget about three times */
+        std::vector<std::vector<std::byte>> assets;
+        for (u32 i = 0; i < 200; i++)
+        {
+            std::vector<std::byte> asset = similarAsset(rng, common);
+            asset.resize(16 + rng() % (common.size() - 16));
+            assets.push_back(std::move(asset));
+        }
+
+        static constexpr u64 MAX_SAMPLES_SIZE_BYTES = 64llu * 1024;
+        auto trainOn = [&](const std::vector<std::vector<std::byte>>& orderedAssets, const std::string& name) {
+            io::ZstdAssetCompressor trainer({.CollectSamples = true, .MaxSamplesSizeBytes = MAX_SAMPLES_SIZE_BYTES});
+            for (auto& asset : orderedAssets)
+                trainer.CompressForType(asset, type);
+            REQUIRE(trainer.TrainDictionaries(directory / name, 16 * 1024).has_value());
+            const auto dictionary = lux::readFileToBytes(directory / name / "shader.zdict");
+            REQUIRE(dictionary.has_value());
+
+            return *dictionary;
+        };
+
+        const std::vector<std::byte> dictionary = trainOn(assets, "ordered");
+        for (u32 i = 0; i < 2; i++)
+        {
+            std::ranges::shuffle(assets, rng);
+            REQUIRE(trainOn(assets, std::format("shuffled_{}", i)) == dictionary);
+        }
+        /* the samples are kept by their hashes, so the orders by hash are the ones that could break it: the assets
+         * that do not fit come either before or after the assets that still fit into the budget */
+        auto hashOf = [](const std::vector<std::byte>& asset) { return Hash::bytes(asset.data(), (u32)asset.size()); };
+        std::ranges::sort(assets, std::less{}, hashOf);
+        REQUIRE(trainOn(assets, "by_hash") == dictionary);
+        std::ranges::sort(assets, std::greater{}, hashOf);
+        REQUIRE(trainOn(assets, "by_hash_reversed") == dictionary);
+        std::filesystem::remove_all(directory);
+    }
+    SECTION("Zstd keeps the dictionaries of the assets baked before retraining")
+    {
+        const AssetTypeMetadata type = {.Name = "shader"};
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "lux_zstd_dictionaries";
+        std::filesystem::remove_all(directory);
+
+        const std::vector<std::byte> firstCommon = randomBytes(rng, 2048);
+        io::ZstdAssetCompressor firstTrainer({.CollectSamples = true});
+        for (u32 i = 0; i < 200; i++)
+            firstTrainer.CompressForType(similarAsset(rng, firstCommon), type);
+        REQUIRE(firstTrainer.TrainDictionaries(directory, 16 * 1024).has_value());
+        const std::vector<std::byte> firstAsset = similarAsset(rng, firstCommon);
+        const std::vector<std::byte> firstCompressed = firstTrainer.CompressForType(firstAsset, type);
+
+        const std::vector<std::byte> secondCommon = randomBytes(rng, 2048);
+        io::ZstdAssetCompressor secondTrainer({.CollectSamples = true});
+        REQUIRE(secondTrainer.LoadDictionaries(directory).has_value());
+        for (u32 i = 0; i < 200; i++)
+            secondTrainer.CompressForType(similarAsset(rng, secondCommon), type);
+        REQUIRE(secondTrainer.TrainDictionaries(directory, 16 * 1024).has_value());
+        const std::vector<std::byte> secondAsset = similarAsset(rng, secondCommon);
+        const std::vector<std::byte> secondCompressed = secondTrainer.CompressForType(secondAsset, type);
+
+        u32 dictionaryCount = 0;
+        for (const auto& file : std::filesystem::directory_iterator(directory))
+            dictionaryCount += file.path().extension() == io::ZstdAssetCompressor::DICTIONARY_EXTENSION;
+        REQUIRE(dictionaryCount == 2);
+
+        io::ZstdAssetCompressor reader;
+        REQUIRE(reader.LoadDictionaries(directory).has_value());
+        REQUIRE(reader.Decompress(firstCompressed, firstAsset.size()) == firstAsset);
+        REQUIRE(reader.Decompress(secondCompressed, secondAsset.size()) == secondAsset);
+        /* the new assets are compressed with the latest dictionary */
+        REQUIRE(reader.CompressForType(secondAsset, type) == secondCompressed);
+        std::filesystem::remove_all(directory);
+    }
+    SECTION("Readers report the data that does not decompress")
+    {
+        const std::vector<std::byte> common = randomBytes(rng, 2048);
+        std::vector<std::vector<std::byte>> samples;
+        for (u32 i = 0; i < 200; i++)
+            samples.push_back(similarAsset(rng, common));
+        io::ZstdAssetCompressor zstd;
+        zstd.AddDictionary("shader", io::ZstdAssetCompressor::TrainDictionary(samples, 16 * 1024));
+
+        const std::vector<std::byte> spirv = similarAsset(rng, common);
+        const std::vector<std::byte> compressed = zstd.CompressForType(spirv, {.Name = "shader"});
+        AssetMetadata metadata = {};
+        metadata.Io.BinarySizeBytes = spirv.size();
+        metadata.Io.BinarySizeBytesCompressed = compressed.size();
+        lux::tests::MemoryAssetIoInterface io(compressed);
+
+        const auto read = shader::readSpirv({}, metadata, io, zstd);
+        REQUIRE(read.has_value());
+        REQUIRE(*read == spirv);
+
+        io::ZstdAssetCompressor withoutDictionary;
+        const auto unreadable = shader::readSpirv({}, metadata, io, withoutDictionary);
+        REQUIRE_FALSE(unreadable.has_value());
+        REQUIRE(unreadable.error().Code == io::IoError::ErrorCode::WrongFormat);
+
+        io::RawAssetCompressor raw;
+        const auto misread = shader::readSpirv({}, metadata, io, raw);
+        REQUIRE_FALSE(misread.has_value());
+    }
+}
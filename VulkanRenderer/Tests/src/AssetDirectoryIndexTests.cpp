@@ -0,0 +1,123 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <AssetLib/Io/AssetDirectoryIndex.h>
+#include <AssetLib/Materials/MaterialMeta.h>
+#include <CoreLib/Utils/FileUtils.h>
+
+#include <filesystem>
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+using namespace lux;
+using namespace lux::assetlib;
+
+void writeMaterialMeta(const std::filesystem::path& rawPath, AssetId id)
+{
+    REQUIRE(writeStringToFile(rawPath, "raw").has_value());
+    const auto meta = material::packMeta({.Metadata = {
+        .AssetId = id,
+        .Type = material::getTypeMetadata(),
+        .Io = {.OriginalFile = rawPath.generic_string()}}});
+    REQUIRE(meta.has_value());
+    REQUIRE(writeStringToFile(getMetadataPath(rawPath), *meta).has_value());
+}
+
+/* nested directories of metadata files, with raw and broken metadata files in between; returns the asset count */
+u32 generateTree(const std::filesystem::path& directory, std::mt19937& rng, u32 depth)
+{
+    std::filesystem::create_directories(directory);
+
+    const u32 assetCount = rng() % 6;
+    for (u32 i = 0; i < assetCount; i++)
+        writeMaterialMeta(directory / std::format("material_{}.mat", i), AssetId(rng() + 1llu));
+    if (rng() % 4 == 0)
+        REQUIRE(writeStringToFile(directory / "broken.mat.meta", "{").has_value());
+
+    u32 count = assetCount;
+    if (depth > 0)
+        for (u32 i = 0, subdirectoryCount = rng() % 4 + 1; i < subdirectoryCount; i++)
+            count += generateTree(directory / std::format("directory_{}", i), rng, depth - 1);
+
+    return count;
+}
+
+void requireSameEntries(const io::AssetDirectoryIndex& a, const io::AssetDirectoryIndex& b)
+{
+    REQUIRE(a.Entries.size() == b.Entries.size());
+    for (u32 i = 0; i < a.Entries.size(); i++)
+    {
+        REQUIRE(a.Entries[i].MetadataPath == b.Entries[i].MetadataPath);
+        REQUIRE(a.Entries[i].SizeBytes == b.Entries[i].SizeBytes);
+        REQUIRE(a.Entries[i].LastWriteTime == b.Entries[i].LastWriteTime);
+        REQUIRE(a.Entries[i].Metadata.AssetId == b.Entries[i].Metadata.AssetId);
+        REQUIRE(a.Entries[i].Metadata.Type.Type == b.Entries[i].Metadata.Type.Type);
+        REQUIRE(a.Entries[i].Metadata.Io.OriginalFile == b.Entries[i].Metadata.Io.OriginalFile);
+    }
+}
+}
+
+TEST_CASE("Asset directory index", "[Assets][AssetDirectoryIndex]")
+{
+    std::mt19937 rng(11);
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "lux_asset_directory_index";
+    std::filesystem::remove_all(directory);
+    const u32 assetCount = generateTree(directory / "assets", rng, 3);
+    REQUIRE(assetCount > 2);
+
+    SECTION("Parallel scan finds the same assets as the serial one")
+    {
+        io::AssetDirectoryScanStats stats = {};
+        const io::AssetDirectoryIndex serial = io::scanAssetDirectory(directory / "assets", nullptr,
+            io::AssetDirectoryScanMode::Serial);
+        const io::AssetDirectoryIndex parallel = io::scanAssetDirectory(directory / "assets", nullptr,
+            io::AssetDirectoryScanMode::Parallel, &stats);
+
+        REQUIRE(serial.Entries.size() == assetCount);
+        REQUIRE(stats.ReusedCount == 0);
+        REQUIRE(stats.ParsedCount >= assetCount);
+        requireSameEntries(serial, parallel);
+        REQUIRE(std::ranges::is_sorted(parallel.Entries, {}, &io::AssetDirectoryIndexEntry::MetadataPath));
+    }
+    SECTION("Unchanged metadata files are not parsed again")
+    {
+        const std::filesystem::path indexPath = directory / "assets.index";
+        const io::AssetDirectoryIndex scanned = io::scanAssetDirectory(directory / "assets", nullptr,
+            io::AssetDirectoryScanMode::Parallel);
+        REQUIRE(io::writeAssetDirectoryIndex(indexPath, scanned).has_value());
+        const auto index = io::readAssetDirectoryIndex(indexPath);
+        REQUIRE(index.has_value());
+        requireSameEntries(scanned, *index);
+
+        io::AssetDirectoryScanStats stats = {};
+        requireSameEntries(scanned, io::scanAssetDirectory(directory / "assets", &*index,
+            io::AssetDirectoryScanMode::Parallel, &stats));
+        REQUIRE(stats.ReusedCount == assetCount);
+
+        /* the size changes together with the id, so the change is seen even if the write time is too coarse */
+        const std::filesystem::path modified = scanned.Entries.front().Metadata.Io.OriginalFile;
+        writeMaterialMeta(modified, AssetId(~0llu));
+        std::filesystem::remove(getMetadataPath(scanned.Entries.back().Metadata.Io.OriginalFile));
+
+        const io::AssetDirectoryIndex rescanned = io::scanAssetDirectory(directory / "assets", &*index,
+            io::AssetDirectoryScanMode::Parallel, &stats);
+        REQUIRE(rescanned.Entries.size() == assetCount - 1);
+        REQUIRE(rescanned.Entries.front().Metadata.AssetId == AssetId(~0llu));
+        REQUIRE(stats.ReusedCount == assetCount - 2);
+        requireSameEntries(rescanned, io::scanAssetDirectory(directory / "assets", nullptr,
+            io::AssetDirectoryScanMode::Serial));
+    }
+    SECTION("Index with unexpected format is rejected")
+    {
+        const std::filesystem::path indexPath = directory / "broken.index";
+        REQUIRE(writeStringToFile(indexPath, "LUXBHEAD").has_value());
+        REQUIRE_FALSE(io::readAssetDirectoryIndex(indexPath).has_value());
+        REQUIRE_FALSE(io::readAssetDirectoryIndex(directory / "missing.index").has_value());
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+// NOLINTEND
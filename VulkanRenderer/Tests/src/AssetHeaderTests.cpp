@@ -0,0 +1,136 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <AssetLib/Io/IoInterface/SeparateAssetIoInterface.h>
+#include <AssetLib/Scenes/Scene/SceneAsset.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+using namespace lux::assetlib;
+
+SceneAsset randomScene(std::mt19937& rng, u32 nodeCount)
+{
+    std::uniform_real_distribution<f32> position(-100.0f, 100.0f);
+
+    SceneAsset scene = {};
+    for (u32 i = 0; i < 8; i++)
+        scene.Meshes.push_back(AssetId(rng() + 1llu));
+    scene.Cameras.push_back({.Far = 1000.0f, .Perspective = SceneAssetCamera::PerspectiveData{}});
+    scene.Cameras.push_back({.Type = SceneAssetCameraType::Orthographic, .Far = 500.0f,
+        .Orthographic = SceneAssetCamera::OrthographicData{.SpanX = 20.0f, .SpanY = 10.0f}});
+    scene.Lights.push_back({.Type = SceneAssetLightType::Spot, .Color = {1.0f, 0.5f, 0.25f}, .Intensity = 3.0f});
+    scene.Skins.push_back({.GeometryBuffer = AssetId(rng() + 1llu), .InverseBindMatrixAccessor = 3,
+        .JointNodes = {1, 2, 3}});
+    scene.Animations.push_back({.Name = "walk", .GeometryBuffer = AssetId(rng() + 1llu), .Channels = {
+        {.Type = SceneAssetAnimationChannelType::Orientation, .SamplerType = SceneAssetAnimationSamplerType::Step,
+            .TargetNode = 1, .TimestampsAccessor = 4, .KeyframesAccessor = 5}}});
+
+    for (u32 i = 0; i < nodeCount; i++)
+    {
+        SceneAssetNode node = {.Name = "node " + std::to_string(i)};
+        if (2 * i + 1 < nodeCount)
+            node.Children.push_back(2 * i + 1);
+        if (2 * i + 2 < nodeCount)
+            node.Children.push_back(2 * i + 2);
+        if (rng() % 2 == 0)
+            node.Mesh = rng() % (u32)scene.Meshes.size();
+        node.Transform.Position = {position(rng), position(rng), position(rng)};
+        node.Transform.Scale = glm::vec3{1.0f + (f32)(rng() % 4)};
+        scene.Nodes.push_back(std::move(node));
+    }
+    scene.Subscenes.push_back({.Name = "main", .Nodes = {0}});
+
+    return scene;
+}
+
+AssetMetadata writeHeader(const std::filesystem::path& path, const AssetCustomHeaderType& header)
+{
+    std::ofstream out(path, std::ios::binary);
+    out.write(header.data(), (isize)header.size());
+
+    AssetMetadata metadata = {};
+    metadata.Io.HeaderFile = path;
+    metadata.Io.HeaderSizeBytes = header.size();
+
+    return metadata;
+}
+
+/* json is the reference representation of a scene */
+std::string asJson(const SceneAsset& scene)
+{
+    return scene::pack(scene, io::AssetHeaderEncoding::Json)->Header;
+}
+}
+
+TEST_CASE("Asset headers", "[Assets][AssetHeader]")
+{
+    std::mt19937 rng(9);
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "lux_asset_headers";
+    std::filesystem::create_directories(directory);
+
+    SECTION("Binary and json headers read back to the same scene")
+    {
+        for (u32 nodeCount : {0u, 1u, 100u, 5000u})
+        {
+            const SceneAsset scene = randomScene(rng, nodeCount);
+            const auto json = scene::pack(scene, io::AssetHeaderEncoding::Json);
+            const auto binary = scene::pack(scene, io::AssetHeaderEncoding::Binary);
+            REQUIRE(json.has_value());
+            REQUIRE(binary.has_value());
+            REQUIRE(io::getAssetHeaderEncoding(json->Header) == io::AssetHeaderEncoding::Json);
+            REQUIRE(io::getAssetHeaderEncoding(binary->Header) == io::AssetHeaderEncoding::Binary);
+            REQUIRE(binary->Header.size() < json->Header.size());
+
+            const auto fromJson = scene::readScene(writeHeader(directory / "scene.json", json->Header));
+            const auto fromBinary = scene::readScene(writeHeader(directory / "scene.bin", binary->Header));
+            REQUIRE(fromJson.has_value());
+            REQUIRE(fromBinary.has_value());
+            REQUIRE(asJson(*fromJson) == json->Header);
+            REQUIRE(asJson(*fromBinary) == json->Header);
+        }
+    }
+    SECTION("Binary headers survive the header formatting of the io")
+    {
+        const auto binary = scene::pack(randomScene(rng, 50), io::AssetHeaderEncoding::Binary);
+        REQUIRE(io::getAssetHeaderFormatted(binary->Header) == binary->Header);
+    }
+    SECTION("Binary headers survive a write through the separate io")
+    {
+        const SceneAsset scene = randomScene(rng, 100);
+        const auto binary = scene::pack(scene, io::AssetHeaderEncoding::Binary);
+        /* text mode writes would expand these on windows */
+        REQUIRE(binary->Header.contains('\n'));
+
+        AssetMetadata metadata = {};
+        metadata.Io.HeaderFile = directory / "scene.scene";
+        metadata.Io.BinaryFile = directory / "scene.bin";
+        io::SeparateAssetIoInterface io;
+        const auto written = io.WriteHeader(metadata, binary->Header);
+        REQUIRE(written.has_value());
+        REQUIRE(*written == binary->Header.size());
+        REQUIRE(std::filesystem::file_size(metadata.Io.HeaderFile) == binary->Header.size());
+        metadata.Io.HeaderSizeBytes = *written;
+
+        const auto header = io.ReadHeader(metadata);
+        REQUIRE(header.has_value());
+        REQUIRE(*header == binary->Header);
+        const auto read = scene::readScene(metadata);
+        REQUIRE(read.has_value());
+        REQUIRE(asJson(*read) == asJson(scene));
+    }
+    SECTION("Binary headers of another version are rejected")
+    {
+        auto binary = scene::pack(randomScene(rng, 10), io::AssetHeaderEncoding::Binary);
+        binary->Header[io::ASSET_BINARY_HEADER_MAGIC.size()] += 1;
+        const auto read = scene::readScene(writeHeader(directory / "scene.bin", binary->Header));
+        REQUIRE_FALSE(read.has_value());
+        REQUIRE(read.error().Code == io::IoError::ErrorCode::WrongFormat);
+    }
+
+    std::filesystem::remove_all(directory);
+}
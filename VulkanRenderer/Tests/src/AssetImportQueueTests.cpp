@@ -0,0 +1,210 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Assets/AssetImportQueue.h"
+
+#include <chrono>
+#include <future>
+
+// NOLINTBEGIN
+
+using namespace lux;
+
+namespace
+{
+struct ScopedImportQueue
+{
+    AssetImportQueue Queue;
+
+    ScopedImportQueue(u32 workerCount) { Queue.Init(workerCount); }
+    ~ScopedImportQueue() { Queue.Shutdown(); }
+};
+
+/* keeps a worker busy until opened, so that the tasks are queued up behind it */
+struct Gate
+{
+    std::promise<void> Opened;
+    std::shared_future<void> OpenedFuture{Opened.get_future().share()};
+    bool IsOpen{false};
+
+    ~Gate() { Open(); }
+    void Open()
+    {
+        if (!IsOpen)
+            Opened.set_value();
+        IsOpen = true;
+    }
+    AssetImportRequest Request(std::string key = {})
+    {
+        return {.ImportFn = [opened = OpenedFuture]() { opened.wait(); }, .Key = std::move(key)};
+    }
+};
+
+struct Recorder
+{
+    std::mutex Mutex;
+    std::vector<u32> Order;
+
+    AssetImportRequest Request(u32 value, AssetImportPriority priority = AssetImportPriority::VisibleNow,
+        std::vector<AssetImportTaskId> dependencies = {}, std::string key = {})
+    {
+        return {
+            .ImportFn = [this, value]()
+            {
+                std::lock_guard lock(Mutex);
+                Order.push_back(value);
+            },
+            .Priority = priority,
+            .Key = std::move(key),
+            .Dependencies = std::move(dependencies)
+        };
+    }
+};
+}
+
+TEST_CASE("AssetImportQueue", "[Assets][AssetImportQueue]")
+{
+    SECTION("Tasks run from the most urgent priority")
+    {
+        ScopedImportQueue queue(1);
+        Gate gate;
+        Recorder recorder;
+        queue.Queue.AddRequest(gate.Request());
+        queue.Queue.AddRequest(recorder.Request(0, AssetImportPriority::Background));
+        queue.Queue.AddRequest(recorder.Request(1, AssetImportPriority::Prefetch));
+        queue.Queue.AddRequest(recorder.Request(2, AssetImportPriority::VisibleNow));
+        queue.Queue.AddRequest(recorder.Request(3, AssetImportPriority::Background));
+        gate.Open();
+        queue.Queue.WaitIdle();
+
+        REQUIRE(recorder.Order == std::vector<u32>{2, 1, 0, 3});
+    }
+    SECTION("Tasks wait for their dependencies, which inherit their priority")
+    {
+        ScopedImportQueue queue(1);
+        Gate gate;
+        Recorder recorder;
+        queue.Queue.AddRequest(gate.Request());
+        const AssetImportTaskId background = queue.Queue.AddRequest(
+            recorder.Request(0, AssetImportPriority::Background));
+        queue.Queue.AddRequest(recorder.Request(1, AssetImportPriority::Prefetch));
+        queue.Queue.AddRequest(recorder.Request(2, AssetImportPriority::VisibleNow, {background}));
+        gate.Open();
+        queue.Queue.WaitIdle();
+
+        REQUIRE(recorder.Order == std::vector<u32>{0, 2, 1});
+    }
+    SECTION("Dependencies are respected across the workers")
+    {
+        ScopedImportQueue queue(4);
+        Recorder recorder;
+        std::vector<AssetImportTaskId> chain;
+        for (u32 i = 0; i < 16; i++)
+            chain.push_back(queue.Queue.AddRequest(recorder.Request(i, AssetImportPriority::Background,
+                chain.empty() ? std::vector<AssetImportTaskId>{} : std::vector{chain.back()})));
+        queue.Queue.WaitIdle();
+
+        REQUIRE(recorder.Order.size() == 16);
+        for (u32 i = 0; i < 16; i++)
+            REQUIRE(recorder.Order[i] == i);
+    }
+    SECTION("Tasks run on several workers at once")
+    {
+        constexpr u32 WORKER_COUNT = 4;
+        ScopedImportQueue queue(WORKER_COUNT);
+        REQUIRE(queue.Queue.GetWorkerCount() == WORKER_COUNT);
+
+        std::atomic<u32> started = 0;
+        std::atomic<u32> metOthers = 0;
+        for (u32 i = 0; i < WORKER_COUNT; i++)
+            queue.Queue.AddRequest({.ImportFn = [&]()
+            {
+                started++;
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                while (started < WORKER_COUNT && std::chrono::steady_clock::now() < deadline)
+                    std::this_thread::yield();
+                if (started == WORKER_COUNT)
+                    metOthers++;
+            }});
+        queue.Queue.WaitIdle();
+
+        REQUIRE(metOthers == WORKER_COUNT);
+    }
+    SECTION("Queued request is replaced by the newer one with the same key")
+    {
+        ScopedImportQueue queue(1);
+        Gate gate;
+        Recorder recorder;
+        queue.Queue.AddRequest(gate.Request());
+        const AssetImportTaskId stale = queue.Queue.AddRequest(
+            recorder.Request(0, AssetImportPriority::Background, {}, "file"));
+        queue.Queue.AddRequest(recorder.Request(1, AssetImportPriority::Prefetch));
+        const AssetImportTaskId replaced = queue.Queue.AddRequest(
+            recorder.Request(2, AssetImportPriority::VisibleNow, {}, "file"));
+        gate.Open();
+        queue.Queue.WaitIdle();
+
+        REQUIRE(stale == replaced);
+        REQUIRE(recorder.Order == std::vector<u32>{2, 1});
+    }
+    SECTION("Requests with the same key never run at once")
+    {
+        ScopedImportQueue queue(2);
+        Gate gate;
+        std::promise<void> started;
+        std::atomic_bool isStarted = false;
+        std::atomic<u32> running = 0;
+        std::atomic<u32> maxRunning = 0;
+        std::atomic<u32> finished = 0;
+        const auto import = [&](std::shared_future<void> opened)
+        {
+            return AssetImportRequest{
+                .ImportFn = [&, opened]()
+                {
+                    const u32 nowRunning = ++running;
+                    maxRunning = std::max(maxRunning.load(), nowRunning);
+                    if (!isStarted.exchange(true))
+                        started.set_value();
+                    opened.wait();
+                    running--;
+                    finished++;
+                },
+                .Key = "file"
+            };
+        };
+        queue.Queue.AddRequest(import(gate.OpenedFuture));
+        started.get_future().wait();
+        queue.Queue.AddRequest(import(gate.OpenedFuture));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(running == 1);
+        gate.Open();
+        queue.Queue.WaitIdle();
+
+        REQUIRE(finished == 2);
+        REQUIRE(maxRunning == 1);
+    }
+    SECTION("Cancelled tasks do not run and do not block their dependents")
+    {
+        ScopedImportQueue queue(1);
+        Gate gate;
+        Recorder recorder;
+        queue.Queue.AddRequest(gate.Request());
+        const AssetImportTaskId cancelled = queue.Queue.AddRequest(recorder.Request(0));
+        const AssetImportTaskId dependent = queue.Queue.AddRequest(
+            recorder.Request(1, AssetImportPriority::VisibleNow, {cancelled}));
+        REQUIRE(queue.Queue.Cancel(cancelled));
+        gate.Open();
+        queue.Queue.WaitIdle();
+
+        REQUIRE(recorder.Order == std::vector<u32>{1});
+        REQUIRE_FALSE(queue.Queue.Cancel(dependent));
+    }
+    SECTION("Stopped queue does not take requests")
+    {
+        ScopedImportQueue queue(1);
+        queue.Queue.Shutdown();
+
+        REQUIRE(queue.Queue.AddRequest({}) == INVALID_ASSET_IMPORT_TASK);
+    }
+}
+
+// NOLINTEND
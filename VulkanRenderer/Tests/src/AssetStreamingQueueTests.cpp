@@ -0,0 +1,172 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "MemoryAssetIoInterface.h"
+#include "Assets/AssetStreamingQueue.h"
+#include "Assets/Scenes/SceneAsset.h"
+
+#include <AssetLib/Io/Compression/RawAssetCompressor.h>
+#include <CoreLib/Jobs/ThreadPool.h>
+
+#include <cstring>
+
+// NOLINTBEGIN
+
+using namespace lux;
+
+namespace
+{
+constexpr u32 POSITION_SIZE = SceneGeometryInfo::STREAM_ELEMENT_SIZES[(u32)SceneGeometryStreamType::Position];
+
+std::vector<std::byte> sequentialBytes(u64 count, u32 seed)
+{
+    std::vector<std::byte> bytes(count);
+    for (u64 i = 0; i < count; i++)
+        bytes[i] = (std::byte)(i * 31 + seed);
+
+    return bytes;
+}
+
+/* the 'loaded' geometry references its baked buffer, the same as the geometry of a scene asset */
+SceneGeometryInfo loadGeometry(u32 positionCount, assetlib::io::AssetIoInterface& io,
+    assetlib::io::AssetCompressor& compressor)
+{
+    SceneGeometryBuffer buffer = {};
+    buffer.Header.SizeBytes = (u64)positionCount * POSITION_SIZE;
+    buffer.Metadata.Io.BinarySizeBytesCompressed = buffer.Header.SizeBytes;
+    buffer.Io = &io;
+    buffer.Compressor = &compressor;
+
+    SceneGeometryInfo geometry = {};
+    geometry.Buffers.push_back(std::move(buffer));
+    geometry.AddStreamRange(SceneGeometryStreamType::Position, 0, 0, positionCount);
+
+    return geometry;
+}
+
+/* mirrors `Scene::Spawn`: geometry is uploaded into staging until the budget of the frame is spent */
+struct MockUploader
+{
+    AssetUploadBudget Budget{};
+    std::vector<std::pair<u32, std::vector<std::byte>>> Uploaded;
+    std::vector<std::pair<u32, SceneGeometryInfo>> Pending;
+
+    void OnFrame(u64 budgetBytes, AssetStreamingQueue<u32, SceneGeometryInfo>& queue)
+    {
+        Budget = {.BudgetBytes = budgetBytes};
+        for (auto& [id, geometry] : queue.TakeCompleted())
+            Pending.emplace_back(id, std::move(*geometry));
+
+        std::vector<std::pair<u32, SceneGeometryInfo>> deferred;
+        for (auto& [id, geometry] : Pending)
+        {
+            if (!Budget.TrySpend(geometry.GetUploadSizeBytes()))
+            {
+                deferred.emplace_back(id, std::move(geometry));
+                continue;
+            }
+
+            std::vector<std::byte> staging(geometry.GetStreamSizeBytes(SceneGeometryStreamType::Position));
+            REQUIRE(geometry.ReadStream(SceneGeometryStreamType::Position, Span(staging.data(), staging.size())));
+            Uploaded.emplace_back(id, std::move(staging));
+        }
+        Pending = std::move(deferred);
+    }
+};
+}
+
+TEST_CASE("AssetStreamingQueue", "[Assets][AssetStreamingQueue]")
+{
+    SECTION("Upload budget always lets the first upload of a frame through")
+    {
+        AssetUploadBudget budget = {.BudgetBytes = 100};
+        REQUIRE(budget.TrySpend(250));
+        REQUIRE_FALSE(budget.TrySpend(1));
+
+        budget = {.BudgetBytes = 100};
+        REQUIRE(budget.TrySpend(60));
+        REQUIRE(budget.TrySpend(40));
+        REQUIRE_FALSE(budget.TrySpend(1));
+    }
+    SECTION("Loads are pending until their result is taken")
+    {
+        AssetStreamingQueue<u32, u32> queue;
+        REQUIRE(queue.Begin(1));
+        REQUIRE_FALSE(queue.Begin(1));
+        REQUIRE(queue.Begin(2));
+
+        queue.Complete(1, 10u);
+        queue.Complete(2, std::nullopt);
+        REQUIRE(queue.IsPending(1));
+        REQUIRE(queue.PendingCount() == 2);
+
+        auto completed = queue.TakeCompleted();
+        REQUIRE(completed.size() == 2);
+        REQUIRE(completed[0].Id == 1);
+        REQUIRE(completed[0].Result == 10u);
+        REQUIRE_FALSE(completed[1].Result.has_value());
+        REQUIRE_FALSE(queue.IsPending(1));
+        REQUIRE(queue.PendingCount() == 0);
+    }
+    SECTION("Cancelled loads are dropped")
+    {
+        AssetStreamingQueue<u32, u32> queue;
+        queue.Begin(1);
+        queue.Begin(2);
+        queue.Complete(1, 10u);
+        queue.Cancel(1);
+        queue.Cancel(2);
+        queue.Complete(2, 20u);
+
+        REQUIRE(queue.PendingCount() == 0);
+        REQUIRE(queue.TakeCompleted().empty());
+    }
+    SECTION("Geometry streamed on worker threads is uploaded within the frame budget")
+    {
+        constexpr u32 ASSET_COUNT = 16;
+        constexpr u64 BUDGET_BYTES = 4096 * POSITION_SIZE;
+
+        assetlib::io::RawAssetCompressor compressor;
+        std::vector<std::vector<std::byte>> buffers;
+        std::vector<std::unique_ptr<tests::MemoryAssetIoInterface>> ios;
+        for (u32 i = 0; i < ASSET_COUNT; i++)
+        {
+            buffers.push_back(sequentialBytes((u64)(1000 + i * 500) * POSITION_SIZE, i));
+            ios.push_back(std::make_unique<tests::MemoryAssetIoInterface>(compressor.Compress(buffers.back())));
+        }
+
+        AssetStreamingQueue<u32, SceneGeometryInfo> queue;
+        std::vector<std::future<void>> loads;
+        for (u32 i = 0; i < ASSET_COUNT; i++)
+        {
+            REQUIRE(queue.Begin(i));
+            loads.push_back(ThreadPool::Global().Submit([&, i]() {
+                queue.Complete(i, loadGeometry((u32)(buffers[i].size() / POSITION_SIZE), *ios[i], compressor));
+            }));
+        }
+        queue.Cancel(ASSET_COUNT - 1);
+
+        MockUploader uploader;
+        u32 frames = 0;
+        while (queue.PendingCount() > 0 || !uploader.Pending.empty())
+        {
+            uploader.OnFrame(BUDGET_BYTES, queue);
+            const bool isSingleUpload = uploader.Budget.SpentBytes > 0 &&
+                uploader.Budget.SpentBytes == uploader.Uploaded.back().second.size();
+            REQUIRE((uploader.Budget.SpentBytes <= BUDGET_BYTES || isSingleUpload));
+            frames++;
+        }
+        for (auto& load : loads)
+            load.get();
+        queue.WaitIdle();
+
+        REQUIRE(frames > 1);
+        REQUIRE(uploader.Uploaded.size() == ASSET_COUNT - 1);
+        for (auto& [id, staging] : uploader.Uploaded)
+        {
+            REQUIRE(id != ASSET_COUNT - 1);
+            REQUIRE(staging == buffers[id]);
+        }
+    }
+}
+
+// NOLINTEND
@@ -0,0 +1,369 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "RenderGraph/Passes/Shadows/CsmStaticCache.h"
+#include "RenderGraph/Passes/Shadows/ShadowPassesUtils.h"
+#include "cvars/CVarSystem.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// NOLINTBEGIN
+
+namespace
+{
+struct Cascades
+{
+    std::vector<Camera> Cameras;
+    std::vector<FrustumCorners> Corners;
+};
+
+Cascades cascadesFor(const Camera& mainCamera, const glm::vec3& lightDirection)
+{
+    static constexpr std::array<f32, SHADOW_CASCADES> SPLITS = {4.0f, 12.0f, 30.0f, 80.0f};
+    const glm::vec3 up = glm::vec3{0.0f, 1.0f, 0.0f};
+
+    Cascades cascades = {};
+    for (u32 i = 0; i < SHADOW_CASCADES; i++)
+    {
+        const f32 previousSplit = i > 0 ? SPLITS[i - 1] : mainCamera.GetNear();
+        cascades.Corners.push_back(mainCamera.GetFrustumCorners(previousSplit, SPLITS[i]));
+        cascades.Cameras.push_back(ShadowUtils::shadowCamera(cascades.Corners.back(), AABB{}, lightDirection, up));
+    }
+
+    return cascades;
+}
+
+Camera mainCameraAt(const glm::vec3& position, f32 fov = glm::radians(60.0f))
+{
+    return Camera::Perspective({
+        .BaseInfo = {
+            .Position = position,
+            .Near = 0.1f,
+            .ViewportWidth = 1920,
+            .ViewportHeight = 1080},
+        .Fov = fov});
+}
+
+bool isRedrawn(const CsmStaticCache& cache, u32 cascade)
+{
+    return cache.GetUpdate(cascade) == CsmStaticCache::UpdateType::Full;
+}
+
+u32 redrawnCount(const CsmStaticCache& cache)
+{
+    u32 count = 0;
+    for (u32 i = 0; i < SHADOW_CASCADES; i++)
+        count += isRedrawn(cache, i) ? 1 : 0;
+
+    return count;
+}
+
+u32 updatedCount(const CsmStaticCache& cache)
+{
+    u32 count = 0;
+    for (u32 i = 0; i < SHADOW_CASCADES; i++)
+        count += cache.GetUpdate(i) != CsmStaticCache::UpdateType::None ? 1 : 0;
+
+    return count;
+}
+
+bool cornersInside(const Camera& camera, const FrustumCorners& corners)
+{
+    for (auto& corner : corners)
+    {
+        const glm::vec4 clip = camera.GetViewProjection() * glm::vec4{corner, 1.0f};
+        if (std::abs(clip.x) > clip.w || std::abs(clip.y) > clip.w || clip.z < 0.0f || clip.z > clip.w)
+            return false;
+    }
+
+    return true;
+}
+
+/* texel of the world origin in the cascade window */
+glm::vec2 anchorTexel(const Camera& camera, const glm::vec2& resolution)
+{
+    const glm::vec4 clip = camera.GetViewProjection() * glm::vec4{0.0f, 0.0f, 0.0f, 1.0f};
+
+    return (glm::vec2{clip} / clip.w + 1.0f) * 0.5f * resolution;
+}
+
+/* the cpu model of the cached static depth: every texel remembers the full redraw it was drawn after,
+ * and the position of its window texel on the texel grid of the light, that scrolling does not change */
+struct CacheModel
+{
+    struct Texel
+    {
+        u32 Redraw{~0u};
+        glm::ivec2 GridTexel{0};
+
+        bool operator==(const Texel&) const = default;
+    };
+
+    u32 Resolution{0};
+    std::array<std::vector<Texel>, SHADOW_CASCADES> Layers{};
+    std::array<u32, SHADOW_CASCADES> Redraws{};
+
+    explicit CacheModel(u32 resolution)
+        : Resolution(resolution)
+    {
+        for (auto& layer : Layers)
+            layer.resize((u64)resolution * resolution);
+    }
+
+    Texel Expected(const CsmStaticCache& cache, u32 cascade, const glm::uvec2& windowTexel) const
+    {
+        const glm::vec2 anchor = anchorTexel(cache.GetCamera(cascade), glm::vec2{(f32)Resolution});
+
+        return {
+            .Redraw = Redraws[cascade],
+            .GridTexel = glm::ivec2{glm::round(glm::vec2{windowTexel} - anchor)}};
+    }
+
+    /* what the gpu does: draws the strips and copies them into the wrapped regions of the cache */
+    void Apply(const CsmStaticCache& cache)
+    {
+        for (u32 i = 0; i < SHADOW_CASCADES; i++)
+        {
+            if (isRedrawn(cache, i))
+                Redraws[i]++;
+            for (auto& strip : cache.GetStrips(i))
+            {
+                CsmStaticCache::CacheRegions regions;
+                const u32 regionCount = cache.GetCacheRegions(i, strip, regions);
+                for (u32 region = 0; region < regionCount; region++)
+                    for (u32 y = 0; y < regions[region].Size.y; y++)
+                        for (u32 x = 0; x < regions[region].Size.x; x++)
+                        {
+                            const glm::uvec2 cacheTexel = regions[region].CacheOffset + glm::uvec2{x, y};
+                            Layers[i][cacheTexel.y * Resolution + cacheTexel.x] =
+                                Expected(cache, i, regions[region].Offset + glm::uvec2{x, y});
+                        }
+            }
+        }
+    }
+
+    /* what the gpu does: copies the wrapped regions of the whole window into the shadow map */
+    bool WindowMatches(const CsmStaticCache& cache, u32 cascade) const
+    {
+        CsmStaticCache::CacheRegions regions;
+        const u32 regionCount = cache.GetCacheRegions(cascade,
+            {.Offset = glm::uvec2{0}, .Size = glm::uvec2{Resolution}}, regions);
+        u64 texels = 0;
+        for (u32 region = 0; region < regionCount; region++)
+            for (u32 y = 0; y < regions[region].Size.y; y++)
+                for (u32 x = 0; x < regions[region].Size.x; x++)
+                {
+                    const glm::uvec2 cacheTexel = regions[region].CacheOffset + glm::uvec2{x, y};
+                    const Texel& texel = Layers[cascade][cacheTexel.y * Resolution + cacheTexel.x];
+                    if (texel != Expected(cache, cascade, regions[region].Offset + glm::uvec2{x, y}))
+                        return false;
+                    texels++;
+                }
+
+        return texels == (u64)Resolution * Resolution;
+    }
+};
+
+void prepare(CsmStaticCache& cache, const Camera& mainCamera, const glm::vec3& lightDirection,
+    Span<const AABB> changedBounds = {})
+{
+    const Cascades cascades = cascadesFor(mainCamera, lightDirection);
+    cache.Prepare(cascades.Cameras, cascades.Corners, lightDirection, changedBounds);
+}
+}
+
+TEST_CASE("CsmStaticCache", "[Shadow][CsmStaticCache]")
+{
+    const glm::vec3 lightDirection = glm::normalize(glm::vec3{-0.3f, -1.0f, -0.2f});
+    const Camera mainCamera = mainCameraAt(glm::vec3{0.0f, 2.0f, 0.0f});
+    CsmStaticCache cache(256);
+
+    SECTION("First prepare draws every cascade")
+    {
+        prepare(cache, mainCamera, lightDirection);
+        REQUIRE(redrawnCount(cache) == SHADOW_CASCADES);
+        for (u32 i = 0; i < SHADOW_CASCADES; i++)
+        {
+            REQUIRE(cache.GetStrips(i).size() == 1);
+            REQUIRE(cache.GetStrips(i)[0] == CsmStaticCache::Rect{.Size = glm::uvec2{cache.GetResolution()}});
+        }
+    }
+    SECTION("Nothing is drawn again when nothing changes")
+    {
+        prepare(cache, mainCamera, lightDirection);
+        const glm::mat4 viewProjection = cache.GetCamera(0).GetViewProjection();
+        prepare(cache, mainCamera, lightDirection);
+        REQUIRE(updatedCount(cache) == 0);
+        REQUIRE(cache.GetCamera(0).GetViewProjection() == viewProjection);
+    }
+    SECTION("Cached cascades cover the cascades of the current frame")
+    {
+        prepare(cache, mainCamera, lightDirection);
+        const Cascades cascades = cascadesFor(mainCamera, lightDirection);
+        for (u32 i = 0; i < SHADOW_CASCADES; i++)
+        {
+            for (auto& corner : cascades.Corners[i])
+            {
+                const glm::vec4 clip = cache.GetCamera(i).GetViewProjection() * glm::vec4{corner, 1.0f};
+                REQUIRE(std::abs(clip.x) <= clip.w);
+                REQUIRE(std::abs(clip.y) <= clip.w);
+                REQUIRE(clip.z >= 0.0f);
+                REQUIRE(clip.z <= clip.w);
+            }
+        }
+    }
+    SECTION("Small camera moves keep the cache and large ones invalidate it")
+    {
+        prepare(cache, mainCamera, lightDirection);
+        prepare(cache, mainCameraAt(glm::vec3{0.01f, 2.0f, -0.01f}), lightDirection);
+        REQUIRE(updatedCount(cache) == 0);
+
+        prepare(cache, mainCameraAt(glm::vec3{20.0f, 2.0f, 0.0f}), lightDirection);
+        REQUIRE(isRedrawn(cache, 0));
+    }
+    SECTION("Moving camera scrolls the cascades and draws only the exposed strips")
+    {
+        CacheModel model(cache.GetResolution());
+        const u32 texelCount = cache.GetResolution() * cache.GetResolution();
+        u32 scrolls = 0;
+        for (u32 frame = 0; frame < 96; frame++)
+        {
+            const Camera movingCamera = mainCameraAt(glm::vec3{0.15f * (f32)frame, 2.0f, -0.1f * (f32)frame});
+            prepare(cache, movingCamera, lightDirection);
+            model.Apply(cache);
+            if (frame > 0)
+                REQUIRE(redrawnCount(cache) == 0);
+            for (u32 i = 0; i < SHADOW_CASCADES; i++)
+            {
+                REQUIRE(model.WindowMatches(cache, i));
+                if (cache.GetUpdate(i) != CsmStaticCache::UpdateType::Scroll)
+                    continue;
+
+                scrolls++;
+                u32 stripTexels = 0;
+                for (auto& strip : cache.GetStrips(i))
+                    stripTexels += strip.Size.x * strip.Size.y;
+                REQUIRE(stripTexels > 0);
+                REQUIRE(stripTexels < texelCount / 4);
+            }
+        }
+        REQUIRE(scrolls > SHADOW_CASCADES);
+    }
+    SECTION("Strip cameras draw their strips of the cascade window")
+    {
+        prepare(cache, mainCamera, lightDirection);
+        prepare(cache, mainCameraAt(glm::vec3{1.5f, 2.0f, -1.0f}), lightDirection);
+        REQUIRE(cache.GetUpdate(0) == CsmStaticCache::UpdateType::Scroll);
+        REQUIRE(cache.GetStrips(0).size() == 2);
+
+        const glm::vec2 resolution = glm::vec2{(f32)cache.GetResolution()};
+        const glm::vec2 anchor = anchorTexel(cache.GetCamera(0), resolution);
+        for (auto& strip : cache.GetStrips(0))
+        {
+            const Camera stripCamera = cache.GetStripCamera(0, strip);
+            const glm::vec2 stripAnchor = anchorTexel(stripCamera, glm::vec2{strip.Size});
+            REQUIRE(glm::all(glm::lessThan(glm::abs(stripAnchor - (anchor - glm::vec2{strip.Offset})),
+                glm::vec2{1e-2f})));
+            REQUIRE(stripCamera.GetView() == cache.GetCamera(0).GetView());
+        }
+    }
+    SECTION("Cache regions wrap around the cache layer")
+    {
+        prepare(cache, mainCamera, lightDirection);
+        prepare(cache, mainCameraAt(glm::vec3{1.5f, 2.0f, -1.0f}), lightDirection);
+        const glm::uvec2 origin = cache.GetOrigin(0);
+        REQUIRE(origin != glm::uvec2{0});
+
+        const u32 resolution = cache.GetResolution();
+        CsmStaticCache::CacheRegions regions;
+        const u32 regionCount = cache.GetCacheRegions(0, {.Size = glm::uvec2{resolution}}, regions);
+        REQUIRE(regionCount == (origin.x > 0 ? 2 : 1) * (origin.y > 0 ? 2 : 1));
+        u32 texels = 0;
+        for (u32 i = 0; i < regionCount; i++)
+        {
+            REQUIRE(glm::all(glm::lessThanEqual(regions[i].CacheOffset + regions[i].Size, glm::uvec2{resolution})));
+            REQUIRE(regions[i].CacheOffset == (regions[i].Offset + origin) % resolution);
+            texels += regions[i].Size.x * regions[i].Size.y;
+        }
+        REQUIRE(texels == resolution * resolution);
+    }
+    SECTION("Far cascades scroll on their staggered frames only")
+    {
+        u32 farScrolls = 0;
+        std::vector<Camera> previousCameras;
+        for (u32 frame = 0; frame < 128; frame++)
+        {
+            const Camera movingCamera = mainCameraAt(glm::vec3{0.2f * (f32)frame, 2.0f, 0.0f});
+            const Cascades cascades = cascadesFor(movingCamera, lightDirection);
+            cache.Prepare(cascades.Cameras, cascades.Corners, lightDirection, {});
+            for (u32 i = 0; i < SHADOW_CASCADES && frame > 0; i++)
+            {
+                if (cache.GetUpdate(i) != CsmStaticCache::UpdateType::Scroll)
+                    continue;
+                /* off its frame a cascade scrolls only when it has to */
+                const bool isScheduled = (frame + i) % CsmStaticCache::UPDATE_PERIODS[i] == 0;
+                if (!isScheduled)
+                    REQUIRE_FALSE(cornersInside(previousCameras[i], cascades.Corners[i]));
+                else if (CsmStaticCache::UPDATE_PERIODS[i] > 1)
+                    farScrolls++;
+            }
+            previousCameras.clear();
+            for (u32 i = 0; i < SHADOW_CASCADES; i++)
+                previousCameras.push_back(cache.GetCamera(i));
+        }
+        REQUIRE(farScrolls > 0);
+    }
+    SECTION("Cascades that got much smaller are drawn again")
+    {
+        prepare(cache, mainCamera, lightDirection);
+        prepare(cache, mainCameraAt(glm::vec3{0.0f, 2.0f, 0.0f}, glm::radians(20.0f)), lightDirection);
+        REQUIRE(redrawnCount(cache) == SHADOW_CASCADES);
+    }
+    SECTION("Light direction change past the threshold invalidates every cascade")
+    {
+        prepare(cache, mainCamera, lightDirection);
+        const glm::vec3 nudged = glm::normalize(lightDirection + glm::vec3{1e-4f, 0.0f, 0.0f});
+        prepare(cache, mainCamera, nudged);
+        REQUIRE(updatedCount(cache) == 0);
+
+        const glm::vec3 rotated = glm::normalize(lightDirection + glm::vec3{0.05f, 0.0f, 0.0f});
+        prepare(cache, mainCamera, rotated);
+        REQUIRE(redrawnCount(cache) == SHADOW_CASCADES);
+    }
+    SECTION("Changed geometry invalidates only the cascades it is in")
+    {
+        prepare(cache, mainCamera, lightDirection);
+
+        const std::array farAway = {AABB{.Min = glm::vec3{500.0f}, .Max = glm::vec3{501.0f}}};
+        prepare(cache, mainCamera, lightDirection, farAway);
+        REQUIRE(updatedCount(cache) == 0);
+
+        /* in front of the camera, within the last cascade only */
+        const std::array distant = {AABB{.Min = glm::vec3{-0.5f, 0.0f, -60.5f}, .Max = glm::vec3{0.5f, 1.0f, -59.5f}}};
+        prepare(cache, mainCamera, lightDirection, distant);
+        REQUIRE(isRedrawn(cache, SHADOW_CASCADES - 1));
+        REQUIRE(cache.GetUpdate(0) == CsmStaticCache::UpdateType::None);
+    }
+    SECTION("Invalidate draws every cascade again")
+    {
+        prepare(cache, mainCamera, lightDirection);
+        cache.Invalidate();
+        REQUIRE(redrawnCount(cache) == SHADOW_CASCADES);
+        prepare(cache, mainCamera, lightDirection);
+        REQUIRE(redrawnCount(cache) == SHADOW_CASCADES);
+        prepare(cache, mainCamera, lightDirection);
+        REQUIRE(updatedCount(cache) == 0);
+    }
+}
+
+TEST_CASE("CsmStaticCache is used by default", "[Shadow][CsmStaticCache]")
+{
+    /* the cache is bypassed by the cascades created on gpu */
+    REQUIRE(CVars::Get().GetI32CVar("Renderer.UseGpuShadowCameras"_hsv) == 0);
+}
+
+TEST_CASE("Shadow casters are occlusion culled by default", "[Shadow][CsmStaticCache]")
+{
+    /* the hiz of the previous frame is reprojected with its cameras, that exist only on cpu */
+    REQUIRE(CVars::Get().GetI32CVar("Renderer.UseGpuShadowCameras"_hsv) == 0);
+    REQUIRE(CVars::Get().GetI32CVar("Renderer.Shadows.OcclusionCull"_hsv) == 1);
+}
@@ -0,0 +1,72 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <AssetLib/Io/Compression/Lz4AssetCompressor.h>
+#include <AssetLib/Io/IoInterface/SeparateAssetIoInterface.h>
+#include <AssetImportLib/Bakers/DirectoryBaker.h>
+#include <AssetImportLib/Importers/ImportContext.h>
+#include <CoreLib/Log.h>
+#include <CoreLib/Utils/FileUtils.h>
+
+#include <filesystem>
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+using namespace lux;
+
+/* flat (not run length encoded) radiance image, which stb reads for the widths below 8 */
+void writeHdrImage(const std::filesystem::path& path, std::mt19937& rng)
+{
+    const u32 width = 4 + rng() % 4;
+    const u32 height = 4 + rng() % 4;
+    std::string image = std::format("#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y {} +X {}\n", height, width);
+    for (u32 i = 0; i < width * height; i++)
+    {
+        image.push_back((char)(rng() % 256));
+        image.push_back((char)(rng() % 256));
+        image.push_back((char)(rng() % 256));
+        image.push_back((char)(124 + rng() % 8));
+    }
+    std::filesystem::create_directories(path.parent_path());
+    REQUIRE(writeStringToFile(path, image).has_value());
+}
+}
+
+TEST_CASE("Directory baker", "[Assets][DirectoryBaker]")
+{
+    Logger::Init({});
+    std::mt19937 rng(5);
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "lux_directory_baker";
+    std::filesystem::remove_all(directory);
+    for (u32 i = 0; i < 12; i++)
+        writeHdrImage(directory / "assets" / std::format("folder_{}", i % 3) / std::format("image_{}.hdr", i), rng);
+
+    assetlib::io::SeparateAssetIoInterface io;
+    assetlib::io::Lz4AssetCompressor compressor;
+    auto ctx = std::make_shared<import::Context>(import::Context{
+        .InitialDirectory = directory / "assets",
+        .BakedDirectory = directory / "baked",
+        .Io = &io,
+        .Compressor = &compressor});
+
+    SECTION("Parallel bake writes the same files as the serial one")
+    {
+        /* the first bake creates the metadata files with random asset ids, the bakes after it reuse them */
+        import::bakeDirectory(ctx, {.Jobs = 1});
+        const u64 serialHash = import::hashDirectory(ctx->BakedDirectory);
+        u32 bakedCount = 0;
+        for (const auto& file : std::filesystem::recursive_directory_iterator(ctx->BakedDirectory))
+            bakedCount += file.is_directory() ? 0 : 1;
+        REQUIRE(bakedCount >= 12);
+
+        std::filesystem::remove_all(ctx->BakedDirectory);
+        import::bakeDirectory(ctx, {.Jobs = 4});
+        REQUIRE(import::hashDirectory(ctx->BakedDirectory) == serialHash);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+// NOLINTEND
@@ -0,0 +1,263 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Light/LightClusterCache.h"
+
+#include <CoreLib/Math/Geometry.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <array>
+#include <bitset>
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+constexpr u32 CLUSTERS_X = 8;
+constexpr u32 CLUSTERS_Y = 8;
+constexpr u32 CLUSTERS_Z = 8;
+constexpr u32 CLUSTER_COUNT = CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z;
+constexpr u32 MAX_LIGHTS = 256;
+
+using LightMask = std::bitset<MAX_LIGHTS>;
+
+/* the cpu reference of the cluster binning shaders, with a uniform grid of view space clusters */
+struct ReferenceClusters
+{
+    std::array<AABB, CLUSTER_COUNT> Bounds{};
+    std::array<LightMask, CLUSTER_COUNT> Masks{};
+    std::array<u32, CLUSTER_COUNT> Generations{};
+
+    void Setup()
+    {
+        const glm::vec3 clusterSize = glm::vec3{100.0f, 100.0f, 100.0f} / glm::vec3{CLUSTERS_X, CLUSTERS_Y, CLUSTERS_Z};
+        for (u32 i = 0; i < CLUSTER_COUNT; i++)
+        {
+            const glm::vec3 min = glm::vec3{
+                -50.0f + (f32)(i % CLUSTERS_X) * clusterSize.x,
+                -50.0f + (f32)(i / CLUSTERS_X % CLUSTERS_Y) * clusterSize.y,
+                -100.0f + (f32)(i / (CLUSTERS_X * CLUSTERS_Y)) * clusterSize.z};
+            Bounds[i] = {.Min = min, .Max = min + clusterSize};
+            Masks[i].reset();
+            Generations[i] = LightClusterCache::NO_GENERATION;
+        }
+    }
+
+    bool IsInCluster(u32 cluster, const LightClusterCache::Light& light, const glm::mat4& view) const
+    {
+        const AABB& bounds = Bounds[cluster];
+        auto sphereInCluster = [&bounds](const Sphere& sphere)
+        {
+            const glm::vec3 closest = glm::clamp(sphere.Center, bounds.Min, bounds.Max);
+            const glm::vec3 delta = closest - sphere.Center;
+
+            return glm::dot(delta, delta) <= sphere.Radius * sphere.Radius;
+        };
+
+        if (!light.IsSpot)
+            return sphereInCluster({.Center = glm::vec3{view * glm::vec4{light.Position, 1.0f}}, .Radius = light.Radius});
+
+        const Cone cone = Cone{
+            .Apex = light.Position,
+            .Axis = light.Direction,
+            .Height = light.Radius,
+            .CosHalfAngle = light.CosOuterAngle,
+            .SinHalfAngle = std::sqrt(1.0f - light.CosOuterAngle * light.CosOuterAngle)}.Transform(view);
+        const Sphere clusterSphere = {
+            .Center = (bounds.Min + bounds.Max) * 0.5f,
+            .Radius = glm::length(bounds.Max - bounds.Min) * 0.5f};
+
+        return sphereInCluster(cone.BoundingSphere()) && cone.Intersects(clusterSphere);
+    }
+
+    LightMask BinFromScratch(u32 cluster, std::span<const LightClusterCache::Light> lights,
+        const glm::mat4& view) const
+    {
+        LightMask mask;
+        for (u32 light = 0; light < lights.size(); light++)
+            mask[light] = IsInCluster(cluster, lights[light], view);
+
+        return mask;
+    }
+
+    /* what the gpu does with the update: rebin the dirty lights in the binned clusters,
+     * and then bin the visible clusters of another generation from scratch */
+    void Apply(const LightClusterCache::Update& update, std::span<const LightClusterCache::Light> lights,
+        const glm::mat4& view, const std::vector<bool>& visible)
+    {
+        if (update.SetupClusters)
+            Setup();
+        for (u32 cluster = 0; cluster < CLUSTER_COUNT; cluster++)
+        {
+            if (Generations[cluster] != update.Generation)
+                continue;
+            for (u32 light : update.DirtyLights)
+                Masks[cluster][light] = IsInCluster(cluster, lights[light], view);
+        }
+        for (u32 cluster = 0; cluster < CLUSTER_COUNT; cluster++)
+        {
+            if (!visible[cluster] || Generations[cluster] == update.Generation)
+                continue;
+            Masks[cluster] = BinFromScratch(cluster, lights, view);
+            Generations[cluster] = update.Generation;
+        }
+    }
+};
+
+std::vector<LightClusterCache::Light> randomLights(u32 count, std::mt19937& rng)
+{
+    std::uniform_real_distribution<f32> lateral(-60.0f, 60.0f);
+    std::uniform_real_distribution<f32> depth(-110.0f, 5.0f);
+    std::uniform_real_distribution<f32> radius(1.0f, 15.0f);
+    std::uniform_real_distribution<f32> axis(-1.0f, 1.0f);
+    std::uniform_real_distribution<f32> cosAngle(0.2f, 0.98f);
+
+    std::vector<LightClusterCache::Light> lights(count);
+    for (u32 i = 0; i < count; i++)
+    {
+        auto& light = lights[i];
+        light.Position = {lateral(rng), lateral(rng), depth(rng)};
+        light.Radius = radius(rng);
+        /* spot lights go after the point lights */
+        light.IsSpot = i >= count / 2;
+        if (light.IsSpot)
+        {
+            light.Direction = glm::normalize(glm::vec3{axis(rng), axis(rng), axis(rng)} + 1e-3f);
+            light.CosOuterAngle = cosAngle(rng);
+        }
+    }
+
+    return lights;
+}
+
+std::vector<bool> randomVisibility(std::mt19937& rng)
+{
+    std::bernoulli_distribution isVisible(0.3);
+    std::vector<bool> visible(CLUSTER_COUNT);
+    for (u32 i = 0; i < CLUSTER_COUNT; i++)
+        visible[i] = isVisible(rng);
+
+    return visible;
+}
+
+bool visibleClustersMatchReference(const ReferenceClusters& clusters, const std::vector<bool>& visible,
+    std::span<const LightClusterCache::Light> lights, const glm::mat4& view)
+{
+    for (u32 cluster = 0; cluster < CLUSTER_COUNT; cluster++)
+        if (visible[cluster] && clusters.Masks[cluster] != clusters.BinFromScratch(cluster, lights, view))
+            return false;
+
+    return true;
+}
+}
+
+TEST_CASE("LightClusterCache", "[Light][LightClusterCache]")
+{
+    const LightClusterCache::Projection projection = {
+        .Matrix = glm::perspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f),
+        .Resolution = {1920, 1080},
+        .Near = 0.1f,
+        .MaxLightCullDistance = 200.0f};
+    const glm::mat4 view = glm::lookAtRH(glm::vec3{0.0f}, glm::vec3{0.0f, 0.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+    std::mt19937 rng(7);
+    LightClusterCache cache = {};
+
+    SECTION("First update sets up and bins everything")
+    {
+        const std::vector lights = randomLights(64, rng);
+        const LightClusterCache::Update update = cache.Prepare(projection, view, lights);
+        REQUIRE(update.SetupClusters);
+        REQUIRE(update.Generation != LightClusterCache::NO_GENERATION);
+        REQUIRE(update.DirtyLights.empty());
+    }
+    SECTION("Nothing is rebuilt when nothing changes")
+    {
+        const std::vector lights = randomLights(64, rng);
+        const u32 generation = cache.Prepare(projection, view, lights).Generation;
+        const LightClusterCache::Update update = cache.Prepare(projection, view, lights);
+        REQUIRE_FALSE(update.SetupClusters);
+        REQUIRE(update.Generation == generation);
+        REQUIRE(update.DirtyLights.empty());
+    }
+    SECTION("Only changed lights are dirty")
+    {
+        std::vector lights = randomLights(64, rng);
+        const u32 generation = cache.Prepare(projection, view, lights).Generation;
+        lights[3].Position.x += 1.0f;
+        lights[40].Radius *= 2.0f;
+        lights[50].Direction = -lights[50].Direction;
+        const LightClusterCache::Update update = cache.Prepare(projection, view, lights);
+        REQUIRE_FALSE(update.SetupClusters);
+        REQUIRE(update.Generation == generation);
+        REQUIRE(std::vector(update.DirtyLights.begin(), update.DirtyLights.end()) == std::vector<u32>{3, 40, 50});
+    }
+    SECTION("View, light count and too many changes start a new generation")
+    {
+        std::vector lights = randomLights(64, rng);
+        u32 generation = cache.Prepare(projection, view, lights).Generation;
+
+        const glm::mat4 movedView = glm::translate(view, glm::vec3{0.0f, 0.0f, 1.0f});
+        LightClusterCache::Update update = cache.Prepare(projection, movedView, lights);
+        REQUIRE_FALSE(update.SetupClusters);
+        REQUIRE(update.Generation != generation);
+        REQUIRE(update.DirtyLights.empty());
+        generation = update.Generation;
+
+        lights.pop_back();
+        update = cache.Prepare(projection, movedView, lights);
+        REQUIRE(update.Generation != generation);
+        generation = update.Generation;
+
+        for (u32 i = 0; i < 32; i++)
+            lights[i].Position.y += 1.0f;
+        update = cache.Prepare(projection, movedView, lights);
+        REQUIRE(update.Generation != generation);
+        REQUIRE(update.DirtyLights.empty());
+    }
+    SECTION("Projection change sets the clusters up again")
+    {
+        const std::vector lights = randomLights(64, rng);
+        cache.Prepare(projection, view, lights);
+        LightClusterCache::Projection resized = projection;
+        resized.Resolution = {1280, 720};
+        REQUIRE(cache.Prepare(resized, view, lights).SetupClusters);
+        REQUIRE_FALSE(cache.Prepare(resized, view, lights).SetupClusters);
+        cache.Invalidate();
+        REQUIRE(cache.Prepare(resized, view, lights).SetupClusters);
+    }
+    SECTION("Incremental updates match binning from scratch")
+    {
+        ReferenceClusters clusters = {};
+        std::vector lights = randomLights(MAX_LIGHTS, rng);
+        glm::mat4 frameView = view;
+        std::uniform_int_distribution<u32> lightIndex(0, MAX_LIGHTS - 1);
+        std::uniform_real_distribution<f32> offset(-3.0f, 3.0f);
+        std::uniform_int_distribution<u32> event(0, 9);
+        for (u32 frame = 0; frame < 64; frame++)
+        {
+            switch (event(rng))
+            {
+            case 0:
+                frameView = glm::translate(frameView, glm::vec3{offset(rng), 0.0f, offset(rng)});
+                break;
+            case 1:
+                for (u32 i = 0; i < MAX_LIGHTS / 2; i++)
+                    lights[lightIndex(rng)].Position.z += offset(rng);
+                break;
+            default:
+                for (u32 i = 0; i < 4; i++)
+                {
+                    auto& light = lights[lightIndex(rng)];
+                    light.Position += glm::vec3{offset(rng), offset(rng), offset(rng)};
+                    light.Radius = std::max(1.0f, light.Radius + offset(rng));
+                }
+                break;
+            }
+
+            const std::vector<bool> visible = randomVisibility(rng);
+            clusters.Apply(cache.Prepare(projection, frameView, lights), lights, frameView, visible);
+            REQUIRE(visibleClustersMatchReference(clusters, visible, lights, frameView));
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Light/LightSphereCuller.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+struct TestSphere
+{
+    glm::vec3 Center{};
+    f32 Radius{};
+};
+
+/* straightforward per-light test, the way the frustum culler used to do it */
+std::vector<u32> referenceCull(const std::vector<TestSphere>& spheres, const LightSphereCuller::CullInfo& info)
+{
+    const FrustumPlanes& frustum = info.Frustum;
+    const ProjectionData& projection = info.Projection;
+    std::vector<u32> visible;
+    for (u32 i = 0; i < spheres.size() && visible.size() < info.MaxVisible; i++)
+    {
+        const glm::vec3 center = glm::vec3{info.View * glm::vec4{spheres[i].Center, 1.0f}};
+        const f32 radius = spheres[i].Radius;
+        bool isVisible = info.Type == CameraType::Perspective ?
+            frustum.RightX * std::abs(center.x) + center.z * frustum.RightZ < radius &&
+            frustum.TopY * std::abs(center.y) + center.z * frustum.TopZ < radius :
+            std::abs(frustum.RightX * center.x + projection.BiasX) < 1.0f + frustum.RightX * radius &&
+            std::abs(frustum.TopY * center.y + projection.BiasY) < 1.0f + frustum.TopY * radius;
+        isVisible = isVisible && center.z - radius <= -frustum.Near && center.z + radius >= -frustum.Far;
+        if (isVisible)
+            visible.push_back(i);
+    }
+
+    return visible;
+}
+
+/* same frustum values as `Camera::GetFrustumPlanes` */
+LightSphereCuller::CullInfo perspectiveInfo(const glm::mat4& view)
+{
+    const glm::mat4 projection = glm::perspectiveRH_ZO(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    const f32 rightLengthInverse = 1.0f / std::sqrt(1.0f + projection[0][0] * projection[0][0]);
+    const f32 topLengthInverse = 1.0f / std::sqrt(1.0f + projection[1][1] * projection[1][1]);
+
+    return {
+        .View = view,
+        .Frustum = {
+            .TopY = projection[1][1] * topLengthInverse,
+            .TopZ = topLengthInverse,
+            .RightX = projection[0][0] * rightLengthInverse,
+            .RightZ = rightLengthInverse,
+            .Near = 0.1f,
+            .Far = 200.0f},
+        .Projection = {projection[0][0], projection[1][1], projection[3][0], projection[3][1]},
+        .Type = CameraType::Perspective};
+}
+
+LightSphereCuller::CullInfo orthographicInfo(const glm::mat4& view)
+{
+    const glm::mat4 projection = glm::orthoRH_ZO(-60.0f, 40.0f, -30.0f, 50.0f, 100.0f, 0.1f);
+
+    return {
+        .View = view,
+        .Frustum = {
+            .TopY = projection[1][1],
+            .TopZ = 0.0f,
+            .RightX = projection[0][0],
+            .RightZ = 0.0f,
+            .Near = 0.1f,
+            .Far = 100.0f},
+        .Projection = {projection[0][0], projection[1][1], projection[3][0], projection[3][1]},
+        .Type = CameraType::Orthographic};
+}
+
+std::vector<LightSphereCuller::SimdPath> availablePaths()
+{
+    using enum LightSphereCuller::SimdPath;
+    std::vector paths = {Scalar};
+    if (LightSphereCuller::BestSimdPath() != Scalar)
+        paths.push_back(Sse);
+    if (LightSphereCuller::BestSimdPath() == Avx2)
+        paths.push_back(Avx2);
+
+    return paths;
+}
+}
+
+TEST_CASE("LightSphereCuller", "[Light][LightSphereCuller]")
+{
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<f32> position(-150.0f, 150.0f);
+    std::uniform_real_distribution<f32> radius(0.1f, 20.0f);
+
+    /* odd count, so that the last simd batch is partial */
+    std::vector<TestSphere> spheres(10007);
+    LightSphereCuller culler;
+    for (u32 i = 0; i < spheres.size(); i++)
+    {
+        spheres[i] = {.Center = {position(rng), position(rng), position(rng)}, .Radius = radius(rng)};
+        culler.Add(spheres[i].Center, spheres[i].Radius, i);
+    }
+    REQUIRE(culler.Count() == spheres.size());
+
+    const glm::mat4 view = glm::lookAtRH(glm::vec3{10.0f, 20.0f, 30.0f}, glm::vec3{-40.0f, 0.0f, -70.0f},
+        glm::vec3{0.0f, 1.0f, 0.0f});
+
+    SECTION("Perspective culling matches the reference exactly")
+    {
+        const LightSphereCuller::CullInfo info = perspectiveInfo(view);
+        const std::vector<u32> expected = referenceCull(spheres, info);
+        REQUIRE(!expected.empty());
+        for (auto path : availablePaths())
+        {
+            std::vector<u32> visible;
+            culler.Cull(info, visible, path);
+            REQUIRE(visible == expected);
+        }
+    }
+    SECTION("Orthographic culling matches the reference exactly")
+    {
+        const LightSphereCuller::CullInfo info = orthographicInfo(view);
+        const std::vector<u32> expected = referenceCull(spheres, info);
+        REQUIRE(!expected.empty());
+        for (auto path : availablePaths())
+        {
+            std::vector<u32> visible;
+            culler.Cull(info, visible, path);
+            REQUIRE(visible == expected);
+        }
+    }
+    SECTION("Visible count is capped")
+    {
+        LightSphereCuller::CullInfo info = perspectiveInfo(view);
+        info.MaxVisible = 13;
+        const std::vector<u32> expected = referenceCull(spheres, info);
+        REQUIRE(expected.size() == 13);
+        for (auto path : availablePaths())
+        {
+            std::vector<u32> visible;
+            culler.Cull(info, visible, path);
+            REQUIRE(visible == expected);
+        }
+    }
+    SECTION("Clear removes all spheres")
+    {
+        culler.Clear();
+        REQUIRE(culler.Count() == 0);
+        for (auto path : availablePaths())
+        {
+            std::vector<u32> visible;
+            culler.Cull(perspectiveInfo(view), visible, path);
+            REQUIRE(visible.empty());
+        }
+    }
+}
@@ -0,0 +1,180 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Assets/Scenes/SceneAsset.h"
+#include "Light/LightZBinner.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+/* the serial binner that allocated the bins every frame, spot lights are indexed after all the point lights */
+std::vector<ZBins::Bin> referenceZBins(const std::vector<lux::CommonLight>& lights, const glm::mat4& view, f32 zSpan)
+{
+    std::vector bins(LIGHT_TILE_BINS_Z, ZBins::Bin{});
+    auto binLight = [&](f32 distanceMin, f32 distanceMax, u16 lightIndex)
+    {
+        const u32 binMinIndex = (u32)(distanceMin / zSpan * LIGHT_TILE_BINS_Z);
+        const u32 binMaxIndex = std::min((u32)(distanceMax / zSpan * LIGHT_TILE_BINS_Z), LIGHT_TILE_BINS_Z - 1);
+        for (u32 binIndex = binMinIndex; binIndex <= binMaxIndex; binIndex++)
+        {
+            auto& bin = bins[binIndex];
+            bin.LightMin = std::min(bin.LightMin, lightIndex);
+            bin.LightMax = std::max(bin.LightMax, lightIndex);
+        }
+    };
+
+    const u16 pointLightCount = (u16)std::ranges::count(lights, lux::LightType::Point, &lux::CommonLight::Type);
+    u16 pointLightIndex = 0;
+    u16 spotLightIndex = 0;
+    for (auto& commonLight : lights)
+    {
+        if (commonLight.Type == lux::LightType::Point)
+        {
+            const glm::vec3 center = glm::vec3{view * glm::vec4{commonLight.PositionDirection, 1.0f}};
+            binLight(std::max(-center.z - commonLight.Radius, 0.0f), -center.z + commonLight.Radius, pointLightIndex);
+            pointLightIndex++;
+        }
+        else if (commonLight.Type == lux::LightType::Spot)
+        {
+            const Cone cone = commonLight.GetSpotCone().Transform(view);
+            binLight(std::max(-cone.Extent(glm::vec3{0.0f, 0.0f, 1.0f}), 0.0f),
+                cone.Extent(glm::vec3{0.0f, 0.0f, -1.0f}), (u16)(pointLightCount + spotLightIndex));
+            spotLightIndex++;
+        }
+    }
+
+    return bins;
+}
+
+/* lights in front of the camera at (0, 0, 0) looking down -z */
+std::vector<lux::CommonLight> randomLights(u32 count, u32 seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<f32> lateral(-50.0f, 50.0f);
+    std::uniform_real_distribution<f32> depth(-220.0f, -0.5f);
+    std::uniform_real_distribution<f32> radius(0.1f, 8.0f);
+    std::uniform_int_distribution<u32> kind(0, 15);
+    std::uniform_real_distribution<f32> axis(-1.0f, 1.0f);
+    std::uniform_real_distribution<f32> angle(0.05f, 1.5f);
+
+    std::vector<lux::CommonLight> lights(count);
+    for (auto& light : lights)
+    {
+        const u32 lightKind = kind(rng);
+        light.Type = lightKind == 0 ? lux::LightType::Directional :
+            lightKind < 5 ? lux::LightType::Spot : lux::LightType::Point;
+        light.PositionDirection = {lateral(rng), lateral(rng), depth(rng)};
+        light.Radius = radius(rng);
+        light.SpotLightData.Direction = glm::normalize(glm::vec3{axis(rng), axis(rng), axis(rng)} + 1e-3f);
+        light.SpotLightData.OuterAngle = lux::SpotLightData::QuantizeAngle(angle(rng));
+    }
+
+    return lights;
+}
+
+bool binsMatch(const std::vector<ZBins::Bin>& a, const std::vector<ZBins::Bin>& b)
+{
+    return std::ranges::equal(a, b, [](const ZBins::Bin& x, const ZBins::Bin& y)
+    {
+        return x.LightMin == y.LightMin && x.LightMax == y.LightMax;
+    });
+}
+}
+
+TEST_CASE("LightZBinner", "[Light][LightZBinner]")
+{
+    const glm::mat4 view = glm::lookAtRH(glm::vec3{0.0f}, glm::vec3{0.0f, 0.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+    const f32 zSpan = 200.0f - 0.1f;
+    LightZBinner binner = {};
+    std::vector<ZBins::Bin> bins(LIGHT_TILE_BINS_Z);
+
+    SECTION("No lights leave all bins empty")
+    {
+        binner.ZBinLights({}, view, zSpan, bins);
+        REQUIRE(binsMatch(bins, std::vector(LIGHT_TILE_BINS_Z, ZBins::Bin{})));
+    }
+    SECTION("Depth sorted lights match the reference")
+    {
+        std::vector<lux::CommonLight> lights = randomLights(60000, 3);
+        std::ranges::stable_sort(lights, std::greater{}, [](const lux::CommonLight& light)
+        {
+            return light.PositionDirection.z;
+        });
+        binner.ZBinLights(lights, view, zSpan, bins);
+        REQUIRE(binsMatch(bins, referenceZBins(lights, view, zSpan)));
+    }
+    SECTION("Unsorted lights match the reference")
+    {
+        const std::vector<lux::CommonLight> lights = randomLights(20000, 5);
+        binner.ZBinLights(lights, view, zSpan, bins);
+        REQUIRE(binsMatch(bins, referenceZBins(lights, view, zSpan)));
+    }
+    SECTION("Spot lights are binned by the depth range of their cone")
+    {
+        lux::CommonLight spotLight = {
+            .Type = lux::LightType::Spot,
+            .PositionDirection = {0.0f, 0.0f, -50.0f},
+            .Radius = 10.0f};
+        spotLight.SpotLightData.Direction = {1.0f, 0.0f, 0.0f};
+        spotLight.SpotLightData.OuterAngle = lux::SpotLightData::QuantizeAngle(0.3f);
+        lux::CommonLight pointLight = {
+            .Type = lux::LightType::Point,
+            .PositionDirection = {0.0f, 0.0f, -150.0f},
+            .Radius = 1.0f};
+
+        /* the cone spans about 3 units of depth around its apex, while its bounding sphere spans 5 */
+        auto binOf = [zSpan](f32 distance) { return (u32)(distance / zSpan * LIGHT_TILE_BINS_Z); };
+        binner.ZBinLights(std::vector{spotLight, pointLight}, view, zSpan, bins);
+        REQUIRE(bins[binOf(50.0f)].LightMin == 1);
+        REQUIRE(bins[binOf(50.0f)].LightMax == 1);
+        REQUIRE(bins[binOf(47.5f)].LightMin == 1);
+        REQUIRE(bins[binOf(46.0f)].LightMin == ZBins::Bin::NO_LIGHT);
+        REQUIRE(bins[binOf(54.0f)].LightMin == ZBins::Bin::NO_LIGHT);
+        REQUIRE(bins[binOf(150.0f)].LightMin == 0);
+    }
+    SECTION("Lights behind the camera are clipped")
+    {
+        lux::CommonLight straddlingPointLight = {
+            .Type = lux::LightType::Point,
+            .PositionDirection = {0.0f, 0.0f, 3.0f},
+            .Radius = 5.0f};
+        lux::CommonLight behindPointLight = {
+            .Type = lux::LightType::Point,
+            .PositionDirection = {0.0f, 0.0f, 20.0f},
+            .Radius = 2.0f};
+        lux::CommonLight straddlingSpotLight = {
+            .Type = lux::LightType::Spot,
+            .PositionDirection = {0.0f, 0.0f, 1.0f},
+            .Radius = 10.0f};
+        straddlingSpotLight.SpotLightData.Direction = {0.0f, 0.0f, -1.0f};
+        straddlingSpotLight.SpotLightData.OuterAngle = lux::SpotLightData::QuantizeAngle(0.3f);
+
+        /* the straddling lights reach 2 and 9 units in front of the camera */
+        auto binOf = [zSpan](f32 distance) { return (u32)(distance / zSpan * LIGHT_TILE_BINS_Z); };
+        binner.ZBinLights(std::vector{straddlingPointLight, behindPointLight, straddlingSpotLight}, view, zSpan,
+            bins);
+        REQUIRE(bins[0].LightMin == 0);
+        REQUIRE(bins[0].LightMax == 2);
+        REQUIRE(bins[binOf(5.0f)].LightMin == 2);
+        REQUIRE(bins[binOf(5.0f)].LightMax == 2);
+        REQUIRE(bins[binOf(10.0f)].LightMin == ZBins::Bin::NO_LIGHT);
+        REQUIRE(std::ranges::none_of(bins, [](const ZBins::Bin& bin)
+        {
+            return bin.LightMin == 1 || bin.LightMax == 1;
+        }));
+    }
+    SECTION("Storage is reused between differently sized light sets")
+    {
+        for (u32 count : {50000u, 300u, 7000u, 1u})
+        {
+            const std::vector<lux::CommonLight> lights = randomLights(count, count);
+            binner.ZBinLights(lights, view, zSpan, bins);
+            REQUIRE(binsMatch(bins, referenceZBins(lights, view, zSpan)));
+        }
+    }
+}
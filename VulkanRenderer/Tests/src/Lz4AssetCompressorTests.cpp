@@ -0,0 +1,154 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <AssetLib/Io/Compression/Lz4AssetCompressor.h>
+
+#include <array>
+#include <cstring>
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+using namespace lux::assetlib;
+
+constexpr u64 BLOCK_SIZE = io::Lz4AssetCompressor::BLOCK_SIZE_BYTES;
+
+std::vector<std::byte> randomData(std::mt19937& rng, u64 sizeBytes)
+{
+    std::vector<std::byte> data(sizeBytes);
+    for (auto& byte : data)
+        byte = (std::byte)(rng() % 13);
+
+    return data;
+}
+
+/* a version 1 chunk: a single lz4 block of a single literal run, as lz4 writes incompressible data */
+std::vector<std::byte> literalBlock(const std::vector<std::byte>& data)
+{
+    constexpr u64 RUN_LENGTH_LIMIT = 15;
+    std::vector<std::byte> block;
+    block.push_back((std::byte)(std::min(data.size(), RUN_LENGTH_LIMIT) << 4));
+    if (data.size() >= RUN_LENGTH_LIMIT)
+    {
+        u64 remaining = data.size() - RUN_LENGTH_LIMIT;
+        for (; remaining >= 255; remaining -= 255)
+            block.push_back((std::byte)255);
+        block.push_back((std::byte)remaining);
+    }
+    block.insert(block.end(), data.begin(), data.end());
+
+    return block;
+}
+
+std::vector<std::byte> decompressRange(io::Lz4AssetCompressor& lz4, const std::vector<std::byte>& compressed,
+    u64 size, u64 offset, u64 count)
+{
+    std::vector<std::byte> range(count);
+    REQUIRE(lz4.DecompressRange(compressed, size, offset, Span<std::byte>(range.data(), range.size())));
+
+    return range;
+}
+}
+
+TEST_CASE("Lz4 asset compressor", "[Assets][AssetCompressor][Lz4]")
+{
+    std::mt19937 rng(7);
+    io::Lz4AssetCompressor lz4;
+
+    SECTION("Round trips sizes around the block size")
+    {
+        for (u64 size : std::to_array<u64>({0, 1, BLOCK_SIZE - 1, BLOCK_SIZE, BLOCK_SIZE + 1, 3 * BLOCK_SIZE + 17}))
+        {
+            const std::vector<std::byte> data = randomData(rng, size);
+            const std::vector<std::byte> compressed = lz4.Compress(data);
+            REQUIRE(lz4.Decompress(compressed, size) == data);
+        }
+    }
+    SECTION("Decompresses any range")
+    {
+        const u64 size = 3 * BLOCK_SIZE + 17;
+        const std::vector<std::byte> data = randomData(rng, size);
+        const std::vector<std::byte> compressed = lz4.Compress(data);
+        REQUIRE(compressed.size() < data.size());
+
+        for (u32 i = 0; i < 100; i++)
+        {
+            const u64 offset = rng() % size;
+            const u64 count = 1 + rng() % (size - offset);
+            const std::vector<std::byte> range = decompressRange(lz4, compressed, size, offset, count);
+            REQUIRE(std::equal(range.begin(), range.end(), data.begin() + offset));
+        }
+    }
+    SECTION("Decompresses ranges across block boundaries")
+    {
+        const u64 size = 3 * BLOCK_SIZE + 17;
+        const std::vector<std::byte> data = randomData(rng, size);
+        const std::vector<std::byte> compressed = lz4.Compress(data);
+
+        for (u64 boundary = BLOCK_SIZE; boundary < size; boundary += BLOCK_SIZE)
+        {
+            for (u64 halfWidth : std::to_array<u64>({1, 100, BLOCK_SIZE / 2}))
+            {
+                const u64 offset = boundary - halfWidth;
+                const u64 count = std::min(2 * halfWidth, size - offset);
+                const std::vector<std::byte> range = decompressRange(lz4, compressed, size, offset, count);
+                REQUIRE(std::equal(range.begin(), range.end(), data.begin() + offset));
+            }
+            /* a whole block, and a range that ends exactly on the boundary */
+            const std::vector<std::byte> block = decompressRange(lz4, compressed, size, boundary - BLOCK_SIZE,
+                BLOCK_SIZE);
+            REQUIRE(std::equal(block.begin(), block.end(), data.begin() + (boundary - BLOCK_SIZE)));
+        }
+        /* the range spans all of the blocks, with partial blocks on both of its edges */
+        const std::vector<std::byte> range = decompressRange(lz4, compressed, size, 5, size - 10);
+        REQUIRE(std::equal(range.begin(), range.end(), data.begin() + 5));
+    }
+    SECTION("Decodes version 1 single block chunks")
+    {
+        for (u64 size : std::to_array<u64>({1, 14, 15, 16, 1000, BLOCK_SIZE + 3}))
+        {
+            const std::vector<std::byte> data = randomData(rng, size);
+            const std::vector<std::byte> compressed = literalBlock(data);
+            REQUIRE(lz4.Decompress(compressed, size) == data);
+
+            const u64 offset = size / 3;
+            const u64 count = std::max<u64>(1, size / 2);
+            const std::vector<std::byte> range = decompressRange(lz4, compressed, size, offset, count);
+            REQUIRE(std::equal(range.begin(), range.end(), data.begin() + offset));
+        }
+    }
+    SECTION("Corrupt chunks are reported")
+    {
+        const u64 size = 3 * BLOCK_SIZE + 17;
+        const std::vector<std::byte> data = randomData(rng, size);
+        const std::vector<std::byte> compressed = lz4.Compress(data);
+
+        /* the second block becomes a literal run, whose length never ends */
+        constexpr u64 HEADER_SIZE = 4 * sizeof(u32);
+        const u32 blockCount = (u32)((size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+        u32 blockSizes[2] = {};
+        std::memcpy(blockSizes, compressed.data() + HEADER_SIZE, sizeof blockSizes);
+        const u64 secondBlockOffset = HEADER_SIZE + blockCount * sizeof(u32) + blockSizes[0];
+        std::vector<std::byte> corrupt = compressed;
+        for (u64 i = secondBlockOffset; i < secondBlockOffset + blockSizes[1]; i++)
+            corrupt[i] = (std::byte)0xff;
+        REQUIRE(lz4.Decompress(corrupt, size).empty());
+        std::vector<std::byte> secondBlock(BLOCK_SIZE);
+        REQUIRE_FALSE(lz4.DecompressRange(corrupt, size, BLOCK_SIZE,
+            Span<std::byte>(secondBlock.data(), secondBlock.size())));
+        /* the other blocks are still readable */
+        const std::vector<std::byte> firstBlock = decompressRange(lz4, corrupt, size, 0, BLOCK_SIZE);
+        REQUIRE(std::equal(firstBlock.begin(), firstBlock.end(), data.begin()));
+
+        /* a truncated chunk */
+        std::vector<std::byte> truncated(compressed.begin(), compressed.end() - 1);
+        REQUIRE(lz4.Decompress(truncated, size).empty());
+
+        /* a range out of the bounds of the data */
+        std::vector<std::byte> range(16);
+        REQUIRE_FALSE(lz4.DecompressRange(compressed, size, size - 8, Span<std::byte>(range.data(), range.size())));
+    }
+}
+
+// NOLINTEND
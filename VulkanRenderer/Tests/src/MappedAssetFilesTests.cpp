@@ -0,0 +1,110 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <AssetLib/Io/IoInterface/MappedAssetFiles.h>
+
+#include <filesystem>
+#include <fstream>
+
+// NOLINTBEGIN
+
+namespace
+{
+void writeFile(const std::filesystem::path& path, std::string_view contents)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), (isize)contents.size());
+}
+
+std::string_view asString(const lux::assetlib::io::BinaryChunkView& view)
+{
+    return {(const char*)view.Data.data(), view.Data.size()};
+}
+}
+
+TEST_CASE("Mapped asset files", "[Assets][MappedAssetFiles]")
+{
+    using namespace lux::assetlib::io;
+    namespace fs = std::filesystem;
+    const fs::path directory = fs::temp_directory_path() / "lux_mapped_asset_files";
+    fs::create_directories(directory);
+    const fs::path path = directory / "asset.bin";
+    writeFile(path, "first contents");
+
+    MappedAssetFiles files;
+
+    SECTION("Views that are alive at the same time share the mapping")
+    {
+        const auto first = files.Get(path);
+        const auto second = files.Get(path);
+        REQUIRE(first.has_value());
+        REQUIRE(second.has_value());
+        REQUIRE(first->Data.data() == second->Data.data());
+        REQUIRE(asString(*second) == "first contents");
+    }
+    SECTION("Views outlive the eviction of their file")
+    {
+        const auto view = files.Get(path);
+        REQUIRE(view.has_value());
+        files.Evict(path);
+        REQUIRE(asString(*view) == "first contents");
+
+        const auto remapped = files.Get(path);
+        REQUIRE(remapped.has_value());
+        REQUIRE(asString(*remapped) == "first contents");
+        REQUIRE(asString(*view) == "first contents");
+    }
+    SECTION("Mapping is kept between the reads")
+    {
+        const std::byte* data = nullptr;
+        {
+            const auto view = files.Get(path);
+            REQUIRE(view.has_value());
+            data = view->Data.data();
+        }
+        REQUIRE(files.IsCached(path));
+        const auto view = files.Get(path);
+        REQUIRE(view.has_value());
+        REQUIRE(view->Data.data() == data);
+    }
+    SECTION("Files changed outside of the cache are mapped again once evicted")
+    {
+        {
+            const auto view = files.Get(path);
+            REQUIRE(view.has_value());
+            REQUIRE(asString(*view) == "first contents");
+        }
+        /* the file is unmapped once it is evicted and its views are gone, so it can be rewritten */
+        files.Evict(path);
+        REQUIRE_FALSE(files.IsCached(path));
+        writeFile(path, "second, longer contents");
+        const auto view = files.Get(path);
+        REQUIRE(view.has_value());
+        REQUIRE(asString(*view) == "second, longer contents");
+    }
+    SECTION("Least recently read files are dropped past the limit")
+    {
+        MappedAssetFiles limitedFiles(2);
+        const fs::path second = directory / "second.bin";
+        const fs::path third = directory / "third.bin";
+        writeFile(second, "second");
+        writeFile(third, "third");
+
+        REQUIRE(limitedFiles.Get(path).has_value());
+        REQUIRE(limitedFiles.Get(second).has_value());
+        REQUIRE(limitedFiles.Get(path).has_value());
+        const auto view = limitedFiles.Get(third);
+        REQUIRE(view.has_value());
+        REQUIRE(limitedFiles.IsCached(path));
+        REQUIRE_FALSE(limitedFiles.IsCached(second));
+        REQUIRE(limitedFiles.IsCached(third));
+        REQUIRE(asString(*view) == "third");
+    }
+    SECTION("Missing files are reported")
+    {
+        REQUIRE_FALSE(files.Get(directory / "missing.bin").has_value());
+    }
+
+    fs::remove_all(directory);
+}
+
+// NOLINTEND
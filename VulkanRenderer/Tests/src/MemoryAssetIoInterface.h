@@ -0,0 +1,46 @@
+#pragma once
+
+#include <AssetLib/Io/IoInterface/AssetIoInterface.h>
+
+#include <cstring>
+
+// NOLINTBEGIN
+
+namespace lux::tests
+{
+/* serves a single in-memory binary chunk */
+class MemoryAssetIoInterface final : public assetlib::io::AssetIoInterface
+{
+public:
+    explicit MemoryAssetIoInterface(std::vector<std::byte> chunk) : m_Chunk(std::move(chunk)) {}
+
+    assetlib::io::IoResult<u64> WriteHeader(const assetlib::AssetMetadata&,
+        const assetlib::AssetCustomHeaderType& header) override { return header.size(); }
+    assetlib::io::IoResult<u64> WriteBinaryChunk(const assetlib::AssetMetadata&,
+        Span<const std::byte> binaryDataChunk) override { return binaryDataChunk.size(); }
+    assetlib::io::IoResult<assetlib::AssetCustomHeaderType> ReadHeader(const assetlib::AssetMetadata&) override
+    {
+        return {};
+    }
+    assetlib::io::IoResult<void> ReadBinaryChunk(const assetlib::AssetMetadata&, std::byte* destination,
+        u64 offsetBytes, u64 sizeBytes) override
+    {
+        std::memcpy(destination, m_Chunk.data() + offsetBytes, sizeBytes);
+        return {};
+    }
+    assetlib::io::IoResult<assetlib::io::BinaryChunkView> MapBinaryChunk(const assetlib::AssetMetadata&,
+        u64 offsetBytes, u64 sizeBytes) override
+    {
+        return assetlib::io::BinaryChunkView{.Data = Span<const std::byte>(m_Chunk.data() + offsetBytes, sizeBytes)};
+    }
+
+    std::string GetHeaderExtension(std::string_view preferred) const override { return std::string(preferred); }
+    std::string GetBinariesExtension() const override { return ".bin"; }
+
+    DEFINE_ASSET_IO_INTERFACE_NAME("Memory", "2d3c9a4e-3f1b-4c55-9b0e-6a7d1c2e8f90"_guid)
+private:
+    std::vector<std::byte> m_Chunk;
+};
+}
+
+// NOLINTEND
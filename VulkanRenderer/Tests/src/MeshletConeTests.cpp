@@ -0,0 +1,208 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Scene/Visibility/MeshletCone.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <array>
+#include <random>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace
+{
+struct Triangle
+{
+    std::array<glm::vec3, 3> Vertices{};
+
+    glm::vec3 Normal() const
+    {
+        return glm::normalize(glm::cross(Vertices[1] - Vertices[0], Vertices[2] - Vertices[0]));
+    }
+};
+
+struct TestMeshlet
+{
+    std::vector<Triangle> Triangles{};
+    glm::vec3 Center{0.0f};
+    f32 Radius{0.0f};
+    std::array<i8, 4> Cone{};
+};
+
+glm::vec3 randomDirection(std::mt19937& rng)
+{
+    std::normal_distribution<f32> axis(0.0f, 1.0f);
+
+    return glm::normalize(glm::vec3{axis(rng), axis(rng), axis(rng)} + 1e-4f);
+}
+
+/* bounds the way the asset baker gets them from meshoptimizer, with the conservative quantization of the cone */
+void computeBounds(TestMeshlet& meshlet)
+{
+    u32 vertexCount = 0;
+    for (auto& triangle : meshlet.Triangles)
+        for (auto& vertex : triangle.Vertices)
+        {
+            meshlet.Center += vertex;
+            vertexCount++;
+        }
+    meshlet.Center /= (f32)vertexCount;
+    for (auto& triangle : meshlet.Triangles)
+        for (auto& vertex : triangle.Vertices)
+            meshlet.Radius = std::max(meshlet.Radius, glm::length(vertex - meshlet.Center));
+
+    glm::vec3 axis{0.0f};
+    for (auto& triangle : meshlet.Triangles)
+        axis += triangle.Normal();
+    axis = glm::normalize(axis);
+    f32 minDot = 1.0f;
+    for (auto& triangle : meshlet.Triangles)
+        minDot = std::min(minDot, glm::dot(axis, triangle.Normal()));
+
+    const glm::vec3 quantized = glm::round(axis * 127.0f);
+    meshlet.Cone = {(i8)quantized.x, (i8)quantized.y, (i8)quantized.z, MeshletCone::NO_CONE_CUTOFF};
+    if (minDot <= 0.0f)
+        return;
+
+    const f32 cutoff = std::sqrt(1.0f - minDot * minDot);
+    const f32 axisError = glm::length(glm::normalize(quantized) - axis);
+    meshlet.Cone[3] = (i8)std::min(127.0f, std::ceil((cutoff + axisError) * 127.0f) + 1.0f);
+}
+
+/* a bumpy square patch, that faces `normal` more or less, depending on `bumpiness` */
+TestMeshlet randomMeshlet(std::mt19937& rng)
+{
+    std::uniform_real_distribution<f32> bumpiness(0.0f, 0.6f);
+    std::uniform_real_distribution<f32> unit(-1.0f, 1.0f);
+
+    const glm::vec3 normal = randomDirection(rng);
+    const glm::vec3 tangent = glm::normalize(glm::cross(normal, std::abs(normal.y) < 0.9f ?
+        glm::vec3{0.0f, 1.0f, 0.0f} : glm::vec3{1.0f, 0.0f, 0.0f}));
+    const glm::vec3 bitangent = glm::cross(normal, tangent);
+    const glm::vec3 origin = glm::vec3{unit(rng), unit(rng), unit(rng)} * 5.0f;
+    const f32 bumps = bumpiness(rng);
+
+    static constexpr u32 GRID = 4;
+    std::array<glm::vec3, (GRID + 1) * (GRID + 1)> grid;
+    for (u32 y = 0; y <= GRID; y++)
+        for (u32 x = 0; x <= GRID; x++)
+            grid[y * (GRID + 1) + x] = origin + tangent * (f32)x + bitangent * (f32)y + normal * bumps * unit(rng);
+
+    TestMeshlet meshlet = {};
+    for (u32 y = 0; y < GRID; y++)
+        for (u32 x = 0; x < GRID; x++)
+        {
+            const u32 corner = y * (GRID + 1) + x;
+            meshlet.Triangles.push_back({{grid[corner], grid[corner + 1], grid[corner + GRID + 2]}});
+            meshlet.Triangles.push_back({{grid[corner], grid[corner + GRID + 2], grid[corner + GRID + 1]}});
+        }
+    computeBounds(meshlet);
+
+    return meshlet;
+}
+
+glm::mat4 randomTransform(std::mt19937& rng)
+{
+    std::uniform_real_distribution<f32> angle(0.0f, 6.28f);
+    std::uniform_real_distribution<f32> scale(0.2f, 4.0f);
+    std::uniform_real_distribution<f32> position(-20.0f, 20.0f);
+
+    glm::mat4 transform = glm::translate(glm::mat4{1.0f}, glm::vec3{position(rng), position(rng), position(rng)});
+    transform = glm::rotate(transform, angle(rng), randomDirection(rng));
+
+    return glm::scale(transform, glm::vec3{scale(rng)});
+}
+
+MeshletCone viewCone(const TestMeshlet& meshlet, const glm::mat4& modelView)
+{
+    return MeshletCone::FromQuantized(meshlet.Cone[0], meshlet.Cone[1], meshlet.Cone[2], meshlet.Cone[3])
+        .Transform(modelView);
+}
+
+/* a triangle is backfacing if the camera is behind its plane */
+bool isBackfacing(const Triangle& triangle, const glm::mat4& modelView)
+{
+    const glm::vec3 a = glm::vec3{modelView * glm::vec4{triangle.Vertices[0], 1.0f}};
+    const glm::vec3 b = glm::vec3{modelView * glm::vec4{triangle.Vertices[1], 1.0f}};
+    const glm::vec3 c = glm::vec3{modelView * glm::vec4{triangle.Vertices[2], 1.0f}};
+
+    return glm::dot(a, glm::cross(b - a, c - a)) >= 0.0f;
+}
+
+bool isBackfacingOrthographic(const Triangle& triangle, const glm::mat4& modelView)
+{
+    const glm::vec3 a = glm::vec3{modelView * glm::vec4{triangle.Vertices[0], 1.0f}};
+    const glm::vec3 b = glm::vec3{modelView * glm::vec4{triangle.Vertices[1], 1.0f}};
+    const glm::vec3 c = glm::vec3{modelView * glm::vec4{triangle.Vertices[2], 1.0f}};
+
+    return glm::cross(b - a, c - a).z <= 0.0f;
+}
+}
+
+TEST_CASE("Meshlet cone", "[Visibility][MeshletCone]")
+{
+    std::mt19937 rng(11);
+
+    SECTION("Meshlets without a cone are never culled")
+    {
+        const MeshletCone cone = MeshletCone::FromQuantized(0, 0, 0, MeshletCone::NO_CONE_CUTOFF);
+        REQUIRE_FALSE(cone.HasCone);
+        REQUIRE(cone.IsVisible(glm::vec3{0.0f, 0.0f, -10.0f}, 1.0f));
+        REQUIRE(cone.IsVisibleOrthographic());
+        REQUIRE(cone.Transform(glm::mat4{1.0f}).IsVisibleOrthographic());
+    }
+    SECTION("Flat meshlet is culled only from behind")
+    {
+        /* faces +z, and the camera looks along -z */
+        const MeshletCone cone = MeshletCone::FromQuantized(0, 0, 127, 0);
+        REQUIRE(cone.IsVisible(glm::vec3{0.0f, 0.0f, -10.0f}, 1.0f));
+        REQUIRE(cone.IsVisibleOrthographic());
+
+        const MeshletCone flipped = cone.Transform(glm::rotate(glm::mat4{1.0f}, 3.14159f, glm::vec3{1.0f, 0.0f, 0.0f}));
+        REQUIRE_FALSE(flipped.IsVisible(glm::vec3{0.0f, 0.0f, -10.0f}, 1.0f));
+        REQUIRE_FALSE(flipped.IsVisibleOrthographic());
+        /* the camera is inside of the bounding sphere */
+        REQUIRE(flipped.IsVisible(glm::vec3{0.0f, 0.0f, -0.5f}, 1.0f));
+    }
+    SECTION("Culled meshlets face away from the perspective view")
+    {
+        u32 culled = 0;
+        for (u32 i = 0; i < 2000; i++)
+        {
+            const TestMeshlet meshlet = randomMeshlet(rng);
+            const glm::mat4 model = randomTransform(rng);
+            const glm::mat4 view = glm::lookAtRH(randomDirection(rng) * 40.0f, glm::vec3{0.0f},
+                glm::vec3{0.0f, 1.0f, 0.0f});
+            const glm::mat4 modelView = view * model;
+
+            const glm::vec3 origin = glm::vec3{modelView * glm::vec4{meshlet.Center, 1.0f}};
+            const f32 radius = meshlet.Radius * glm::length(glm::vec3{model[0]});
+            if (viewCone(meshlet, modelView).IsVisible(origin, radius))
+                continue;
+
+            culled++;
+            for (auto& triangle : meshlet.Triangles)
+                REQUIRE(isBackfacing(triangle, modelView));
+        }
+        REQUIRE(culled > 100);
+    }
+    SECTION("Culled meshlets face away from the orthographic view")
+    {
+        u32 culled = 0;
+        for (u32 i = 0; i < 2000; i++)
+        {
+            const TestMeshlet meshlet = randomMeshlet(rng);
+            const glm::mat4 view = glm::lookAtRH(glm::vec3{0.0f}, randomDirection(rng),
+                glm::vec3{0.0f, 1.0f, 0.0f});
+            const glm::mat4 modelView = view * randomTransform(rng);
+            if (viewCone(meshlet, modelView).IsVisibleOrthographic())
+                continue;
+
+            culled++;
+            for (auto& triangle : meshlet.Triangles)
+                REQUIRE(isBackfacingOrthographic(triangle, modelView));
+        }
+        REQUIRE(culled > 100);
+    }
+}
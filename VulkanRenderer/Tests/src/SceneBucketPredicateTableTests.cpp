@@ -0,0 +1,102 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Scene/SceneBucketPredicateTable.h"
+
+// NOLINTBEGIN
+
+using enum SceneRenderObjectFlags;
+
+namespace
+{
+bool matchesReference(const SceneBucketPredicate& predicate, SceneRenderObjectFlags flags, u32 renderObjectIndex)
+{
+    return (flags & predicate.Mask) == predicate.Value &&
+        renderObjectIndex >= predicate.FirstRenderObject &&
+        (u64)renderObjectIndex < (u64)predicate.FirstRenderObject + predicate.RenderObjectCount;
+}
+}
+
+TEST_CASE("SceneBucketPredicateTable", "[Scene][SceneBucketPredicateTable]")
+{
+    SceneBucketPredicateTable table;
+    SECTION("Empty predicate accepts everything")
+    {
+        table.Compile({SceneBucketPredicate{}});
+        for (u32 flags = 0; flags < 1 << SCENE_RENDER_OBJECT_FLAG_COUNT; flags++)
+            REQUIRE(table.BucketBits(SceneRenderObjectFlags(flags), flags) == 1);
+    }
+    SECTION("Flag predicates compute bucket bits")
+    {
+        table.Compile({
+            SceneBucketPredicate::Has(Opaque),
+            SceneBucketPredicate::Has(AlphaMask),
+            SceneBucketPredicate{.Mask = Opaque | Skinned, .Value = Opaque},
+            SceneBucketPredicate::Has(Translucent | TwoSided),
+        });
+        REQUIRE(table.BucketBits(None, 0) == 0);
+        REQUIRE(table.BucketBits(HasMaterial | Opaque, 0) == 0b0101);
+        REQUIRE(table.BucketBits(HasMaterial | Opaque | Skinned, 0) == 0b0001);
+        REQUIRE(table.BucketBits(HasMaterial | AlphaMask | TwoSided, 0) == 0b0010);
+        REQUIRE(table.BucketBits(HasMaterial | Translucent, 0) == 0b0000);
+        REQUIRE(table.BucketBits(HasMaterial | Translucent | TwoSided, 0) == 0b1000);
+    }
+    SECTION("Ranged predicates respect render object index")
+    {
+        table.Compile({
+            SceneBucketPredicate{.FirstRenderObject = 0, .RenderObjectCount = 1},
+            SceneBucketPredicate{.Mask = Opaque, .Value = Opaque, .FirstRenderObject = 2},
+            SceneBucketPredicate{.FirstRenderObject = 5, .RenderObjectCount = 3},
+        });
+        REQUIRE(table.BucketBits(Opaque, 0) == 0b001);
+        REQUIRE(table.BucketBits(Opaque, 1) == 0b000);
+        REQUIRE(table.BucketBits(Opaque, 2) == 0b010);
+        REQUIRE(table.BucketBits(None, 2) == 0b000);
+        REQUIRE(table.BucketBits(Opaque, 5) == 0b110);
+        REQUIRE(table.BucketBits(Opaque, 7) == 0b110);
+        REQUIRE(table.BucketBits(Opaque, 8) == 0b010);
+        REQUIRE(table.BucketBits(Opaque, ~0u - 1) == 0b010);
+    }
+    SECTION("Batched path matches single render object path")
+    {
+        std::vector<SceneBucketPredicate> predicates = {
+            SceneBucketPredicate::Has(Opaque),
+            SceneBucketPredicate::Has(AlphaMask | Skinned),
+            SceneBucketPredicate{.Mask = BlendShapes, .Value = None, .FirstRenderObject = 3, .RenderObjectCount = 40},
+            SceneBucketPredicate{.Mask = HasMaterial, .Value = None},
+        };
+        table.Compile(predicates);
+
+        static constexpr u32 FIRST_RENDER_OBJECT = 7;
+        std::vector<SceneRenderObjectFlags> flags;
+        for (u32 i = 0; i < 1024; i++)
+            flags.push_back(SceneRenderObjectFlags((i * 37u) % (1 << SCENE_RENDER_OBJECT_FLAG_COUNT)));
+        std::vector<SceneBucketBits> bucketBits(flags.size());
+        table.BucketBits(flags, FIRST_RENDER_OBJECT, bucketBits);
+
+        for (u32 i = 0; i < flags.size(); i++)
+        {
+            REQUIRE(bucketBits[i] == table.BucketBits(flags[i], FIRST_RENDER_OBJECT + i));
+            SceneBucketBits expected = 0;
+            for (u32 bucket = 0; bucket < predicates.size(); bucket++)
+                if (matchesReference(predicates[bucket], flags[i], FIRST_RENDER_OBJECT + i))
+                    expected.Set(bucket);
+            REQUIRE(bucketBits[i] == expected);
+        }
+    }
+    SECTION("Can use all bucket bits")
+    {
+        std::vector<SceneBucketPredicate> predicates(MAX_BUCKETS_PER_SET, SceneBucketPredicate::Has(Opaque));
+        table.Compile(predicates);
+        REQUIRE(table.BucketBits(Opaque, 0) == SceneBucketBits::All());
+        REQUIRE(table.BucketBits(Translucent, 0) == 0);
+    }
+    SECTION("Ranged predicates work past the first 64 buckets")
+    {
+        std::vector<SceneBucketPredicate> predicates(MAX_BUCKETS_PER_SET, SceneBucketPredicate::Has(AlphaMask));
+        predicates.back() = {.FirstRenderObject = 10, .RenderObjectCount = 2};
+        table.Compile(predicates);
+        REQUIRE(table.BucketBits(Opaque, 9) == 0);
+        REQUIRE(table.BucketBits(Opaque, 10) == SceneBucketBits::Bit(MAX_BUCKETS_PER_SET - 1));
+        REQUIRE(table.BucketBits(AlphaMask, 12) == SceneBucketBits::FirstN(MAX_BUCKETS_PER_SET - 1));
+    }
+}
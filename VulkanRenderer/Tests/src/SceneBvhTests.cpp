@@ -0,0 +1,399 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Scene/SceneBvh.h"
+
+#include <algorithm>
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+AABB randomBounds(std::mt19937& rng, f32 worldSize = 100.0f, f32 maxSize = 2.0f)
+{
+    std::uniform_real_distribution<f32> position(-worldSize, worldSize);
+    std::uniform_real_distribution<f32> size(0.01f, maxSize);
+    const glm::vec3 min = {position(rng), position(rng), position(rng)};
+
+    return {.Min = min, .Max = min + glm::vec3{size(rng), size(rng), size(rng)}};
+}
+
+bool contains(const AABB& outer, const AABB& inner)
+{
+    return glm::all(glm::lessThanEqual(outer.Min, inner.Min)) && glm::all(glm::greaterThanEqual(outer.Max, inner.Max));
+}
+
+bool overlaps(const AABB& a, const AABB& b)
+{
+    return glm::all(glm::lessThanEqual(a.Min, b.Max)) && glm::all(glm::lessThanEqual(b.Min, a.Max));
+}
+
+void requireValid(const SceneBvh& bvh)
+{
+    if (bvh.Root() == SceneBvh::INVALID_NODE)
+    {
+        REQUIRE(bvh.PrimitiveCount() == 0);
+        return;
+    }
+
+    u32 primitiveCount = 0;
+    std::vector<u32> stack = {bvh.Root()};
+    REQUIRE(bvh.GetNode(bvh.Root()).Parent == SceneBvh::INVALID_NODE);
+    while (!stack.empty())
+    {
+        const u32 nodeIndex = stack.back();
+        stack.pop_back();
+        const SceneBvh::Node& node = bvh.GetNode(nodeIndex);
+        if (node.IsLeaf())
+        {
+            REQUIRE(node.PrimitiveCount <= SceneBvh::MAX_LEAF_PRIMITIVES);
+            for (u32 i = 0; i < node.PrimitiveCount; i++)
+            {
+                const u32 primitive = bvh.Primitives()[node.FirstPrimitive + i];
+                REQUIRE(bvh.Contains(primitive));
+                REQUIRE(contains(node.Bounds, bvh.PrimitiveBounds(primitive)));
+            }
+            primitiveCount += node.PrimitiveCount;
+            continue;
+        }
+
+        const SceneBvh::Node& left = bvh.GetNode(node.Left);
+        const SceneBvh::Node& right = bvh.GetNode(node.Right);
+        REQUIRE(left.Parent == nodeIndex);
+        REQUIRE(right.Parent == nodeIndex);
+        REQUIRE(contains(node.Bounds, left.Bounds));
+        REQUIRE(contains(node.Bounds, right.Bounds));
+        stack.push_back(node.Left);
+        stack.push_back(node.Right);
+    }
+    REQUIRE(primitiveCount == bvh.PrimitiveCount());
+}
+
+std::vector<u32> queryAabb(const SceneBvh& bvh, const AABB& bounds)
+{
+    std::vector<u32> result;
+    bvh.QueryAabb(bounds, [&result](u32 primitive) { result.push_back(primitive); });
+    std::ranges::sort(result);
+
+    return result;
+}
+
+std::vector<u32> queryAabbReference(const std::vector<AABB>& primitives, const std::vector<bool>& isLive,
+    const AABB& bounds)
+{
+    std::vector<u32> result;
+    for (u32 i = 0; i < primitives.size(); i++)
+        if (isLive[i] && overlaps(primitives[i], bounds))
+            result.push_back(i);
+
+    return result;
+}
+
+/* all primitives alive */
+std::vector<bool> allLive(u32 count)
+{
+    return std::vector<bool>(count, true);
+}
+}
+
+TEST_CASE("SceneBvh", "[Scene][SceneBvh]")
+{
+    std::mt19937 rng(42);
+    SceneBvh bvh;
+
+    SECTION("Empty bvh has no root")
+    {
+        bvh.Build({});
+        REQUIRE(bvh.Root() == SceneBvh::INVALID_NODE);
+        REQUIRE(!bvh.Raycast(glm::vec3{0.0f}, glm::vec3{0.0f, 0.0f, 1.0f}, 100.0f).IsHit());
+        bvh.QueryAabb({.Min = glm::vec3{-1.0f}, .Max = glm::vec3{1.0f}}, [](u32) { FAIL(); });
+    }
+    SECTION("Build produces a valid hierarchy")
+    {
+        std::vector<AABB> bounds(1000);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng);
+        bvh.Build(bounds);
+        requireValid(bvh);
+        REQUIRE(bvh.PrimitiveCount() == bounds.size());
+    }
+    SECTION("Build handles coincident primitives")
+    {
+        std::vector<AABB> bounds(37, AABB{.Min = glm::vec3{1.0f}, .Max = glm::vec3{2.0f}});
+        bvh.Build(bounds);
+        requireValid(bvh);
+    }
+    SECTION("Aabb query matches brute force")
+    {
+        std::vector<AABB> bounds(500);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng);
+        bvh.Build(bounds);
+
+        for (u32 i = 0; i < 100; i++)
+        {
+            const AABB query = randomBounds(rng, 100.0f, 40.0f);
+            REQUIRE(queryAabb(bvh, query) == queryAabbReference(bounds, allLive(500), query));
+        }
+    }
+    SECTION("Frustum query reports every primitive inside the planes")
+    {
+        std::vector<AABB> bounds(500);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng);
+        bvh.Build(bounds);
+
+        /* an axis-aligned box expressed as 6 inward planes is an exact test */
+        const AABB box = {.Min = glm::vec3{-30.0f, -10.0f, 0.0f}, .Max = glm::vec3{20.0f, 50.0f, 60.0f}};
+        const std::array planes = {
+            Plane::ByPointAndNormal(box.Min, glm::vec3{1.0f, 0.0f, 0.0f}),
+            Plane::ByPointAndNormal(box.Min, glm::vec3{0.0f, 1.0f, 0.0f}),
+            Plane::ByPointAndNormal(box.Min, glm::vec3{0.0f, 0.0f, 1.0f}),
+            Plane::ByPointAndNormal(box.Max, glm::vec3{-1.0f, 0.0f, 0.0f}),
+            Plane::ByPointAndNormal(box.Max, glm::vec3{0.0f, -1.0f, 0.0f}),
+            Plane::ByPointAndNormal(box.Max, glm::vec3{0.0f, 0.0f, -1.0f}),
+        };
+        std::vector<u32> visible;
+        bvh.QueryFrustum(Span<const Plane>(planes.data(), planes.size()),
+            [&visible](u32 primitive) { visible.push_back(primitive); });
+        std::ranges::sort(visible);
+
+        REQUIRE(visible == queryAabbReference(bounds, allLive(500), box));
+    }
+    SECTION("Raycast finds the closest primitive")
+    {
+        std::vector<AABB> bounds(500);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng, 100.0f, 10.0f);
+        bvh.Build(bounds);
+
+        std::uniform_real_distribution<f32> direction(-1.0f, 1.0f);
+        for (u32 i = 0; i < 200; i++)
+        {
+            const glm::vec3 origin = randomBounds(rng).Min;
+            const glm::vec3 rayDirection = glm::normalize(glm::vec3{direction(rng), direction(rng), direction(rng)});
+            const glm::vec3 inverseDirection = 1.0f / rayDirection;
+
+            f32 closest = 1000.0f;
+            for (auto& primitive : bounds)
+                closest = std::min(closest,
+                    SceneBvh::RayAabbDistance(primitive, origin, inverseDirection, closest));
+
+            const SceneBvh::RaycastHit hit = bvh.Raycast(origin, rayDirection, 1000.0f);
+            REQUIRE(hit.IsHit() == (closest < 1000.0f));
+            if (hit.IsHit())
+                REQUIRE(hit.Distance == closest);
+        }
+    }
+    SECTION("Raycast with an infinite distance only reports hits")
+    {
+        std::vector<AABB> bounds(500);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng, 100.0f, 10.0f);
+        bvh.Build(bounds);
+
+        /* the rays start outside of the world and point away from it */
+        constexpr f32 INFINITE_DISTANCE = std::numeric_limits<f32>::infinity();
+        for (const glm::vec3 direction : {glm::vec3{1.0f, 0.0f, 0.0f}, glm::normalize(glm::vec3{1.0f, 1.0f, 1.0f})})
+        {
+            u32 intersectCalls = 0;
+            const SceneBvh::RaycastHit miss = bvh.Raycast(glm::vec3{200.0f}, direction, INFINITE_DISTANCE,
+                [&intersectCalls](u32, f32) { intersectCalls++; return INFINITE_DISTANCE; });
+            REQUIRE(!miss.IsHit());
+            REQUIRE(intersectCalls == 0);
+            REQUIRE(!bvh.Raycast(glm::vec3{200.0f}, direction, INFINITE_DISTANCE).IsHit());
+        }
+
+        /* the primitives that are hit, but that `intersect` misses */
+        const SceneBvh::RaycastHit miss = bvh.Raycast(glm::vec3{-200.0f, 0.0f, 0.0f}, glm::vec3{1.0f, 0.0f, 0.0f},
+            INFINITE_DISTANCE, [](u32, f32) { return INFINITE_DISTANCE; });
+        REQUIRE(!miss.IsHit());
+
+        const glm::vec3 target = (bounds[3].Min + bounds[3].Max) * 0.5f;
+        const glm::vec3 origin = target + glm::vec3{0.0f, 0.0f, -300.0f};
+        const SceneBvh::RaycastHit hit = bvh.Raycast(origin, glm::vec3{0.0f, 0.0f, 1.0f}, INFINITE_DISTANCE);
+        REQUIRE(hit.IsHit());
+        REQUIRE(hit.Distance <= 300.0f);
+    }
+    SECTION("Refit keeps the hierarchy valid after moves")
+    {
+        std::vector<AABB> bounds(1000);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng);
+        bvh.Build(bounds);
+
+        std::uniform_int_distribution<u32> primitiveDistribution(0, 999);
+        std::uniform_real_distribution<f32> offset(-5.0f, 5.0f);
+        for (u32 frame = 0; frame < 20; frame++)
+        {
+            for (u32 i = 0; i < 50; i++)
+            {
+                const u32 primitive = primitiveDistribution(rng);
+                const glm::vec3 delta = {offset(rng), offset(rng), offset(rng)};
+                bounds[primitive] = {.Min = bounds[primitive].Min + delta, .Max = bounds[primitive].Max + delta};
+                bvh.Update(primitive, bounds[primitive]);
+            }
+            const SceneBvh::RefitStats stats = bvh.Refit();
+            REQUIRE(!stats.FullRebuild);
+            requireValid(bvh);
+
+            const AABB query = randomBounds(rng, 100.0f, 40.0f);
+            REQUIRE(queryAabb(bvh, query) == queryAabbReference(bounds, allLive(1000), query));
+        }
+    }
+    SECTION("Refit only touches the path of a moved primitive")
+    {
+        std::vector<AABB> bounds(1024);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng);
+        bvh.Build(bounds);
+
+        bounds[7].Max += glm::vec3{0.001f};
+        bvh.Update(7, bounds[7]);
+        const SceneBvh::RefitStats stats = bvh.Refit();
+        REQUIRE(stats.RefitNodes <= 32);
+        REQUIRE(stats.RebuiltSubtrees == 0);
+        requireValid(bvh);
+    }
+    SECTION("Degraded subtrees are rebuilt")
+    {
+        std::vector<AABB> bounds(2000);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng);
+        bvh.Build(bounds);
+        SceneBvh refitOnly = bvh;
+
+        /* scatter a quarter of the primitives to the other side of the world */
+        for (u32 primitive = 0; primitive < bounds.size(); primitive += 4)
+        {
+            bounds[primitive] = {.Min = -bounds[primitive].Max, .Max = -bounds[primitive].Min};
+            bvh.Update(primitive, bounds[primitive]);
+            refitOnly.Update(primitive, bounds[primitive]);
+        }
+        const SceneBvh::RefitStats stats = bvh.Refit();
+        refitOnly.Refit(std::numeric_limits<f32>::infinity());
+
+        REQUIRE(stats.RebuiltSubtrees > 0);
+        requireValid(bvh);
+        requireValid(refitOnly);
+        REQUIRE(bvh.SahCost() < refitOnly.SahCost());
+
+        const AABB query = {.Min = glm::vec3{-20.0f}, .Max = glm::vec3{20.0f}};
+        REQUIRE(queryAabb(bvh, query) == queryAabbReference(bounds, allLive(2000), query));
+    }
+    SECTION("Insert and remove")
+    {
+        std::vector<AABB> bounds(300);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng);
+        bvh.Build(bounds);
+        std::vector<bool> isLive = allLive(300);
+
+        for (u32 primitive = 0; primitive < 300; primitive += 3)
+        {
+            bvh.Remove(primitive);
+            isLive[primitive] = false;
+        }
+        REQUIRE(!bvh.Refit().FullRebuild);
+        requireValid(bvh);
+        REQUIRE(bvh.PrimitiveCount() == 200);
+        const AABB query = {.Min = glm::vec3{-50.0f}, .Max = glm::vec3{50.0f}};
+        REQUIRE(queryAabb(bvh, query) == queryAabbReference(bounds, isLive, query));
+
+        bounds.resize(400);
+        isLive.resize(400);
+        for (u32 primitive = 300; primitive < 400; primitive++)
+        {
+            bounds[primitive] = randomBounds(rng);
+            bvh.Insert(primitive, bounds[primitive]);
+            isLive[primitive] = true;
+        }
+        /* removing a primitive before its ancestors were refit */
+        bvh.Remove(399);
+        isLive[399] = false;
+        REQUIRE(!bvh.Refit().FullRebuild);
+        requireValid(bvh);
+        REQUIRE(bvh.PrimitiveCount() == 299);
+        REQUIRE(queryAabb(bvh, query) == queryAabbReference(bounds, isLive, query));
+    }
+    SECTION("Inserted primitives rarely need a full rebuild")
+    {
+        std::vector<AABB> bounds(1000);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng);
+
+        /* the hierarchy is only rebuilt as a whole once its root degrades or too many slots are unused */
+        constexpr u32 BATCH_COUNT = 10;
+        u32 fullRebuilds = 0;
+        for (u32 batch = 0; batch < BATCH_COUNT; batch++)
+        {
+            for (u32 primitive = batch * 100; primitive < (batch + 1) * 100; primitive++)
+                bvh.Insert(primitive, bounds[primitive]);
+            fullRebuilds += bvh.Refit().FullRebuild ? 1 : 0;
+            requireValid(bvh);
+
+            const u32 insertedCount = (batch + 1) * 100;
+            std::vector<bool> isLive = allLive(insertedCount);
+            isLive.resize(1000, false);
+            const AABB query = randomBounds(rng, 100.0f, 40.0f);
+            REQUIRE(queryAabb(bvh, query) == queryAabbReference(bounds, isLive, query));
+        }
+
+        REQUIRE(fullRebuilds * 3 < BATCH_COUNT);
+
+        /* the inserted hierarchy is not much worse than the one built at once */
+        SceneBvh built;
+        built.Build(bounds);
+        REQUIRE(bvh.SahCost() < 2.0f * built.SahCost());
+
+        bvh.Rebuild();
+        requireValid(bvh);
+        REQUIRE(bvh.SahCost() == built.SahCost());
+    }
+    SECTION("Inserted primitives are found before the refit")
+    {
+        std::vector<AABB> bounds(200);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng);
+        bvh.Build(Span<const AABB>(bounds.data(), 100));
+        for (u32 primitive = 100; primitive < 200; primitive++)
+            bvh.Insert(primitive, bounds[primitive]);
+
+        /* the ancestors are not refit yet, but the primitives that were there before are still reported */
+        const AABB query = {.Min = glm::vec3{-100.0f}, .Max = glm::vec3{100.0f}};
+        std::vector<u32> found = queryAabb(bvh, query);
+        for (u32 primitive = 0; primitive < 100; primitive++)
+            REQUIRE(std::ranges::binary_search(found, primitive));
+
+        bvh.Refit();
+        requireValid(bvh);
+        REQUIRE(queryAabb(bvh, query) == queryAabbReference(bounds, allLive(200), query));
+    }
+    SECTION("Unused primitive slots trigger a full rebuild")
+    {
+        std::vector<AABB> bounds(400);
+        for (auto& primitive : bounds)
+            primitive = randomBounds(rng);
+        bvh.Build(Span<const AABB>(bounds.data(), 100));
+        std::vector<bool> isLive = allLive(100);
+        isLive.resize(400, false);
+
+        /* every removed primitive leaves an unused slot in its leaf */
+        bool rebuilt = false;
+        for (u32 primitive = 100; primitive < 400; primitive++)
+        {
+            bvh.Insert(primitive, bounds[primitive]);
+            bvh.Remove(primitive - 100);
+            isLive[primitive] = true;
+            isLive[primitive - 100] = false;
+            const SceneBvh::RefitStats stats = bvh.Refit();
+            rebuilt = rebuilt || stats.FullRebuild;
+            requireValid(bvh);
+        }
+        REQUIRE(rebuilt);
+        REQUIRE(bvh.Primitives().size() <= 2 * bvh.PrimitiveCount() + SceneBvh::MIN_UNUSED_PRIMITIVE_SLOTS_TO_REBUILD);
+
+        const AABB query = {.Min = glm::vec3{-50.0f}, .Max = glm::vec3{50.0f}};
+        REQUIRE(queryAabb(bvh, query) == queryAabbReference(bounds, isLive, query));
+    }
+}
@@ -0,0 +1,154 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Scene/Visibility/SceneDrawRanges.h"
+
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+constexpr u32 NO_DRAW = ~0u;
+
+struct TestSet
+{
+    std::vector<u32> BucketMeshletCounts{};
+    /* every meshlet of the set, with the buckets of its render object */
+    std::vector<SceneBucketBits> MeshletBuckets{};
+};
+
+TestSet randomSet(std::mt19937& rng, u32 bucketCount, u32 meshletCount)
+{
+    std::uniform_int_distribution<u32> bucket(0, bucketCount - 1);
+
+    TestSet set = {};
+    set.BucketMeshletCounts.resize(bucketCount);
+    for (u32 i = 0; i < meshletCount; i++)
+    {
+        SceneBucketBits buckets = SceneBucketBits::Bit(bucket(rng));
+        if (rng() % 3 == 0)
+            buckets.Set(bucket(rng));
+        buckets.ForEachSetBit([&](u32 b) { set.BucketMeshletCounts[b]++; });
+        set.MeshletBuckets.push_back(buckets);
+    }
+
+    return set;
+}
+}
+
+TEST_CASE("SceneDrawRanges", "[Scene][SceneDrawRanges]")
+{
+    std::mt19937 rng(7);
+
+    SECTION("Ranges are densely packed view after view")
+    {
+        const std::vector<u32> bucketMeshletCounts = {5, 0, 7, 3};
+        SceneDrawRanges ranges;
+        ranges.Init(3, bucketMeshletCounts, SceneBucketBits::All());
+
+        REQUIRE(ranges.Ranges().size() == 12);
+        REQUIRE(ranges.DrawCount() == 3 * 15);
+        u32 offset = 0;
+        for (u32 view = 0; view < 3; view++)
+            for (u32 bucket = 0; bucket < 4; bucket++)
+            {
+                REQUIRE(ranges.Get(view, bucket) ==
+                    SceneDrawRange{.Offset = offset, .Capacity = bucketMeshletCounts[bucket]});
+                offset += bucketMeshletCounts[bucket];
+            }
+    }
+    SECTION("Buckets outside of the mask get no draws")
+    {
+        const std::vector<u32> bucketMeshletCounts = {5, 2, 7, 3};
+        SceneDrawRanges ranges;
+        ranges.Init(2, bucketMeshletCounts, SceneBucketBits::Bit(1) | SceneBucketBits::Bit(3));
+
+        REQUIRE(ranges.DrawCount() == 2 * 5);
+        REQUIRE(ranges.Get(0, 0).Capacity == 0);
+        REQUIRE(ranges.Get(0, 2).Capacity == 0);
+        REQUIRE(ranges.Get(1, 1) == SceneDrawRange{.Offset = 5, .Capacity = 2});
+        REQUIRE(ranges.Get(1, 3) == SceneDrawRange{.Offset = 7, .Capacity = 3});
+
+        const std::vector<SceneDrawRanges::Element> elements = {
+            {.Views = SceneViewMask::FirstN(2), .Buckets = SceneBucketBits::Bit(0) | SceneBucketBits::Bit(1)}};
+        std::vector<u32> draws(ranges.DrawCount(), NO_DRAW);
+        std::vector<u32> counts(ranges.Ranges().size());
+        ranges.Compact(elements, draws, counts);
+        REQUIRE(counts == std::vector<u32>{0, 1, 0, 0, 0, 1, 0, 0});
+        REQUIRE(draws[ranges.Get(0, 1).Offset] == 0);
+        REQUIRE(draws[ranges.Get(1, 1).Offset] == 0);
+    }
+    SECTION("Empty set has no draws")
+    {
+        SceneDrawRanges ranges;
+        ranges.Init(4, {}, SceneBucketBits::All());
+        REQUIRE(ranges.Ranges().empty());
+        REQUIRE(ranges.DrawCount() == 0);
+    }
+    SECTION("Compaction writes every visible meshlet once into each of its ranges")
+    {
+        for (u32 iteration = 0; iteration < 50; iteration++)
+        {
+            const u32 viewCount = 1 + rng() % 6;
+            const u32 bucketCount = 1 + rng() % 9;
+            const TestSet set = randomSet(rng, bucketCount, rng() % 400);
+            SceneBucketBits mask = {};
+            for (u32 bucket = 0; bucket < bucketCount; bucket++)
+                if (rng() % 4 != 0)
+                    mask.Set(bucket);
+
+            SceneDrawRanges ranges;
+            ranges.Init(viewCount, set.BucketMeshletCounts, mask);
+
+            std::vector<SceneDrawRanges::Element> elements;
+            for (auto& buckets : set.MeshletBuckets)
+            {
+                SceneViewMask views = {};
+                for (u32 view = 0; view < viewCount; view++)
+                    if (rng() % 2 == 0)
+                        views.Set(view);
+                elements.push_back({.Views = views, .Buckets = buckets});
+            }
+
+            std::vector<u32> draws(ranges.DrawCount(), NO_DRAW);
+            std::vector<u32> counts(ranges.Ranges().size());
+            ranges.Compact(elements, draws, counts);
+
+            for (u32 view = 0; view < viewCount; view++)
+                for (u32 bucket = 0; bucket < bucketCount; bucket++)
+                {
+                    std::vector<u32> expected;
+                    if (mask.Test(bucket))
+                        for (u32 i = 0; i < elements.size(); i++)
+                            if (elements[i].Views.Test(view) && elements[i].Buckets.Test(bucket))
+                                expected.push_back(i);
+
+                    const SceneDrawRange& range = ranges.Get(view, bucket);
+                    const u32 count = counts[ranges.RangeIndex(view, bucket)];
+                    REQUIRE(count == expected.size());
+                    REQUIRE(count <= range.Capacity);
+                    REQUIRE(std::equal(expected.begin(), expected.end(), draws.begin() + range.Offset));
+                    /* the tail of the range is left for the count buffer to skip */
+                    for (u32 i = count; i < range.Capacity; i++)
+                        REQUIRE(draws[range.Offset + i] == NO_DRAW);
+                }
+        }
+    }
+    SECTION("Meshlets visible in every view fill the ranges up")
+    {
+        const TestSet set = randomSet(rng, 5, 300);
+        SceneDrawRanges ranges;
+        ranges.Init(3, set.BucketMeshletCounts, SceneBucketBits::All());
+
+        std::vector<SceneDrawRanges::Element> elements;
+        for (auto& buckets : set.MeshletBuckets)
+            elements.push_back({.Views = SceneViewMask::FirstN(3), .Buckets = buckets});
+        std::vector<u32> draws(ranges.DrawCount(), NO_DRAW);
+        std::vector<u32> counts(ranges.Ranges().size());
+        ranges.Compact(elements, draws, counts);
+
+        for (u32 i = 0; i < counts.size(); i++)
+            REQUIRE(counts[i] == ranges.Ranges()[i].Capacity);
+        REQUIRE(std::ranges::find(draws, NO_DRAW) == draws.end());
+    }
+}
@@ -0,0 +1,107 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "MemoryAssetIoInterface.h"
+#include "Assets/Scenes/SceneAsset.h"
+
+#include <AssetLib/Io/Compression/Lz4AssetCompressor.h>
+
+#include <cstring>
+
+// NOLINTBEGIN
+
+using namespace lux;
+
+namespace
+{
+std::vector<std::byte> sequentialBytes(u64 count)
+{
+    std::vector<std::byte> bytes(count);
+    for (u64 i = 0; i < count; i++)
+        bytes[i] = (std::byte)(i * 31 + i / 251);
+
+    return bytes;
+}
+}
+
+TEST_CASE("SceneGeometryStreams", "[Scene][SceneGeometryStreams]")
+{
+    constexpr u32 POSITION_SIZE = SceneGeometryInfo::STREAM_ELEMENT_SIZES[(u32)SceneGeometryStreamType::Position];
+
+    SECTION("Adjacent accessors of a buffer are merged into a single range")
+    {
+        SceneGeometryInfo geometry = {};
+        geometry.Buffers.resize(2);
+
+        REQUIRE(geometry.AddStreamRange(SceneGeometryStreamType::Position, 0, 0, 10) == 0);
+        REQUIRE(geometry.AddStreamRange(SceneGeometryStreamType::Position, 0, 10 * POSITION_SIZE, 5) == 10);
+        REQUIRE(geometry.Streams[(u32)SceneGeometryStreamType::Position].Ranges.size() == 1);
+
+        REQUIRE(geometry.AddStreamRange(SceneGeometryStreamType::Position, 1, 15 * POSITION_SIZE, 5) == 15);
+        REQUIRE(geometry.AddStreamRange(SceneGeometryStreamType::Position, 0, 100 * POSITION_SIZE, 5) == 20);
+        REQUIRE(geometry.Streams[(u32)SceneGeometryStreamType::Position].Ranges.size() == 3);
+        REQUIRE(geometry.GetStreamSizeBytes(SceneGeometryStreamType::Position) == 25 * POSITION_SIZE);
+        REQUIRE(geometry.GetStreamSizeBytes(SceneGeometryStreamType::Normal) == 0);
+    }
+    SECTION("Stream is assembled from buffer ranges and owned data")
+    {
+        const std::vector<std::byte> bufferData = sequentialBytes(64 * POSITION_SIZE);
+
+        SceneGeometryInfo geometry = {};
+        geometry.Buffers.push_back({.Data = std::make_shared<const std::vector<std::byte>>(bufferData)});
+        geometry.AddStreamRange(SceneGeometryStreamType::Position, 0, 8 * POSITION_SIZE, 4);
+        std::vector<std::byte> owned(2 * POSITION_SIZE, std::byte{0x7f});
+        geometry.AddStreamData(SceneGeometryStreamType::Position, std::vector(owned));
+        geometry.AddStreamRange(SceneGeometryStreamType::Position, 0, 0, 3);
+
+        std::vector<std::byte> stream(geometry.GetStreamSizeBytes(SceneGeometryStreamType::Position));
+        REQUIRE(geometry.ReadStream(SceneGeometryStreamType::Position, Span(stream.data(), stream.size())));
+
+        REQUIRE(std::memcmp(stream.data(), bufferData.data() + 8 * POSITION_SIZE, 4 * POSITION_SIZE) == 0);
+        REQUIRE(std::memcmp(stream.data() + 4 * POSITION_SIZE, owned.data(), owned.size()) == 0);
+        REQUIRE(std::memcmp(stream.data() + 6 * POSITION_SIZE, bufferData.data(), 3 * POSITION_SIZE) == 0);
+    }
+    SECTION("Ranges are decompressed straight from the compressed buffer")
+    {
+        assetlib::io::Lz4AssetCompressor compressor;
+        const std::vector<std::byte> bufferData =
+            sequentialBytes(3 * assetlib::io::Lz4AssetCompressor::BLOCK_SIZE_BYTES + 123);
+        std::vector<std::byte> compressed = compressor.Compress(bufferData);
+        const u64 compressedSize = compressed.size();
+        tests::MemoryAssetIoInterface io(std::move(compressed));
+
+        SceneGeometryBuffer buffer = {};
+        buffer.Header.SizeBytes = bufferData.size();
+        buffer.Metadata.Io.BinarySizeBytesCompressed = compressedSize;
+        buffer.Io = &io;
+        buffer.Compressor = &compressor;
+
+        SceneGeometryInfo geometry = {};
+        geometry.Buffers.push_back(std::move(buffer));
+        /* spans a block boundary */
+        const u64 firstOffset = assetlib::io::Lz4AssetCompressor::BLOCK_SIZE_BYTES - 5 * POSITION_SIZE;
+        geometry.AddStreamRange(SceneGeometryStreamType::Position, 0, firstOffset, 1000);
+        geometry.AddStreamRange(SceneGeometryStreamType::Position, 0, 0, 7);
+
+        std::vector<std::byte> stream(geometry.GetStreamSizeBytes(SceneGeometryStreamType::Position));
+        REQUIRE(geometry.ReadStream(SceneGeometryStreamType::Position, Span(stream.data(), stream.size())));
+        REQUIRE(std::memcmp(stream.data(), bufferData.data() + firstOffset, 1000 * POSITION_SIZE) == 0);
+        REQUIRE(std::memcmp(stream.data() + 1000 * POSITION_SIZE, bufferData.data(), 7 * POSITION_SIZE) == 0);
+    }
+    SECTION("Out of bounds range fails to read")
+    {
+        SceneGeometryInfo geometry = {};
+        assetlib::io::Lz4AssetCompressor compressor;
+        tests::MemoryAssetIoInterface io({});
+        SceneGeometryBuffer buffer = {};
+        buffer.Header.SizeBytes = 4 * POSITION_SIZE;
+        buffer.Io = &io;
+        buffer.Compressor = &compressor;
+        geometry.Buffers.push_back(std::move(buffer));
+        geometry.AddStreamRange(SceneGeometryStreamType::Position, 0, 0, 5);
+
+        std::vector<std::byte> stream(geometry.GetStreamSizeBytes(SceneGeometryStreamType::Position));
+        REQUIRE_FALSE(geometry.ReadStream(SceneGeometryStreamType::Position, Span(stream.data(), stream.size())));
+    }
+}
+
+// NOLINTEND
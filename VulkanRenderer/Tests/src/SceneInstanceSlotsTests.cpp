@@ -0,0 +1,142 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Scene/SceneInstanceSlots.h"
+
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+struct SlotData
+{
+    lux::SceneInstanceHandle Instance{};
+    u32 Value{};
+};
+
+void removeInstance(SceneInstanceSlots& slots, std::vector<SlotData>& data, lux::SceneInstanceHandle instance)
+{
+    slots.Remove(instance, [&data](u32 from, u32 to) {
+        data[to] = data[from];
+    });
+    data.resize(slots.Count());
+}
+
+void requireConsistent(const SceneInstanceSlots& slots, const std::vector<SlotData>& data,
+    const std::vector<std::vector<u32>>& expectedValues)
+{
+    REQUIRE(slots.Count() == data.size());
+    for (u32 slot = 0; slot < data.size(); slot++)
+        REQUIRE(slots.SlotOwner(slot) == data[slot].Instance);
+
+    for (u32 instance = 0; instance < expectedValues.size(); instance++)
+    {
+        auto instanceSlots = slots.InstanceSlots(instance);
+        REQUIRE(instanceSlots.size() == expectedValues[instance].size());
+        REQUIRE(slots.Contains(instance) == !expectedValues[instance].empty());
+        std::vector<u32> values;
+        for (u32 slot : instanceSlots)
+        {
+            REQUIRE(data[slot].Instance == instance);
+            values.push_back(data[slot].Value);
+        }
+        std::ranges::sort(values);
+        auto expected = expectedValues[instance];
+        std::ranges::sort(expected);
+        REQUIRE(values == expected);
+    }
+}
+}
+
+TEST_CASE("SceneInstanceSlots", "[Scene][SceneInstanceSlots]")
+{
+    SceneInstanceSlots slots;
+    std::vector<SlotData> data;
+    SECTION("Add appends slots in order")
+    {
+        REQUIRE(slots.Add(0) == 0);
+        REQUIRE(slots.Add(0) == 1);
+        REQUIRE(slots.Add(3) == 2);
+        REQUIRE(slots.Count() == 3);
+        REQUIRE(slots.Contains(0));
+        REQUIRE(!slots.Contains(1));
+        REQUIRE(slots.Contains(3));
+        REQUIRE(slots.InstanceSlots(0).size() == 2);
+        REQUIRE(slots.InstanceSlots(7).empty());
+    }
+    SECTION("Removing the last instance does not move anything")
+    {
+        for (u32 i = 0; i < 3; i++)
+            data.push_back({.Instance = 0, .Value = slots.Add(0)});
+        for (u32 i = 0; i < 2; i++)
+            data.push_back({.Instance = 1, .Value = slots.Add(1)});
+
+        u32 moves = 0;
+        slots.Remove(1, [&moves](u32, u32) { moves++; });
+        REQUIRE(moves == 0);
+        REQUIRE(slots.Count() == 3);
+        REQUIRE(!slots.Contains(1));
+    }
+    SECTION("Removing an instance moves only as many slots as it owns")
+    {
+        for (u32 i = 0; i < 2; i++)
+            data.push_back({.Instance = 0, .Value = i});
+        for (u32 i = 0; i < 2; i++)
+            slots.Add(0);
+        for (u32 i = 0; i < 100; i++)
+        {
+            slots.Add(1);
+            data.push_back({.Instance = 1, .Value = i});
+        }
+
+        u32 moves = 0;
+        slots.Remove(0, [&](u32 from, u32 to) {
+            data[to] = data[from];
+            moves++;
+        });
+        data.resize(slots.Count());
+        REQUIRE(moves == 2);
+
+        std::vector<std::vector<u32>> expected(2);
+        for (u32 i = 0; i < 100; i++)
+            expected[1].push_back(i);
+        requireConsistent(slots, data, expected);
+    }
+    SECTION("Randomized add and remove sequences stay consistent")
+    {
+        static constexpr u32 MAX_INSTANCES = 64;
+        static constexpr u32 ITERATIONS = 2000;
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<u32> instanceDistribution(0, MAX_INSTANCES - 1);
+        std::uniform_int_distribution<u32> countDistribution(0, 16);
+        std::bernoulli_distribution addDistribution(0.6);
+
+        std::vector<std::vector<u32>> expected(MAX_INSTANCES);
+        u32 nextValue = 0;
+        for (u32 iteration = 0; iteration < ITERATIONS; iteration++)
+        {
+            const lux::SceneInstanceHandle instance = instanceDistribution(rng);
+            if (addDistribution(rng) && expected[instance].empty())
+            {
+                const u32 count = countDistribution(rng);
+                for (u32 i = 0; i < count; i++)
+                {
+                    const u32 slot = slots.Add(instance);
+                    REQUIRE(slot == data.size());
+                    data.push_back({.Instance = instance, .Value = nextValue});
+                    expected[instance].push_back(nextValue);
+                    nextValue++;
+                }
+            }
+            else
+            {
+                removeInstance(slots, data, instance);
+                expected[instance].clear();
+            }
+
+            if (iteration % 50 == 0)
+                requireConsistent(slots, data, expected);
+        }
+        requireConsistent(slots, data, expected);
+    }
+}
@@ -0,0 +1,89 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Scene/Visibility/SceneRenderObjectRanges.h"
+
+#include <algorithm>
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+std::vector<u32> expand(const SceneRenderObjectRanges& ranges)
+{
+    std::vector<u32> slots;
+    for (auto& range : ranges.Ranges())
+    {
+        REQUIRE(range.CompactedOffset == slots.size());
+        for (u32 i = 0; i < range.Count; i++)
+            slots.push_back(range.First + i);
+    }
+
+    return slots;
+}
+}
+
+TEST_CASE("SceneRenderObjectRanges", "[Scene][SceneRenderObjectRanges]")
+{
+    SceneRenderObjectRanges ranges;
+    SECTION("Consecutive slots become a single range")
+    {
+        const std::vector<u32> slots = {4, 5, 6, 7};
+        ranges.AddSlots(slots);
+        ranges.Compact();
+        REQUIRE(ranges.Ranges().size() == 1);
+        REQUIRE(ranges.Ranges()[0] == SceneRenderObjectRange{.First = 4, .Count = 4, .CompactedOffset = 0});
+        REQUIRE(ranges.SlotCount() == 4);
+    }
+    SECTION("Adjacent ranges of different instances are merged")
+    {
+        ranges.AddRange(10, 5);
+        ranges.AddRange(0, 3);
+        ranges.AddRange(3, 7);
+        ranges.AddRange(20, 1);
+        ranges.Compact();
+        REQUIRE(ranges.Ranges().size() == 2);
+        REQUIRE(ranges.Ranges()[0] == SceneRenderObjectRange{.First = 0, .Count = 15, .CompactedOffset = 0});
+        REQUIRE(ranges.Ranges()[1] == SceneRenderObjectRange{.First = 20, .Count = 1, .CompactedOffset = 15});
+    }
+    SECTION("Empty ranges are ignored")
+    {
+        ranges.AddRange(3, 0);
+        ranges.Compact();
+        REQUIRE(ranges.Ranges().empty());
+        REQUIRE(ranges.SlotCount() == 0);
+    }
+    SECTION("Compacted ranges cover exactly the added slots")
+    {
+        std::mt19937 rng(11);
+        std::vector<u32> allSlots(2000);
+        for (u32 i = 0; i < allSlots.size(); i++)
+            allSlots[i] = i;
+        std::ranges::shuffle(allSlots, rng);
+
+        /* split the shuffled slots into "instances" of random sizes, and keep some of them */
+        std::vector<u32> expected;
+        std::uniform_int_distribution<u32> instanceSize(1, 40);
+        std::bernoulli_distribution isVisible(0.5);
+        for (u32 first = 0; first < allSlots.size();)
+        {
+            const u32 count = std::min(instanceSize(rng), (u32)allSlots.size() - first);
+            std::vector<u32> instanceSlots(allSlots.begin() + first, allSlots.begin() + first + count);
+            /* most instances own consecutive slots */
+            std::ranges::sort(instanceSlots);
+            if (isVisible(rng))
+            {
+                ranges.AddSlots(instanceSlots);
+                expected.insert(expected.end(), instanceSlots.begin(), instanceSlots.end());
+            }
+            first += count;
+        }
+        ranges.Compact();
+        std::ranges::sort(expected);
+
+        REQUIRE(expand(ranges) == expected);
+        REQUIRE(ranges.SlotCount() == expected.size());
+        for (u32 i = 1; i < ranges.Ranges().size(); i++)
+            REQUIRE(ranges.Ranges()[i - 1].First + ranges.Ranges()[i - 1].Count < ranges.Ranges()[i].First);
+    }
+}
@@ -0,0 +1,107 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "RenderGraph/Passes/Shadows/ShadowPassesUtils.h"
+
+#include <cmath>
+
+// NOLINTBEGIN
+
+namespace
+{
+bool isClose(f32 a, f32 b)
+{
+    return std::abs(a - b) <= 1e-4f * std::max(1.0f, std::abs(b));
+}
+
+bool isIncreasing(const ShadowUtils::CascadeSplits& splits, u32 cascadeCount)
+{
+    f32 previous = splits.Near;
+    for (u32 i = 0; i < cascadeCount; i++)
+    {
+        if (splits.Far[i] <= previous)
+            return false;
+        previous = splits.Far[i];
+    }
+
+    return true;
+}
+}
+
+TEST_CASE("Shadow cascade splits", "[Shadow][CascadeSplits]")
+{
+    const ShadowUtils::CascadeSplitInfo info = {
+        .Near = 0.1f,
+        .Far = 1000.0f,
+        .DepthMin = 0.5f,
+        .DepthMax = 200.0f};
+
+    SECTION("Splits are fit to the visible depth range")
+    {
+        const ShadowUtils::CascadeSplits splits = ShadowUtils::cascadeSplits(info);
+        REQUIRE(splits.Near == 0.5f);
+        REQUIRE(splits.Far[SHADOW_CASCADES - 1] == 200.0f);
+        REQUIRE(isIncreasing(splits, SHADOW_CASCADES));
+    }
+    SECTION("Zero lambda gives logarithmic splits and unit lambda gives uniform ones")
+    {
+        const ShadowUtils::CascadeSplits logarithmic = ShadowUtils::cascadeSplits(info);
+        for (u32 i = 1; i < SHADOW_CASCADES; i++)
+            REQUIRE(isClose(logarithmic.Far[i] / logarithmic.Far[i - 1], logarithmic.Far[0] / logarithmic.Near));
+
+        ShadowUtils::CascadeSplitInfo uniformInfo = info;
+        uniformInfo.Lambda = 1.0f;
+        const ShadowUtils::CascadeSplits uniform = ShadowUtils::cascadeSplits(uniformInfo);
+        for (u32 i = 1; i < SHADOW_CASCADES; i++)
+            REQUIRE(isClose(uniform.Far[i] - uniform.Far[i - 1], uniform.Far[0] - uniform.Near));
+
+        ShadowUtils::CascadeSplitInfo blendInfo = info;
+        blendInfo.Lambda = 0.5f;
+        const ShadowUtils::CascadeSplits blend = ShadowUtils::cascadeSplits(blendInfo);
+        for (u32 i = 0; i < SHADOW_CASCADES; i++)
+            REQUIRE(isClose(blend.Far[i], 0.5f * (logarithmic.Far[i] + uniform.Far[i])));
+    }
+    SECTION("Depth range is limited by the camera range")
+    {
+        ShadowUtils::CascadeSplitInfo wideInfo = info;
+        wideInfo.DepthMin = 0.01f;
+        wideInfo.DepthMax = std::numeric_limits<f32>::infinity();
+        const ShadowUtils::CascadeSplits splits = ShadowUtils::cascadeSplits(wideInfo);
+        REQUIRE(splits.Near == wideInfo.Near);
+        REQUIRE(splits.Far[SHADOW_CASCADES - 1] == wideInfo.Far);
+        REQUIRE(isIncreasing(splits, SHADOW_CASCADES));
+    }
+    SECTION("Empty depth range falls back to the camera range")
+    {
+        /* that is what the reverse-z depth reduction linearizes to when only the sky is visible */
+        ShadowUtils::CascadeSplitInfo emptyInfo = info;
+        emptyInfo.DepthMin = std::numeric_limits<f32>::infinity();
+        emptyInfo.DepthMax = std::numeric_limits<f32>::infinity();
+        const ShadowUtils::CascadeSplits splits = ShadowUtils::cascadeSplits(emptyInfo);
+        REQUIRE(splits.Near == emptyInfo.Near);
+        REQUIRE(splits.Far[SHADOW_CASCADES - 1] == emptyInfo.Far);
+        REQUIRE(isIncreasing(splits, SHADOW_CASCADES));
+    }
+    SECTION("Flat depth range gives non-degenerate cascades")
+    {
+        ShadowUtils::CascadeSplitInfo flatInfo = info;
+        flatInfo.DepthMin = 10.0f;
+        flatInfo.DepthMax = 10.0f + 1e-6f;
+        const ShadowUtils::CascadeSplits splits = ShadowUtils::cascadeSplits(flatInfo);
+        REQUIRE(splits.Near == 10.0f);
+        REQUIRE(isIncreasing(splits, SHADOW_CASCADES));
+
+        flatInfo.DepthMin = flatInfo.Far;
+        flatInfo.DepthMax = 2.0f * flatInfo.Far;
+        REQUIRE(isIncreasing(ShadowUtils::cascadeSplits(flatInfo), SHADOW_CASCADES));
+    }
+    SECTION("Fewer cascades span the same range")
+    {
+        ShadowUtils::CascadeSplitInfo fewerInfo = info;
+        fewerInfo.CascadeCount = 2;
+        const ShadowUtils::CascadeSplits splits = ShadowUtils::cascadeSplits(fewerInfo);
+        REQUIRE(splits.Near == 0.5f);
+        REQUIRE(splits.Far[1] == 200.0f);
+        REQUIRE(isClose(splits.Far[0], std::sqrt(0.5f * 200.0f)));
+        REQUIRE(isIncreasing(splits, 2));
+    }
+}
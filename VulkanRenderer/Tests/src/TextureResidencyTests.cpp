@@ -0,0 +1,153 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Assets/Images/TextureResidency.h"
+
+#include <numeric>
+
+// NOLINTBEGIN
+
+using namespace lux;
+
+namespace
+{
+constexpr u32 TEXTURE_SIZE = 1024;
+constexpr u32 TAIL_MIP = 4;
+constexpr u64 UNLIMITED = ~0llu;
+
+/* rgba8 square texture */
+std::vector<u64> squareMipSizes(u32 size)
+{
+    std::vector<u64> sizes;
+    for (; size > 0; size >>= 1)
+        sizes.push_back((u64)size * size * 4);
+
+    return sizes;
+}
+
+u64 tailSize(u32 mip)
+{
+    const std::vector<u64> sizes = squareMipSizes(TEXTURE_SIZE);
+    return std::accumulate(sizes.begin() + mip, sizes.end(), 0llu);
+}
+
+void applyChanges(TextureResidency& residency, const std::vector<TextureResidency::Change>& changes)
+{
+    for (auto& change : changes)
+        residency.OnResident(change.Texture, change.ResidentMip);
+}
+
+void streamFully(TextureResidency& residency, u32 texture, u64 frame)
+{
+    const TextureResidency::Config config = {.VramBudgetBytes = UNLIMITED, .UploadBudgetBytes = UNLIMITED};
+    residency.Request(texture, 0, frame);
+    while (residency.GetResidentMip(texture) > 0)
+        applyChanges(residency, residency.Update(frame, config));
+}
+}
+
+TEST_CASE("TextureResidency", "[Assets][TextureResidency]")
+{
+    const TextureResidency::Config unlimited = {.VramBudgetBytes = UNLIMITED, .UploadBudgetBytes = UNLIMITED};
+
+    SECTION("Only the mipmap tail is resident initially")
+    {
+        TextureResidency residency;
+        residency.Add(0, squareMipSizes(TEXTURE_SIZE), TAIL_MIP);
+
+        REQUIRE(residency.GetResidentMip(0) == TAIL_MIP);
+        REQUIRE(residency.GetResidentBytes() == tailSize(TAIL_MIP));
+        REQUIRE(residency.Update(1, unlimited).empty());
+
+        residency.Remove(0);
+        REQUIRE(residency.GetResidentBytes() == 0);
+    }
+    SECTION("Requested mipmaps are streamed in one at a time, from the smallest")
+    {
+        TextureResidency residency;
+        residency.Add(0, squareMipSizes(TEXTURE_SIZE), TAIL_MIP);
+        residency.Request(0, 1, 1);
+        residency.Request(0, 2, 1);
+
+        for (u32 mip = TAIL_MIP; mip > 1; mip--)
+        {
+            auto changes = residency.Update(1, unlimited);
+            REQUIRE(changes.size() == 1);
+            REQUIRE(changes.front().ResidentMip == mip - 1);
+            /* the change is pending */
+            REQUIRE(residency.Update(1, unlimited).empty());
+            REQUIRE(residency.GetResidentMip(0) == mip);
+            REQUIRE(residency.GetResidentBytes() == tailSize(mip - 1));
+
+            applyChanges(residency, changes);
+            REQUIRE(residency.GetResidentMip(0) == mip - 1);
+        }
+        REQUIRE(residency.Update(1, unlimited).empty());
+    }
+    SECTION("Upload budget limits the changes of a frame")
+    {
+        TextureResidency residency;
+        for (u32 texture = 0; texture < 3; texture++)
+        {
+            residency.Add(texture, squareMipSizes(TEXTURE_SIZE), TAIL_MIP);
+            residency.Request(texture, 0, 1);
+        }
+
+        REQUIRE(residency.Update(1, {.VramBudgetBytes = UNLIMITED, .UploadBudgetBytes = 0}).size() == 1);
+        REQUIRE(residency.Update(1, {
+            .VramBudgetBytes = UNLIMITED, .UploadBudgetBytes = 2 * tailSize(TAIL_MIP - 1)}).size() == 2);
+    }
+    SECTION("Textures that are not requested anymore are evicted to stream in the requested ones")
+    {
+        TextureResidency residency;
+        residency.Add(0, squareMipSizes(TEXTURE_SIZE), TAIL_MIP);
+        residency.Add(1, squareMipSizes(TEXTURE_SIZE), TAIL_MIP);
+        streamFully(residency, 1, 1);
+        REQUIRE(residency.GetResidentBytes() == tailSize(0) + tailSize(TAIL_MIP));
+
+        const TextureResidency::Config config = {
+            .VramBudgetBytes = tailSize(0) + tailSize(TAIL_MIP),
+            .UploadBudgetBytes = UNLIMITED,
+            .RequestLifetimeFrames = 10
+        };
+
+        /* texture 1 is still desired */
+        residency.Request(0, 0, 5);
+        REQUIRE(residency.Update(5, config).empty());
+
+        residency.Request(0, 0, 20);
+        auto changes = residency.Update(20, config);
+        REQUIRE(changes.size() == 2);
+        REQUIRE(changes[0].Texture == 1);
+        REQUIRE(changes[0].ResidentMip == 1);
+        REQUIRE(changes[1].Texture == 0);
+        REQUIRE(changes[1].ResidentMip == TAIL_MIP - 1);
+        REQUIRE(residency.GetResidentBytes() <= config.VramBudgetBytes);
+    }
+    SECTION("Lowered budget evicts the desired mipmaps, but keeps the tail")
+    {
+        TextureResidency residency;
+        residency.Add(0, squareMipSizes(TEXTURE_SIZE), TAIL_MIP);
+        residency.Add(1, squareMipSizes(TEXTURE_SIZE), TAIL_MIP);
+        streamFully(residency, 0, 1);
+        streamFully(residency, 1, 2);
+
+        auto changes = residency.Update(2, {.VramBudgetBytes = 0, .UploadBudgetBytes = UNLIMITED});
+        REQUIRE(changes.size() == 2);
+        /* least recently requested goes first */
+        REQUIRE(changes[0].Texture == 0);
+        applyChanges(residency, changes);
+        REQUIRE(residency.GetResidentMip(0) == TAIL_MIP);
+        REQUIRE(residency.GetResidentMip(1) == TAIL_MIP);
+        REQUIRE(residency.GetResidentBytes() == 2 * tailSize(TAIL_MIP));
+    }
+    SECTION("Mipmap is estimated from the screen size")
+    {
+        REQUIRE(TextureResidency::EstimateMip(1024, 512, 2048.0f) == 0);
+        REQUIRE(TextureResidency::EstimateMip(1024, 512, 1024.0f) == 0);
+        REQUIRE(TextureResidency::EstimateMip(1024, 512, 512.0f) == 1);
+        REQUIRE(TextureResidency::EstimateMip(1024, 512, 300.0f) == 1);
+        REQUIRE(TextureResidency::EstimateMip(1024, 512, 0.0f) == 10);
+    }
+}
+
+// NOLINTEND
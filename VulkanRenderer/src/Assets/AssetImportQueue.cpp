@@ -3,21 +3,31 @@
 
 #include "AssetManager.h"
 
+#include <unordered_set>
+
 namespace lux
 {
-void AssetImportQueue::Init()
+void AssetImportQueue::Init(u32 workerCount)
 {
-    m_WorkerThread = std::thread([this]()
-    {
-        ProcessRequests();
-    });
+    if (workerCount == 0)
+        workerCount = std::max(std::thread::hardware_concurrency() / 2, 1u);
+
+    m_Exit = false;
+    m_Workers.reserve(workerCount);
+    for (u32 i = 0; i < workerCount; i++)
+        m_Workers.emplace_back([this]()
+        {
+            ProcessRequests();
+        });
 }
 
 void AssetImportQueue::Shutdown()
 {
     SignalStop();
-    if (m_WorkerThread.joinable())
-        m_WorkerThread.join();
+    for (auto& worker : m_Workers)
+        if (worker.joinable())
+            worker.join();
+    m_Workers.clear();
 }
 
 void AssetImportQueue::SignalStop()
@@ -26,34 +36,202 @@ void AssetImportQueue::SignalStop()
         std::lock_guard lock(m_CvMutex);
         m_Exit = true;
     }
-    m_Cv.notify_one();
+    m_Cv.notify_all();
+    m_IdleCv.notify_all();
 }
 
-bool AssetImportQueue::AddRequest(AssetImportRequest&& request)
+AssetImportTaskId AssetImportQueue::AddRequest(AssetImportRequest&& request)
 {
+    AssetImportTaskId taskId = INVALID_ASSET_IMPORT_TASK;
     {
         std::lock_guard lock(m_CvMutex);
-        m_Requests.push(std::move(request));
+        if (m_Exit)
+            return INVALID_ASSET_IMPORT_TASK;
+
+        if (auto queued = m_QueuedKeys.find(request.Key); !request.Key.empty() && queued != m_QueuedKeys.end())
+        {
+            taskId = queued->second;
+            Task& task = m_Tasks.at(taskId);
+            task.Request.ImportFn = std::move(request.ImportFn);
+            RaisePriority(taskId, request.Priority);
+            AddDependencies(taskId, task, request.Dependencies);
+
+            return taskId;
+        }
+
+        taskId = m_NextTaskId++;
+        std::vector<AssetImportTaskId> dependencies = std::move(request.Dependencies);
+        if (!request.Key.empty())
+        {
+            if (auto running = m_RunningKeys.find(request.Key); running != m_RunningKeys.end())
+                dependencies.push_back(running->second);
+            m_QueuedKeys.emplace(request.Key, taskId);
+        }
+
+        Task& task = m_Tasks[taskId];
+        task.Request = std::move(request);
+        task.Request.Dependencies.clear();
+        AddDependencies(taskId, task, dependencies);
+        if (task.UnfinishedDependencies == 0)
+            m_Ready[(u32)task.Request.Priority].push_back(taskId);
     }
     m_Cv.notify_one();
 
+    return taskId;
+}
+
+bool AssetImportQueue::Cancel(AssetImportTaskId task)
+{
+    {
+        std::lock_guard lock(m_CvMutex);
+        auto it = m_Tasks.find(task);
+        if (it == m_Tasks.end() || it->second.IsRunning)
+            return false;
+
+        Finish(task);
+    }
+    m_Cv.notify_all();
+    m_IdleCv.notify_all();
+
     return true;
 }
 
+void AssetImportQueue::WaitIdle()
+{
+    std::unique_lock lock(m_CvMutex);
+    m_IdleCv.wait(lock, [this](){ return m_Exit || m_Tasks.empty(); });
+}
+
 void AssetImportQueue::ProcessRequests()
 {
     for (;;)
     {
         std::unique_lock lock(m_CvMutex);
-        m_Cv.wait(lock, [this](){ return m_Exit || !m_Requests.empty(); });
+        AssetImportTaskId taskId = INVALID_ASSET_IMPORT_TASK;
+        m_Cv.wait(lock, [this, &taskId](){ return m_Exit || TryPopReady(taskId); });
         if (m_Exit)
             return;
 
-        AssetImportRequest request = std::move(m_Requests.front());
-        m_Requests.pop();
+        Task& task = m_Tasks.at(taskId);
+        task.IsRunning = true;
+        if (!task.Request.Key.empty())
+        {
+            m_QueuedKeys.erase(task.Request.Key);
+            m_RunningKeys[task.Request.Key] = taskId;
+        }
+        const std::function<void()> importFn = std::move(task.Request.ImportFn);
         lock.unlock();
 
-        request.ImportFn();
+        importFn();
+
+        lock.lock();
+        Finish(taskId);
+        lock.unlock();
+        /* the dependent tasks might be ready now */
+        m_Cv.notify_all();
+        m_IdleCv.notify_all();
+    }
+}
+
+void AssetImportQueue::AddDependencies(AssetImportTaskId taskId, Task& task,
+    const std::vector<AssetImportTaskId>& dependencies)
+{
+    for (const AssetImportTaskId dependency : dependencies)
+    {
+        /* the finished tasks are not tracked, and the cycles would never finish */
+        auto it = m_Tasks.find(dependency);
+        if (it == m_Tasks.end() || std::ranges::find(task.Request.Dependencies, dependency) !=
+            task.Request.Dependencies.end() || DependsOn(dependency, taskId))
+            continue;
+
+        task.Request.Dependencies.push_back(dependency);
+        task.UnfinishedDependencies++;
+        it->second.Dependents.push_back(taskId);
+        RaisePriority(dependency, task.Request.Priority);
+    }
+}
+
+bool AssetImportQueue::DependsOn(AssetImportTaskId taskId, AssetImportTaskId dependency) const
+{
+    std::vector<AssetImportTaskId> toVisit = {taskId};
+    std::unordered_set<AssetImportTaskId> visited;
+    while (!toVisit.empty())
+    {
+        const AssetImportTaskId visit = toVisit.back();
+        toVisit.pop_back();
+        if (visit == dependency)
+            return true;
+        auto it = m_Tasks.find(visit);
+        if (it == m_Tasks.end() || !visited.insert(visit).second)
+            continue;
+        const auto& dependencies = it->second.Request.Dependencies;
+        toVisit.insert(toVisit.end(), dependencies.begin(), dependencies.end());
+    }
+
+    return false;
+}
+
+void AssetImportQueue::RaisePriority(AssetImportTaskId taskId, AssetImportPriority priority)
+{
+    /* a task inherits the priority of the tasks that wait for it */
+    auto it = m_Tasks.find(taskId);
+    if (it == m_Tasks.end() || it->second.IsRunning || it->second.Request.Priority <= priority)
+        return;
+
+    Task& task = it->second;
+    task.Request.Priority = priority;
+    if (task.UnfinishedDependencies == 0)
+        m_Ready[(u32)priority].push_back(taskId);
+    for (const AssetImportTaskId dependency : task.Request.Dependencies)
+        RaisePriority(dependency, priority);
+}
+
+bool AssetImportQueue::TryPopReady(AssetImportTaskId& taskId)
+{
+    for (u32 priority = 0; priority < m_Ready.size(); priority++)
+    {
+        auto& ready = m_Ready[priority];
+        while (!ready.empty())
+        {
+            const AssetImportTaskId candidate = ready.front();
+            ready.pop_front();
+            auto it = m_Tasks.find(candidate);
+            if (it == m_Tasks.end() || it->second.IsRunning || it->second.UnfinishedDependencies > 0 ||
+                (u32)it->second.Request.Priority != priority)
+                continue;
+
+            taskId = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void AssetImportQueue::Finish(AssetImportTaskId taskId)
+{
+    auto it = m_Tasks.find(taskId);
+    if (it == m_Tasks.end())
+        return;
+
+    const Task task = std::move(it->second);
+    m_Tasks.erase(it);
+    if (!task.Request.Key.empty())
+    {
+        if (auto queued = m_QueuedKeys.find(task.Request.Key); queued != m_QueuedKeys.end() && queued->second == taskId)
+            m_QueuedKeys.erase(queued);
+        if (auto running = m_RunningKeys.find(task.Request.Key);
+            running != m_RunningKeys.end() && running->second == taskId)
+            m_RunningKeys.erase(running);
+    }
+
+    for (const AssetImportTaskId dependent : task.Dependents)
+    {
+        auto dependentIt = m_Tasks.find(dependent);
+        if (dependentIt == m_Tasks.end())
+            continue;
+        if (--dependentIt->second.UnfinishedDependencies == 0)
+            m_Ready[(u32)dependentIt->second.Request.Priority].push_back(dependent);
     }
 }
 }
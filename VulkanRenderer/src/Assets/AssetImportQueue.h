@@ -1,29 +1,88 @@
 ﻿#pragma once
 
+#include <CoreLib/types.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace lux 
 {
+using AssetImportTaskId = u64;
+static constexpr AssetImportTaskId INVALID_ASSET_IMPORT_TASK = 0;
+
+enum class AssetImportPriority : u8
+{
+    /* the asset is needed for the frames on screen */
+    VisibleNow,
+    Prefetch,
+    /* reimports of the changed files */
+    Background,
+    MaxVal
+};
+
 struct AssetImportRequest
 {
     std::function<void()> ImportFn = [](){};
+    AssetImportPriority Priority{AssetImportPriority::VisibleNow};
+    /* a queued request with the same key is stale and is replaced by this one (keeping its task id);
+     * requests with the same key never run at once */
+    std::string Key{};
+    /* the request does not start until these tasks are finished or cancelled */
+    std::vector<AssetImportTaskId> Dependencies{};
 };
 
 class AssetImportQueue
 {
 public:
-    void Init();
+    /* `workerCount` of 0 means half of the hardware threads, as the importers use the thread pool themselves */
+    void Init(u32 workerCount = 0);
     void Shutdown();
     void SignalStop();
-    bool AddRequest(AssetImportRequest&& request);
+    /* returns `INVALID_ASSET_IMPORT_TASK` if the queue is stopped */
+    AssetImportTaskId AddRequest(AssetImportRequest&& request);
+    /* only the tasks that have not started can be cancelled, the tasks that depend on it are not blocked by it anymore */
+    bool Cancel(AssetImportTaskId task);
+    /* blocks until there are no queued or running tasks */
+    void WaitIdle();
+    u32 GetWorkerCount() const { return (u32)m_Workers.size(); }
     /* this function blocks and should be called from secondary thread */
     void ProcessRequests();
 
 private:
-    std::queue<AssetImportRequest> m_Requests;
+    struct Task
+    {
+        AssetImportRequest Request{};
+        u32 UnfinishedDependencies{0};
+        std::vector<AssetImportTaskId> Dependents{};
+        bool IsRunning{false};
+    };
+    void AddDependencies(AssetImportTaskId taskId, Task& task, const std::vector<AssetImportTaskId>& dependencies);
+    bool DependsOn(AssetImportTaskId taskId, AssetImportTaskId dependency) const;
+    void RaisePriority(AssetImportTaskId taskId, AssetImportPriority priority);
+    bool TryPopReady(AssetImportTaskId& taskId);
+    void Finish(AssetImportTaskId taskId);
+
+private:
+    std::unordered_map<AssetImportTaskId, Task> m_Tasks;
+    /* ready tasks by priority; entries are not removed when a task changes its priority or gets cancelled,
+     * such entries are skipped instead */
+    std::array<std::deque<AssetImportTaskId>, (u32)AssetImportPriority::MaxVal> m_Ready;
+    std::unordered_map<std::string, AssetImportTaskId> m_QueuedKeys;
+    std::unordered_map<std::string, AssetImportTaskId> m_RunningKeys;
+    AssetImportTaskId m_NextTaskId{INVALID_ASSET_IMPORT_TASK + 1};
     std::condition_variable m_Cv;
+    /* separate from `m_Cv`, so that `WaitIdle` never takes the wake up meant for a worker */
+    std::condition_variable m_IdleCv;
     std::mutex m_CvMutex;
     std::atomic_bool m_Exit{false};
-    std::thread m_WorkerThread;
+    std::vector<std::thread> m_Workers;
 };
 }
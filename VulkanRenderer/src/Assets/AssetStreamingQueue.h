@@ -0,0 +1,128 @@
+﻿#pragma once
+
+#include <CoreLib/types.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+namespace lux
+{
+/* limits the amount of data that is uploaded to gpu in a single frame,
+ * the first upload of a frame always fits, so that assets larger than the budget still make progress */
+struct AssetUploadBudget
+{
+    u64 BudgetBytes{0};
+    u64 SpentBytes{0};
+
+    bool TrySpend(u64 sizeBytes)
+    {
+        if (SpentBytes > 0 && SpentBytes + sizeBytes > BudgetBytes)
+            return false;
+        SpentBytes += sizeBytes;
+
+        return true;
+    }
+};
+
+/* tracks assets that are loaded on worker threads,
+ * the loaded assets are handed over to the main thread by `TakeCompleted` */
+template <typename Key, typename Asset>
+class AssetStreamingQueue
+{
+public:
+    struct Completed
+    {
+        Key Id{};
+        /* empty if the load has failed */
+        std::optional<Asset> Result{};
+    };
+public:
+    /* returns false if the asset is already being loaded */
+    bool Begin(Key key);
+    /* the result of a cancelled load is dropped */
+    void Complete(Key key, std::optional<Asset>&& asset);
+    void Cancel(Key key);
+    
+    /* the asset is pending until its result is taken */
+    bool IsPending(Key key) const;
+    u32 PendingCount() const;
+    std::vector<Completed> TakeCompleted();
+    /* blocks until all the pending loads are completed */
+    void WaitIdle();
+private:
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    std::unordered_set<Key> m_Loading;
+    std::vector<Completed> m_Completed;
+};
+
+template <typename Key, typename Asset>
+bool AssetStreamingQueue<Key, Asset>::Begin(Key key)
+{
+    std::lock_guard lock(m_Mutex);
+    
+    return m_Loading.insert(key).second;
+}
+
+template <typename Key, typename Asset>
+void AssetStreamingQueue<Key, Asset>::Complete(Key key, std::optional<Asset>&& asset)
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        if (!m_Loading.contains(key))
+            return;
+        m_Completed.push_back({.Id = key, .Result = std::move(asset)});
+    }
+    m_Cv.notify_all();
+}
+
+template <typename Key, typename Asset>
+void AssetStreamingQueue<Key, Asset>::Cancel(Key key)
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Loading.erase(key);
+        std::erase_if(m_Completed, [&key](const Completed& completed) { return completed.Id == key; });
+    }
+    m_Cv.notify_all();
+}
+
+template <typename Key, typename Asset>
+bool AssetStreamingQueue<Key, Asset>::IsPending(Key key) const
+{
+    std::lock_guard lock(m_Mutex);
+    
+    return m_Loading.contains(key);
+}
+
+template <typename Key, typename Asset>
+u32 AssetStreamingQueue<Key, Asset>::PendingCount() const
+{
+    std::lock_guard lock(m_Mutex);
+    
+    return (u32)m_Loading.size();
+}
+
+template <typename Key, typename Asset>
+std::vector<typename AssetStreamingQueue<Key, Asset>::Completed> AssetStreamingQueue<Key, Asset>::TakeCompleted()
+{
+    std::lock_guard lock(m_Mutex);
+    
+    std::vector<Completed> completed = std::move(m_Completed);
+    m_Completed.clear();
+    for (auto& asset : completed)
+        m_Loading.erase(asset.Id);
+
+    return completed;
+}
+
+template <typename Key, typename Asset>
+void AssetStreamingQueue<Key, Asset>::WaitIdle()
+{
+    std::unique_lock lock(m_Mutex);
+    m_Cv.wait(lock, [this]() { return m_Completed.size() == m_Loading.size(); });
+}
+}
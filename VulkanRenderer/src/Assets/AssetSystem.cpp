@@ -44,6 +44,27 @@ AssetSystemFileLockGuard::~AssetSystemFileLockGuard()
     m_Locker->ReleaseLock(m_RawPath, m_MetadataPath);
 }
 
+std::shared_lock<std::shared_mutex> AssetAccessLocks::LockRead(const std::filesystem::path& rawPath)
+{
+    return std::shared_lock(GetMutex(rawPath));
+}
+
+std::unique_lock<std::shared_mutex> AssetAccessLocks::LockWrite(const std::filesystem::path& rawPath)
+{
+    return std::unique_lock(GetMutex(rawPath));
+}
+
+std::shared_mutex& AssetAccessLocks::GetMutex(const std::filesystem::path& rawPath)
+{
+    std::string key = fs::weakly_canonical(rawPath).generic_string();
+    std::scoped_lock lock(m_Mutex);
+    auto& mutex = m_Locks[std::move(key)];
+    if (!mutex)
+        mutex = std::make_unique<std::shared_mutex>();
+
+    return *mutex;
+}
+
 void AssetSystem::Init(const std::shared_ptr<import::Context>& context)
 {
     m_Ctx = context;
@@ -53,6 +74,7 @@ void AssetSystem::Init(const std::shared_ptr<import::Context>& context)
 void AssetSystem::Shutdown()
 {
     m_ImportQueue.Shutdown();
+    WriteAssetIndex();
 }
 
 void AssetSystem::RegisterAssetManager(assetlib::AssetType type, AssetManager& manager)
@@ -67,33 +89,49 @@ void AssetSystem::SetAssetsDirectory(const std::filesystem::path& path)
     InitFileWatcher(path);
 }
 
+void AssetSystem::SetAssetIndexPath(const std::filesystem::path& path)
+{
+    m_AssetIndexPath = path;
+}
+
 void AssetSystem::ScanAssetsDirectory()
 {
     for (auto& manager : m_Managers | std::views::values)
         manager->OnAssetSystemInit();
+
+    if (!m_AssetIndexPath.empty() && fs::exists(m_AssetIndexPath))
+    {
+        auto index = assetlib::io::readAssetDirectoryIndex(m_AssetIndexPath);
+        std::scoped_lock lock(m_AssetIndexMutex);
+        if (index.has_value())
+            m_AssetIndex = std::move(*index);
+        else
+            LUX_LOG_WARN("Failed to read asset index, the assets directory is scanned from scratch. Error: {}",
+                index.error());
+    }
     
     ScanAssetsDirectory(m_AssetsDirectory);
+    WriteAssetIndex();
 }
 
 void AssetSystem::ScanAssetsDirectory(const std::filesystem::path& path)
 {
-    for (const auto& file : fs::recursive_directory_iterator(path))
+    assetlib::io::AssetDirectoryIndex scanned;
     {
-        if (file.is_directory())
-            continue;
-        
-        const std::filesystem::path filePath = std::filesystem::weakly_canonical(file.path()).generic_string();
-        if (filePath.extension() != assetlib::ASSETLIB_METADATA_EXTENSION)
-            continue;
-            
-        auto metadataRead = assetlib::io::readBaseAssetMetadata(filePath);
-        if (!metadataRead.has_value())
-            continue;
+        std::scoped_lock lock(m_AssetIndexMutex);
+        scanned = assetlib::io::scanAssetDirectory(path, &m_AssetIndex, assetlib::io::AssetDirectoryScanMode::Parallel);
+    }
 
+    /* the managers are not thread safe, so the scan result is merged serially, in the order of metadata paths */
+    for (auto& entry : scanned.Entries)
+    {
+        const std::filesystem::path metadataPath = entry.MetadataPath;
         for (auto& manager : m_Managers | std::views::values)
-            if (manager->AddManaged(*metadataRead, filePath))
-                RegisterAsset(filePath, *metadataRead);
+            if (manager->AddManaged(entry.Metadata, metadataPath))
+                RegisterAsset(metadataPath, entry.Metadata);
     }
+
+    UpdateAssetIndex(path, std::move(scanned));
 }
 
 void AssetSystem::RegisterAsset(const std::filesystem::path& metadataPath, const assetlib::AssetMetadata& metadata)
@@ -125,17 +163,32 @@ assetlib::AssetId AssetSystem::ResolveMetaPath(const std::filesystem::path& path
     return m_IdResolver.ResolveMetaPath(path);
 }
 
-bool AssetSystem::AddImportRequest(AssetImportRequest&& request)
+AssetImportTaskId AssetSystem::AddImportRequest(AssetImportRequest&& request)
 {
     return m_ImportQueue.AddRequest(std::move(request));
 }
 
+bool AssetSystem::CancelImportRequest(AssetImportTaskId task)
+{
+    return m_ImportQueue.Cancel(task);
+}
+
 AssetSystemFileLockGuard AssetSystem::LockAssetFile(const std::filesystem::path& assetPath,
     const import::Importer& importer)
 {
     return AssetSystemFileLockGuard(assetPath, importer.GetMetaPath(assetPath), m_AssetSystemFileLocker);
 }
 
+std::shared_lock<std::shared_mutex> AssetSystem::LockAssetRead(const std::filesystem::path& assetPath)
+{
+    return m_AssetAccessLocks.LockRead(assetPath);
+}
+
+std::unique_lock<std::shared_mutex> AssetSystem::LockAssetWrite(const std::filesystem::path& assetPath)
+{
+    return m_AssetAccessLocks.LockWrite(assetPath);
+}
+
 void AssetSystem::InitFileWatcher(const std::filesystem::path& path)
 {
     m_FileWatcher = std::make_unique<FileWatcher>();
@@ -165,8 +218,39 @@ void AssetSystem::InitFileWatcher(const std::filesystem::path& path)
         path.string(), FileWatcher::ErrorDescription(res.error()));
 }
 
+void AssetSystem::UpdateAssetIndex(const std::filesystem::path& directory,
+    assetlib::io::AssetDirectoryIndex&& scanned)
+{
+    std::string prefix = fs::weakly_canonical(directory).generic_string();
+    if (!prefix.ends_with('/'))
+        prefix.push_back('/');
+
+    std::scoped_lock lock(m_AssetIndexMutex);
+    std::erase_if(m_AssetIndex.Entries, [&prefix](const assetlib::io::AssetDirectoryIndexEntry& entry) {
+        return entry.MetadataPath.starts_with(prefix);
+    });
+    m_AssetIndex.Entries.insert(m_AssetIndex.Entries.end(),
+        std::make_move_iterator(scanned.Entries.begin()), std::make_move_iterator(scanned.Entries.end()));
+    std::ranges::sort(m_AssetIndex.Entries, {}, &assetlib::io::AssetDirectoryIndexEntry::MetadataPath);
+    m_IsAssetIndexDirty = true;
+}
+
+void AssetSystem::WriteAssetIndex()
+{
+    std::scoped_lock lock(m_AssetIndexMutex);
+    if (!m_IsAssetIndexDirty || m_AssetIndexPath.empty())
+        return;
+    
+    if (const auto written = assetlib::io::writeAssetDirectoryIndex(m_AssetIndexPath, m_AssetIndex);
+        !written.has_value())
+        LUX_LOG_WARN("Failed to write asset index. Error: {}", written.error());
+    m_IsAssetIndexDirty = false;
+}
+
 void AssetSystem::OnFileModified(const std::filesystem::path& path)
 {
+    /* the io keeps the baked files mapped between the reads */
+    m_Ctx->Io->OnFileModified(fs::weakly_canonical(path));
     if (m_AssetSystemFileLocker.HasLock(path))
         return;
     
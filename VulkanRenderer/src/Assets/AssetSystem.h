@@ -3,8 +3,11 @@
 #include "AssetIdResolver.h"
 #include "AssetManager.h"
 
+#include <AssetLib/Io/AssetDirectoryIndex.h>
 #include <CoreLib/Platform/FileWatcher.h>
 
+#include <shared_mutex>
+
 namespace lux
 {
 namespace import
@@ -60,6 +63,23 @@ private:
     AssetSystemFileLocker* m_Locker{nullptr};
 };
 
+/* imports run on several workers, so the imports that read the baked files of an asset (mipmap streaming)
+ * take a shared lock, and the imports that may bake them (loads and reimports) take an exclusive lock */
+class AssetAccessLocks
+{
+public:
+    std::shared_lock<std::shared_mutex> LockRead(const std::filesystem::path& rawPath);
+    std::unique_lock<std::shared_mutex> LockWrite(const std::filesystem::path& rawPath);
+
+private:
+    std::shared_mutex& GetMutex(const std::filesystem::path& rawPath);
+
+private:
+    std::mutex m_Mutex;
+    /* the mutexes are never removed, there is one per accessed asset */
+    std::unordered_map<std::string, std::unique_ptr<std::shared_mutex>> m_Locks;
+};
+
 class AssetSystem
 {
 public:
@@ -67,6 +87,8 @@ public:
     void Shutdown();
     void RegisterAssetManager(assetlib::AssetType type, AssetManager& manager);
     void SetAssetsDirectory(const std::filesystem::path& path);
+    /* the scan result is cached in this file, so the unchanged metadata files are not parsed on the next run */
+    void SetAssetIndexPath(const std::filesystem::path& path);
     void ScanAssetsDirectory();
     void ScanAssetsDirectory(const std::filesystem::path& path);
     void RegisterAsset(const std::filesystem::path& metadataPath, const assetlib::AssetMetadata& metadata);
@@ -80,8 +102,13 @@ public:
 
     const AssetIdResolver::AssetInfo* Resolve(assetlib::AssetId id) const;
     assetlib::AssetId ResolveMetaPath(const std::filesystem::path& path) const;
-    bool AddImportRequest(AssetImportRequest&& request);
+    AssetImportTaskId AddImportRequest(AssetImportRequest&& request);
+    bool CancelImportRequest(AssetImportTaskId task);
     AssetSystemFileLockGuard LockAssetFile(const std::filesystem::path& assetPath, const import::Importer& importer);
+    /* the locks must not be held while taking the resource lock of a manager,
+     * as the managers load the assets with their resource lock taken */
+    std::shared_lock<std::shared_mutex> LockAssetRead(const std::filesystem::path& assetPath);
+    std::unique_lock<std::shared_mutex> LockAssetWrite(const std::filesystem::path& assetPath);
 
     const std::filesystem::path& GetAssetsDirectory() const { return m_AssetsDirectory; }
     const std::shared_ptr<import::Context>& GetContext() const { return m_Ctx; }
@@ -89,6 +116,9 @@ public:
 private:
     void InitFileWatcher(const std::filesystem::path& path);
     void OnFileModified(const std::filesystem::path& path);
+    void UpdateAssetIndex(const std::filesystem::path& directory, assetlib::io::AssetDirectoryIndex&& scanned);
+    /* the index is written once after the startup scan and once at shutdown, not after every scan */
+    void WriteAssetIndex();
 
 private:
     std::unordered_map<assetlib::AssetType, AssetManager*> m_Managers;
@@ -98,12 +128,18 @@ private:
     FileWatcherHandler m_FileWatcherHandler;
 
     std::filesystem::path m_AssetsDirectory{};
+    std::filesystem::path m_AssetIndexPath{};
+    /* scenes scan their directories after baking, on the import thread */
+    assetlib::io::AssetDirectoryIndex m_AssetIndex{};
+    bool m_IsAssetIndexDirty{false};
+    std::mutex m_AssetIndexMutex;
     std::shared_ptr<import::Context> m_Ctx{nullptr};
 
     std::unordered_map<assetlib::AssetType, AssetUpdatedSignal> m_AssetUpdatedSignals;
 
     AssetImportQueue m_ImportQueue;
     AssetSystemFileLocker m_AssetSystemFileLocker;
+    AssetAccessLocks m_AssetAccessLocks;
 };
 
 template <typename ResourceAssetManager> requires std::is_base_of_v<AssetManager, ResourceAssetManager>
@@ -8,12 +8,63 @@
 #include "Rendering/DeletionQueue.h"
 #include "Rendering/Image/ImageUtility.h"
 #include "Vulkan/Device.h"
+#include "cvars/CVarSystem.h"
 
 #include <AssetLib/Images/ImageMeta.h>
 #include <AssetImportLib/Importers/Images/ImageImporter.h>
 
 namespace lux
 {
+namespace
+{
+/* the mipmaps up to this size are loaded with the image, the larger ones are streamed */
+constexpr u32 STREAMED_TAIL_SIZE = 64;
+
+bool isStreamable(const assetlib::ImageHeader& header)
+{
+    return
+        header.Kind == assetlib::ImageKind::Image2d &&
+        !header.GenerateMipmaps &&
+        header.Mipmaps > 1 &&
+        std::max(header.Width, header.Height) > STREAMED_TAIL_SIZE;
+}
+
+u32 streamedTailMip(const assetlib::ImageHeader& header)
+{
+    u32 mip = 0;
+    while (mip + 1 < header.Mipmaps && std::max(header.Width >> mip, header.Height >> mip) > STREAMED_TAIL_SIZE)
+        mip++;
+
+    return mip;
+}
+
+ImageAsset createImage(const assetlib::ImageAsset& imageAsset)
+{
+    u32 layersDepth = imageAsset.Header.Layers;
+    i8 mips = (i8)imageAsset.Header.Mipmaps;
+    if (imageAsset.Header.Kind == assetlib::ImageKind::Image3d)
+        layersDepth = imageAsset.Header.Depth;
+    if (imageAsset.Header.GenerateMipmaps)
+        mips = imageAsset.Header.Kind == assetlib::ImageKind::Image3d ?
+           images::mipmapCount({imageAsset.Header.Width, imageAsset.Header.Height, imageAsset.Header.Depth}) :
+           images::mipmapCount({imageAsset.Header.Width, imageAsset.Header.Height});
+
+    return Device::CreateImage({
+        .DataSource = &imageAsset,
+        .Description = ImageDescription{
+            .Width = imageAsset.Header.Width,
+            .Height = imageAsset.Header.Height,
+            .LayersDepth = layersDepth,
+            .Mipmaps = mips,
+            .Format = formatFromAssetImageFormat(imageAsset.Header.Format),
+            .Kind = imageKindFromAssetImageKind(imageAsset.Header.Kind),
+            .Usage = ImageUsage::Sampled,
+        },
+        .CalculateMipmaps = imageAsset.Header.GenerateMipmaps
+    }, Device::DummyDeletionQueue());
+}
+}
+
 bool ImageAssetManager::AddManaged(const assetlib::AssetMetadata& metadata, const std::filesystem::path&)
 {
     return metadata.Type.Type == assetlib::image::ASSET_TYPE;
@@ -36,6 +87,10 @@ void ImageAssetManager::OnFileModified(const std::filesystem::path& path)
 
 void ImageAssetManager::Shutdown()
 {
+    for (auto& mipmaps : m_StreamedMipmaps.TakeCompleted())
+        if (mipmaps.Result->Texture.HasValue())
+            Device::Destroy(mipmaps.Result->Texture);
+    
     for (ImageHandle handle : m_Images | std::views::values |
          std::views::filter([this](const ImageHandle handle) { return GetAsset(handle).HasValue(); }))
         Device::Destroy(GetAsset(handle));
@@ -44,6 +99,22 @@ void ImageAssetManager::Shutdown()
 void ImageAssetManager::OnFrameBegin(FrameContext& ctx)
 {
     m_FrameDeletionQueue = &ctx.DeletionQueue;
+    m_FrameNumber = ctx.FrameNumberTick;
+
+    HandleStreamedImages();
+}
+
+void ImageAssetManager::RequestScreenSize(ImageHandle image, f32 screenSizePixels)
+{
+    Lock lock(m_ResourceAccessMutex);
+
+    auto it = m_StreamedImages.find(image.Index());
+    if (it == m_StreamedImages.end())
+        return;
+
+    const assetlib::ImageHeader& header = it->second.Header;
+    m_Residency.Request(image.Index(),
+        TextureResidency::EstimateMip(header.Width, header.Height, screenSizePixels), m_FrameNumber);
 }
 
 ImageHandle ImageAssetManager::LoadAsset(const ImageLoadParameters& parameters)
@@ -56,6 +127,11 @@ ImageHandle ImageAssetManager::LoadAsset(const ImageLoadParameters& parameters)
     if (cached.IsValid())
         return cached;
 
+    /* the image is baked if it was not yet */
+    auto assetLock = m_AssetSystem->LockAssetWrite(path);
+    if (parameters.Streamed)
+        return LoadStreamed(importer, path, id);
+
     return m_Images.Add(DoLoad(importer, path), id);
 }
 
@@ -73,6 +149,8 @@ void ImageAssetManager::UnloadAsset(ImageHandle handle)
 
     LUX_LOG_INFO("Unloading image: {}", assetInfo->Path.string());
 
+    m_Residency.Remove(handle.Index());
+    m_StreamedImages.erase(handle.Index());
     m_FrameDeletionQueue->Enqueue(GetAsset(handle));
     m_Images.Erase(handle, id);
 }
@@ -90,7 +168,12 @@ void ImageAssetManager::OnRawFileModified(const std::filesystem::path& path)
             import::ImageImporter importer(m_Ctx, {});
             AssetSystemFileLockGuard fileLock = m_AssetSystem->LockAssetFile(path, importer);
             
-            const ImageAsset newImage = DoLoad(importer, path);
+            ImageAsset newImage = {};
+            {
+                /* the reimport rewrites the baked files that the mipmap streaming reads */
+                auto assetLock = m_AssetSystem->LockAssetWrite(path);
+                newImage = DoLoad(importer, path);
+            }
             if (!newImage.HasValue())
                 return;
 
@@ -109,10 +192,15 @@ void ImageAssetManager::OnRawFileModified(const std::filesystem::path& path)
 
                 m_FrameDeletionQueue->Enqueue(GetAsset(cached));
                 m_Images[cached.Index()] = newImage;
+                /* the reloaded image has all of its mipmaps */
+                m_Residency.Remove(cached.Index());
+                m_StreamedImages.erase(cached.Index());
             }
 
             m_AssetSystem->NotifyAssetUpdate(assetlib::image::ASSET_TYPE, {.AssetHandle = cached});
-        }
+        },
+        .Priority = AssetImportPriority::Background,
+        .Key = path.generic_string()
     });
 }
 
@@ -126,31 +214,141 @@ ImageAsset ImageAssetManager::DoLoad(import::ImageImporter& importer, const std:
         LUX_LOG_ERROR("Failed to load image: {} ({})", imported.error(), path.string());
         return {};
     }
-    auto& imageAsset = importer.GetImportedImage().Asset;
+    
+    return createImage(importer.GetImportedImage().Asset);
+}
 
-    u32 layersDepth = imageAsset.Header.Layers;
-    i8 mips = (i8)imageAsset.Header.Mipmaps;
-    if (imageAsset.Header.Kind == assetlib::ImageKind::Image3d)
-        layersDepth = imageAsset.Header.Depth;
-    if (imageAsset.Header.GenerateMipmaps)
-        mips = imageAsset.Header.Kind == assetlib::ImageKind::Image3d ?
-           images::mipmapCount({imageAsset.Header.Width, imageAsset.Header.Height, imageAsset.Header.Depth}) :
-           images::mipmapCount({imageAsset.Header.Width, imageAsset.Header.Height});
+ImageHandle ImageAssetManager::LoadStreamed(import::ImageImporter& importer, const std::filesystem::path& path,
+    assetlib::AssetId id)
+{
+    auto imported = importer.Import(path, import::ImportFlags::BakeIfNotBaked | import::ImportFlags::Header);
+    if (!imported.has_value())
+    {
+        LUX_LOG_ERROR("Failed to load image: {} ({})", imported.error(), path.string());
+        return m_Images.Add({}, id);
+    }
+    const assetlib::ImageHeader& header = importer.GetImportedImage().Asset.Header;
+    if (!isStreamable(header))
+        return m_Images.Add(DoLoad(importer, path), id);
 
-    const Image image = Device::CreateImage({
-        .DataSource = &imageAsset,
-        .Description = ImageDescription{
-            .Width = imageAsset.Header.Width,
-            .Height = imageAsset.Header.Height,
-            .LayersDepth = layersDepth,
-            .Mipmaps = mips,
-            .Format = formatFromAssetImageFormat(imageAsset.Header.Format),
-            .Kind = imageKindFromAssetImageKind(imageAsset.Header.Kind),
-            .Usage = ImageUsage::Sampled,
-        },
-        .CalculateMipmaps = imageAsset.Header.GenerateMipmaps
-    }, Device::DummyDeletionQueue());
+    LUX_LOG_INFO("Loading image: {} (streamed)", path.string());
+
+    const u32 tailMip = streamedTailMip(header);
+    const ImageHandle handle = m_Images.Add(LoadMipmapTail(header, importer.GetImportedAssetMetadata(), tailMip), id);
+    if (!GetAsset(handle).HasValue())
+        return handle;
+    
+    std::vector<u64> mipSizes(header.Mipmaps);
+    for (u32 mip = 0; mip < header.Mipmaps; mip++)
+        for (const u64 layerSize : header.MipmapSizes[mip])
+            mipSizes[mip] += layerSize;
+    m_Residency.Add(handle.Index(), std::move(mipSizes), tailMip);
+    m_StreamedImages.emplace(handle.Index(), StreamedImage{
+        .Handle = handle,
+        .Header = header,
+        .Metadata = importer.GetImportedAssetMetadata()
+    });
+
+    return handle;
+}
+
+ImageAsset ImageAssetManager::LoadMipmapTail(const assetlib::ImageHeader& header,
+    const assetlib::AssetMetadata& metadata, u32 firstMipmap) const
+{
+    assetlib::ImageAsset tail = {.Header = header};
+    tail.Header.Width = std::max(1u, header.Width >> firstMipmap);
+    tail.Header.Height = std::max(1u, header.Height >> firstMipmap);
+    tail.Header.Mipmaps = header.Mipmaps - firstMipmap;
+    tail.Header.MipmapSizes.erase(tail.Header.MipmapSizes.begin(), tail.Header.MipmapSizes.begin() + firstMipmap);
+    tail.MipmapsImageData.resize(tail.Header.Mipmaps);
+    for (u32 mip = 0; mip < tail.Header.Mipmaps; mip++)
+    {
+        tail.MipmapsImageData[mip].resize(header.Layers);
+        for (u32 layer = 0; layer < header.Layers; layer++)
+        {
+            auto imageData = assetlib::image::readImageData(header, metadata, firstMipmap + mip, layer,
+                *m_Ctx->Io, *m_Ctx->Compressor);
+            if (!imageData.has_value())
+            {
+                LUX_LOG_ERROR("Failed to load image mipmap {}: {} ({})", firstMipmap + mip, imageData.error(),
+                    metadata.Io.BinaryFile.string());
+                return {};
+            }
+            tail.MipmapsImageData[mip][layer] = std::move(*imageData);
+        }
+    }
+
+    return createImage(tail);
+}
+
+void ImageAssetManager::HandleStreamedImages()
+{
+    std::vector<ImageHandle> updatedImages;
+    {
+        Lock lock(m_ResourceAccessMutex);
+
+        for (auto& [request, mipmaps] : m_StreamedMipmaps.TakeCompleted())
+        {
+            auto it = m_StreamedImages.find(mipmaps->ImageIndex);
+            const bool isOutdated = it == m_StreamedImages.end() || it->second.StreamRequest != request;
+            if (isOutdated)
+            {
+                if (mipmaps->Texture.HasValue())
+                    m_FrameDeletionQueue->Enqueue(mipmaps->Texture);
+                continue;
+            }
+            /* keep the mipmaps that are resident, the residency will retry the change later */
+            if (!mipmaps->Texture.HasValue())
+            {
+                m_Residency.OnResident(mipmaps->ImageIndex, m_Residency.GetResidentMip(mipmaps->ImageIndex));
+                continue;
+            }
 
-    return image;
+            m_FrameDeletionQueue->Enqueue(GetAsset(it->second.Handle));
+            m_Images[mipmaps->ImageIndex] = mipmaps->Texture;
+            m_Residency.OnResident(mipmaps->ImageIndex, mipmaps->ResidentMip);
+            updatedImages.push_back(it->second.Handle);
+        }
+
+        const TextureResidency::Config config = {
+            /* the budget is in MiB, so that it can exceed the range of the i32 cvar */
+            .VramBudgetBytes =
+                (u64)std::max(CVars::Get().GetI32CVar("Textures.Streaming.VramBudgetMiB"_hsv).value_or(0), 0) << 20,
+            .UploadBudgetBytes = 
+                (u64)CVars::Get().GetI32CVar("Textures.Streaming.UploadBudgetBytes"_hsv).value_or(0),
+        };
+        for (auto& change : m_Residency.Update(m_FrameNumber, config))
+            StreamMipmaps(change.Texture, change.ResidentMip);
+    }
+
+    /* updates the descriptors that reference the images */
+    for (const ImageHandle image : updatedImages)
+        m_AssetSystem->NotifyAssetUpdate(assetlib::image::ASSET_TYPE, {.AssetHandle = image});
+}
+
+void ImageAssetManager::StreamMipmaps(u32 imageIndex, u32 residentMip)
+{
+    StreamedImage& streamed = m_StreamedImages.at(imageIndex);
+    const u64 request = ++m_StreamRequestCount;
+    streamed.StreamRequest = request;
+
+    m_StreamedMipmaps.Begin(request);
+    m_AssetSystem->AddImportRequest({
+        .ImportFn = [this, request, imageIndex, residentMip, header = streamed.Header, metadata = streamed.Metadata]()
+        {
+            ImageAsset texture = {};
+            {
+                auto assetLock = m_AssetSystem->LockAssetRead(metadata.Io.OriginalFile);
+                texture = LoadMipmapTail(header, metadata, residentMip);
+            }
+            m_StreamedMipmaps.Complete(request, StreamedMipmaps{
+                .ImageIndex = imageIndex,
+                .Texture = texture,
+                .ResidentMip = residentMip
+            });
+        },
+        /* the mipmap tail is already resident, the streamed mipmaps only make the texture sharper */
+        .Priority = AssetImportPriority::Prefetch
+    });
 }
 }
@@ -1,9 +1,13 @@
 ﻿#pragma once
 
 #include "ImageAsset.h"
+#include "TextureResidency.h"
 #include "Assets/AssetManager.h"
+#include "Assets/AssetStreamingQueue.h"
 #include "Assets/Common/AssetFreeListMap.h"
 
+#include <AssetLib/Images/ImageAsset.h>
+
 #include <AssetImportLib/Importers/ImportContext.h>
 
 struct FrameContext;
@@ -19,6 +23,8 @@ template <>
 struct ResourceAssetLoadParameters<ImageAsset>
 {
     std::filesystem::path Path{};
+    /* only the smallest mipmaps are loaded, the rest is streamed in on request (see `RequestScreenSize`) */
+    bool Streamed{false};
 };
 
 using ImageLoadParameters = ResourceAssetLoadParameters<ImageAsset>;
@@ -35,6 +41,9 @@ public:
     void Shutdown();
 
     void OnFrameBegin(FrameContext& ctx);
+    /* requests the mipmap of a streamed image, that has about one texel per pixel when the image covers
+     * `screenSizePixels`, the request is valid for a number of frames */
+    void RequestScreenSize(ImageHandle image, f32 screenSizePixels);
 
 protected:
     ImageHandle LoadAsset(const ImageLoadParameters& parameters) override;
@@ -44,12 +53,40 @@ protected:
 private:
     void OnRawFileModified(const std::filesystem::path& path);
     ImageAsset DoLoad(import::ImageImporter& importer, const std::filesystem::path& path) const;
+    ImageHandle LoadStreamed(import::ImageImporter& importer, const std::filesystem::path& path,
+        assetlib::AssetId id);
+    ImageAsset LoadMipmapTail(const assetlib::ImageHeader& header, const assetlib::AssetMetadata& metadata,
+        u32 firstMipmap) const;
+    void HandleStreamedImages();
+    void StreamMipmaps(u32 imageIndex, u32 residentMip);
 
 private:
     // todo: alternative is to make ImageHandle equivalent to Image (since both are handles)
     // todo: this will require support from Device to swap things (already exists in method `ResizeBuffer`)
     AssetFreeListMap<ImageAsset> m_Images;
 
+    struct StreamedImage
+    {
+        ImageHandle Handle{};
+        assetlib::ImageHeader Header{};
+        assetlib::AssetMetadata Metadata{};
+        /* the results of the outdated stream requests are discarded */
+        u64 StreamRequest{0};
+    };
+    struct StreamedMipmaps
+    {
+        u32 ImageIndex{};
+        /* has no value if the mipmaps failed to load */
+        ImageAsset Texture{};
+        u32 ResidentMip{};
+    };
+    /* indexed by the image index */
+    std::unordered_map<u32, StreamedImage> m_StreamedImages;
+    TextureResidency m_Residency;
+    AssetStreamingQueue<u64, StreamedMipmaps> m_StreamedMipmaps;
+    u64 m_StreamRequestCount{0};
+    u64 m_FrameNumber{0};
+
     /* for hot-reloading */
     DeletionQueue* m_FrameDeletionQueue{nullptr};
 };
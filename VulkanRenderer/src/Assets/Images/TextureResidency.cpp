@@ -0,0 +1,187 @@
+﻿#include "rendererpch.h"
+#include "TextureResidency.h"
+
+#include "Assets/AssetStreamingQueue.h"
+
+namespace lux
+{
+void TextureResidency::Add(u32 texture, std::vector<u64>&& mipSizes, u32 tailMip)
+{
+    ASSERT(!mipSizes.empty())
+    ASSERT(!m_Textures.contains(texture))
+    
+    TextureInfo info = {};
+    info.TailSizes.resize(mipSizes.size());
+    u64 tailSize = 0;
+    for (u32 mip = (u32)mipSizes.size(); mip > 0; mip--)
+    {
+        tailSize += mipSizes[mip - 1];
+        info.TailSizes[mip - 1] = tailSize;
+    }
+    info.TailMip = std::min(tailMip, (u32)mipSizes.size() - 1);
+    info.ResidentMip = info.TailMip;
+    info.TargetMip = info.TailMip;
+    info.RequestedMip = info.TailMip;
+    
+    m_ResidentBytes += info.TailSizes[info.TailMip];
+    m_Textures.emplace(texture, std::move(info));
+}
+
+void TextureResidency::Remove(u32 texture)
+{
+    auto it = m_Textures.find(texture);
+    if (it == m_Textures.end())
+        return;
+
+    m_ResidentBytes -= it->second.TailSizes[it->second.TargetMip];
+    m_Textures.erase(it);
+}
+
+void TextureResidency::Request(u32 texture, u32 mip, u64 frame)
+{
+    auto it = m_Textures.find(texture);
+    if (it == m_Textures.end())
+        return;
+
+    TextureInfo& info = it->second;
+    mip = std::min(mip, info.TailMip);
+    if (!info.HasRequest || info.RequestFrame != frame)
+        info.RequestedMip = mip;
+    else
+        info.RequestedMip = std::min(info.RequestedMip, mip);
+    info.RequestFrame = frame;
+    info.HasRequest = true;
+}
+
+void TextureResidency::OnResident(u32 texture, u32 residentMip)
+{
+    auto it = m_Textures.find(texture);
+    if (it == m_Textures.end())
+        return;
+
+    TextureInfo& info = it->second;
+    info.ResidentMip = std::min(residentMip, info.TailMip);
+    SetTarget(info, info.ResidentMip);
+}
+
+std::vector<TextureResidency::Change> TextureResidency::Update(u64 frame, const Config& config)
+{
+    std::vector<Change> changes;
+    
+    /* the budget might have been lowered */
+    if (m_ResidentBytes > config.VramBudgetBytes)
+        Evict(frame, config, 0, ~0u, changes);
+
+    std::vector<std::pair<u32, TextureInfo*>> toStream;
+    for (auto& [texture, info] : m_Textures)
+        if (info.ResidentMip == info.TargetMip && GetDesiredMip(info, frame, config) < info.TargetMip)
+            toStream.emplace_back(texture, &info);
+    
+    /* the most recently requested textures that are the furthest from their desired mipmap go first */
+    std::ranges::sort(toStream, [&](const auto& a, const auto& b) {
+        const TextureInfo& aInfo = *a.second;
+        const TextureInfo& bInfo = *b.second;
+        if (aInfo.RequestFrame != bInfo.RequestFrame)
+            return aInfo.RequestFrame > bInfo.RequestFrame;
+        const u32 aMissing = aInfo.TargetMip - GetDesiredMip(aInfo, frame, config);
+        const u32 bMissing = bInfo.TargetMip - GetDesiredMip(bInfo, frame, config);
+        if (aMissing != bMissing)
+            return aMissing > bMissing;
+        
+        return a.first < b.first;
+    });
+
+    AssetUploadBudget uploadBudget = {.BudgetBytes = config.UploadBudgetBytes};
+    for (auto& [texture, info] : toStream)
+    {
+        if (info->ResidentMip != info->TargetMip)
+            continue;
+        
+        const u32 nextMip = info->TargetMip - 1;
+        const u64 addedBytes = info->TailSizes[nextMip] - info->TailSizes[info->TargetMip];
+        if (m_ResidentBytes + addedBytes > config.VramBudgetBytes)
+            Evict(frame, config, addedBytes, texture, changes);
+        if (m_ResidentBytes + addedBytes > config.VramBudgetBytes)
+            continue;
+        if (!uploadBudget.TrySpend(info->TailSizes[nextMip]))
+            break;
+
+        SetTarget(*info, nextMip);
+        changes.push_back({.Texture = texture, .ResidentMip = nextMip});
+    }
+
+    return changes;
+}
+
+u32 TextureResidency::GetResidentMip(u32 texture) const
+{
+    auto it = m_Textures.find(texture);
+    if (it == m_Textures.end())
+        return 0;
+
+    return it->second.ResidentMip;
+}
+
+u32 TextureResidency::EstimateMip(u32 width, u32 height, f32 screenSizePixels)
+{
+    const f32 texels = (f32)std::max(width, height);
+    if (screenSizePixels >= texels)
+        return 0;
+
+    return (u32)std::log2(texels / std::max(screenSizePixels, 1.0f));
+}
+
+u32 TextureResidency::GetDesiredMip(const TextureInfo& texture, u64 frame, const Config& config) const
+{
+    if (!texture.HasRequest || frame > texture.RequestFrame + config.RequestLifetimeFrames)
+        return texture.TailMip;
+
+    return texture.RequestedMip;
+}
+
+void TextureResidency::SetTarget(TextureInfo& texture, u32 mip)
+{
+    m_ResidentBytes = m_ResidentBytes - texture.TailSizes[texture.TargetMip] + texture.TailSizes[mip];
+    texture.TargetMip = mip;
+}
+
+void TextureResidency::Evict(u64 frame, const Config& config, u64 bytesToFit, u32 keep,
+    std::vector<Change>& changes)
+{
+    auto fits = [&]() { return m_ResidentBytes + bytesToFit <= config.VramBudgetBytes; };
+    
+    std::vector<std::pair<u32, TextureInfo*>> candidates;
+    for (auto& [texture, info] : m_Textures)
+        if (texture != keep && info.ResidentMip == info.TargetMip && info.TargetMip < info.TailMip)
+            candidates.emplace_back(texture, &info);
+    std::ranges::sort(candidates, [](const auto& a, const auto& b) {
+        if (a.second->RequestFrame != b.second->RequestFrame)
+            return a.second->RequestFrame < b.second->RequestFrame;
+
+        return a.first < b.first;
+    });
+
+    /* the mipmaps that are not desired anymore are evicted first, and only then the desired ones,
+     * but the desired ones are evicted only to fit into the budget, and not to stream other textures in */
+    const bool evictDesired = bytesToFit == 0;
+    for (u32 pass = 0; pass < (evictDesired ? 2u : 1u) && !fits(); pass++)
+    {
+        for (auto& [texture, info] : candidates)
+        {
+            if (fits())
+                break;
+            
+            const u32 minMip = pass == 0 ? GetDesiredMip(*info, frame, config) : info->TailMip;
+            const u32 originalMip = info->TargetMip;
+            while (!fits() && info->TargetMip < minMip)
+                SetTarget(*info, info->TargetMip + 1);
+            
+            if (info->TargetMip == originalMip)
+                continue;
+            
+            std::erase_if(changes, [texture](const Change& change) { return change.Texture == texture; });
+            changes.push_back({.Texture = texture, .ResidentMip = info->TargetMip});
+        }
+    }
+}
+}
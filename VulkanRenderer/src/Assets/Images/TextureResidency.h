@@ -0,0 +1,69 @@
+﻿#pragma once
+
+#include <CoreLib/types.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace lux
+{
+/* decides which mipmaps of the streamed textures are resident,
+ * the resident mipmaps of a texture are always a tail: all the mipmaps starting from `ResidentMip`,
+ * so the textures are streamed in from the smallest mipmap up, one mipmap per change */
+class TextureResidency
+{
+public:
+    struct Config
+    {
+        u64 VramBudgetBytes{0};
+        /* io and upload budget of a single frame, a change reuploads the whole tail of mipmaps */
+        u64 UploadBudgetBytes{0};
+        /* number of frames the requested mipmap is kept as desired after the last request */
+        u32 RequestLifetimeFrames{60};
+    };
+    struct Change
+    {
+        u32 Texture{0};
+        u32 ResidentMip{0};
+    };
+public:
+    /* `mipSizes` are the sizes of all layers of each mipmap, the finest mipmap first;
+     * `tailMip` is the finest mipmap that is never evicted, and it is initially resident */
+    void Add(u32 texture, std::vector<u64>&& mipSizes, u32 tailMip);
+    void Remove(u32 texture);
+    bool Contains(u32 texture) const { return m_Textures.contains(texture); }
+    /* the smallest requested mipmap of a frame wins */
+    void Request(u32 texture, u32 mip, u64 frame);
+    /* the changes returned by `Update` are pending until they are applied */
+    void OnResident(u32 texture, u32 residentMip);
+    std::vector<Change> Update(u64 frame, const Config& config);
+    
+    u32 GetResidentMip(u32 texture) const;
+    /* includes the pending changes */
+    u64 GetResidentBytes() const { return m_ResidentBytes; }
+
+    /* the mipmap with about one texel per pixel, for a texture that covers `screenSizePixels` */
+    static u32 EstimateMip(u32 width, u32 height, f32 screenSizePixels);
+private:
+    struct TextureInfo
+    {
+        /* `TailSizes[i]` is the size of all the mipmaps starting from `i` */
+        std::vector<u64> TailSizes{};
+        u32 TailMip{0};
+        u32 ResidentMip{0};
+        /* equals to `ResidentMip` if there is no pending change */
+        u32 TargetMip{0};
+        u32 RequestedMip{0};
+        u64 RequestFrame{0};
+        bool HasRequest{false};
+    };
+    
+    u32 GetDesiredMip(const TextureInfo& texture, u64 frame, const Config& config) const;
+    void SetTarget(TextureInfo& texture, u32 mip);
+    /* evicts the mipmaps of the least recently requested textures, except `keep` */
+    void Evict(u64 frame, const Config& config, u64 bytesToFit, u32 keep, std::vector<Change>& changes);
+private:
+    std::unordered_map<u32, TextureInfo> m_Textures;
+    u64 m_ResidentBytes{0};
+};
+}
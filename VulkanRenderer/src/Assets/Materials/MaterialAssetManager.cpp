@@ -141,6 +141,6 @@ ImageHandle MaterialAssetManager::LoadTexture(assetlib::AssetId imageAsset) cons
     if (imageInfo == nullptr)
         return {};
 
-    return m_ImageAssetManager->LoadResource({.Path = imageInfo->Path});
+    return m_ImageAssetManager->LoadResource({.Path = imageInfo->Path, .Streamed = true});
 }
 }
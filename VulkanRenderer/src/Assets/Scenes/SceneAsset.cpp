@@ -3,6 +3,8 @@
 
 #include "Light/Light.h"
 
+#include <AssetLib/Scenes/GeometryBuffer/GeometryBufferAsset.h>
+
 namespace lux
 {
 void SceneLightInfo::SetSunLight(const DirectionalLight& light)
@@ -39,6 +41,114 @@ void SceneLightInfo::AddLight(const PointLight& light)
     });
 }
 
+u32 SceneGeometryInfo::AddStreamRange(SceneGeometryStreamType stream, u32 buffer, u64 offsetBytes,
+    u32 elementCount)
+{
+    auto& [streamElementCount, ranges] = Streams[(u32)stream];
+    const u32 firstElement = streamElementCount;
+    const u64 sizeBytes = (u64)elementCount * STREAM_ELEMENT_SIZES[(u32)stream];
+    streamElementCount += elementCount;
+
+    /* the accessors of a baked buffer usually follow each other, so the whole stream is a single range */
+    if (!ranges.empty() && ranges.back().Buffer == buffer &&
+        ranges.back().OffsetBytes + ranges.back().SizeBytes == offsetBytes)
+    {
+        ranges.back().SizeBytes += sizeBytes;
+        return firstElement;
+    }
+    
+    ranges.push_back({
+        .Buffer = buffer,
+        .OffsetBytes = offsetBytes,
+        .SizeBytes = sizeBytes
+    });
+    
+    return firstElement;
+}
+
+u32 SceneGeometryInfo::AddStreamData(SceneGeometryStreamType stream, std::vector<std::byte>&& data)
+{
+    ASSERT(data.size() % STREAM_ELEMENT_SIZES[(u32)stream] == 0)
+    
+    auto& [streamElementCount, ranges] = Streams[(u32)stream];
+    const u32 firstElement = streamElementCount;
+    streamElementCount += (u32)(data.size() / STREAM_ELEMENT_SIZES[(u32)stream]);
+    ranges.push_back({
+        .SizeBytes = data.size(),
+        .OwnedData = std::move(data)
+    });
+
+    return firstElement;
+}
+
+u64 SceneGeometryInfo::GetStreamSizeBytes(SceneGeometryStreamType stream) const
+{
+    return (u64)Streams[(u32)stream].ElementCount * STREAM_ELEMENT_SIZES[(u32)stream];
+}
+
+u64 SceneGeometryInfo::GetUploadSizeBytes() const
+{
+    u64 sizeBytes = Meshlets.size() * sizeof(assetlib::SceneAssetMeshlet) + Materials.size() * sizeof(MaterialGPU);
+    for (u32 stream = 0; stream < (u32)SceneGeometryStreamType::MaxVal; stream++)
+        sizeBytes += GetStreamSizeBytes((SceneGeometryStreamType)stream);
+
+    return sizeBytes;
+}
+
+u64 SceneGeometryInfo::GetInstanceUploadSizeBytes() const
+{
+    u64 sizeBytes = RenderObjects.size() * sizeof(RenderObjectGPU) + Skins.size() * sizeof(SkinGPU) +
+        BlendShapes.size() * sizeof(BlendShapeGPU);
+    for (auto& skin : SkinJoints)
+        sizeBytes += skin.JointNodes.size() * sizeof(glm::mat4);
+    for (auto& renderObject : RenderObjects)
+    {
+        if (renderObject.SkinIndex == SceneRenderObject::INVALID && renderObject.BlendShapeCount == 0)
+            continue;
+
+        sizeBytes += sizeof(RenderObjectSkinnedInfoGPU) +
+            (u64)renderObject.VertexCount * sizeof(SkinnedVertexGPU) +
+            (u64)renderObject.MeshletCount * sizeof(MeshletBoundsGPU);
+    }
+
+    return sizeBytes;
+}
+
+bool SceneGeometryInfo::ReadStream(SceneGeometryStreamType stream, Span<std::byte> destination) const
+{
+    ASSERT(destination.size() >= GetStreamSizeBytes(stream))
+    
+    u64 offsetBytes = 0;
+    for (auto& range : Streams[(u32)stream].Ranges)
+    {
+        std::byte* rangeDestination = destination.data() + offsetBytes;
+        offsetBytes += range.SizeBytes;
+        
+        if (range.Buffer == SceneGeometryStreamRange::OWNED)
+        {
+            std::memcpy(rangeDestination, range.OwnedData.data(), range.SizeBytes);
+            continue;
+        }
+
+        auto& buffer = Buffers[range.Buffer];
+        if (buffer.Data)
+        {
+            std::memcpy(rangeDestination, buffer.Data->data() + range.OffsetBytes, range.SizeBytes);
+            continue;
+        }
+        
+        auto read = assetlib::sceneGeometry::readBufferDataRange(buffer.Header, buffer.Metadata,
+            *buffer.Io, *buffer.Compressor, range.OffsetBytes, Span(rangeDestination, range.SizeBytes));
+        if (!read.has_value())
+        {
+            LUX_LOG_ERROR("Failed to read geometry stream: {}", read.error());
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void SceneAsset::SetSunLight(const DirectionalLight& light)
 {
     const u32 lightIndex = (u32)Lights.Lights.size();
@@ -81,6 +191,34 @@ void SceneAsset::AddLight(const PointLight& light)
     });
 }
 
+u16 SpotLightData::QuantizeAngle(f32 angle)
+{
+    const f32 normalized = std::clamp(angle / (std::numbers::pi_v<f32> / 2.0f), 0.0f, 1.0f);
+
+    return (u16)std::round(normalized * std::numeric_limits<u16>::max());
+}
+
+f32 SpotLightData::DequantizeAngle(u16 angle)
+{
+    return (f32)angle / std::numeric_limits<u16>::max() * (std::numbers::pi_v<f32> / 2.0f);
+}
+
+namespace
+{
+/* `quatLookAt` degenerates when the direction is parallel to its up vector,
+ * which is the case for the spot lights that point straight down or up */
+glm::quat lookAtDirection(const glm::vec3& direction)
+{
+    static constexpr glm::vec3 UP = glm::vec3(0.0f, 1.0f, 0.0f);
+    static constexpr glm::vec3 UP_ALTERNATE = glm::vec3(0.0f, 0.0f, 1.0f);
+    static constexpr f32 PARALLEL_COS = 0.999f;
+
+    const glm::vec3 forward = glm::normalize(direction);
+
+    return glm::quatLookAt(forward, std::abs(glm::dot(forward, UP)) > PARALLEL_COS ? UP_ALTERNATE : UP);
+}
+}
+
 Transform3d CommonLight::GetTransform() const
 {
     switch (Type)
@@ -94,8 +232,10 @@ Transform3d CommonLight::GetTransform() const
             .Position = PositionDirection,
         };
     case LightType::Spot:
-        ASSERT(false, "Spot light is not supported")
-        break;
+        return Transform3d {
+            .Position = PositionDirection,
+            .Orientation = lookAtDirection(SpotLightData.Direction),
+        };
     default:
         ASSERT(false, "Light type is not supported")
         break;
@@ -104,6 +244,14 @@ Transform3d CommonLight::GetTransform() const
     std::unreachable();
 }
 
+Cone CommonLight::GetSpotCone() const
+{
+    ASSERT(Type == LightType::Spot, "Only spot lights have a cone")
+
+    return Cone::FromHalfAngle(PositionDirection, SpotLightData.Direction, Radius,
+        SpotLightData::DequantizeAngle(SpotLightData.OuterAngle));
+}
+
 SceneHierarchyAnimationChannel::SceneHierarchyAnimationChannel(SceneHierarchyAnimationChannelType type,
     SceneHierarchyAnimationSamplerType samplerType, u32 elementCount)
     : m_Type(type), m_SamplerType(samplerType), m_KeyframeElementCount(elementCount)
@@ -4,9 +4,12 @@
 #include "Assets/Materials/MaterialAsset.h"
 
 #include <AssetLib/Scenes/Scene/SceneAsset.h>
+#include <AssetLib/Scenes/GeometryBuffer/GeometryBufferAsset.h>
 #include <AssetLib/Scenes/Mesh/MeshAsset.h>
+#include <CoreLib/Math/Geometry.h>
 #include <CoreLib/Math/Transform.h>
 #include <CoreLib/Containers/SlotMapType.h>
+#include <CoreLib/Containers/Span.h>
 
 struct PointLight;
 struct DirectionalLight;
@@ -24,15 +27,57 @@ struct SceneHierarchyNode;
 struct SceneHierarchyAnimation;
 struct SceneHierarchyAnimationChannel;
 
+/* the streams have the same order and element types as the views of a baked geometry buffer */
+enum class SceneGeometryStreamType : u8
+{
+    Position = 0,
+    Normal = 1,
+    Tangent = 2,
+    Uv = 3,
+    Joint = 4,
+    Weight = 5,
+    Index = 6,
+
+    MaxVal = 7,
+};
+
+/* a baked geometry buffer, the stream data is decompressed from it straight into the upload memory */
+struct SceneGeometryBuffer
+{
+    assetlib::AssetMetadata Metadata{};
+    assetlib::GeometryBufferHeader Header{};
+    assetlib::io::AssetIoInterface* Io{nullptr};
+    assetlib::io::AssetCompressor* Compressor{nullptr};
+    /* set only if the compressor cannot decompress a range, so the buffer was decompressed as a whole */
+    std::shared_ptr<const std::vector<std::byte>> Data{};
+};
+
+struct SceneGeometryStreamRange
+{
+    static constexpr u32 OWNED = ~0lu;
+    
+    u32 Buffer{OWNED};
+    u64 OffsetBytes{};
+    u64 SizeBytes{};
+    /* the data that is not in the baked buffer as is (e.g. resolved sparse accessors) */
+    std::vector<std::byte> OwnedData{};
+};
+
+struct SceneGeometryStream
+{
+    u32 ElementCount{};
+    std::vector<SceneGeometryStreamRange> Ranges{};
+};
+
 struct SceneGeometryInfo
 {
-    std::vector<assetlib::SceneAssetIndexType> Indices;
-    std::vector<glm::vec3> Positions;
-    std::vector<glm::vec3> Normals;
-    std::vector<glm::vec4> Tangents;
-    std::vector<glm::vec2> UVs;
-    std::vector<glm::u16vec4> Joints;
-    std::vector<glm::vec4> Weights;
+    static constexpr std::array<u32, (u32)SceneGeometryStreamType::MaxVal> STREAM_ELEMENT_SIZES = {
+        sizeof(glm::vec3), sizeof(glm::vec3), sizeof(glm::vec4), sizeof(glm::vec2),
+        sizeof(glm::u16vec4), sizeof(glm::vec4), sizeof(assetlib::SceneAssetIndexType)
+    };
+    
+    std::vector<SceneGeometryBuffer> Buffers;
+    std::array<SceneGeometryStream, (u32)SceneGeometryStreamType::MaxVal> Streams{};
 
     std::vector<SceneMeshRenderObjects> MeshRenderObjects;
     std::vector<SceneRenderObject> RenderObjects;
@@ -53,6 +98,17 @@ struct SceneGeometryInfo
         u32 OcclusionUvIndex{0};
     };
     std::vector<MaterialInfo> MaterialsCpu;
+
+    /* returns the index of the first added element */
+    u32 AddStreamRange(SceneGeometryStreamType stream, u32 buffer, u64 offsetBytes, u32 elementCount);
+    u32 AddStreamData(SceneGeometryStreamType stream, std::vector<std::byte>&& data);
+    u64 GetStreamSizeBytes(SceneGeometryStreamType stream) const;
+    /* approximate size of the data that is uploaded when the geometry is added to the scene */
+    u64 GetUploadSizeBytes() const;
+    /* approximate size of the data that is uploaded for each instance of the geometry */
+    u64 GetInstanceUploadSizeBytes() const;
+    /* `destination` is usually the mapped upload memory of the stream */
+    bool ReadStream(SceneGeometryStreamType stream, Span<std::byte> destination) const;
 };
 
 struct SceneLightInfo
@@ -147,11 +203,16 @@ enum class LightType : u8
 
 struct SpotLightData
 {
-    /* quantized */
+    /* half angles of the cone, quantized over [0, pi / 2] */
     u16 InnerAngle{};
     u16 OuterAngle{};
+    /* set by the scene hierarchy, together with the position */
+    glm::vec3 Direction{0.0f, 0.0f, -1.0f};
+
+    static u16 QuantizeAngle(f32 angle);
+    static f32 DequantizeAngle(u16 angle);
 
-    auto operator<=>(const SpotLightData&) const = default;
+    bool operator==(const SpotLightData&) const = default;
 };
 
 struct CommonLight
@@ -165,6 +226,8 @@ struct CommonLight
     bool IsSun{false};
 
     Transform3d GetTransform() const;
+    /* volume lit by a spot light, `Radius` is its range */
+    Cone GetSpotCone() const;
 };
 
 struct SceneHierarchyHandle
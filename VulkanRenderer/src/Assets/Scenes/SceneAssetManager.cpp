@@ -77,9 +77,72 @@ SceneHandle SceneAssetManager::AddExternalScene(SceneAsset&& scene)
     return m_Scenes.Add(std::move(scene), {});
 }
 
+SceneHandle SceneAssetManager::LoadResourceAsync(const SceneLoadParameters& parameters)
+{
+    const std::filesystem::path path = weakly_canonical(parameters.Path).generic_string();
+    import::SceneImporter importer(m_Ctx);
+    const assetlib::AssetId id = m_AssetSystem->ResolveMetaPath(importer.GetMetaPath(path));
+
+    Lock lock(m_ResourceAccessMutex);
+    
+    const SceneHandle cached = m_Scenes.Find(id);
+    if (cached.IsValid())
+        return cached;
+
+    const SceneHandle newScene = m_Scenes.Add({}, id);
+    m_StreamedScenes.Begin(newScene);
+    m_AssetSystem->AddImportRequest({
+        .ImportFn = [this, path, newScene]()
+        {
+            import::SceneImporter importer(m_Ctx);
+            AssetSystemFileLockGuard fileLock = m_AssetSystem->LockAssetFile(path, importer);
+            
+            std::optional<SceneAsset> sceneAsset = {};
+            {
+                /* the scene is baked if it was not yet, while a reimport may be rebaking it */
+                auto assetLock = m_AssetSystem->LockAssetWrite(path);
+                sceneAsset = DoLoad(importer, path);
+            }
+            m_StreamedScenes.Complete(newScene, std::move(sceneAsset));
+        }
+    });
+
+    return newScene;
+}
+
+bool SceneAssetManager::IsLoaded(SceneHandle handle) const
+{
+    return handle.IsValid() && !m_StreamedScenes.IsPending(handle);
+}
+
+void SceneAssetManager::RequestTextureMips(SceneHandle handle, Span<const f32> materialScreenSizesPixels) const
+{
+    Lock lock(m_ResourceAccessMutex);
+
+    const auto& materials = m_Scenes[handle].Geometry.MaterialsCpu;
+    const u32 materialCount = (u32)std::min(materials.size(), materialScreenSizesPixels.size());
+    for (u32 materialIndex = 0; materialIndex < materialCount; materialIndex++)
+    {
+        const f32 screenSizePixels = materialScreenSizesPixels[materialIndex];
+        if (screenSizePixels <= 0.0f)
+            continue;
+        
+        const MaterialAsset* material = m_MaterialAssetManager->Get(materials[materialIndex].Handle);
+        if (!material)
+            continue;
+        
+        for (const ImageHandle texture : {material->BaseColorTexture, material->EmissiveTexture,
+            material->NormalTexture, material->MetallicRoughnessTexture, material->OcclusionTexture})
+            if (texture.IsValid())
+                m_TextureAssetManager->RequestScreenSize(texture, screenSizePixels);
+    }
+}
+
 void SceneAssetManager::OnFrameBegin(FrameContext&)
 {
     Lock lock(m_ResourceAccessMutex);
+
+    HandleStreamedScenes();
     
     auto& queued = m_ToUnload[(u32)UnloadState::Queued];
     auto& toUnload = m_ToUnload[(u32)UnloadState::Unload];
@@ -103,7 +166,11 @@ SceneHandle SceneAssetManager::LoadAsset(const SceneLoadParameters& parameters)
     if (cached.IsValid())
         return cached;
     
-    auto sceneAsset = DoLoad(importer, path);
+    std::optional<SceneAsset> sceneAsset = {};
+    {
+        auto assetLock = m_AssetSystem->LockAssetWrite(path);
+        sceneAsset = DoLoad(importer, path);
+    }
     if (!sceneAsset.has_value())
         return {};
     
@@ -125,6 +192,7 @@ void SceneAssetManager::UnloadAsset(SceneHandle handle)
     
     LUX_LOG_INFO("Unloading scene: {}", assetInfo->Path.string());
 
+    m_StreamedScenes.Cancel(handle);
     m_ToUnload[(u32)UnloadState::Queued].push_back(handle);
     UnregisterMaterials(handle);
     m_SceneDeletedSignal.Emit({.Scene = handle});
@@ -143,7 +211,11 @@ void SceneAssetManager::OnRawFileModified(const std::filesystem::path& path)
             import::SceneImporter importer(m_Ctx);
             AssetSystemFileLockGuard fileLock = m_AssetSystem->LockAssetFile(path, importer);
             
-            auto sceneAsset = DoLoad(importer, path);
+            std::optional<SceneAsset> sceneAsset = {};
+            {
+                auto assetLock = m_AssetSystem->LockAssetWrite(path);
+                sceneAsset = DoLoad(importer, path);
+            }
             if (!sceneAsset.has_value())
                 return;
             
@@ -160,6 +232,8 @@ void SceneAssetManager::OnRawFileModified(const std::filesystem::path& path)
                     return;
                 }
 
+                /* the scene was not streamed in yet, the reloaded one is newer */
+                m_StreamedScenes.Cancel(cached);
                 UnregisterMaterials(cached);
                 m_Scenes[cached] = std::move(*sceneAsset);
                 RegisterMaterials(cached);
@@ -167,7 +241,9 @@ void SceneAssetManager::OnRawFileModified(const std::filesystem::path& path)
             }
             
             m_AssetSystem->NotifyAssetUpdate(assetlib::scene::ASSET_TYPE, {.AssetHandle = cached});
-        }
+        },
+        .Priority = AssetImportPriority::Background,
+        .Key = path.generic_string()
     });
 }
 
@@ -199,6 +275,8 @@ void SceneAssetManager::OnMaterialUpdated(MaterialHandle material)
 
 void SceneAssetManager::OnTextureUpdated(ImageHandle texture)
 {
+    std::lock_guard lock(m_LoadedTexturesMutex);
+    
     auto it = m_LoadedTextures.find(texture);
     if (it == m_LoadedTextures.end())
         return;
@@ -264,15 +342,15 @@ std::optional<SceneAsset> SceneAssetManager::DoLoad(import::SceneImporter& impor
     if (willBake) 
         m_AssetSystem->ScanAssetsDirectory(path.parent_path());
 
-    std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset> importedBuffers;
-    std::optional<SceneGeometryInfo> geometryInfo = LoadGeometryInfo(sceneAsset, importedBuffers);
+    LoadedGeometryBuffers loadedBuffers;
+    std::optional<SceneGeometryInfo> geometryInfo = LoadGeometryInfo(sceneAsset, loadedBuffers);
     if (!geometryInfo.has_value())
     {
         LUX_LOG_ERROR("Failed to load geometry info for scene: {}", path.string());
         return std::nullopt;
     }
     
-    SceneHierarchyInfo hierarchyInfo = LoadHierarchyInfo(sceneAsset, *geometryInfo, importedBuffers);
+    SceneHierarchyInfo hierarchyInfo = LoadHierarchyInfo(sceneAsset, *geometryInfo, loadedBuffers);
     
     return SceneAsset{
         .Geometry = std::move(*geometryInfo),
@@ -282,11 +360,11 @@ std::optional<SceneAsset> SceneAssetManager::DoLoad(import::SceneImporter& impor
 }
 
 std::optional<SceneGeometryInfo> SceneAssetManager::LoadGeometryInfo(const assetlib::SceneAsset& scene, 
-    std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset>& importedBuffers)
+    LoadedGeometryBuffers& loadedBuffers)
 { 
     SceneGeometryInfo geometryInfo = {};
     
-    if (auto loadMeshesResult = LoadMeshesAndSkins(geometryInfo, scene, importedBuffers); !loadMeshesResult)
+    if (auto loadMeshesResult = LoadMeshesAndSkins(geometryInfo, scene, loadedBuffers); !loadMeshesResult)
         return std::nullopt;
     
     return geometryInfo;
@@ -305,8 +383,10 @@ SceneLightInfo SceneAssetManager::LoadLightsInfo(const assetlib::SceneAsset& sce
             .Color = light.Color,
             .Intensity = light.Intensity,
             .Radius = light.Range,
-            // todo:
-            .SpotLightData = {}
+            .SpotLightData = {
+                .InnerAngle = SpotLightData::QuantizeAngle(light.InnerConeAngle),
+                .OuterAngle = SpotLightData::QuantizeAngle(light.OuterConeAngle)
+            }
         });
 
     return sceneLightInfo;
@@ -314,11 +394,11 @@ SceneLightInfo SceneAssetManager::LoadLightsInfo(const assetlib::SceneAsset& sce
 
 SceneHierarchyInfo SceneAssetManager::LoadHierarchyInfo(const assetlib::SceneAsset& scene, 
     SceneGeometryInfo& geometryInfo, 
-    std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset>& importedBuffers)
+    LoadedGeometryBuffers& loadedBuffers)
 {
     SceneHierarchyInfo sceneHierarchy = {};
     
-    LoadAnimations(sceneHierarchy, scene, importedBuffers);
+    LoadAnimations(sceneHierarchy, scene, loadedBuffers);
     LoadNodes(sceneHierarchy, scene, geometryInfo);
     
     return sceneHierarchy;
@@ -436,22 +516,22 @@ void SceneAssetManager::LoadNodes(SceneHierarchyInfo& sceneHierarchy, const asse
 }
 
 void SceneAssetManager::LoadAnimations(SceneHierarchyInfo& sceneHierarchy, const assetlib::SceneAsset& scene,
-    std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset>& importedBuffers)
+    LoadedGeometryBuffers& loadedBuffers)
 {
-    auto copyAccessorToVector = [](auto& vector, const assetlib::GeometryBufferAccessor& accessor,
-        const assetlib::GeometryBufferAsset& buffer, u64 accessorElementSizeBytes, u64 vectorElementSizeBytes) {
+    auto copyAccessorToVector = [this](auto& vector, const assetlib::GeometryBufferAccessor& accessor,
+        LoadedGeometryBuffer& buffer, u64 accessorElementSizeBytes, u64 vectorElementSizeBytes) {
         vector.resize(accessor.Count);
+        const std::byte* view = GetGeometryBufferView(buffer, accessor.BufferView);
+        if (!view)
+            return;
         
         if (accessorElementSizeBytes == vectorElementSizeBytes)
         {
-            std::memcpy(vector.data(),
-                buffer.Data.data() + buffer.Header.BufferViews[accessor.BufferView].OffsetBytes +
-                accessor.OffsetBytes, accessor.Count * sizeof(vector[0]));
+            std::memcpy(vector.data(), view + accessor.OffsetBytes, accessor.Count * sizeof(vector[0]));
             return;
         }
         
-        const std::byte* source = buffer.Data.data() + buffer.Header.BufferViews[accessor.BufferView].OffsetBytes +
-            accessor.OffsetBytes;
+        const std::byte* source = view + accessor.OffsetBytes;
         std::byte* destination = (std::byte*)vector.data();
         
         for (u32 i = 0; i < accessor.Count; i++)
@@ -464,8 +544,7 @@ void SceneAssetManager::LoadAnimations(SceneHierarchyInfo& sceneHierarchy, const
     
     for (auto& animation : scene.Animations)
     {
-        // todo: this loads extra stuff that we do not need for animations, consider another lighter function
-        auto* bufferInfo = GetGeometryBuffer(animation.GeometryBuffer, importedBuffers);
+        auto* bufferInfo = GetGeometryBuffer(animation.GeometryBuffer, loadedBuffers);
         if (!bufferInfo)
             continue;
         
@@ -541,17 +620,17 @@ void SceneAssetManager::LoadAnimations(SceneHierarchyInfo& sceneHierarchy, const
 }
 
 bool SceneAssetManager::LoadMeshesAndSkins(SceneGeometryInfo& geometry, const assetlib::SceneAsset& scene, 
-    std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset>& importedBuffers)
+    LoadedGeometryBuffers& loadedBuffers)
 {
     struct ImportedMeshInfo
     {
-        assetlib::GeometryBufferAsset* Buffer{nullptr};
+        LoadedGeometryBuffer* Buffer{nullptr};
         assetlib::MeshAsset MeshAsset{};
         std::vector<u32> PrimitivesSkinIndices;
     };
     struct ImportedSkinInfo
     {
-        assetlib::GeometryBufferAsset* Buffer{nullptr};
+        LoadedGeometryBuffer* Buffer{nullptr};
         u32 FirstJointMatrix{SceneSkin::INVALID};
         bool IsLoaded() const { return FirstJointMatrix != SceneSkin::INVALID; }
     };
@@ -620,7 +699,7 @@ bool SceneAssetManager::LoadMeshesAndSkins(SceneGeometryInfo& geometry, const as
                 return false;
     
             auto& importedMesh = importer.GetImportedMesh().Asset;
-            auto* bufferInfo = GetGeometryBuffer(importedMesh.GeometryBuffer, importedBuffers);
+            auto* bufferInfo = GetGeometryBuffer(importedMesh.GeometryBuffer, loadedBuffers);
             if (!bufferInfo)
                 return false;
         
@@ -633,7 +712,7 @@ bool SceneAssetManager::LoadMeshesAndSkins(SceneGeometryInfo& geometry, const as
 
         for (auto& skin : scene.Skins)
         {
-            auto* bufferInfo = GetGeometryBuffer(skin.GeometryBuffer, importedBuffers);
+            auto* bufferInfo = GetGeometryBuffer(skin.GeometryBuffer, loadedBuffers);
             if (!bufferInfo)
                 return false;
             importedSkins.push_back({.Buffer = bufferInfo});
@@ -659,47 +738,76 @@ bool SceneAssetManager::LoadMeshesAndSkins(SceneGeometryInfo& geometry, const as
         return true;
     };
 
-    auto readAccessor = [&]<typename T>(const assetlib::GeometryBufferAsset& buffer,
-        const assetlib::GeometryBufferAccessor& accessor, std::vector<T>& destinationVector) -> u32 {
-            
-        const u32 fistElement = (u32)destinationVector.size();
+    auto getGeometryBufferIndex = [&geometry, this](LoadedGeometryBuffer& buffer) -> u32 {
+        if (buffer.GeometryBuffer == LoadedGeometryBuffer::UNSET)
+        {
+            buffer.GeometryBuffer = (u32)geometry.Buffers.size();
+            geometry.Buffers.push_back({
+                .Metadata = buffer.Metadata,
+                .Header = buffer.Header,
+                .Io = m_Ctx->Io,
+                .Compressor = m_Ctx->Compressor,
+                .Data = buffer.Data
+            });
+        }
+        
+        return buffer.GeometryBuffer;
+    };
+    /* the baked views have the layout of the gpu streams, so the accessor only records its range,
+     * and it is decompressed straight into the upload memory later */
+    auto readStreamAccessor = [&](LoadedGeometryBuffer& buffer, const assetlib::GeometryBufferAccessor& accessor,
+        SceneGeometryStreamType stream) -> u32 {
+        const u64 elementSizeBytes = SceneGeometryInfo::STREAM_ELEMENT_SIZES[(u32)stream];
         auto& bufferHeader = buffer.Header;
-
+        
         if (accessor.Sparse.has_value())
         {
             auto& sparse = *accessor.Sparse;
             ASSERT(sparse.Indices.ComponentType == assetlib::GeometryBufferAccessorComponentType::U32)
             
-            const auto& indicesView = bufferHeader.BufferViews[sparse.Indices.BufferView];
             const auto& dataView = bufferHeader.BufferViews[sparse.Data.BufferView];
-
-            const Span indices(
-                (const u32*)(buffer.Data.data() + indicesView.OffsetBytes + sparse.Indices.OffsetBytes), sparse.Count);
-            const Span data(
-                (const T*)(buffer.Data.data() + dataView.OffsetBytes + sparse.Data.OffsetBytes), sparse.Count);
-
-            std::vector<u32> sparseIndices;
-            std::vector<T> sparseData;
-            sparseIndices.append_range(indices);
-            sparseData.append_range(data);
+            const std::byte* indicesView = GetGeometryBufferView(buffer, sparse.Indices.BufferView);
             
-            destinationVector.insert(destinationVector.end(), accessor.Count, T{});
-            for (auto&& [denseIndex, sparseIndex] : std::views::enumerate(sparseIndices))
-                destinationVector[fistElement + sparseIndex] = sparseData[denseIndex];
+            std::vector<std::byte> sparseData(sparse.Count * elementSizeBytes);
+            std::vector<std::byte> denseData(accessor.Count * elementSizeBytes);
+            if (indicesView && ReadGeometryBufferRange(buffer, dataView.OffsetBytes + sparse.Data.OffsetBytes,
+                Span(sparseData.data(), sparseData.size())))
+            {
+                const u32* indices = (const u32*)(indicesView + sparse.Indices.OffsetBytes);
+                for (u32 denseIndex = 0; denseIndex < sparse.Count; denseIndex++)
+                    std::memcpy(denseData.data() + indices[denseIndex] * elementSizeBytes,
+                        sparseData.data() + denseIndex * elementSizeBytes, elementSizeBytes);
+            }
             
-            return fistElement;
+            return geometry.AddStreamData(stream, std::move(denseData));
         }
     
         const auto& view = bufferHeader.BufferViews[accessor.BufferView];
-        const Span<const T> data(
-            (const T*)(buffer.Data.data() + view.OffsetBytes + accessor.OffsetBytes), 
+        
+        return geometry.AddStreamRange(stream, getGeometryBufferIndex(buffer), view.OffsetBytes + accessor.OffsetBytes,
             accessor.Count);
-    
-        destinationVector.append_range(data);
+    };
+    auto readStreamAttributeAccessor = [&](LoadedGeometryBuffer& buffer, const assetlib::MeshAttribute* attribute,
+        SceneGeometryStreamType stream) -> u32 {
+        if (attribute == nullptr)
+            return SceneRenderObject::INVALID;
+        
+        return readStreamAccessor(buffer, buffer.Header.Accessors[attribute->Accessor], stream);
+    };
+    /* meshlets and joint matrices are needed on cpu */
+    auto readAccessor = [&]<typename T>(LoadedGeometryBuffer& buffer,
+        const assetlib::GeometryBufferAccessor& accessor, std::vector<T>& destinationVector) -> u32 {
+        ASSERT(!accessor.Sparse.has_value())
+            
+        const u32 fistElement = (u32)destinationVector.size();
+        destinationVector.resize(fistElement + accessor.Count);
+        if (const std::byte* view = GetGeometryBufferView(buffer, accessor.BufferView))
+            std::memcpy(destinationVector.data() + fistElement, view + accessor.OffsetBytes,
+                accessor.Count * sizeof(T));
             
         return fistElement;
     };
-    auto readAttributeAccessor = [&]<typename T>(const assetlib::GeometryBufferAsset& buffer,
+    auto readAttributeAccessor = [&]<typename T>(LoadedGeometryBuffer& buffer,
         const assetlib::MeshAttribute* attribute, std::vector<T>& destinationVector) -> u32 {
         if (attribute == nullptr)
             return SceneRenderObject::INVALID;
@@ -725,17 +833,19 @@ bool SceneAssetManager::LoadMeshesAndSkins(SceneGeometryInfo& geometry, const as
         {
             const auto* positionAttribute = primitive.FindAttribute(assetlib::MeshAttribute::POSITION_NAME);
             const u32 vertexCount = accessors[positionAttribute->Accessor].Count;
-            const u32 firstIndex = readAccessor(*buffer, accessors[primitive.IndicesAccessor], geometry.Indices);
-            const u32 firstPosition = readAttributeAccessor(*buffer, positionAttribute, geometry.Positions); 
-            const u32 firstNormal = readAttributeAccessor(*buffer,
+            const u32 firstIndex = readStreamAccessor(*buffer, accessors[primitive.IndicesAccessor],
+                SceneGeometryStreamType::Index);
+            const u32 firstPosition = readStreamAttributeAccessor(*buffer, positionAttribute,
+                SceneGeometryStreamType::Position); 
+            const u32 firstNormal = readStreamAttributeAccessor(*buffer,
                 primitive.FindAttribute(assetlib::MeshAttribute::NORMAL_NAME),
-                geometry.Normals); 
-            const u32 firstTangent = readAttributeAccessor(*buffer,
+                SceneGeometryStreamType::Normal); 
+            const u32 firstTangent = readStreamAttributeAccessor(*buffer,
                 primitive.FindAttribute(assetlib::MeshAttribute::TANGENT_NAME),
-                geometry.Tangents); 
-            const u32 firstUv = readAttributeAccessor(*buffer,
+                SceneGeometryStreamType::Tangent); 
+            const u32 firstUv = readStreamAttributeAccessor(*buffer,
                 primitive.FindAttribute(assetlib::MeshAttribute::UV0_NAME),
-                geometry.UVs); 
+                SceneGeometryStreamType::Uv); 
             const auto* meshletAttribute = primitive.FindAttribute(assetlib::MeshAttribute::MESHLET_NAME);
             const u32 firstMeshlet = readAttributeAccessor(*buffer, meshletAttribute, geometry.Meshlets); 
             const u32 meshletCount = accessors[meshletAttribute->Accessor].Count;
@@ -746,15 +856,15 @@ bool SceneAssetManager::LoadMeshesAndSkins(SceneGeometryInfo& geometry, const as
             
             for (auto& blendShape : primitive.BlendShapes)
             {
-                const u32 firstBlendPosition = readAttributeAccessor(*buffer,
+                const u32 firstBlendPosition = readStreamAttributeAccessor(*buffer,
                     blendShape.FindAttribute(assetlib::MeshAttribute::POSITION_NAME),
-                    geometry.Positions); 
-                const u32 firstBlendNormal = readAttributeAccessor(*buffer,
+                    SceneGeometryStreamType::Position); 
+                const u32 firstBlendNormal = readStreamAttributeAccessor(*buffer,
                     blendShape.FindAttribute(assetlib::MeshAttribute::NORMAL_NAME),
-                    geometry.Normals); 
-                const u32 firstBlendTangent = readAttributeAccessor(*buffer,
+                    SceneGeometryStreamType::Normal); 
+                const u32 firstBlendTangent = readStreamAttributeAccessor(*buffer,
                     blendShape.FindAttribute(assetlib::MeshAttribute::TANGENT_NAME),
-                    geometry.Tangents);
+                    SceneGeometryStreamType::Tangent);
                 
                 geometry.BlendShapes.push_back({
                     .Name = blendShape.Name,
@@ -800,8 +910,8 @@ bool SceneAssetManager::LoadMeshesAndSkins(SceneGeometryInfo& geometry, const as
         auto& meshInfo = importedMeshes[meshIndex];
         auto& primitive = importedMeshes[meshIndex].MeshAsset.Primitives[primitiveIndex];
             
-        const assetlib::GeometryBufferAsset* skinBuffer = skinInfo.Buffer;
-        const assetlib::GeometryBufferAsset* meshBuffer = meshInfo.Buffer;
+        LoadedGeometryBuffer* skinBuffer = skinInfo.Buffer;
+        LoadedGeometryBuffer* meshBuffer = meshInfo.Buffer;
 
         if (!skinInfo.IsLoaded())
         {
@@ -812,45 +922,91 @@ bool SceneAssetManager::LoadMeshesAndSkins(SceneGeometryInfo& geometry, const as
         
         geometry.Skins.push_back({
             .FirstJointMatrix = skinInfo.FirstJointMatrix,
-            .FirstJoint = readAttributeAccessor(*meshBuffer,
-                primitive.FindAttribute(assetlib::MeshAttribute::JOINTS0_NAME), geometry.Joints),
-            .FirstWeight = readAttributeAccessor(*meshBuffer,
-                primitive.FindAttribute(assetlib::MeshAttribute::WEIGHTS0_NAME), geometry.Weights)
+            .FirstJoint = readStreamAttributeAccessor(*meshBuffer,
+                primitive.FindAttribute(assetlib::MeshAttribute::JOINTS0_NAME), SceneGeometryStreamType::Joint),
+            .FirstWeight = readStreamAttributeAccessor(*meshBuffer,
+                primitive.FindAttribute(assetlib::MeshAttribute::WEIGHTS0_NAME), SceneGeometryStreamType::Weight)
         });
     }
     
     return true;
 }
 
-std::optional<assetlib::GeometryBufferAsset> SceneAssetManager::LoadGeometryBuffer(assetlib::AssetId buffer)
+std::optional<SceneAssetManager::LoadedGeometryBuffer> SceneAssetManager::LoadGeometryBuffer(
+    assetlib::AssetId buffer)
 {
-    using enum assetlib::GeometryBufferViewType;
-    
     auto* geometryBufferAssetInfo = m_AssetSystem->Resolve(buffer);
     if (!geometryBufferAssetInfo)
         return std::nullopt;
     
+    /* without range decompression every view read would decompress the whole buffer */
+    const bool readWhole = !m_Ctx->Compressor->SupportsRangeDecompression();
+    
     import::GeometryBufferImporter importer(m_Ctx, {});
-    auto imported = importer.Import(geometryBufferAssetInfo->MetaPath);
+    auto imported = importer.Import(geometryBufferAssetInfo->MetaPath,
+        readWhole ? import::ImportFlags::Header | import::ImportFlags::Binaries : import::ImportFlags::Header);
     if (!imported.has_value())
         return std::nullopt;
+
+    auto& importedBuffer = importer.GetImportedBuffer().Asset;
     
-    return importer.GetImportedBuffer().Asset;
+    return LoadedGeometryBuffer{
+        .Metadata = importer.GetImportedAssetMetadata(),
+        .Header = importedBuffer.Header,
+        .Data = readWhole ? std::make_shared<const std::vector<std::byte>>(importedBuffer.Data) : nullptr
+    };
 }
 
-assetlib::GeometryBufferAsset* SceneAssetManager::GetGeometryBuffer(assetlib::AssetId buffer, 
-    std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset>& importedBuffers)
+SceneAssetManager::LoadedGeometryBuffer* SceneAssetManager::GetGeometryBuffer(assetlib::AssetId buffer, 
+    LoadedGeometryBuffers& loadedBuffers)
 {
-    if (!importedBuffers.contains(buffer))
+    if (!loadedBuffers.contains(buffer))
     {
-        auto importedBuffer = LoadGeometryBuffer(buffer);
-        if (!importedBuffer.has_value())
+        auto loadedBuffer = LoadGeometryBuffer(buffer);
+        if (!loadedBuffer.has_value())
             return nullptr;
 
-        importedBuffers.emplace(buffer, std::move(*importedBuffer));
+        loadedBuffers.emplace(buffer, std::move(*loadedBuffer));
     }
 
-    return &importedBuffers.at(buffer);
+    return &loadedBuffers.at(buffer);
+}
+
+bool SceneAssetManager::ReadGeometryBufferRange(const LoadedGeometryBuffer& buffer, u64 offsetBytes,
+    Span<std::byte> destination)
+{
+    if (buffer.Data)
+    {
+        std::memcpy(destination.data(), buffer.Data->data() + offsetBytes, destination.size());
+        return true;
+    }
+    
+    auto read = assetlib::sceneGeometry::readBufferDataRange(buffer.Header, buffer.Metadata,
+        *m_Ctx->Io, *m_Ctx->Compressor, offsetBytes, destination);
+    if (!read.has_value())
+    {
+        LUX_LOG_ERROR("Failed to read geometry buffer: {}", read.error());
+        return false;
+    }
+    
+    return true;
+}
+
+const std::byte* SceneAssetManager::GetGeometryBufferView(LoadedGeometryBuffer& buffer, u32 view)
+{
+    if (buffer.Data)
+        return buffer.Data->data() + buffer.Header.BufferViews[view].OffsetBytes;
+    
+    auto it = buffer.Views.find(view);
+    if (it != buffer.Views.end())
+        return it->second.data();
+
+    const auto& bufferView = buffer.Header.BufferViews[view];
+    std::vector<std::byte> viewData(bufferView.LengthBytes);
+    if (!ReadGeometryBufferRange(buffer, bufferView.OffsetBytes, Span(viewData.data(), viewData.size())))
+        return nullptr;
+
+    return buffer.Views.emplace(view, std::move(viewData)).first->second.data();
 }
 
 MaterialGPU SceneAssetManager::LoadMaterial(const SceneGeometryInfo::MaterialInfo& materialInfo, 
@@ -876,6 +1032,8 @@ MaterialGPU SceneAssetManager::LoadMaterial(const SceneGeometryInfo::MaterialInf
 
 TextureHandle SceneAssetManager::LoadTexture(u32 uvIndex, ImageHandle image, TextureHandle fallback)
 {
+    std::lock_guard lock(m_LoadedTexturesMutex);
+    
     if (m_LoadedTextures.contains(image))
         return m_LoadedTextures[image];
     
@@ -891,4 +1049,21 @@ TextureHandle SceneAssetManager::LoadTexture(u32 uvIndex, ImageHandle image, Tex
 
     return m_LoadedTextures[image] = m_TexturesRingBuffer->AddTexture(imageAsset);
 }
+
+void SceneAssetManager::HandleStreamedScenes()
+{
+    for (auto& [sceneHandle, sceneAsset] : m_StreamedScenes.TakeCompleted())
+    {
+        if (!sceneAsset.has_value())
+        {
+            /* the instances that wait for the scene are deleted the same way as on unload */
+            m_ToUnload[(u32)UnloadState::Queued].push_back(sceneHandle);
+            m_SceneDeletedSignal.Emit({.Scene = sceneHandle});
+            continue;
+        }
+
+        m_Scenes[sceneHandle] = std::move(*sceneAsset);
+        RegisterMaterials(sceneHandle);
+    }
+}
 }
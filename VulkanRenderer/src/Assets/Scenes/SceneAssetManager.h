@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "SceneAsset.h"
 #include "Assets/AssetManager.h"
+#include "Assets/AssetStreamingQueue.h"
 #include "Assets/AssetSystem.h"
 #include "Assets/Common/AssetSlotMap.h"
 #include "Scene/BindlessTextureDescriptorsRingBuffer.h"
@@ -66,6 +67,14 @@ public:
     MaterialUpdatedSignal& GetMaterialUpdatedSignal() { return m_MaterialUpdatedSignal; }
 
     SceneHandle AddExternalScene(SceneAsset&& scene);
+    /* the scene is loaded on the import thread, the returned handle refers to an empty scene until
+     * `IsLoaded` returns true; the loaded scene is swapped in by `OnFrameBegin` */
+    SceneHandle LoadResourceAsync(const SceneLoadParameters& parameters);
+    bool IsLoaded(SceneHandle handle) const;
+    /* requests the texture mipmaps of every scene material for the size it covers on screen,
+     * `materialScreenSizesPixels` is indexed by the scene material, and the materials past its end or with 0
+     * are not requested */
+    void RequestTextureMips(SceneHandle handle, Span<const f32> materialScreenSizesPixels) const;
     
     void OnFrameBegin(FrameContext& ctx);
 
@@ -75,6 +84,22 @@ protected:
     GetType GetAsset(SceneHandle handle) const override;
 
 private:
+    /* only the header of a geometry buffer is loaded, the vertex data is decompressed on upload,
+     * the views that are needed on cpu (meshlets, animations, etc.) are read lazily */
+    struct LoadedGeometryBuffer
+    {
+        static constexpr u32 UNSET = ~0lu;
+        
+        assetlib::AssetMetadata Metadata{};
+        assetlib::GeometryBufferHeader Header{};
+        /* set only if the compressor cannot decompress a range */
+        std::shared_ptr<const std::vector<std::byte>> Data{};
+        std::unordered_map<u32, std::vector<std::byte>> Views{};
+        /* index in `SceneGeometryInfo::Buffers` */
+        u32 GeometryBuffer{UNSET};
+    };
+    using LoadedGeometryBuffers = std::unordered_map<assetlib::AssetId, LoadedGeometryBuffer>;
+    
     void OnRawFileModified(const std::filesystem::path& path);
     void OnMaterialUpdated(MaterialHandle material);
     void OnTextureUpdated(ImageHandle texture);
@@ -83,26 +108,31 @@ private:
     std::optional<SceneAsset> DoLoad(import::SceneImporter& importer, const std::filesystem::path& path);
     
     std::optional<SceneGeometryInfo> LoadGeometryInfo(const assetlib::SceneAsset& scene, 
-        std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset>& importedBuffers);
+        LoadedGeometryBuffers& loadedBuffers);
     SceneLightInfo LoadLightsInfo(const assetlib::SceneAsset& scene);
     SceneHierarchyInfo LoadHierarchyInfo(const assetlib::SceneAsset& scene, SceneGeometryInfo& geometryInfo, 
-        std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset>& importedBuffers);
+        LoadedGeometryBuffers& loadedBuffers);
     void LoadNodes(SceneHierarchyInfo& sceneHierarchy, const assetlib::SceneAsset& scene, 
         const SceneGeometryInfo& geometryInfo);
     void LoadAnimations(SceneHierarchyInfo& sceneHierarchy, const assetlib::SceneAsset& scene,
-        std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset>& importedBuffers);
+        LoadedGeometryBuffers& loadedBuffers);
     bool LoadMeshesAndSkins(SceneGeometryInfo& geometry, const assetlib::SceneAsset& scene, 
-        std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset>& importedBuffers);
-    std::optional<assetlib::GeometryBufferAsset> LoadGeometryBuffer(assetlib::AssetId buffer);
-    assetlib::GeometryBufferAsset* GetGeometryBuffer(assetlib::AssetId buffer, 
-        std::unordered_map<assetlib::AssetId, assetlib::GeometryBufferAsset>& importedBuffers);
+        LoadedGeometryBuffers& loadedBuffers);
+    std::optional<LoadedGeometryBuffer> LoadGeometryBuffer(assetlib::AssetId buffer);
+    LoadedGeometryBuffer* GetGeometryBuffer(assetlib::AssetId buffer, LoadedGeometryBuffers& loadedBuffers);
+    bool ReadGeometryBufferRange(const LoadedGeometryBuffer& buffer, u64 offsetBytes, Span<std::byte> destination);
+    const std::byte* GetGeometryBufferView(LoadedGeometryBuffer& buffer, u32 view);
     MaterialGPU LoadMaterial(const SceneGeometryInfo::MaterialInfo& materialInfo, const MaterialAsset& materialAsset);
     TextureHandle LoadTexture(u32 uvIndex, ImageHandle image, TextureHandle fallback);
+    void HandleStreamedScenes();
 
 private:
     AssetSlotMap<SceneAsset> m_Scenes;
+    AssetStreamingQueue<SceneHandle, SceneAsset> m_StreamedScenes;
     
     BindlessTextureDescriptorsRingBuffer* m_TexturesRingBuffer{nullptr};
+    /* scenes are loaded on the import thread, while materials are updated on the main thread */
+    std::mutex m_LoadedTexturesMutex;
     std::unordered_map<ImageHandle, TextureHandle> m_LoadedTextures;
     
     ImageAssetManager* m_TextureAssetManager{nullptr};
@@ -267,7 +267,9 @@ void ShaderAssetManager::OnRawFileModified(const std::filesystem::path& path)
                         existingPipeline.Layout = pipelineInfo->Layout;
                         existingPipeline.ShouldReload = true;
                     }
-                }
+                },
+                .Priority = AssetImportPriority::Background,
+                .Key = std::format("{} {}", shaderPath.generic_string(), rebakeInfo.DefinesHash)
             });
         }
     }
@@ -19,3 +19,17 @@ bool PointLight::operator==(const PointLight& other) const
         Intensity == other.Intensity &&
         Radius == other.Radius;
 }
+
+bool SpotLight::operator==(const SpotLight& other) const
+{
+    return
+        Position == other.Position &&
+        Color == other.Color &&
+        Intensity == other.Intensity &&
+        Radius == other.Radius &&
+        Direction == other.Direction &&
+        AngleScale == other.AngleScale &&
+        AngleOffset == other.AngleOffset &&
+        CosOuterAngle == other.CosOuterAngle &&
+        SinOuterAngle == other.SinOuterAngle;
+}
@@ -2,6 +2,7 @@
 
 #include "RenderGraph/Passes/Generated/Types/DirectionalLightUniform.generated.h"
 #include "RenderGraph/Passes/Generated/Types/PointLightUniform.generated.h"
+#include "RenderGraph/Passes/Generated/Types/SpotLightUniform.generated.h"
 #include "RenderGraph/Passes/Generated/Types/LightClusterUniform.generated.h"
 #include "RenderGraph/Passes/Generated/Types/LightTileUniform.generated.h"
 
@@ -19,10 +20,16 @@ struct PointLight : gen::PointLight
     bool operator==(const PointLight& other) const;
 };
 
+struct SpotLight : gen::SpotLight
+{
+    bool operator==(const SpotLight& other) const;
+};
+
 struct LightsInfo
 {
     u32 DirectionalLightCount{};
     u32 PointLightCount{};
+    u32 SpotLightCount{};
 
     auto operator<=>(const LightsInfo& other) const = default;
 };
@@ -0,0 +1,93 @@
+#include "rendererpch.h"
+
+#include "LightClusterCache.h"
+
+#include "FrameContext.h"
+#include "Settings.h"
+#include "Core/Camera.h"
+#include "cvars/CVarSystem.h"
+#include "Light/Light.h"
+#include "Scene/SceneLight.h"
+#include "Vulkan/Device.h"
+
+LightClusterCache LightClusterCache::Create(DeletionQueue& deletionQueue)
+{
+    LightClusterCache cache = {};
+    cache.m_Clusters = Device::CreateBuffer({
+        .Description = {
+            .SizeBytes = sizeof(LightCluster) * LIGHT_CLUSTER_BINS,
+            .Usage = BufferUsage::Ordinary | BufferUsage::Storage
+        },
+    }, deletionQueue);
+    cache.m_ClusterVisibility = Device::CreateBuffer({
+        .Description = {
+            .SizeBytes = sizeof(u8) * LIGHT_CLUSTER_BINS,
+            .Usage = BufferUsage::Ordinary | BufferUsage::Storage
+        },
+    }, deletionQueue);
+
+    return cache;
+}
+
+LightClusterCache::Update LightClusterCache::Prepare(const SceneLight& light, const Camera& camera,
+    const FrameContext& ctx)
+{
+    const Projection projection = {
+        .Matrix = camera.GetProjection(),
+        .Resolution = ctx.Resolution,
+        .Near = camera.GetNear(),
+        .MaxLightCullDistance = *CVars::Get().GetF32CVar("Renderer.Limits.MaxLightCullDistance"_hsv)};
+
+    /* point lights go first in the local light index space, and spot lights after them */
+    m_CurrentLights.clear();
+    for (auto& commonLight : light.VisibleLights())
+        if (commonLight.Type == lux::LightType::Point && !commonLight.IsSun)
+            m_CurrentLights.push_back({
+                .Position = commonLight.PositionDirection,
+                .Radius = commonLight.Radius});
+    for (auto& commonLight : light.VisibleLights())
+        if (commonLight.Type == lux::LightType::Spot && !commonLight.IsSun)
+            m_CurrentLights.push_back({
+                .Position = commonLight.PositionDirection,
+                .Radius = commonLight.Radius,
+                .Direction = commonLight.SpotLightData.Direction,
+                .CosOuterAngle = commonLight.GetSpotCone().CosHalfAngle,
+                .IsSpot = true});
+
+    return Prepare(projection, camera.GetView(), m_CurrentLights);
+}
+
+LightClusterCache::Update LightClusterCache::Prepare(const Projection& projection, const glm::mat4& view,
+    Span<const Light> lights)
+{
+    Update update = {};
+    update.SetupClusters = !m_IsValid || projection != m_Projection;
+
+    /* light masks are in view space, so any change of the view invalidates them */
+    bool rebinAll = update.SetupClusters || view != m_View || lights.size() != m_Lights.size();
+    m_DirtyLights.clear();
+    if (!rebinAll)
+    {
+        for (u32 i = 0; i < lights.size(); i++)
+            if (lights[i] != m_Lights[i])
+                m_DirtyLights.push_back(i);
+        rebinAll = (f32)m_DirtyLights.size() > MAX_DIRTY_LIGHTS_FRACTION * (f32)lights.size();
+    }
+    if (rebinAll)
+    {
+        m_DirtyLights.clear();
+        m_Generation++;
+        if (m_Generation == NO_GENERATION)
+            m_Generation++;
+    }
+
+    m_IsValid = true;
+    m_Projection = projection;
+    m_View = view;
+    m_Lights.assign(lights.begin(), lights.end());
+
+    update.Generation = m_Generation;
+    update.DirtyLights = m_DirtyLights;
+
+    return update;
+}
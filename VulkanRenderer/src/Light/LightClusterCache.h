@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Rendering/Buffer/Buffer.h"
+
+#include <CoreLib/types.h>
+#include <CoreLib/Containers/Span.h>
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class Camera;
+class DeletionQueue;
+class SceneLight;
+struct FrameContext;
+
+/* light clusters and their light masks persist between the frames, and this class decides how much of them
+ * has to be rebuilt: the cluster bounds only depend on the projection, and the light masks have to be rebuilt
+ * only for the lights that have changed, as long as the view and the light index space stay the same */
+class LightClusterCache
+{
+public:
+    /* everything that the cluster bounds depend on */
+    struct Projection
+    {
+        glm::mat4 Matrix{1.0f};
+        glm::uvec2 Resolution{0};
+        f32 Near{0.0f};
+        f32 MaxLightCullDistance{0.0f};
+
+        bool operator==(const Projection&) const = default;
+    };
+    /* everything that the cluster mask of a light depends on, in the order of the local light index space */
+    struct Light
+    {
+        glm::vec3 Position{0.0f};
+        f32 Radius{0.0f};
+        glm::vec3 Direction{0.0f};
+        f32 CosOuterAngle{-1.0f};
+        bool IsSpot{false};
+
+        bool operator==(const Light&) const = default;
+    };
+    struct Update
+    {
+        bool SetupClusters{false};
+        /* visible clusters that were binned with a different generation are binned from scratch */
+        u32 Generation{NO_GENERATION};
+        /* lights to rebin in all the clusters of the current generation */
+        Span<const u32> DirtyLights{};
+    };
+    /* the generation of the clusters that were never binned */
+    static constexpr u32 NO_GENERATION = 0;
+    /* past this share of changed lights it is cheaper to rebin the visible clusters from scratch */
+    static constexpr f32 MAX_DIRTY_LIGHTS_FRACTION = 0.25f;
+public:
+    static LightClusterCache Create(DeletionQueue& deletionQueue);
+
+    Update Prepare(const SceneLight& light, const Camera& camera, const FrameContext& ctx);
+    /* `DirtyLights` of the returned update stay valid until the next call */
+    Update Prepare(const Projection& projection, const glm::mat4& view, Span<const Light> lights);
+    /* the next `Prepare` rebuilds everything */
+    void Invalidate() { m_IsValid = false; }
+
+    Buffer GetClusters() const { return m_Clusters; }
+    Buffer GetClusterVisibility() const { return m_ClusterVisibility; }
+private:
+    Buffer m_Clusters{};
+    Buffer m_ClusterVisibility{};
+
+    bool m_IsValid{false};
+    Projection m_Projection{};
+    glm::mat4 m_View{1.0f};
+    u32 m_Generation{NO_GENERATION};
+    /* lights as they were binned the last time */
+    std::vector<Light> m_Lights;
+    std::vector<Light> m_CurrentLights;
+    std::vector<u32> m_DirtyLights;
+};
@@ -5,100 +5,130 @@
 #include "Core/Camera.h"
 #include "cvars/CVarSystem.h"
 
+#include <CoreLib/Math/Frustum.h>
 #include <CoreLib/Math/Geometry.h>
+#include <CoreLib/Utils/RadixSort.h>
 
 namespace
 {
-bool isVisiblePerspective(const Sphere& sphere, const FrustumPlanes& frustum)
+/* the same volume that `LightSphereCuller` tests the spheres against, as inward facing view space planes */
+Frustum viewSpaceFrustum(const FrustumPlanes& planes, const ProjectionData& projection, CameraType type)
 {
-    bool visible = true;
-    visible = visible && frustum.RightX * abs(sphere.Center.x) + sphere.Center.z * frustum.RightZ <
-        sphere.Radius;
-    visible = visible && frustum.TopY * abs(sphere.Center.y) + sphere.Center.z * frustum.TopZ <
-        sphere.Radius;
-    visible = visible &&
-        sphere.Center.z - sphere.Radius <= -frustum.Near &&
-        sphere.Center.z + sphere.Radius >= -frustum.Far;
-
-    return visible;
-}
+    Frustum frustum = {};
+    if (type == CameraType::Perspective)
+    {
+        frustum.Planes[0] = {.Normal = {-planes.RightX, 0.0f, -planes.RightZ}, .Offset = 0.0f};
+        frustum.Planes[1] = {.Normal = {planes.RightX, 0.0f, -planes.RightZ}, .Offset = 0.0f};
+        frustum.Planes[2] = {.Normal = {0.0f, -planes.TopY, -planes.TopZ}, .Offset = 0.0f};
+        frustum.Planes[3] = {.Normal = {0.0f, planes.TopY, -planes.TopZ}, .Offset = 0.0f};
+    }
+    else
+    {
+        frustum.Planes[0] = {.Normal = {-1.0f, 0.0f, 0.0f}, .Offset = (1.0f - projection.BiasX) / planes.RightX};
+        frustum.Planes[1] = {.Normal = {1.0f, 0.0f, 0.0f}, .Offset = (1.0f + projection.BiasX) / planes.RightX};
+        frustum.Planes[2] = {.Normal = {0.0f, -1.0f, 0.0f}, .Offset = (1.0f - projection.BiasY) / planes.TopY};
+        frustum.Planes[3] = {.Normal = {0.0f, 1.0f, 0.0f}, .Offset = (1.0f + projection.BiasY) / planes.TopY};
+    }
+    frustum.Planes[4] = {.Normal = {0.0f, 0.0f, -1.0f}, .Offset = -planes.Near};
+    frustum.Planes[5] = {.Normal = {0.0f, 0.0f, 1.0f}, .Offset = planes.Far};
 
-bool isVisibleOrthographic(const Sphere& sphere, const FrustumPlanes& frustum,
-    const ProjectionData& projection)
-{
-    bool visible = true;
-    visible = visible && abs(frustum.RightX * sphere.Center.x + projection.BiasX) <
-        1.0f + frustum.RightX * sphere.Radius;
-    visible = visible && abs(frustum.TopY * sphere.Center.y + projection.BiasY) <
-        1.0f + frustum.TopY * sphere.Radius;
-    visible = visible &&
-        sphere.Center.z - sphere.Radius <= -frustum.Near &&
-        sphere.Center.z + sphere.Radius >= -frustum.Far;
-
-    return visible;
+    return frustum;
 }
 
-std::vector<lux::CommonLight> getVisibleLights(const SceneLight& light, const Camera& camera)
+std::vector<lux::CommonLight> getVisibleLights(SceneLight& light, const Camera& camera)
 {
     const u32 maxLightsPerFrustum = (u32)*CVars::Get().GetI32CVar("Lights.FrustumMax"_hsv);
     const f32 maxLightCullDistance = *CVars::Get().GetF32CVar("Renderer.Limits.MaxLightCullDistance"_hsv);
 
-    const FrustumPlanes frustum = camera.GetFrustumPlanes(maxLightCullDistance);
-    const ProjectionData projection = camera.GetProjectionData();
-
     std::vector<lux::CommonLight> visibleLights;
     visibleLights.reserve(light.Count());
+
+    LightSphereCuller& pointLightSpheres = light.PointLightSpheres();
+    pointLightSpheres.Clear();
+    std::vector<const lux::CommonLight*> pointLights;
+    pointLights.reserve(light.Count());
+    std::vector<const lux::CommonLight*> spotLights;
     for (const auto& commonLight : light)
     {
         switch (commonLight.Type)
         {
         case lux::LightType::Point:
-            {
-                Sphere sphere = {
-                    .Center = commonLight.PositionDirection,
-                    .Radius = commonLight.Radius
-                };
-                sphere.Center = glm::vec3{camera.GetView() * glm::vec4{sphere.Center, 1.0f}};
-
-                const bool isVisible = camera.GetType() == CameraType::Perspective ?
-                                           isVisiblePerspective(sphere, frustum) :
-                                           isVisibleOrthographic(sphere, frustum, projection);
-                if (isVisible)
-                    visibleLights.push_back(commonLight);
-                if (visibleLights.size() == maxLightsPerFrustum)
-                    break;
-            }
+            pointLightSpheres.Add(commonLight.PositionDirection, commonLight.Radius, (u32)pointLights.size());
+            pointLights.push_back(&commonLight);
             break;
-        case lux::LightType::Directional:
         case lux::LightType::Spot:
+            spotLights.push_back(&commonLight);
+            break;
+        case lux::LightType::Directional:
         default:
             visibleLights.push_back(commonLight);
             break;
         }
     }
 
+    const FrustumPlanes frustumPlanes = camera.GetFrustumPlanes(maxLightCullDistance);
+    std::vector<u32> visiblePointLights;
+    visiblePointLights.reserve(pointLights.size());
+    pointLightSpheres.Cull({
+            .View = camera.GetView(),
+            .Frustum = frustumPlanes,
+            .Projection = camera.GetProjectionData(),
+            .Type = camera.GetType(),
+            .MaxVisible = maxLightsPerFrustum},
+        visiblePointLights);
+    for (u32 pointLight : visiblePointLights)
+        visibleLights.push_back(*pointLights[pointLight]);
+
+    /* spot lights share the per-frustum limit with the point lights */
+    const Frustum frustum = viewSpaceFrustum(frustumPlanes, camera.GetProjectionData(), camera.GetType());
+    u32 visibleLocalLights = (u32)visiblePointLights.size();
+    for (const lux::CommonLight* spotLight : spotLights)
+    {
+        if (visibleLocalLights >= maxLightsPerFrustum)
+            break;
+        if (!frustum.Intersects(spotLight->GetSpotCone().Transform(camera.GetView())))
+            continue;
+        visibleLights.push_back(*spotLight);
+        visibleLocalLights++;
+    }
+
     return visibleLights;
 }
 
 void sortByDepth(std::vector<lux::CommonLight>& visibleLights, const Camera& camera)
 {
-    Plane sortPlane = camera.GetNearViewPlane();
+    const Plane sortPlane = camera.GetNearViewPlane();
 
-    std::ranges::sort(visibleLights, std::less<>{}, [&sortPlane](const lux::CommonLight& commonLight) -> f32
+    std::vector<u32> depthKeys(visibleLights.size());
+    for (u32 i = 0; i < visibleLights.size(); i++)
     {
+        const lux::CommonLight& commonLight = visibleLights[i];
+        f32 depth = 0.0f;
         switch (commonLight.Type)
         {
         case lux::LightType::Directional:
-            return 0.0f;
+            break;
         case lux::LightType::Point:
-            return sortPlane.SignedDistance(commonLight.PositionDirection);
         case lux::LightType::Spot:
+            depth = sortPlane.SignedDistance(commonLight.PositionDirection);
+            break;
         default:
             ASSERT(false, "Unsupported light type")
             break;
         }
-        std::unreachable();
-    });
+        /* `+ 0.0f` turns -0.0 into +0.0, so that they get the same key */
+        depthKeys[i] = lux::floatSortKey(depth + 0.0f);
+    }
+
+    std::vector<u32> order;
+    std::vector<u32> scratch;
+    lux::radixSortIndices(depthKeys, order, scratch);
+
+    std::vector<lux::CommonLight> sorted;
+    sorted.reserve(visibleLights.size());
+    for (u32 index : order)
+        sorted.push_back(visibleLights[index]);
+    visibleLights.swap(sorted);
 }
 }
 
@@ -0,0 +1,323 @@
+#include "rendererpch.h"
+
+#include "LightSphereCuller.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define LIGHT_CULLER_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LIGHT_CULLER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LIGHT_CULLER_TARGET_AVX2
+#endif
+
+/* all paths have to round exactly the same way */
+#if defined(_MSC_VER) && !defined(__clang__)
+#pragma fp_contract(off)
+#endif
+
+namespace
+{
+struct SpheresView
+{
+    const f32* CenterX{nullptr};
+    const f32* CenterY{nullptr};
+    const f32* CenterZ{nullptr};
+    const f32* Radius{nullptr};
+    const u32* Payload{nullptr};
+    u32 Count{0};
+};
+
+/* appends visible payloads of a batch from its bit mask, returns false once `MaxVisible` is reached */
+bool emitVisible(const SpheresView& spheres, u32 first, u32 mask, u32 maxVisible, u32& visibleCount,
+    std::vector<u32>& visible)
+{
+    while (mask != 0)
+    {
+        if (visibleCount == maxVisible)
+            return false;
+        visible.push_back(spheres.Payload[first + (u32)std::countr_zero(mask)]);
+        visibleCount++;
+        mask &= mask - 1;
+    }
+
+    return visibleCount != maxVisible;
+}
+
+void cullScalar(const SpheresView& spheres, const LightSphereCuller::CullInfo& info, std::vector<u32>& visible)
+{
+    const glm::mat4& view = info.View;
+    const FrustumPlanes& frustum = info.Frustum;
+    const ProjectionData& projection = info.Projection;
+    const bool isPerspective = info.Type == CameraType::Perspective;
+
+    u32 visibleCount = 0;
+    for (u32 i = 0; i < spheres.Count; i++)
+    {
+        const f32 x = spheres.CenterX[i];
+        const f32 y = spheres.CenterY[i];
+        const f32 z = spheres.CenterZ[i];
+        const f32 radius = spheres.Radius[i];
+
+        /* same order of operations as glm's `mat4 * vec4` */
+        const f32 viewX = (view[0][0] * x + view[1][0] * y) + (view[2][0] * z + view[3][0]);
+        const f32 viewY = (view[0][1] * x + view[1][1] * y) + (view[2][1] * z + view[3][1]);
+        const f32 viewZ = (view[0][2] * x + view[1][2] * y) + (view[2][2] * z + view[3][2]);
+
+        bool isVisible = isPerspective ?
+            frustum.RightX * std::abs(viewX) + viewZ * frustum.RightZ < radius &&
+            frustum.TopY * std::abs(viewY) + viewZ * frustum.TopZ < radius :
+            std::abs(frustum.RightX * viewX + projection.BiasX) < 1.0f + frustum.RightX * radius &&
+            std::abs(frustum.TopY * viewY + projection.BiasY) < 1.0f + frustum.TopY * radius;
+        isVisible = isVisible && viewZ - radius <= -frustum.Near && viewZ + radius >= -frustum.Far;
+
+        if (isVisible && !emitVisible(spheres, i, 1, info.MaxVisible, visibleCount, visible))
+            return;
+    }
+}
+
+#ifdef LIGHT_CULLER_X86
+void cullSse(const SpheresView& spheres, const LightSphereCuller::CullInfo& info, std::vector<u32>& visible)
+{
+    static constexpr u32 WIDTH = 4;
+
+    const glm::mat4& view = info.View;
+    const FrustumPlanes& frustum = info.Frustum;
+    const ProjectionData& projection = info.Projection;
+    const bool isPerspective = info.Type == CameraType::Perspective;
+
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 rightX = _mm_set1_ps(frustum.RightX);
+    const __m128 rightZ = _mm_set1_ps(frustum.RightZ);
+    const __m128 topY = _mm_set1_ps(frustum.TopY);
+    const __m128 topZ = _mm_set1_ps(frustum.TopZ);
+    const __m128 minusNear = _mm_set1_ps(-frustum.Near);
+    const __m128 minusFar = _mm_set1_ps(-frustum.Far);
+    const __m128 biasX = _mm_set1_ps(projection.BiasX);
+    const __m128 biasY = _mm_set1_ps(projection.BiasY);
+    __m128 matrix[3][4];
+    for (u32 row = 0; row < 3; row++)
+        for (u32 column = 0; column < 4; column++)
+            matrix[row][column] = _mm_set1_ps(view[column][row]);
+
+    u32 visibleCount = 0;
+    for (u32 first = 0; first < spheres.Count; first += WIDTH)
+    {
+        const __m128 x = _mm_loadu_ps(spheres.CenterX + first);
+        const __m128 y = _mm_loadu_ps(spheres.CenterY + first);
+        const __m128 z = _mm_loadu_ps(spheres.CenterZ + first);
+        const __m128 radius = _mm_loadu_ps(spheres.Radius + first);
+
+        __m128 viewPosition[3];
+        for (u32 row = 0; row < 3; row++)
+            viewPosition[row] = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(matrix[row][0], x), _mm_mul_ps(matrix[row][1], y)),
+                _mm_add_ps(_mm_mul_ps(matrix[row][2], z), matrix[row][3]));
+        const __m128 viewX = viewPosition[0];
+        const __m128 viewY = viewPosition[1];
+        const __m128 viewZ = viewPosition[2];
+
+        __m128 isVisible;
+        if (isPerspective)
+        {
+            const __m128 right = _mm_add_ps(
+                _mm_mul_ps(rightX, _mm_andnot_ps(signMask, viewX)), _mm_mul_ps(viewZ, rightZ));
+            const __m128 top = _mm_add_ps(
+                _mm_mul_ps(topY, _mm_andnot_ps(signMask, viewY)), _mm_mul_ps(viewZ, topZ));
+            isVisible = _mm_and_ps(_mm_cmplt_ps(right, radius), _mm_cmplt_ps(top, radius));
+        }
+        else
+        {
+            const __m128 right = _mm_andnot_ps(signMask, _mm_add_ps(_mm_mul_ps(rightX, viewX), biasX));
+            const __m128 top = _mm_andnot_ps(signMask, _mm_add_ps(_mm_mul_ps(topY, viewY), biasY));
+            isVisible = _mm_and_ps(
+                _mm_cmplt_ps(right, _mm_add_ps(one, _mm_mul_ps(rightX, radius))),
+                _mm_cmplt_ps(top, _mm_add_ps(one, _mm_mul_ps(topY, radius))));
+        }
+        isVisible = _mm_and_ps(isVisible, _mm_and_ps(
+            _mm_cmple_ps(_mm_sub_ps(viewZ, radius), minusNear),
+            _mm_cmpge_ps(_mm_add_ps(viewZ, radius), minusFar)));
+
+        u32 mask = (u32)_mm_movemask_ps(isVisible);
+        if (spheres.Count - first < WIDTH)
+            mask &= (1u << (spheres.Count - first)) - 1;
+        if (!emitVisible(spheres, first, mask, info.MaxVisible, visibleCount, visible))
+            return;
+    }
+}
+
+LIGHT_CULLER_TARGET_AVX2
+void cullAvx2(const SpheresView& spheres, const LightSphereCuller::CullInfo& info, std::vector<u32>& visible)
+{
+    static constexpr u32 WIDTH = 8;
+
+    const glm::mat4& view = info.View;
+    const FrustumPlanes& frustum = info.Frustum;
+    const ProjectionData& projection = info.Projection;
+    const bool isPerspective = info.Type == CameraType::Perspective;
+
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 rightX = _mm256_set1_ps(frustum.RightX);
+    const __m256 rightZ = _mm256_set1_ps(frustum.RightZ);
+    const __m256 topY = _mm256_set1_ps(frustum.TopY);
+    const __m256 topZ = _mm256_set1_ps(frustum.TopZ);
+    const __m256 minusNear = _mm256_set1_ps(-frustum.Near);
+    const __m256 minusFar = _mm256_set1_ps(-frustum.Far);
+    const __m256 biasX = _mm256_set1_ps(projection.BiasX);
+    const __m256 biasY = _mm256_set1_ps(projection.BiasY);
+    __m256 matrix[3][4];
+    for (u32 row = 0; row < 3; row++)
+        for (u32 column = 0; column < 4; column++)
+            matrix[row][column] = _mm256_set1_ps(view[column][row]);
+
+    u32 visibleCount = 0;
+    for (u32 first = 0; first < spheres.Count; first += WIDTH)
+    {
+        const __m256 x = _mm256_loadu_ps(spheres.CenterX + first);
+        const __m256 y = _mm256_loadu_ps(spheres.CenterY + first);
+        const __m256 z = _mm256_loadu_ps(spheres.CenterZ + first);
+        const __m256 radius = _mm256_loadu_ps(spheres.Radius + first);
+
+        __m256 viewPosition[3];
+        for (u32 row = 0; row < 3; row++)
+            viewPosition[row] = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(matrix[row][0], x), _mm256_mul_ps(matrix[row][1], y)),
+                _mm256_add_ps(_mm256_mul_ps(matrix[row][2], z), matrix[row][3]));
+        const __m256 viewX = viewPosition[0];
+        const __m256 viewY = viewPosition[1];
+        const __m256 viewZ = viewPosition[2];
+
+        __m256 isVisible;
+        if (isPerspective)
+        {
+            const __m256 right = _mm256_add_ps(
+                _mm256_mul_ps(rightX, _mm256_andnot_ps(signMask, viewX)), _mm256_mul_ps(viewZ, rightZ));
+            const __m256 top = _mm256_add_ps(
+                _mm256_mul_ps(topY, _mm256_andnot_ps(signMask, viewY)), _mm256_mul_ps(viewZ, topZ));
+            isVisible = _mm256_and_ps(
+                _mm256_cmp_ps(right, radius, _CMP_LT_OQ), _mm256_cmp_ps(top, radius, _CMP_LT_OQ));
+        }
+        else
+        {
+            const __m256 right = _mm256_andnot_ps(signMask, _mm256_add_ps(_mm256_mul_ps(rightX, viewX), biasX));
+            const __m256 top = _mm256_andnot_ps(signMask, _mm256_add_ps(_mm256_mul_ps(topY, viewY), biasY));
+            isVisible = _mm256_and_ps(
+                _mm256_cmp_ps(right, _mm256_add_ps(one, _mm256_mul_ps(rightX, radius)), _CMP_LT_OQ),
+                _mm256_cmp_ps(top, _mm256_add_ps(one, _mm256_mul_ps(topY, radius)), _CMP_LT_OQ));
+        }
+        isVisible = _mm256_and_ps(isVisible, _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_sub_ps(viewZ, radius), minusNear, _CMP_LE_OQ),
+            _mm256_cmp_ps(_mm256_add_ps(viewZ, radius), minusFar, _CMP_GE_OQ)));
+
+        u32 mask = (u32)_mm256_movemask_ps(isVisible);
+        if (spheres.Count - first < WIDTH)
+            mask &= (1u << (spheres.Count - first)) - 1;
+        if (!emitVisible(spheres, first, mask, info.MaxVisible, visibleCount, visible))
+            return;
+    }
+}
+
+bool cpuSupportsAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    i32 cpuInfo[4];
+    __cpuid(cpuInfo, 0);
+    if (cpuInfo[0] < 7)
+        return false;
+    __cpuid(cpuInfo, 1);
+    static constexpr i32 OS_XSAVE_BIT = 1 << 27;
+    static constexpr i32 AVX_BIT = 1 << 28;
+    if ((cpuInfo[2] & OS_XSAVE_BIT) == 0 || (cpuInfo[2] & AVX_BIT) == 0)
+        return false;
+    /* the os has to preserve ymm registers */
+    if ((_xgetbv(0) & 0b110) != 0b110)
+        return false;
+    __cpuidex(cpuInfo, 7, 0);
+    static constexpr i32 AVX2_BIT = 1 << 5;
+
+    return (cpuInfo[1] & AVX2_BIT) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+}
+
+LightSphereCuller::SimdPath LightSphereCuller::BestSimdPath()
+{
+#ifdef LIGHT_CULLER_X86
+    static const SimdPath BEST_PATH = cpuSupportsAvx2() ? SimdPath::Avx2 : SimdPath::Sse;
+
+    return BEST_PATH;
+#else
+    return SimdPath::Scalar;
+#endif
+}
+
+void LightSphereCuller::Clear()
+{
+    m_CenterX.clear();
+    m_CenterY.clear();
+    m_CenterZ.clear();
+    m_Radius.clear();
+    m_Payload.clear();
+    m_Count = 0;
+}
+
+void LightSphereCuller::Add(const glm::vec3& center, f32 radius, u32 payload)
+{
+    if (m_Count % MAX_SIMD_WIDTH == 0)
+    {
+        const u32 paddedSize = m_Count + MAX_SIMD_WIDTH;
+        m_CenterX.resize(paddedSize, 0.0f);
+        m_CenterY.resize(paddedSize, 0.0f);
+        m_CenterZ.resize(paddedSize, 0.0f);
+        m_Radius.resize(paddedSize, 0.0f);
+        m_Payload.resize(paddedSize, 0);
+    }
+
+    m_CenterX[m_Count] = center.x;
+    m_CenterY[m_Count] = center.y;
+    m_CenterZ[m_Count] = center.z;
+    m_Radius[m_Count] = radius;
+    m_Payload[m_Count] = payload;
+    m_Count++;
+}
+
+void LightSphereCuller::Cull(const CullInfo& info, std::vector<u32>& visible, SimdPath path) const
+{
+    if (info.MaxVisible == 0)
+        return;
+
+    const SpheresView spheres = {
+        .CenterX = m_CenterX.data(),
+        .CenterY = m_CenterY.data(),
+        .CenterZ = m_CenterZ.data(),
+        .Radius = m_Radius.data(),
+        .Payload = m_Payload.data(),
+        .Count = m_Count};
+
+    switch (path)
+    {
+#ifdef LIGHT_CULLER_X86
+    case SimdPath::Avx2:
+        ASSERT(BestSimdPath() == SimdPath::Avx2, "Avx2 is not supported by this cpu")
+        cullAvx2(spheres, info, visible);
+        return;
+    case SimdPath::Sse:
+        cullSse(spheres, info, visible);
+        return;
+#endif
+    case SimdPath::Scalar:
+    default:
+        cullScalar(spheres, info, visible);
+        return;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Core/Camera.h"
+
+#include <CoreLib/core.h>
+
+#include <vector>
+
+/* bounding spheres of point lights in structure-of-arrays layout,
+ * culled against a camera frustum 8 (avx2) or 4 (sse) spheres at a time */
+class LightSphereCuller
+{
+public:
+    static constexpr u32 MAX_SIMD_WIDTH = 8;
+    enum class SimdPath : u8 { Scalar, Sse, Avx2 };
+    struct CullInfo
+    {
+        glm::mat4 View{1.0f};
+        FrustumPlanes Frustum{};
+        ProjectionData Projection{};
+        CameraType Type{CameraType::Perspective};
+        u32 MaxVisible{~0u};
+    };
+public:
+    /* the widest path supported by both the build and the cpu */
+    static SimdPath BestSimdPath();
+
+    void Clear();
+    /* `payload` is what `Cull` reports for this sphere */
+    void Add(const glm::vec3& center, f32 radius, u32 payload);
+    u32 Count() const { return m_Count; }
+
+    /* appends payloads of visible spheres to `visible`, in the order they were added;
+     * stops after `MaxVisible` spheres. All paths produce exactly the same result */
+    void Cull(const CullInfo& info, std::vector<u32>& visible, SimdPath path = BestSimdPath()) const;
+private:
+    /* arrays are padded to `MAX_SIMD_WIDTH`, so that the simd paths never have a partial load */
+    std::vector<f32> m_CenterX;
+    std::vector<f32> m_CenterY;
+    std::vector<f32> m_CenterZ;
+    std::vector<f32> m_Radius;
+    std::vector<u32> m_Payload;
+    u32 m_Count{0};
+};
@@ -2,52 +2,239 @@
 
 #include "LightZBinner.h"
 
+#include "FrameContext.h"
 #include "Core/Camera.h"
 #include "cvars/CVarSystem.h"
 #include "Scene/SceneLight.h"
+#include "Vulkan/Device.h"
 
-ZBins LightZBinner::ZBinLights(SceneLight& light, const Camera& camera)
+#include <CoreLib/Jobs/ThreadPool.h>
+
+namespace
+{
+/* binning a chunk has to reset its bins, so it is not worth it for too few lights */
+constexpr u32 MIN_LIGHTS_PER_CHUNK = 1024;
+constexpr u32 BINS_PER_MERGE_CHUNK = 1024;
+
+/* the first bin at or after `bin` that is not set yet, `next` is compressed along the way */
+u32 nextUnsetBin(u16* next, u32 bin)
+{
+    while (next[bin] != bin)
+    {
+        next[bin] = next[next[bin]];
+        bin = next[bin];
+    }
+
+    return bin;
+}
+}
+
+LightZBinner LightZBinner::Create(DeletionQueue& deletionQueue)
+{
+    LightZBinner binner = {};
+    for (Buffer& bins : binner.m_Bins)
+        bins = Device::CreateBuffer({
+            .Description = {
+                .SizeBytes = sizeof(ZBins::Bin) * LIGHT_TILE_BINS_Z,
+                .Usage = BufferUsage::Ordinary | BufferUsage::Storage | BufferUsage::Mappable
+            },
+            .PersistentMapping = true
+        }, deletionQueue);
+
+    return binner;
+}
+
+Buffer LightZBinner::GetBins(const FrameContext& ctx) const
 {
-    ZBins bins = {};
+    return m_Bins[ctx.FrameNumber];
+}
 
+void LightZBinner::ZBinLights(const SceneLight& light, const Camera& camera, FrameContext& ctx)
+{
     /* bins are uniform in z */
     const f32 maxLightCullDistance = *CVars::Get().GetF32CVar("Renderer.Limits.MaxLightCullDistance"_hsv);
     const FrustumPlanes frustum = camera.GetFrustumPlanes(maxLightCullDistance);
-    f32 zSpan = frustum.Far - frustum.Near;
-    u16 pointLightIndex = 0;
-    for (auto& commonLight : light.VisibleLights())
+
+    /* host writes are visible to the frame's submit, and the buffer is not in use by the frames in flight */
+    ZBins::Bin* bins = (ZBins::Bin*)GetBins(ctx).GetMappedAddress();
+    ZBinLights(light.VisibleLights(), camera.GetView(), frustum.Far - frustum.Near, {bins, LIGHT_TILE_BINS_Z});
+}
+
+void LightZBinner::ZBinLights(Span<const lux::CommonLight> lights, const glm::mat4& view, f32 zSpan,
+    Span<ZBins::Bin> bins)
+{
+    ASSERT(bins.size() == LIGHT_TILE_BINS_Z, "Expected {} bins", LIGHT_TILE_BINS_Z)
+    lux::ThreadPool& threadPool = lux::ThreadPool::Global();
+
+    const u32 lightCount = (u32)lights.size();
+    const u32 chunkCount = std::clamp(lightCount / MIN_LIGHTS_PER_CHUNK, 1u, threadPool.Concurrency());
+    const u32 chunkSize = std::max(lux::ThreadPool::ChunkCount(lightCount, chunkCount), 1u);
+
+    /* `resize` does not allocate once the storage has grown to the largest light count */
+    m_ChunkPointBins.resize(chunkCount * LIGHT_TILE_BINS_Z);
+    m_ChunkSpotBins.resize(chunkCount * LIGHT_TILE_BINS_Z);
+    m_ChunkNextBinMin.resize(chunkCount * (LIGHT_TILE_BINS_Z + 1));
+    m_ChunkNextBinMax.resize(chunkCount * (LIGHT_TILE_BINS_Z + 1));
+    m_ChunkPointLightCounts.resize(chunkCount);
+    m_ChunkSpotLightCounts.resize(chunkCount);
+    m_PointBinRanges.resize(lightCount);
+    m_SpotBinRanges.resize(lightCount);
+
+    threadPool.ParallelFor(chunkCount, 1, [&](u32 chunkIndex, u32, u32)
+    {
+        const u32 first = std::min(chunkIndex * chunkSize, lightCount);
+        const u32 count = std::min(chunkSize, lightCount - first);
+        ZBinChunk(lights.subspan(first, count), view, zSpan, chunkIndex, first);
+    });
+
+    /* exclusive scan turns the light counts of the chunks into the index of their first light of each type */
+    u32 pointLightCount = 0;
+    for (u32& chunkPointLights : m_ChunkPointLightCounts)
+        pointLightCount += std::exchange(chunkPointLights, pointLightCount);
+    u32 spotLightCount = 0;
+    for (u32& chunkSpotLights : m_ChunkSpotLightCounts)
+        spotLightCount += std::exchange(chunkSpotLights, spotLightCount);
+    ASSERT(pointLightCount + spotLightCount <= ZBins::Bin::NO_LIGHT,
+        "Too many lights for z binning: {}", pointLightCount + spotLightCount)
+
+    /* the min of a bin comes from the first chunk that has it set, and the max from the last one;
+     * spot lights follow the point lights in the index space */
+    auto firstInChunks = [&](const std::vector<ZBins::Bin>& chunkBins, const std::vector<u32>& chunkOffsets,
+        u32 binIndex) -> u32
+    {
+        for (u32 chunk = 0; chunk < chunkCount; chunk++)
+        {
+            const ZBins::Bin& chunkBin = chunkBins[chunk * LIGHT_TILE_BINS_Z + binIndex];
+            if (chunkBin.LightMin != ZBins::Bin::NO_LIGHT)
+                return chunkOffsets[chunk] + chunkBin.LightMin;
+        }
+        return ZBins::Bin::NO_LIGHT;
+    };
+    auto lastInChunks = [&](const std::vector<ZBins::Bin>& chunkBins, const std::vector<u32>& chunkOffsets,
+        u32 binIndex) -> u32
+    {
+        for (u32 chunk = chunkCount; chunk > 0; chunk--)
+        {
+            const ZBins::Bin& chunkBin = chunkBins[(chunk - 1) * LIGHT_TILE_BINS_Z + binIndex];
+            if (chunkBin.LightMin != ZBins::Bin::NO_LIGHT)
+                return chunkOffsets[chunk - 1] + chunkBin.LightMax;
+        }
+        return ZBins::Bin::NO_LIGHT;
+    };
+    threadPool.ParallelFor(LIGHT_TILE_BINS_Z, BINS_PER_MERGE_CHUNK, [&](u32, u32 binFirst, u32 binEnd)
     {
-        switch (commonLight.Type)
+        for (u32 binIndex = binFirst; binIndex < binEnd; binIndex++)
+        {
+            ZBins::Bin bin = {};
+            const u32 pointMin = firstInChunks(m_ChunkPointBins, m_ChunkPointLightCounts, binIndex);
+            if (pointMin != ZBins::Bin::NO_LIGHT)
+            {
+                bin.LightMin = (u16)pointMin;
+                bin.LightMax = (u16)lastInChunks(m_ChunkPointBins, m_ChunkPointLightCounts, binIndex);
+            }
+            const u32 spotMin = firstInChunks(m_ChunkSpotBins, m_ChunkSpotLightCounts, binIndex);
+            if (spotMin != ZBins::Bin::NO_LIGHT)
+            {
+                if (pointMin == ZBins::Bin::NO_LIGHT)
+                    bin.LightMin = (u16)(pointLightCount + spotMin);
+                bin.LightMax = (u16)(pointLightCount + lastInChunks(m_ChunkSpotBins, m_ChunkSpotLightCounts, binIndex));
+            }
+            bins[binIndex] = bin;
+        }
+    });
+}
+
+void LightZBinner::ZBinChunk(Span<const lux::CommonLight> lights, const glm::mat4& view, f32 zSpan, u32 chunkIndex,
+    u32 rangesOffset)
+{
+    /* the range is clipped to the bins before the conversion, lights behind the camera or past the last bin
+     * are left out */
+    auto toBinRange = [zSpan](f32 distanceMin, f32 distanceMax) -> BinRange
+    {
+        const f32 first = std::max(distanceMin, 0.0f) / zSpan * LIGHT_TILE_BINS_Z;
+        const f32 last = distanceMax / zSpan * LIGHT_TILE_BINS_Z;
+        if (last < 0.0f || first >= (f32)LIGHT_TILE_BINS_Z)
+            return {};
+
+        return {
+            .First = (u32)first,
+            .Last = (u32)std::min(last, (f32)(LIGHT_TILE_BINS_Z - 1))};
+    };
+
+    BinRange* pointRanges = &m_PointBinRanges[rangesOffset];
+    BinRange* spotRanges = &m_SpotBinRanges[rangesOffset];
+    u32 pointLightCount = 0;
+    u32 spotLightCount = 0;
+    for (auto& light : lights)
+    {
+        switch (light.Type)
         {
         case lux::LightType::Point:
             {
-                Sphere sphere = {
-                    .Center = commonLight.PositionDirection,
-                    .Radius = commonLight.Radius
-                };
-                sphere.Center = glm::vec3{camera.GetView() * glm::vec4{sphere.Center, 1.0f}};
-        
-                const f32 distanceMin = std::max(-sphere.Center.z - sphere.Radius, 0.0f);
-                const f32 distanceMax = -sphere.Center.z + sphere.Radius;
-
-                const u32 binMinIndex = (u32)(distanceMin / zSpan * LIGHT_TILE_BINS_Z);
-                const u32 binMaxIndex = std::min((u32)(distanceMax / zSpan * LIGHT_TILE_BINS_Z), LIGHT_TILE_BINS_Z - 1);
-
-                for (u32 binIndex = binMinIndex; binIndex <= binMaxIndex; binIndex++)
-                {
-                    auto& bin = bins.Bins[binIndex];
-                    bin.LightMin = std::min(bin.LightMin, pointLightIndex);
-                    bin.LightMax = std::max(bin.LightMax, pointLightIndex);
-                }
-                pointLightIndex++;
+                /* only the depth of `view * position` is needed, summed in the same order as glm does it */
+                const glm::vec3& position = light.PositionDirection;
+                const f32 depth =
+                    (view[0].z * position.x + view[1].z * position.y) + (view[2].z * position.z + view[3].z);
+                pointRanges[pointLightCount] = toBinRange(-depth - light.Radius, -depth + light.Radius);
+                pointLightCount++;
+                break;
             }
-            break;
-        case lux::LightType::Directional:
         case lux::LightType::Spot:
+            {
+                const Cone cone = light.GetSpotCone().Transform(view);
+                spotRanges[spotLightCount] = toBinRange(
+                    -cone.Extent(glm::vec3(0.0f, 0.0f, 1.0f)),
+                    cone.Extent(glm::vec3(0.0f, 0.0f, -1.0f)));
+                spotLightCount++;
+                break;
+            }
         default:
             break;
         }
     }
-    
-    return bins;
+
+    u16* nextBinMin = &m_ChunkNextBinMin[chunkIndex * (LIGHT_TILE_BINS_Z + 1)];
+    u16* nextBinMax = &m_ChunkNextBinMax[chunkIndex * (LIGHT_TILE_BINS_Z + 1)];
+    BinChunkRanges({pointRanges, pointLightCount}, &m_ChunkPointBins[chunkIndex * LIGHT_TILE_BINS_Z],
+        nextBinMin, nextBinMax);
+    BinChunkRanges({spotRanges, spotLightCount}, &m_ChunkSpotBins[chunkIndex * LIGHT_TILE_BINS_Z],
+        nextBinMin, nextBinMax);
+
+    m_ChunkPointLightCounts[chunkIndex] = pointLightCount;
+    m_ChunkSpotLightCounts[chunkIndex] = spotLightCount;
+}
+
+void LightZBinner::BinChunkRanges(Span<const BinRange> ranges, ZBins::Bin* bins, u16* nextBinMin, u16* nextBinMax)
+{
+    std::fill_n(bins, LIGHT_TILE_BINS_Z, ZBins::Bin{});
+    std::iota(nextBinMin, nextBinMin + LIGHT_TILE_BINS_Z + 1, (u16)0);
+    std::iota(nextBinMax, nextBinMax + LIGHT_TILE_BINS_Z + 1, (u16)0);
+
+    /* every bin is set at most once per pass: the min pass goes front to back, so the first light to reach a bin
+     * has the smallest index, and the max pass goes back to front */
+    for (u32 light = 0; light < ranges.size(); light++)
+    {
+        const BinRange range = ranges[light];
+        if (range.First > range.Last)
+            continue;
+        for (u32 bin = nextUnsetBin(nextBinMin, range.First); bin <= range.Last;
+            bin = nextUnsetBin(nextBinMin, bin + 1))
+        {
+            bins[bin].LightMin = (u16)light;
+            nextBinMin[bin] = (u16)(bin + 1);
+        }
+    }
+
+    for (u32 light = (u32)ranges.size(); light > 0; light--)
+    {
+        const BinRange range = ranges[light - 1];
+        if (range.First > range.Last)
+            continue;
+        for (u32 bin = nextUnsetBin(nextBinMax, range.First); bin <= range.Last;
+            bin = nextUnsetBin(nextBinMax, bin + 1))
+        {
+            bins[bin].LightMax = (u16)(light - 1);
+            nextBinMax[bin] = (u16)(bin + 1);
+        }
+    }
 }
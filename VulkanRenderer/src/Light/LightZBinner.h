@@ -1,13 +1,23 @@
 #pragma once
 
 #include "Settings.h"
+#include "Rendering/Buffer/Buffer.h"
 
 #include <CoreLib/types.h>
+#include <CoreLib/Containers/Span.h>
 
+#include <array>
 #include <vector>
 
 class Camera;
+class DeletionQueue;
 class SceneLight;
+struct FrameContext;
+
+namespace lux
+{
+struct CommonLight;
+}
 
 struct ZBins
 {
@@ -17,13 +27,46 @@ struct ZBins
         u16 LightMin{NO_LIGHT};
         u16 LightMax{0};
     };
-    std::vector<Bin> Bins{std::vector(LIGHT_TILE_BINS_Z, Bin{})};
 };
 
+/* bins lights uniformly in view depth; a bin holds the min and max index of the local lights that overlap it,
+ * where spot lights are indexed after all the point lights.
+ * All the storage is kept between the frames, and the bins are written straight into persistently mapped memory,
+ * one buffer per frame in flight, so that the frame reads the bins of its own lights */
 class LightZBinner
 {
 public:
-    // todo: this allocates 32 KiB every frame... maybe this is not the best way, although I doubt it matters at all
-    // todo: maybe keep bins on a stack inside of std::array?
-    static ZBins ZBinLights(SceneLight& light, const Camera& camera);
+    static LightZBinner Create(DeletionQueue& deletionQueue);
+
+    void ZBinLights(const SceneLight& light, const Camera& camera, FrameContext& ctx);
+    /* `LIGHT_TILE_BINS_Z` bins of the frame */
+    Buffer GetBins(const FrameContext& ctx) const;
+
+    /* bins `lights` into `bins`, `zSpan` is the view depth covered by all the bins;
+     * lights are split into chunks that are binned in parallel, and then merged per bin */
+    void ZBinLights(Span<const lux::CommonLight> lights, const glm::mat4& view, f32 zSpan, Span<ZBins::Bin> bins);
+private:
+    /* first and last bin of a light, empty if `First > Last` */
+    struct BinRange
+    {
+        u32 First{1};
+        u32 Last{0};
+    };
+    void ZBinChunk(Span<const lux::CommonLight> lights, const glm::mat4& view, f32 zSpan, u32 chunkIndex,
+        u32 rangesOffset);
+    /* `ranges` are indexed by light, `nextBinMin` and `nextBinMax` are scratch */
+    static void BinChunkRanges(Span<const BinRange> ranges, ZBins::Bin* bins, u16* nextBinMin, u16* nextBinMax);
+private:
+    std::array<Buffer, BUFFERED_FRAMES> m_Bins{};
+
+    /* `LIGHT_TILE_BINS_Z` bins per chunk, with light indices local to the chunk and to the light type */
+    std::vector<ZBins::Bin> m_ChunkPointBins;
+    std::vector<ZBins::Bin> m_ChunkSpotBins;
+    /* `LIGHT_TILE_BINS_Z + 1` entries per chunk, each one points towards the next bin that is not yet set */
+    std::vector<u16> m_ChunkNextBinMin;
+    std::vector<u16> m_ChunkNextBinMax;
+    std::vector<u32> m_ChunkPointLightCounts;
+    std::vector<u32> m_ChunkSpotLightCounts;
+    std::vector<BinRange> m_PointBinRanges;
+    std::vector<BinRange> m_SpotBinRanges;
 };
@@ -6,6 +6,7 @@
 #include "RenderGraph/Passes/Generated/LightClustersCompactBindGroupRG.generated.h"
 #include "RenderGraph/Passes/Generated/LightClustersCompactCreateDispatchBindGroupRG.generated.h"
 #include "RenderGraph/Passes/Generated/LightClustersCompactIdentifyBindGroupRG.generated.h"
+#include "RenderGraph/Passes/Generated/LightClustersUpdateBindGroupRG.generated.h"
 #include "Scene/SceneLight.h"
 
 namespace
@@ -23,6 +24,10 @@ struct PassDataCrateDispatch
 {
     RG::BufferResource DispatchIndirect{};
 };
+struct PassDataUpdate
+{
+    RG::BufferResource Clusters{};
+};
 struct PassDataCompact
 {
     RG::BufferResource ActiveClusters{};
@@ -64,7 +69,7 @@ PassDataIdentify& identifyActiveClusters(StringId name, RG::Graph& renderGraph,
 }
 
 PassDataCompactPrepare& compactActiveClustersPrepare(StringId name, RG::Graph& renderGraph,
-    RG::BufferResource clusterVisibility)
+    RG::BufferResource clusterVisibility, RG::BufferResource clusters, u32 generation)
 {
     using namespace RG;
     using PassData = PassDataWithBind<PassDataCompactPrepare, LightClustersCompactBindGroupRG>;
@@ -83,6 +88,7 @@ PassDataCompactPrepare& compactActiveClustersPrepare(StringId name, RG::Graph& r
             passData.ActiveClustersCount = graph.Upload(passData.ActiveClustersCount, 0);
             
             passData.BindGroup.SetResourcesVisibility(clusterVisibility);
+            passData.BindGroup.SetResourcesClusters(clusters);
         },
         [=](const PassData& passData, FrameContext& frameContext, const Graph&)
         {
@@ -91,6 +97,9 @@ PassDataCompactPrepare& compactActiveClustersPrepare(StringId name, RG::Graph& r
             
             auto& cmd = frameContext.CommandList;
             passData.BindGroup.BindCompute(cmd);
+            cmd.PushConstants({
+                .PipelineLayout = passData.BindGroup.Shader->GetLayout(),
+                .Data = {generation}});
             cmd.Dispatch({
                 .Invocations = {LIGHT_CLUSTER_BINS_X, LIGHT_CLUSTER_BINS_Y * LIGHT_CLUSTER_BINS_Z, 1},
                 .GroupSize = passData.BindGroup.GetCompactClustersGroupSize()
@@ -128,17 +137,60 @@ PassDataCrateDispatch& createIndirectDispatch(StringId name, RG::Graph& renderGr
         });
 }
 
-PassDataCompact& compactActiveClusters(StringId name, RG::Graph& renderGraph,
+PassDataUpdate& updateDirtyLights(StringId name, RG::Graph& renderGraph,
     const Passes::LightClustersBin::ExecutionInfo& info)
 {
     using namespace RG;
+    using PassData = PassDataWithBind<PassDataUpdate, LightClustersUpdateBindGroupRG>;
+
+    const u32 dirtyLightCount = (u32)info.DirtyLights.size();
+    
+    return renderGraph.AddRenderPass<PassData>(name,
+        [&](Graph& graph, PassData& passData)
+        {
+            CPU_PROFILE_FRAME("Lights.Clusters.Update.Setup")
+
+            passData.BindGroup = LightClustersUpdateBindGroupRG(graph);
+
+            BufferResource dirtyLights = graph.Create("Clusters.DirtyLights"_hsv,
+                RGBufferDescription{.SizeBytes = dirtyLightCount * sizeof(u32)});
+            dirtyLights = graph.Upload(dirtyLights, info.DirtyLights);
+
+            passData.Clusters = passData.BindGroup.SetResourcesClusters(info.Clusters);
+            passData.BindGroup.SetResourcesDirtyLights(dirtyLights);
+            passData.BindGroup.SetResourcesPointLights(info.PointLights);
+            passData.BindGroup.SetResourcesSpotLights(info.SpotLights);
+            passData.BindGroup.SetResourcesView(info.ViewInfo);
+        },
+        [=, generation = info.Generation](const PassData& passData, FrameContext& frameContext, const Graph&)
+        {
+            CPU_PROFILE_FRAME("Lights.Clusters.Update")
+            GPU_PROFILE_FRAME("Lights.Clusters.Update")
+
+            auto& cmd = frameContext.CommandList;
+            passData.BindGroup.BindCompute(cmd);
+            cmd.PushConstants({
+                .PipelineLayout = passData.BindGroup.Shader->GetLayout(),
+                .Data = {generation, dirtyLightCount}});
+            cmd.Dispatch({
+                .Invocations = {LIGHT_CLUSTER_BINS, 1, 1},
+                .GroupSize = passData.BindGroup.GetUpdateLightsClustersGroupSize()
+            });
+        });
+}
+
+PassDataCompact& compactActiveClusters(StringId name, RG::Graph& renderGraph,
+    const Passes::LightClustersBin::ExecutionInfo& info, RG::BufferResource clusters)
+{
+    using namespace RG;
 
     return renderGraph.AddRenderPass<PassDataCompact>(name,
         [&](Graph& graph, PassDataCompact& passData)
         {
             auto& identify = identifyActiveClusters(name.Concatenate(".Identify"), graph,
                 info.ClusterVisibility, info.Depth, info.ViewInfo);
-            auto& compact = compactActiveClustersPrepare(name.Concatenate(".Prepare"), graph, identify.Visibility);
+            auto& compact = compactActiveClustersPrepare(name.Concatenate(".Prepare"), graph, identify.Visibility,
+                clusters, info.Generation);
             auto& createDispatch = createIndirectDispatch(name.Concatenate(".CreateDispatch"), graph,
                 compact.ActiveClustersCount);
 
@@ -166,25 +218,35 @@ Passes::LightClustersBin::PassData& Passes::LightClustersBin::addToGraph(StringI
         {
             CPU_PROFILE_FRAME("Lights.Clusters.Bin.Setup")
 
-            auto& compact = compactActiveClusters(name.Concatenate(".Compact"), graph, info);
+            /* the clusters that are already binned only need the changed lights rebinned */
+            BufferResource clusters = info.Clusters;
+            if (!info.DirtyLights.empty())
+                clusters = updateDirtyLights(name.Concatenate(".Update"), graph, info).Clusters;
+
+            auto& compact = compactActiveClusters(name.Concatenate(".Compact"), graph, info, clusters);
 
             passData.BindGroup = LightClustersBinBindGroupRG(graph);
 
-            passData.Clusters = passData.BindGroup.SetResourcesClusters(info.Clusters);
+            passData.Clusters = passData.BindGroup.SetResourcesClusters(clusters);
             passData.DispatchIndirect = graph.ReadBuffer(compact.DispatchIndirect, ResourceAccessFlags::Indirect);
 
             passData.BindGroup.SetResourcesActiveClusters(compact.ActiveClusters);
             passData.BindGroup.SetResourcesActiveClustersCount(compact.ActiveClustersCount);
             passData.BindGroup.SetResourcesView(info.ViewInfo);
             passData.BindGroup.SetResourcesPointLights(info.PointLights);
+            passData.BindGroup.SetResourcesSpotLights(info.SpotLights);
         },
-        [=](const PassDataBind& passData, FrameContext& frameContext, const Graph& graph)
+        [=, generation = info.Generation](const PassDataBind& passData, FrameContext& frameContext,
+            const Graph& graph)
         {
             CPU_PROFILE_FRAME("Lights.Clusters.Bin")
             GPU_PROFILE_FRAME("Lights.Clusters.Bin")
 
             auto& cmd = frameContext.CommandList;
             passData.BindGroup.BindCompute(cmd);
+            cmd.PushConstants({
+                .PipelineLayout = passData.BindGroup.Shader->GetLayout(),
+                .Data = {generation}});
             cmd.DispatchIndirect({
                 .Buffer = graph.GetBuffer(passData.DispatchIndirect)
             });
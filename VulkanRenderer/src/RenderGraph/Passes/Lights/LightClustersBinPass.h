@@ -2,6 +2,8 @@
 
 #include "RenderGraph/RGResource.h"
 
+#include <CoreLib/Containers/Span.h>
+
 class SceneLight;
 
 namespace Passes::LightClustersBin
@@ -13,6 +15,11 @@ struct ExecutionInfo
     RG::BufferResource ClusterVisibility{};
     RG::ImageResource Depth{};
     RG::BufferResource PointLights{};
+    RG::BufferResource SpotLights{};
+    /* visible clusters with a different generation are binned from scratch */
+    u32 Generation{0};
+    /* lights to rebin in every cluster of `Generation` */
+    Span<const u32> DirtyLights{};
 };
 
 struct PassData
@@ -18,10 +18,8 @@ Passes::LightClustersSetup::PassData& Passes::LightClustersSetup::addToGraph(Str
 
             passData.BindGroup = LightClustersSetupBindGroupRG(graph);
 
-            passData.Clusters = passData.BindGroup.SetResourcesClusters(graph.Create("Clusters"_hsv,
-                RGBufferDescription{.SizeBytes = LIGHT_CLUSTER_BINS * sizeof(LightCluster)}));
-            passData.ClusterVisibility = passData.BindGroup.SetResourcesVisibility(graph.Create("Cluster.Visibility"_hsv,
-                RGBufferDescription{.SizeBytes = LIGHT_CLUSTER_BINS * sizeof(u8)}));
+            passData.Clusters = passData.BindGroup.SetResourcesClusters(info.Clusters);
+            passData.ClusterVisibility = passData.BindGroup.SetResourcesVisibility(info.ClusterVisibility);
             passData.BindGroup.SetResourcesView(info.ViewInfo);
         },
         [=](const PassDataBind& passData, FrameContext& frameContext, const Graph&)
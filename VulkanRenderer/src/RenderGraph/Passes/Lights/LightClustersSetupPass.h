@@ -8,6 +8,9 @@ namespace Passes::LightClustersSetup
 struct ExecutionInfo
 {
     RG::BufferResource ViewInfo{};
+    /* both persist between the frames, setup is only needed when the projection changes */
+    RG::BufferResource Clusters{};
+    RG::BufferResource ClusterVisibility{};
 };
 
 struct PassData
@@ -23,6 +23,7 @@ Passes::LightTilesBin::PassData& Passes::LightTilesBin::addToGraph(StringId name
             passData.Tiles = passData.BindGroup.SetResourcesTiles(info.Tiles);
             passData.BindGroup.SetResourcesDepth(info.Depth);
             passData.BindGroup.SetResourcesPointLights(info.PointLights);
+            passData.BindGroup.SetResourcesSpotLights(info.SpotLights);
             passData.BindGroup.SetResourcesView(info.ViewInfo);
         },
         [=, description = renderGraph.GetImageDescription(info.Depth)]
@@ -11,6 +11,7 @@ struct ExecutionInfo
     RG::BufferResource Tiles{};
     RG::ImageResource Depth{};
     RG::BufferResource PointLights{};
+    RG::BufferResource SpotLights{};
 };
 
 struct PassData
@@ -79,18 +79,14 @@ PassData& addToGraph(StringId name, RG::Graph& renderGraph, const ExecutionInfo&
             resources.VisibilityCountData = passData.BindGroup.SetResourcesVisibilityCountData(
                 resources.VisibilityCountData);
 
-            for (u32 view = 0; view < resources.VisibilityCount; view++)
-            {
-                for (u32 bucket = 0; bucket < bucketCount; bucket++)
-                {
-                    const u32 index = view * bucketCount + bucket;
-                    resources.Draws[index] = passData.BindGroup.SetResourcesDrawCommands(resources.Draws[index], index);
-                    resources.DrawInfos[index] =
-                        passData.BindGroup.SetResourcesDrawInfos(resources.DrawInfos[index], index);
-
-                    resources.DrawInfos[index] = graph.Upload(resources.DrawInfos[index], SceneBucketDrawInfo{});
-                }
-            }
+            /* the reocclusion stage refills the ranges of the first one, its draws are in the same buckets */
+            if (info.Stage != SceneVisibilityStage::Reocclusion)
+                resources.InitDraws(*info.MultiviewVisibility, info.BucketsMask, graph);
+            resources.Draws = passData.BindGroup.SetResourcesDrawCommands(resources.Draws);
+            resources.DrawInfos = passData.BindGroup.SetResourcesDrawInfos(resources.DrawInfos);
+            resources.DrawOffsets = passData.BindGroup.SetResourcesDrawOffsets(resources.DrawOffsets);
+            resources.DrawInfos = graph.Upload(resources.DrawInfos,
+                std::vector<SceneBucketDrawInfo>(std::max(1u, (u32)resources.DrawRanges.Ranges().size())));
 
             passData.Dispatch = graph.ReadBuffer(dispatch, ResourceAccessFlags::Indirect);
         },
@@ -103,7 +99,7 @@ PassData& addToGraph(StringId name, RG::Graph& renderGraph, const ExecutionInfo&
             {
                 u32 ViewCount{0};
                 u32 BucketCount{0};
-                u64 AvailableBucketsMask{~0lu};
+                SceneBucketBits AvailableBucketsMask{SceneBucketBits::All()};
             };
             
             auto& cmd = frameContext.CommandList;
@@ -10,7 +10,7 @@ struct ExecutionInfo
     ::SceneMultiviewVisibility* MultiviewVisibility{nullptr};
     SceneVisibilityPassesResources* Resources{nullptr};
     SceneVisibilityStage Stage{SceneVisibilityStage::Cull};
-    u64 BucketsMask{~0lu};
+    SceneBucketBits BucketsMask{SceneBucketBits::All()};
 };
 
 struct PassData
@@ -27,6 +27,7 @@ Passes::SceneMultiviewRenderObjectVisibility::PassData& Passes::SceneMultiviewRe
 
             if (info.Stage != SceneVisibilityStage::Reocclusion)
                 resources.Init(multiview, graph);
+            resources.CandidateRanges = passData.BindGroup.SetResourcesCandidateRanges(resources.CandidateRanges);
 
             resources.VisibleRenderObjectsData = passData.BindGroup.SetResourcesVisibleRenderObjects(
                 resources.VisibleRenderObjectsData);
@@ -56,8 +57,9 @@ Passes::SceneMultiviewRenderObjectVisibility::PassData& Passes::SceneMultiviewRe
 
             struct PushConstants
             {
-                u32 RenderObjectCount{0};
+                u32 CandidateCount{0};
                 u32 ViewCount{0};
+                u32 CandidateRangeCount{0};
             };
             
             auto& cmd = frameContext.CommandList;
@@ -65,12 +67,13 @@ Passes::SceneMultiviewRenderObjectVisibility::PassData& Passes::SceneMultiviewRe
             cmd.PushConstants({
                 .PipelineLayout = passData.BindGroup.Shader->GetLayout(), 
                 .Data = {PushConstants{
-                    .RenderObjectCount = passData.Resources->RenderObjectCount,
-                    .ViewCount = passData.Resources->VisibilityCount
+                    .CandidateCount = passData.Resources->CandidateCount,
+                    .ViewCount = passData.Resources->VisibilityCount,
+                    .CandidateRangeCount = passData.Resources->CandidateRangeCount
                 }}
             });
             cmd.Dispatch({
-               .Invocations = {passData.Resources->RenderObjectCount, 1, 1},
+               .Invocations = {passData.Resources->CandidateCount, 1, 1},
                .GroupSize = passData.BindGroup.GetRenderObjectVisibilityGroupSize()
             });
         });
@@ -7,6 +7,8 @@
 #include "RenderGraph/Passes/Generated/Types/SceneVisibilityCountDataUniform.generated.h"
 #include "RenderGraph/Passes/Scene/SceneGeometryRGResources.h"
 
+static_assert(sizeof(::gen::SceneVisibilityElement::ViewMask) == sizeof(SceneViewMask));
+
 SceneVisibilityPassesResources SceneVisibilityPassesResources::FromSceneMultiviewVisibility(
     RG::Graph& renderGraph, SceneGeometryRGResources& sceneGeometryRGResources,
     const SceneMultiviewVisibility& sceneMultiviewVisibility)
@@ -46,22 +48,6 @@ SceneVisibilityPassesResources SceneVisibilityPassesResources::FromSceneMultivie
     for (u32 i = 0; i < resources.VisibilityCount; i++)
         resources.Views[i] = renderGraph.Create("View"_hsv, RG::RGBufferDescription{.SizeBytes = sizeof(ViewInfoGPU)});
 
-    const u32 bucketCount = set.BucketCount();
-    ASSERT(bucketCount * resources.VisibilityCount < MAX_DRAW_COMMAND_BUFFERS,
-        "Too many combinations of views and buckets ({})", bucketCount * resources.VisibilityCount)
-    for (u32 view = 0; view < resources.VisibilityCount; view++)
-    {
-        for (u32 bucket = 0; bucket < bucketCount; bucket++)
-        {
-            const u32 index = view * bucketCount + bucket;
-            
-            resources.Draws[index] = renderGraph.Create(StringId("Draws{}_{}", view, bucket),
-                RG::RGBufferDescription{.SizeBytes = resources.MeshletCount * sizeof(IndirectDrawCommand)});
-            resources.DrawInfos[index] = renderGraph.Create(StringId("DrawsInfo{}_{}", view, bucket),
-                RG::RGBufferDescription{.SizeBytes = sizeof(SceneBucketDrawInfo)});
-        }
-    }
-    
     return resources;
 }
 
@@ -69,6 +55,21 @@ void SceneVisibilityPassesResources::Init(const SceneMultiviewVisibility& sceneM
     RG::Graph& renderGraph)
 {
     VisibilityCountData = renderGraph.Upload(VisibilityCountData, ::gen::SceneVisibilityCountData{});
+
+    SceneRenderObjectRanges candidates;
+    sceneMultiviewVisibility.CullInstances(candidates);
+    CandidateCount = candidates.SlotCount();
+    CandidateRangeCount = (u32)candidates.Ranges().size();
+    /* matches `RenderObjectRange` in `renderObjectVisibility.slang` */
+    std::vector<glm::uvec2> candidateRanges;
+    candidateRanges.reserve(std::max(1u, CandidateRangeCount));
+    for (auto& range : candidates.Ranges())
+        candidateRanges.emplace_back(range.First, range.CompactedOffset);
+    if (candidateRanges.empty())
+        candidateRanges.emplace_back(0, 0);
+    CandidateRanges = renderGraph.Create("CandidateRenderObjectRanges"_hsv, RG::RGBufferDescription{
+        .SizeBytes = candidateRanges.size() * sizeof(glm::uvec2)});
+    CandidateRanges = renderGraph.Upload(CandidateRanges, candidateRanges);
     for (u32 i = 0; i < VisibilityCount; i++)
     {
         if (sceneMultiviewVisibility.View({i}).ViewInfo.IsViewInfoGPU())
@@ -76,4 +77,25 @@ void SceneVisibilityPassesResources::Init(const SceneMultiviewVisibility& sceneM
         else
             Views[i] = sceneMultiviewVisibility.View({i}).ViewInfo.AsHandle<RG::BufferResource>();
     }
+}
+
+void SceneVisibilityPassesResources::InitDraws(const SceneMultiviewVisibility& sceneMultiviewVisibility,
+    const SceneBucketBits& bucketsMask, RG::Graph& renderGraph)
+{
+    DrawRanges.Init(VisibilityCount, sceneMultiviewVisibility.ObjectSet().BucketMeshletCounts(), bucketsMask);
+
+    std::vector<u32> drawOffsets;
+    drawOffsets.reserve(std::max(1u, (u32)DrawRanges.Ranges().size()));
+    for (auto& range : DrawRanges.Ranges())
+        drawOffsets.push_back(range.Offset);
+    if (drawOffsets.empty())
+        drawOffsets.push_back(0);
+
+    Draws = renderGraph.Create("Draws"_hsv, RG::RGBufferDescription{
+        .SizeBytes = std::max(1u, DrawRanges.DrawCount()) * sizeof(IndirectDrawCommand)});
+    DrawInfos = renderGraph.Create("DrawInfos"_hsv, RG::RGBufferDescription{
+        .SizeBytes = drawOffsets.size() * sizeof(SceneBucketDrawInfo)});
+    DrawOffsets = renderGraph.Create("DrawOffsets"_hsv, RG::RGBufferDescription{
+        .SizeBytes = drawOffsets.size() * sizeof(u32)});
+    DrawOffsets = renderGraph.Upload(DrawOffsets, drawOffsets);
 }
\ No newline at end of file
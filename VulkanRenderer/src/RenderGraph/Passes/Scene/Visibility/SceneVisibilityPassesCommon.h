@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RenderGraph/RGResource.h"
+#include "Scene/Visibility/SceneDrawRanges.h"
 #include "Scene/Visibility/SceneMultiviewVisibility.h"
 
 struct SceneGeometryRGResources;
@@ -13,14 +14,20 @@ struct SceneVisibilityPassesResources
     RG::BufferResource RenderObjects{};
     RG::BufferResource RenderObjectBuckets{};
     RG::BufferResource RenderObjectHandles{};
+    /* render object ranges that survived cpu instance culling */
+    RG::BufferResource CandidateRanges{};
     std::array<RG::BufferResource, SceneMultiviewVisibility::MAX_VIEWS> Views{};
     std::array<RG::ImageResource, SceneMultiviewVisibility::MAX_VIEWS> Hiz{};
     std::array<RG::ImageResource, SceneMultiviewVisibility::MAX_VIEWS> HizPrevious{};
     std::array<RG::BufferResource, SceneMultiviewVisibility::MAX_VIEWS> MinMaxDepthReductions{};
 
-    static constexpr u32 MAX_DRAW_COMMAND_BUFFERS = MAX_BUCKETS_PER_SET * 2;
-    std::array<RG::BufferResource, MAX_DRAW_COMMAND_BUFFERS> Draws{};
-    std::array<RG::BufferResource, MAX_DRAW_COMMAND_BUFFERS> DrawInfos{};
+    /* the draw commands of all views and buckets, packed into `DrawRanges` */
+    RG::BufferResource Draws{};
+    /* a `SceneBucketDrawInfo` per draw range */
+    RG::BufferResource DrawInfos{};
+    /* the offset of each draw range in `Draws` */
+    RG::BufferResource DrawOffsets{};
+    SceneDrawRanges DrawRanges{};
     
     RG::BufferResource VisibleRenderObjectsData{};
     RG::BufferResource OccludedRenderObjectsData{};
@@ -31,6 +38,8 @@ struct SceneVisibilityPassesResources
     
     u32 VisibilityCount{0};
     u32 RenderObjectCount{0};
+    u32 CandidateCount{0};
+    u32 CandidateRangeCount{0};
     u32 MeshletCount{0};
     
     static SceneVisibilityPassesResources FromSceneMultiviewVisibility(
@@ -39,4 +48,7 @@ struct SceneVisibilityPassesResources
         const SceneMultiviewVisibility& sceneMultiviewVisibility);
 
     void Init(const SceneMultiviewVisibility& sceneMultiviewVisibility, RG::Graph& renderGraph);
+    /* lays out the draw ranges of the buckets of `bucketsMask` and creates the draw buffers for them */
+    void InitDraws(const SceneMultiviewVisibility& sceneMultiviewVisibility, const SceneBucketBits& bucketsMask,
+        RG::Graph& renderGraph);
 };
\ No newline at end of file
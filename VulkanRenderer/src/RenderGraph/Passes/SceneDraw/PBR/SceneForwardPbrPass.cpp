@@ -52,6 +52,7 @@ Passes::SceneForwardPbr::PassData& Passes::SceneForwardPbr::addToGraph(StringId
             passData.BindGroup.SetResourcesSsao(info.SSAO.SSAO);
             passData.BindGroup.SetResourcesDirectionalLights(info.DirectionalLights);
             passData.BindGroup.SetResourcesPointLights(info.PointLights);
+            passData.BindGroup.SetResourcesSpotLights(info.SpotLights);
             if (useTiled || useHybrid)
             {
                 passData.BindGroup.SetResourcesLightZBins(info.ZBins);
@@ -77,7 +78,9 @@ Passes::SceneForwardPbr::PassData& Passes::SceneForwardPbr::addToGraph(StringId
             });
             cmd.DrawIndexedIndirectCount({
                 .DrawBuffer = graph.GetBuffer(passData.Resources.Draws),
+                .DrawOffset = passData.Resources.DrawOffset,
                 .CountBuffer = graph.GetBuffer(passData.Resources.DrawInfo),
+                .CountOffset = passData.Resources.DrawInfoOffset,
                 .MaxCount = passData.Resources.MaxDrawCount
             });
         });
@@ -14,6 +14,7 @@ struct ExecutionInfo
     const SceneGeometryRGResources* Geometry{nullptr};
     RG::BufferResource DirectionalLights{};
     RG::BufferResource PointLights{};
+    RG::BufferResource SpotLights{};
     RG::SSAOData SSAO{};
     RG::IBLData IBL{};
     RG::BufferResource Clusters{};
@@ -9,7 +9,9 @@ void SceneDrawPassResources::InitFrom(const SceneDrawPassExecutionInfo& info, RG
     using namespace RG;
     using enum ResourceAccessFlags;
     
-    MaxDrawCount = (u32)(renderGraph.GetBufferDescription(info.Draws).SizeBytes / sizeof(IndirectDrawCommand));
+    DrawOffset = info.DrawRange.Offset * sizeof(IndirectDrawCommand);
+    DrawInfoOffset = info.DrawInfoIndex * sizeof(SceneBucketDrawInfo);
+    MaxDrawCount = info.DrawRange.Capacity;
     Draws = renderGraph.ReadBuffer(info.Draws, Vertex | Indirect);
     DrawInfo = renderGraph.ReadBuffer(info.DrawInfo, Vertex | Indirect);
     VisibleMeshlets = renderGraph.ReadBuffer(info.VisibleMeshlets, Vertex | Pixel);
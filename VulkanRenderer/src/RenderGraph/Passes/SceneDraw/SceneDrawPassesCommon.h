@@ -4,6 +4,7 @@
 #include "RenderGraph/RGGraph.h"
 #include "RenderGraph/RGDrawResources.h"
 
+#include "Scene/Visibility/SceneDrawRanges.h"
 #include "Scene/Visibility/SceneVisibility.h"
 
 #include <functional>
@@ -14,6 +15,9 @@ struct SceneDrawPassExecutionInfo
 {
     RG::BufferResource Draws{};
     RG::BufferResource DrawInfo{};
+    /* the range of the pass in `Draws`, and the index of its count in `DrawInfo` */
+    SceneDrawRange DrawRange{};
+    u32 DrawInfoIndex{0};
     glm::uvec2 Resolution{};
     RG::BufferResource ViewInfo{};
     RG::BufferResource VisibleMeshlets{};
@@ -27,6 +31,8 @@ struct SceneDrawPassResources
     RG::BufferResource ViewInfo{};
     RG::BufferResource VisibleMeshlets{};
     RG::DrawAttachmentResources Attachments{};
+    u64 DrawOffset{0};
+    u64 DrawInfoOffset{0};
     u32 MaxDrawCount{0};
 
     void InitFrom(const SceneDrawPassExecutionInfo& info, RG::Graph& renderGraph);
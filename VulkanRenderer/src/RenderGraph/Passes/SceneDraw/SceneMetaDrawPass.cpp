@@ -16,14 +16,13 @@ Passes::SceneMetaDraw::PassData& Passes::SceneMetaDraw::addToGraph(StringId name
     using namespace RG;
     using enum ResourceAccessFlags;
 
-    // todo: this should do something else if no pass uses occlusion culling, or if hiz info already available
+    // todo: this should do something else if hiz info already available
     
     return renderGraph.AddRenderPass<PassData>(name,
         [&](Graph& graph, PassData& passData)
         {
             CPU_PROFILE_FRAME("SceneMetaDraw")
 
-            const u32 bucketCount = info.MultiviewVisibility->ObjectSet().BucketCount();
             std::array<ImageResource, SceneMultiviewVisibility::MAX_VIEWS> passDepths{};
 
             auto drawWithVisibility = [&](u32 visibilityIndex, bool reocclusion)
@@ -58,15 +57,17 @@ Passes::SceneMetaDraw::PassData& Passes::SceneMetaDraw::addToGraph(StringId name
                     {
                         const u32 bucketIndex = info.MultiviewVisibility->ObjectSet().BucketHandleToIndex(bucketHandle);
                         auto& bucket = pass.Pass->BucketFromHandle(bucketHandle);
-                        u32 drawIndex = visibilityIndex * bucketCount + bucketIndex;
+                        const u32 drawIndex = info.Resources->DrawRanges.RangeIndex(visibilityIndex, bucketIndex);
                         
                         attachmentResources = pass.DrawPassInit(
                             StringId("{}.{}.{}.{}.{}",
                                 name, pass.SceneView.Name, pass.Pass->Name(), bucket.Name(),
                                 reocclusion ? "Reocclusion" : ""),
                             graph, {
-                                .Draws = info.Resources->Draws[drawIndex],
-                                .DrawInfo = info.Resources->DrawInfos[drawIndex],
+                                .Draws = info.Resources->Draws,
+                                .DrawInfo = info.Resources->DrawInfos,
+                                .DrawRange = info.Resources->DrawRanges.Ranges()[drawIndex],
+                                .DrawInfoIndex = drawIndex,
                                 .ViewInfo = info.Resources->Views[visibilityIndex],
                                 .VisibleMeshlets = info.Resources->VisibleMeshletsData,
                                 .Attachments = inputAttachments,
@@ -93,13 +94,13 @@ Passes::SceneMetaDraw::PassData& Passes::SceneMetaDraw::addToGraph(StringId name
             for (auto& viewPass : info.DrawPasses)
                 passData.DrawPassViewAttachments.Add(viewPass.SceneView.Name, viewPass.Pass->Name(), viewPass.Attachments);
 
-            u64 bucketsMask = 0;
+            SceneBucketBits bucketsMask{};
             for (auto& pass : info.DrawPasses)
             {
                 for (auto& bucketHandle : pass.Pass->BucketHandles())
                 {
                     const u32 bucketIndex = info.MultiviewVisibility->ObjectSet().BucketHandleToIndex(bucketHandle);
-                    bucketsMask |= (u64)1 << bucketIndex;
+                    bucketsMask.Set(bucketIndex);
                 }
             }
         
@@ -136,6 +137,16 @@ Passes::SceneMetaDraw::PassData& Passes::SceneMetaDraw::addToGraph(StringId name
                 visibilityIndex++)
                 drawWithVisibility(visibilityIndex, /*reocclusion*/false);
 
+            /* the first stage draws what was visible in the previous frame, and the second stage draws what
+             * the depth of the first stage does not occlude of the rest; without occlusion culling
+             * the first stage already draws everything that is visible */
+            bool anyOcclusionCulled = false;
+            for (u32 i = 0; i < info.MultiviewVisibility->VisibilityCount(); i++)
+                anyOcclusionCulled = anyOcclusionCulled || enumHasAny(
+                    info.MultiviewVisibility->View({i}).ViewInfo.VisibilityFlags(), VisibilityFlags::OcclusionCull);
+            if (!anyOcclusionCulled)
+                return;
+
             SceneMultiviewVisibilityHiz::addToGraph(
                 name.Concatenate("HizMultiview"),
                 graph, {
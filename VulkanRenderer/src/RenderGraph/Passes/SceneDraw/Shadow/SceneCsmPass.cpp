@@ -2,64 +2,68 @@
 
 #include "SceneCsmPass.h"
 
+#include "FrameContext.h"
 #include "SceneDirectionalShadowPass.h"
-#include "Assets/Materials/MaterialAssetManager.h"
 #include "Core/Camera.h"
 #include "cvars/CVarSystem.h"
 #include "RenderGraph/RGCommon.h"
 #include "RenderGraph/RGGraph.h"
 #include "RenderGraph/Passes/SceneDraw/SceneDrawPassesCommon.h"
+#include "RenderGraph/Passes/Shadows/CsmStaticCache.h"
 #include "RenderGraph/Passes/Shadows/ShadowCamerasGpuPass.h"
 #include "RenderGraph/Passes/Shadows/ShadowPassesUtils.h"
 #include "Scene/Visibility/SceneMultiviewVisibility.h"
 
 namespace
 {
-    std::vector<f32> calculateDepthCascades(const Camera& mainCamera, f32 shadowMin, f32 shadowMax)
+    f32 splitLambda()
     {
         static f32 SPLIT_LAMBDA = 0.0f;
         ImGui::Begin("CSM lambda");
         ImGui::DragFloat("Lambda", &SPLIT_LAMBDA, 1e-2f, 0.0f, 1.0f);
         ImGui::End();
 
+        return SPLIT_LAMBDA;
+    }
+
+    ShadowUtils::CascadeSplits calculateDepthCascades(const Camera& mainCamera, f32 shadowMin, f32 shadowMax,
+        f32 lambda)
+    {
         const f32 maxShadowDistance = *CVars::Get().GetF32CVar("Renderer.Limits.MaxShadowDistance"_hsv);
         const FrustumPlanes frustum = mainCamera.GetFrustumPlanes(maxShadowDistance);
-        
-        const f32 near = std::max(frustum.Near, shadowMin);
-        const f32 far = std::min(frustum.Far, shadowMax);
 
-        const f32 depthRange = far - near;
-        const f32 depthRatio = far / near;
-        
-        std::vector depthSplits(SHADOW_CASCADES, 0.0f);
+        return ShadowUtils::cascadeSplits({
+            .Near = frustum.Near,
+            .Far = frustum.Far,
+            .DepthMin = shadowMin,
+            .DepthMax = shadowMax,
+            .Lambda = lambda});
+    }
+
+    std::vector<FrustumCorners> calculateCascadeCorners(const Camera& mainCamera,
+        const ShadowUtils::CascadeSplits& splits)
+    {
+        std::vector<FrustumCorners> corners;
+        corners.reserve(SHADOW_CASCADES);
         for (u32 i = 0; i < SHADOW_CASCADES; i++)
         {
-            /* https://developer.nvidia.com/gpugems/gpugems3/
-             * part-ii-light-and-shadows/chapter-10-parallel-split-shadow-maps-programmable-gpus */
-            const f32 iOverN = (f32)(i + 1) / (f32)SHADOW_CASCADES;
-            const f32 cLog = near * std::pow(depthRatio, iOverN);
-            const f32 cUniform = near + depthRange * iOverN;
-
-            const f32 split = Math::lerp(cLog, cUniform, SPLIT_LAMBDA);
-            depthSplits[i] = split;
+            const f32 previousDepth = i > 0 ? splits.Far[i - 1] : splits.Near;
+            corners.push_back(mainCamera.GetFrustumCorners(previousDepth, splits.Far[i]));
         }
 
-        return depthSplits;
+        return corners;
     }
 
-    std::vector<Camera> createShadowCameras(const Camera& mainCamera, const glm::vec3& lightDirection,
-        const std::vector<f32>& cascades, f32 shadowMin, const AABB& geometryBounds, bool stabilizeCascades)
+    std::vector<Camera> createShadowCameras(const std::vector<FrustumCorners>& cascadeCorners,
+        const glm::vec3& lightDirection, const AABB& geometryBounds, bool stabilizeCascades)
     {
         std::vector<Camera> cameras;
         cameras.reserve(SHADOW_CASCADES);
         
         const glm::vec3 up = abs(lightDirection.y) < 0.999f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f);
         
-        for (u32 i = 0; i < SHADOW_CASCADES; i++)
+        for (auto& corners : cascadeCorners)
         {
-            const f32 previousDepth = i > 0 ? cascades[i - 1] : shadowMin;
-            const f32 depth = cascades[i];
-            const FrustumCorners corners = mainCamera.GetFrustumCorners(previousDepth, depth);
             if (stabilizeCascades)
                 cameras.push_back(ShadowUtils::shadowCameraStable(corners, geometryBounds, lightDirection, up));
             else
@@ -68,6 +72,61 @@ namespace
         
         return cameras;
     }
+
+    SceneDrawPassInitFn initShadowPassForView(u32 viewIndex, const SceneGeometryRGResources* geometry)
+    {
+        return [viewIndex, geometry](StringId shadowPassName, RG::Graph& shadowGraph,
+            const SceneDrawPassExecutionInfo& shadowInfo)
+            {
+                auto& pass = Passes::SceneDirectionalShadow::addToGraph(
+                    StringId("{}.DirectionalShadow.{}", shadowPassName, viewIndex),
+                    shadowGraph, {
+                        .DrawInfo = shadowInfo,
+                        .Geometry = geometry});
+
+                return pass.Resources.Attachments;
+            };
+    }
+
+    ImageSubregion layerSubregion(u32 layer, const glm::uvec2& offset, const glm::uvec2& size)
+    {
+        return {
+            .LayerBase = layer,
+            .Layers = 1,
+            .Bottom = glm::uvec3{offset, 0},
+            .Top = glm::uvec3{offset + size, 1}};
+    }
+
+    RG::DrawAttachments cascadeAttachments(RG::ImageResource cascade, AttachmentLoad onLoad)
+    {
+        return {
+            .Depth = RG::DepthStencilAttachment{
+                .Resource = cascade,
+                .Description = {
+                    .OnLoad = onLoad,
+                    .ClearDepthStencil = {.Depth = 0.0f, .Stencil = 0}},
+                /* todo: for some reason DEPTH_CONSTANT_BIAS does not do anything at all */
+                .DepthBias = DepthBias{.Constant = DEPTH_CONSTANT_BIAS, .Slope = DEPTH_SLOPE_BIAS}
+            }
+        };
+    }
+
+    RG::ImageResource createShadowMap(RG::Graph& graph)
+    {
+        return graph.Create("ShadowMap"_hsv, RG::ResourceCreationFlags::AutoUpdate,
+            RG::RGImageDescription{
+                .Width = (f32)SHADOW_MAP_RESOLUTION,
+                .Height = (f32)SHADOW_MAP_RESOLUTION,
+                .LayersDepth = (f32)SHADOW_CASCADES,
+                .Format = Format::D32_FLOAT,
+                .Kind = ImageKind::Image2dArray
+            });
+    }
+
+    RG::ImageResource cascadeOf(RG::Graph& graph, RG::ImageResource shadowMap, u32 cascade)
+    {
+        return graph.SplitImage(shadowMap, {.MipmapBase = 0, .Mipmaps = 1, .LayerBase = (i8)cascade, .Layers = 1});
+    }
 }
 
 Passes::SceneCsm::PassData& Passes::SceneCsm::addToGraph(StringId name, RG::Graph& renderGraph,
@@ -88,17 +147,24 @@ Passes::SceneCsm::PassData& Passes::SceneCsm::addToGraph(StringId name, RG::Grap
 
             Cameras& cameras = graph.GetOrCreateBlackboardValue<Cameras>();
             std::array<BufferResource, SHADOW_CASCADES> gpuViews = {};
+            const f32 lambda = splitLambda();
             if (!info.CreateCamerasInGpu)
             {
-                const std::vector cascades = calculateDepthCascades(*info.MainCamera, info.ShadowMin, info.ShadowMax);
-                cameras.ShadowCameras =
-                    createShadowCameras(*info.MainCamera, info.DirectionalLight.Direction, cascades,
-                        std::max(info.ShadowMin, info.MainCamera->GetNear()),
-                        info.GeometryBounds, info.StabilizeCascades);
+                const ShadowUtils::CascadeSplits cascades = calculateDepthCascades(*info.MainCamera,
+                    info.ShadowMin, info.ShadowMax, lambda);
+                const std::vector cascadeCorners = calculateCascadeCorners(*info.MainCamera, cascades);
+                cameras.ShadowCameras = createShadowCameras(cascadeCorners, info.DirectionalLight.Direction,
+                    info.GeometryBounds, info.StabilizeCascades);
+
+                /* cascades keep the cameras their static depth was drawn with */
+                info.StaticCache->Prepare(cameras.ShadowCameras, cascadeCorners, info.DirectionalLight.Direction,
+                    info.ChangedBounds);
+                for (u32 i = 0; i < cameras.ShadowCameras.size(); i++)
+                    cameras.ShadowCameras[i] = info.StaticCache->GetCamera(i);
 
                 CsmInfo& csmInfo = graph.GetOrCreateBlackboardValue<CsmInfo>();
                 csmInfo.CascadeCount = SHADOW_CASCADES;
-                std::ranges::copy(cascades.begin(), cascades.end(), csmInfo.Cascades.begin());
+                std::ranges::copy(cascades.Far.begin(), cascades.Far.end(), csmInfo.Cascades.begin());
                 for (u32 i = 0; i < cameras.ShadowCameras.size(); i++)
                 {
                     auto& camera = cameras.ShadowCameras[i];
@@ -114,10 +180,16 @@ Passes::SceneCsm::PassData& Passes::SceneCsm::addToGraph(StringId name, RG::Grap
             }
             else
             {
+                /* cameras are only known on gpu, so the static depth cannot be reused, and is redrawn in full
+                 * once the cameras are back on cpu */
+                info.StaticCache->Invalidate();
+
+                /* splits are fit to the depth reduction of this frame, without a readback */
                 auto& gpuShadowCameras = ShadowCamerasGpu::addToGraph(name.Concatenate(".ShadowCameraGpu"), graph, {
                     .DepthMinMax = info.DepthMinMaxBuffer,
                     .View = graph.GetGlobalResources().PrimaryViewInfoResource,
-                    .LightDirection = info.DirectionalLight.Direction
+                    .LightDirection = info.DirectionalLight.Direction,
+                    .SplitLambda = lambda
                 });
 
                 passData.CsmData.CsmInfo = gpuShadowCameras.CsmData;
@@ -125,86 +197,242 @@ Passes::SceneCsm::PassData& Passes::SceneCsm::addToGraph(StringId name, RG::Grap
                     gpuViews.begin());
             }
 
-            const ImageResource shadow = renderGraph.Create("ShadowMap"_hsv, ResourceCreationFlags::AutoUpdate,
-                RGImageDescription{
-                    .Width = (f32)SHADOW_MAP_RESOLUTION,
-                    .Height = (f32)SHADOW_MAP_RESOLUTION,
-                    .LayersDepth = (f32)SHADOW_CASCADES,
-                    .Format = Format::D32_FLOAT,
-                    .Kind = ImageKind::Image2dArray
-                });
-
-            auto initShadowPassForView = [&](u32 viewIndex)
-            {
-                return [viewIndex, geometry = info.Geometry](StringId shadowPassName, Graph& shadowGraph,
-                    const SceneDrawPassExecutionInfo& shadowInfo)
-                    {
-                        auto& pass = SceneDirectionalShadow::addToGraph(
-                            StringId("{}.DirectionalShadow.{}", shadowPassName, viewIndex),
-                            shadowGraph, {
-                                .DrawInfo = shadowInfo,
-                                .Geometry = geometry});
-
-                        return pass.Resources.Attachments;
-                    };
-            };
-
-            std::vector<ImageResource> cascadeShadows;
-            cascadeShadows.reserve(SHADOW_CASCADES);
-            passData.MetaPassDescriptions.reserve(SHADOW_CASCADES);
+            /* shadow passes cull back faces, so the meshlets that face away from the light are culled as well */
+            passData.CascadeViewInfos.reserve(SHADOW_CASCADES);
             for (u32 i = 0; i < SHADOW_CASCADES; i++)
             {
-                ImageResource cascade = graph.SplitImage(shadow,
-                    {.MipmapBase = 0, .Mipmaps = 1, .LayerBase = (i8)i, .Layers = 1});
-                DrawAttachments attachments = {
-                    .Depth = DepthStencilAttachment{
-                        .Resource = cascade,
-                        .Description = {
-                            .OnLoad = AttachmentLoad::Clear,
-                            .ClearDepthStencil = {.Depth = 0.0f, .Stencil = 0}},
-                        /* todo: for some reason DEPTH_CONSTANT_BIAS does not do anything at all */
-                        .DepthBias = DepthBias{.Constant = DEPTH_CONSTANT_BIAS, .Slope = DEPTH_SLOPE_BIAS}
-                    }
-                };
-
-                SceneViewInfo sceneViewInfo = {};
-                VisibilityFlags visibilityFlags = VisibilityFlags::ClampDepth;
+                VisibilityFlags visibilityFlags = VisibilityFlags::ClampDepth | VisibilityFlags::ConeCull;
                 if (!info.CreateCamerasInGpu)
                 {
+                    const bool occlusionCull = info.PreviousHiz != nullptr;
+                    if (occlusionCull)
+                        visibilityFlags |= VisibilityFlags::OcclusionCull;
+
                     ViewInfoGPU viewInfo = ViewInfoGPU::Default();
                     viewInfo.Camera = CameraGPU::FromCamera(cameras.ShadowCameras[i], glm::uvec2{SHADOW_MAP_RESOLUTION},
                         visibilityFlags);
-                    sceneViewInfo = viewInfo;
+                    /* without the hiz of the previous frame the first visibility stage only does frustum culling */
+                    if (occlusionCull)
+                        viewInfo.PreviousCamera = info.PreviousHiz->Hiz[i].HasValue() ?
+                            info.PreviousHiz->Cameras[i] :
+                            CameraGPU::FromCamera(cameras.ShadowCameras[i], glm::uvec2{SHADOW_MAP_RESOLUTION},
+                                VisibilityFlags::ClampDepth);
+                    passData.CascadeViewInfos.emplace_back(viewInfo);
                 }
                 else
                 {
-                    sceneViewInfo = SceneViewInfo(gpuViews[i], visibilityFlags);
+                    passData.CascadeViewInfos.emplace_back(gpuViews[i], visibilityFlags);
+                }
+            }
+
+            if (info.CreateCamerasInGpu)
+            {
+                /* the cache is bypassed: static casters are drawn straight into the cleared cascades,
+                 * so there is nothing to copy */
+                const ImageResource shadow = createShadowMap(graph);
+                for (u32 i = 0; i < SHADOW_CASCADES; i++)
+                {
+                    SceneView view = {
+                        .Name = StringId("{}.StaticView.{}", name, i),
+                        .ViewInfo = passData.CascadeViewInfos[i]
+                    };
+
+                    passData.StaticMetaPassDescriptions.push_back({
+                        .Pass = info.StaticPass,
+                        .DrawPassInit = initShadowPassForView(i, info.Geometry),
+                        .SceneView = view,
+                        .Visibility = info.StaticMultiviewVisibility->AddVisibility(view),
+                        .Attachments = cascadeAttachments(cascadeOf(graph, shadow, i), AttachmentLoad::Clear)
+                    });
+                }
+
+                return;
+            }
+
+            for (u32 i = 0; i < SHADOW_CASCADES; i++)
+            {
+                const Span<const CsmStaticCache::Rect> strips = info.StaticCache->GetStrips(i);
+                for (u32 stripIndex = 0; stripIndex < strips.size(); stripIndex++)
+                {
+                    const CsmStaticCache::Rect& strip = strips[stripIndex];
+                    const ImageResource stripDepth = graph.Create(StringId("{}.StaticStrip.{}.{}", name, i, stripIndex),
+                        ResourceCreationFlags::AutoUpdate,
+                        RGImageDescription{
+                            .Width = (f32)strip.Size.x,
+                            .Height = (f32)strip.Size.y,
+                            .Format = Format::D32_FLOAT
+                        });
+
+                    /* the strips are not occlusion culled, they are drawn into the new parts of the cascades */
+                    ViewInfoGPU viewInfo = ViewInfoGPU::Default();
+                    viewInfo.Camera = CameraGPU::FromCamera(info.StaticCache->GetStripCamera(i, strip), strip.Size,
+                        VisibilityFlags::ClampDepth | VisibilityFlags::ConeCull);
+
+                    SceneView view = {
+                        .Name = StringId("{}.StaticView.{}.{}", name, i, stripIndex),
+                        .ViewInfo = viewInfo
+                    };
+
+                    passData.StaticMetaPassDescriptions.push_back({
+                        .Pass = info.StaticPass,
+                        .DrawPassInit = initShadowPassForView(i, info.Geometry),
+                        .SceneView = view,
+                        .Visibility = info.StaticMultiviewVisibility->AddVisibility(view),
+                        .Attachments = cascadeAttachments(stripDepth, AttachmentLoad::Clear)
+                    });
                 }
-                
-                
-                SceneView view = {
-                    .Name = StringId("{}.View.{}", name, i),
-                    .ViewInfo = sceneViewInfo
-                };
-
-                SceneDrawPassDescription description = {
-                    .Pass = info.Pass,
-                    .DrawPassInit = initShadowPassForView(i),
-                    .SceneView = view,
-                    .Visibility = info.MultiviewVisibility->AddVisibility(view),
-                    .Attachments = attachments
-                };
-
-                passData.MetaPassDescriptions.push_back(description);
             }
-            
-            
         },
         [=](const PassData&, FrameContext&, const Graph&)
         {
         });
 }
 
+namespace
+{
+    /* updates the strips of the cached static depth, and copies it into a new shadow map */
+    RG::ImageResource addStaticCacheToGraph(StringId name, RG::Graph& renderGraph,
+        const Passes::SceneCsm::PassData& passData, const Passes::SceneCsm::ExecutionInfo& info,
+        const SceneDrawPassViewAttachments* staticAttachments)
+    {
+        using namespace RG;
+        using enum ResourceAccessFlags;
+
+        struct UpdatePassData
+        {
+            std::vector<ImageResource> Strips{};
+            ImageResource StaticDepth{};
+        };
+
+        struct CopyPassData
+        {
+            ImageResource StaticDepth{};
+            ImageResource ShadowMap{};
+        };
+
+        const CsmStaticCache* cache = info.StaticCache;
+        ImageResource staticDepth = renderGraph.ImportPersistent(name.Concatenate(".StaticDepth"),
+            cache->GetStaticDepth());
+
+        if (!passData.StaticMetaPassDescriptions.empty())
+        {
+            ASSERT(staticAttachments != nullptr, "Strips of the static depth have to be drawn")
+            std::vector<ImageResource> strips;
+            strips.reserve(passData.StaticMetaPassDescriptions.size());
+            for (auto& description : passData.StaticMetaPassDescriptions)
+                strips.push_back(
+                    staticAttachments->Get(description.SceneView.Name, info.StaticPass->Name()).Depth->Resource);
+
+            /* strips are drawn in the window space of the cascade, and are stored at the wrapped cache texels */
+            staticDepth = renderGraph.AddRenderPass<UpdatePassData>(name.Concatenate(".UpdateStatic"),
+                [&](Graph& graph, UpdatePassData& updateData)
+                {
+                    CPU_PROFILE_FRAME("SceneCsm.UpdateStatic.Setup")
+
+                    for (auto strip : strips)
+                        updateData.Strips.push_back(graph.ReadImage(strip, Copy));
+                    updateData.StaticDepth = graph.WriteImage(staticDepth, Copy);
+                },
+                [=](const UpdatePassData& updateData, FrameContext& frameContext, const Graph& graph)
+                {
+                    GPU_PROFILE_FRAME("SceneCsm.UpdateStatic")
+
+                    const Image cacheImage = graph.GetImage(updateData.StaticDepth);
+                    u32 stripImageIndex = 0;
+                    for (u32 i = 0; i < SHADOW_CASCADES; i++)
+                    {
+                        for (auto& strip : cache->GetStrips(i))
+                        {
+                            const Image stripImage = graph.GetImage(updateData.Strips[stripImageIndex++]);
+                            CsmStaticCache::CacheRegions regions;
+                            const u32 regionCount = cache->GetCacheRegions(i, strip, regions);
+                            for (u32 region = 0; region < regionCount; region++)
+                                frameContext.CommandList.CopyImage({
+                                    .Source = stripImage,
+                                    .Destination = cacheImage,
+                                    .SourceSubregion = layerSubregion(0,
+                                        regions[region].Offset - strip.Offset, regions[region].Size),
+                                    .DestinationSubregion = layerSubregion(i,
+                                        regions[region].CacheOffset, regions[region].Size)
+                                });
+                        }
+                    }
+                }).StaticDepth;
+        }
+
+        return renderGraph.AddRenderPass<CopyPassData>(name.Concatenate(".CopyStatic"),
+            [&](Graph& graph, CopyPassData& copyData)
+            {
+                CPU_PROFILE_FRAME("SceneCsm.CopyStatic.Setup")
+
+                const ImageResource shadow = createShadowMap(graph);
+
+                copyData.StaticDepth = graph.ReadImage(staticDepth, Copy);
+                copyData.ShadowMap = graph.WriteImage(shadow, Copy);
+            },
+            [=](const CopyPassData& copyData, FrameContext& frameContext, const Graph& graph)
+            {
+                GPU_PROFILE_FRAME("SceneCsm.CopyStatic")
+
+                /* undoes the toroidal addressing of the cache, so that shading sees ordinary cascades */
+                const Image cacheImage = graph.GetImage(copyData.StaticDepth);
+                const Image shadow = graph.GetImage(copyData.ShadowMap);
+                for (u32 i = 0; i < SHADOW_CASCADES; i++)
+                {
+                    CsmStaticCache::CacheRegions regions;
+                    const u32 regionCount = cache->GetCacheRegions(i, {.Size = glm::uvec2{cache->GetResolution()}},
+                        regions);
+                    for (u32 region = 0; region < regionCount; region++)
+                        frameContext.CommandList.CopyImage({
+                            .Source = cacheImage,
+                            .Destination = shadow,
+                            .SourceSubregion = layerSubregion(i, regions[region].CacheOffset, regions[region].Size),
+                            .DestinationSubregion = layerSubregion(i, regions[region].Offset, regions[region].Size)
+                        });
+                }
+            }).ShadowMap;
+    }
+}
+
+void Passes::SceneCsm::addDynamicToGraph(StringId name, RG::Graph& renderGraph, PassData& passData,
+    const ExecutionInfo& info, const SceneDrawPassViewAttachments* staticAttachments)
+{
+    using namespace RG;
+
+    std::array<ImageResource, SHADOW_CASCADES> cascades{};
+    if (info.CreateCamerasInGpu)
+    {
+        /* the static casters were drawn straight into the cascades */
+        ASSERT(staticAttachments != nullptr, "Static casters have to be drawn")
+        for (u32 i = 0; i < SHADOW_CASCADES; i++)
+            cascades[i] = staticAttachments->Get(passData.StaticMetaPassDescriptions[i].SceneView.Name,
+                info.StaticPass->Name()).Depth->Resource;
+    }
+    else
+    {
+        const ImageResource shadow = addStaticCacheToGraph(name, renderGraph, passData, info, staticAttachments);
+        for (u32 i = 0; i < SHADOW_CASCADES; i++)
+            cascades[i] = cascadeOf(renderGraph, shadow, i);
+    }
+
+    passData.MetaPassDescriptions.reserve(SHADOW_CASCADES);
+    for (u32 i = 0; i < SHADOW_CASCADES; i++)
+    {
+        SceneView view = {
+            .Name = StringId("{}.View.{}", name, i),
+            .ViewInfo = passData.CascadeViewInfos[i]
+        };
+
+        passData.MetaPassDescriptions.push_back({
+            .Pass = info.DynamicPass,
+            .DrawPassInit = initShadowPassForView(i, info.Geometry),
+            .SceneView = view,
+            .Visibility = info.MultiviewVisibility->AddVisibility(view),
+            .Attachments = cascadeAttachments(cascades[i], AttachmentLoad::Load)
+        });
+    }
+}
+
 void Passes::SceneCsm::mergeCsm(RG::Graph& renderGraph, PassData& passData, const ScenePass& scenePass,
     const SceneDrawPassViewAttachments& attachments)
 {
@@ -216,26 +444,31 @@ void Passes::SceneCsm::mergeCsm(RG::Graph& renderGraph, PassData& passData, cons
 }
 
 
-ScenePassCreateInfo Passes::SceneCsm::getScenePassCreateInfo(StringId name, 
-    const lux::MaterialAssetManager& materialAssetManager)
+ScenePassCreateInfo Passes::SceneCsm::getStaticScenePassCreateInfo(StringId name)
 {
     return ScenePassCreateInfo{
         .Name = name,
         .BucketCreateInfos = {
             {
-                .Name = "Opaque material"_hsv,
-                .Filter = [&](const lux::SceneGeometryInfo& geometry, SceneRenderObjectHandle renderObject) {
-                    const u32 material = geometry.RenderObjects[renderObject.Index].Material;
-                    if (material == lux::SceneRenderObject::INVALID)
-                        return false;
-                    const lux::MaterialAsset* materialAsset = materialAssetManager.Get(
-                        geometry.MaterialsCpu[material].Handle);
-                    if (materialAsset == nullptr)
-                        return false;
-                    
-                    return materialAsset->AlphaMode == lux::MaterialAlphaMode::Opaque;
+                .Name = "Static opaque material"_hsv,
+                .Predicate = {
+                    .Mask = SceneRenderObjectFlags::Opaque | SceneRenderObjectFlags::Dynamic,
+                    .Value = SceneRenderObjectFlags::Opaque
                 },
             }
         },
     };
 }
+
+ScenePassCreateInfo Passes::SceneCsm::getDynamicScenePassCreateInfo(StringId name)
+{
+    return ScenePassCreateInfo{
+        .Name = name,
+        .BucketCreateInfos = {
+            {
+                .Name = "Dynamic opaque material"_hsv,
+                .Predicate = SceneBucketPredicate::Has(SceneRenderObjectFlags::Opaque | SceneRenderObjectFlags::Dynamic),
+            }
+        },
+    };
+}
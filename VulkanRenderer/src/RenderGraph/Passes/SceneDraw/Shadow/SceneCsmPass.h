@@ -1,11 +1,14 @@
 #pragma once
 
+#include "Settings.h"
 #include "Light/Light.h"
 #include "RenderGraph/RGDrawResources.h"
 #include "RenderGraph/RGResource.h"
 #include "RenderGraph/Passes/Generated/Types/CsmDataUniform.generated.h"
 #include "Scene/ScenePass.h"
+#include "Scene/Visibility/SceneView.h"
 
+#include <CoreLib/Containers/Span.h>
 #include <CoreLib/Math/Geometry.h>
 
 struct SceneGeometryRGResources;
@@ -15,6 +18,7 @@ class SceneMultiviewVisibility;
 class ScenePass;
 class Camera;
 class SceneLight;
+class CsmStaticCache;
 
 namespace Passes::SceneCsm
 {
@@ -22,11 +26,26 @@ struct CsmInfo : ::gen::CsmData
 {
 };
 
+/* hierarchical depth of the cascades of some frame, and the cascade cameras it was built with */
+struct CascadesHiz
+{
+    std::array<RG::PersistentImageResource, SHADOW_CASCADES> Hiz{};
+    std::array<CameraGPU, SHADOW_CASCADES> Cameras{};
+};
+
 struct ExecutionInfo
 {
-    const ScenePass* Pass{nullptr};
+    /* static casters are drawn only into the strips of `StaticCache` that have to be updated,
+     * and dynamic casters are drawn every frame over the copy of the cached depth;
+     * with `CreateCamerasInGpu` the cache is bypassed, and both are drawn into the cleared cascades */
+    const ScenePass* StaticPass{nullptr};
+    const ScenePass* DynamicPass{nullptr};
     const SceneGeometryRGResources* Geometry{nullptr};
+    SceneMultiviewVisibility* StaticMultiviewVisibility{nullptr};
     SceneMultiviewVisibility* MultiviewVisibility{nullptr};
+    CsmStaticCache* StaticCache{nullptr};
+    /* world-space bounds of the geometry that was added, moved or removed this frame */
+    Span<const AABB> ChangedBounds{};
     /* pass will construct the suitable shadow camera based on main camera frustum */
     const Camera* MainCamera{nullptr};
     DirectionalLight DirectionalLight{};
@@ -34,18 +53,30 @@ struct ExecutionInfo
     f32 ShadowMax{100};
     RG::BufferResource DepthMinMaxBuffer{};
     bool CreateCamerasInGpu{false};
+    /* if set, the dynamic casters are occlusion culled by the hiz of the previous frame,
+     * which needs the cameras of the previous frame, and so is ignored when cameras are created on gpu */
+    const CascadesHiz* PreviousHiz{nullptr};
     bool StabilizeCascades{false};
     AABB GeometryBounds{};
 };
 
 struct PassData
 {
+    /* draws the static casters of the strips of the cached depth, empty if no strip has to be updated,
+     * or of the whole cascades if the cameras are created on gpu */
+    std::vector<SceneDrawPassDescription> StaticMetaPassDescriptions;
+    /* draws the dynamic casters of all cascades, filled by `addDynamicToGraph` */
     std::vector<SceneDrawPassDescription> MetaPassDescriptions;
+    std::vector<SceneViewInfo> CascadeViewInfos;
     RG::CsmData CsmData{};
 };
 
 PassData& addToGraph(StringId name, RG::Graph& renderGraph, const ExecutionInfo& info);
+/* `staticAttachments` are the attachments of the static meta draw, if there was one this frame */
+void addDynamicToGraph(StringId name, RG::Graph& renderGraph, PassData& passData, const ExecutionInfo& info,
+    const SceneDrawPassViewAttachments* staticAttachments);
 void mergeCsm(RG::Graph& renderGraph, PassData& passData, const ScenePass& scenePass,
     const SceneDrawPassViewAttachments& attachments);
-ScenePassCreateInfo getScenePassCreateInfo(StringId name, const lux::MaterialAssetManager& materialAssetManager);
+ScenePassCreateInfo getStaticScenePassCreateInfo(StringId name);
+ScenePassCreateInfo getDynamicScenePassCreateInfo(StringId name);
 }
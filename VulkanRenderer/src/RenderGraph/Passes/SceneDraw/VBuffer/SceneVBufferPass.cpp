@@ -39,7 +39,9 @@ Passes::SceneVBuffer::PassData& Passes::SceneVBuffer::addToGraph(StringId name,
             });
             cmd.DrawIndexedIndirectCount({
                 .DrawBuffer = graph.GetBuffer(passData.Resources.Draws),
+                .DrawOffset = passData.Resources.DrawOffset,
                 .CountBuffer = graph.GetBuffer(passData.Resources.DrawInfo),
+                .CountOffset = passData.Resources.DrawInfoOffset,
                 .MaxCount = passData.Resources.MaxDrawCount
             });
         });
@@ -48,6 +48,7 @@ Passes::SceneVBufferPbr::PassData& Passes::SceneVBufferPbr::addToGraph(StringId
             passData.BindGroup.SetResourcesSsao(info.SSAO.SSAO);
             passData.BindGroup.SetResourcesDirectionalLights(info.DirectionalLights);
             passData.BindGroup.SetResourcesPointLights(info.PointLights);
+            passData.BindGroup.SetResourcesSpotLights(info.SpotLights);
             if (useTiled || useHybrid)
             {
                 passData.BindGroup.SetResourcesLightZBins(info.ZBins);
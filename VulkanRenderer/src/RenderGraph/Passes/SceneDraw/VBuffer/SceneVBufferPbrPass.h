@@ -15,6 +15,7 @@ struct ExecutionInfo
     RG::BufferResource ViewInfo{};
     RG::BufferResource DirectionalLights{};
     RG::BufferResource PointLights{};
+    RG::BufferResource SpotLights{};
     RG::SSAOData SSAO{};
     RG::IBLData IBL{};
     RG::BufferResource Clusters{};
@@ -0,0 +1,255 @@
+#include "rendererpch.h"
+
+#include "CsmStaticCache.h"
+
+#include "RenderGraph/RGGraph.h"
+#include "Vulkan/Device.h"
+
+#include <CoreLib/Math/Frustum.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace
+{
+glm::vec2 orthographicExtent(const Camera& camera)
+{
+    const glm::mat4& projection = camera.GetProjection();
+
+    return glm::vec2{2.0f / std::abs(projection[0][0]), 2.0f / std::abs(projection[1][1])};
+}
+
+/* grows the clip volume of an orthographic camera around its center */
+Camera enlargeCamera(const Camera& camera, f32 margin, f32 depthMargin)
+{
+    const glm::vec2 extent = orthographicExtent(camera);
+    const f32 depthExtent = 1.0f / std::abs(camera.GetProjection()[2][2]);
+    const f32 depthScale = depthExtent / (depthExtent + 2.0f * depthMargin * std::max(extent.x, extent.y));
+    const f32 scale = 1.0f / (1.0f + margin);
+    glm::mat4 grow = glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 0.0f, 0.5f});
+    grow = glm::scale(grow, glm::vec3{scale, scale, depthScale});
+    grow = glm::translate(grow, glm::vec3{0.0f, 0.0f, -0.5f});
+
+    Camera enlarged = camera;
+    enlarged.SetProjection(grow * camera.GetProjection());
+
+    return enlarged;
+}
+
+struct WrappedSegment
+{
+    u32 Offset{0};
+    u32 CacheOffset{0};
+    u32 Size{0};
+};
+
+/* splits a window segment into the parts that do not wrap around the cache, returns the part count */
+u32 wrapSegment(u32 offset, u32 size, u32 origin, u32 resolution, std::array<WrappedSegment, 2>& segments)
+{
+    const u32 cacheOffset = (offset + origin) % resolution;
+    const u32 untilWrap = resolution - cacheOffset;
+    segments[0] = {.Offset = offset, .CacheOffset = cacheOffset, .Size = std::min(size, untilWrap)};
+    if (size <= untilWrap)
+        return 1;
+
+    segments[1] = {.Offset = offset + untilWrap, .CacheOffset = 0, .Size = size - untilWrap};
+
+    return 2;
+}
+}
+
+CsmStaticCache::CsmStaticCache(u32 resolution)
+    : m_Resolution(resolution)
+{
+}
+
+CsmStaticCache CsmStaticCache::Create(RG::Graph& graph, DeletionQueue& deletionQueue)
+{
+    CsmStaticCache cache = {};
+    cache.m_StaticDepth = graph.AddPersistent(Device::CreateImage({
+        .Description = ImageDescription{
+            .Width = cache.m_Resolution,
+            .Height = cache.m_Resolution,
+            .LayersDepth = SHADOW_CASCADES,
+            .Format = Format::D32_FLOAT,
+            .Kind = ImageKind::Image2dArray,
+            .Usage = ImageUsage::Depth | ImageUsage::Source | ImageUsage::Destination
+        },
+    }, deletionQueue));
+
+    return cache;
+}
+
+void CsmStaticCache::Prepare(Span<const Camera> cameras, Span<const FrustumCorners> corners,
+    const glm::vec3& lightDirection, Span<const AABB> changedBounds)
+{
+    ASSERT(cameras.size() == SHADOW_CASCADES && corners.size() == SHADOW_CASCADES,
+        "Expected {} cascades", SHADOW_CASCADES)
+
+    const bool lightChanged = !m_IsValid ||
+        glm::dot(lightDirection, m_LightDirection) < MIN_LIGHT_DIRECTION_COS;
+    for (u32 i = 0; i < SHADOW_CASCADES; i++)
+    {
+        Cascade& cascade = m_Cascades[i];
+        cascade.Update = UpdateType::None;
+        cascade.StripCount = 0;
+
+        auto redraw = [&]()
+        {
+            cascade.Camera = enlargeCamera(cameras[i], EXTENT_MARGIN, DEPTH_MARGIN);
+            cascade.Origin = glm::uvec2{0};
+            cascade.Update = UpdateType::Full;
+            cascade.Strips[0] = {.Offset = glm::uvec2{0}, .Size = glm::uvec2{m_Resolution}};
+            cascade.StripCount = 1;
+        };
+        if (lightChanged || IsAffected(cascade.Camera, changedBounds))
+        {
+            redraw();
+            continue;
+        }
+
+        /* the cascades that still cover what they have to wait for their frame */
+        const bool covers = Covers(cascade.Camera, cameras[i], corners[i]);
+        const bool isScheduled = (m_Frame + i) % UPDATE_PERIODS[i] == 0;
+        if (covers && !isScheduled)
+            continue;
+
+        const glm::ivec2 texels = ScrollTexels(cascade.Camera, corners[i]);
+        const glm::uvec2 shift = glm::uvec2{glm::abs(texels)};
+        const u32 distance = std::max(shift.x, shift.y);
+        if (covers && distance < MIN_SCROLL_TEXELS)
+            continue;
+
+        const Camera scrolled = ScrollCamera(cascade.Camera, texels);
+        if (distance >= m_Resolution || !Covers(scrolled, cameras[i], corners[i]))
+        {
+            redraw();
+            continue;
+        }
+
+        /* the window texel `w` moves to `w - texels`, the strips that have scrolled in are drawn */
+        const glm::ivec2 resolution = glm::ivec2{(i32)m_Resolution};
+        cascade.Camera = scrolled;
+        cascade.Origin = glm::uvec2{((glm::ivec2{cascade.Origin} + texels) % resolution + resolution) % resolution};
+        cascade.Update = UpdateType::Scroll;
+        if (texels.x != 0)
+            cascade.Strips[cascade.StripCount++] = {
+                .Offset = glm::uvec2{texels.x > 0 ? m_Resolution - shift.x : 0, 0},
+                .Size = glm::uvec2{shift.x, m_Resolution}};
+        if (texels.y != 0)
+            cascade.Strips[cascade.StripCount++] = {
+                .Offset = glm::uvec2{texels.x > 0 ? 0 : shift.x, texels.y > 0 ? m_Resolution - shift.y : 0},
+                .Size = glm::uvec2{m_Resolution - shift.x, shift.y}};
+    }
+
+    m_Frame++;
+    m_IsValid = true;
+    m_LightDirection = lightDirection;
+}
+
+void CsmStaticCache::Invalidate()
+{
+    m_IsValid = false;
+    for (auto& cascade : m_Cascades)
+    {
+        cascade.Origin = glm::uvec2{0};
+        cascade.Update = UpdateType::Full;
+        cascade.Strips[0] = {.Offset = glm::uvec2{0}, .Size = glm::uvec2{m_Resolution}};
+        cascade.StripCount = 1;
+    }
+}
+
+Span<const CsmStaticCache::Rect> CsmStaticCache::GetStrips(u32 cascade) const
+{
+    return Span<const Rect>(m_Cascades[cascade].Strips.data(), m_Cascades[cascade].StripCount);
+}
+
+Camera CsmStaticCache::GetStripCamera(u32 cascade, const Rect& strip) const
+{
+    const glm::vec2 resolution = glm::vec2{(f32)m_Resolution};
+    const glm::vec2 stripSize = glm::vec2{strip.Size};
+    const glm::vec2 stripCenter = (glm::vec2{strip.Offset} + 0.5f * stripSize) * 2.0f / resolution - 1.0f;
+    glm::mat4 crop = glm::scale(glm::mat4{1.0f}, glm::vec3{resolution / stripSize, 1.0f});
+    crop = glm::translate(crop, glm::vec3{-stripCenter, 0.0f});
+
+    Camera camera = m_Cascades[cascade].Camera;
+    camera.SetProjection(crop * camera.GetProjection());
+
+    return camera;
+}
+
+u32 CsmStaticCache::GetCacheRegions(u32 cascade, const Rect& rect, CacheRegions& regions) const
+{
+    const glm::uvec2& origin = m_Cascades[cascade].Origin;
+    std::array<WrappedSegment, 2> columns;
+    std::array<WrappedSegment, 2> rows;
+    const u32 columnCount = wrapSegment(rect.Offset.x, rect.Size.x, origin.x, m_Resolution, columns);
+    const u32 rowCount = wrapSegment(rect.Offset.y, rect.Size.y, origin.y, m_Resolution, rows);
+
+    u32 count = 0;
+    for (u32 row = 0; row < rowCount; row++)
+        for (u32 column = 0; column < columnCount; column++)
+            regions[count++] = {
+                .Offset = glm::uvec2{columns[column].Offset, rows[row].Offset},
+                .CacheOffset = glm::uvec2{columns[column].CacheOffset, rows[row].CacheOffset},
+                .Size = glm::uvec2{columns[column].Size, rows[row].Size}};
+
+    return count;
+}
+
+bool CsmStaticCache::Covers(const Camera& cached, const Camera& camera, const FrustumCorners& corners)
+{
+    const glm::vec2 extentRatio = orthographicExtent(camera) / orthographicExtent(cached);
+    if (std::min(extentRatio.x, extentRatio.y) < MIN_EXTENT_RATIO)
+        return false;
+
+    for (auto& corner : corners)
+    {
+        const glm::vec4 clip = cached.GetViewProjection() * glm::vec4{corner, 1.0f};
+        if (std::abs(clip.x) > clip.w || std::abs(clip.y) > clip.w || clip.z < 0.0f || clip.z > clip.w)
+            return false;
+    }
+
+    return true;
+}
+
+bool CsmStaticCache::IsAffected(const Camera& cached, Span<const AABB> changedBounds)
+{
+    /* casters are depth clamped, so only the sides of the cascade matter */
+    Frustum frustum = Frustum::FromViewProjection(cached.GetViewProjection());
+    frustum.Planes[4] = {.Normal = glm::vec3{0.0f}, .Offset = 0.0f};
+    frustum.Planes[5] = {.Normal = glm::vec3{0.0f}, .Offset = 0.0f};
+
+    for (auto& bounds : changedBounds)
+        if (frustum.Intersects(bounds))
+            return true;
+
+    return false;
+}
+
+glm::ivec2 CsmStaticCache::ScrollTexels(const Camera& cached, const FrustumCorners& corners) const
+{
+    /* centers the window on the cascade */
+    glm::vec2 min = glm::vec2{std::numeric_limits<f32>::max()};
+    glm::vec2 max = glm::vec2{std::numeric_limits<f32>::lowest()};
+    for (auto& corner : corners)
+    {
+        const glm::vec4 clip = cached.GetViewProjection() * glm::vec4{corner, 1.0f};
+        const glm::vec2 ndc = glm::vec2{clip} / clip.w;
+        min = glm::min(min, ndc);
+        max = glm::max(max, ndc);
+    }
+    const glm::vec2 center = 0.5f * (min + max);
+
+    return glm::ivec2{glm::round(center * 0.5f * (f32)m_Resolution)};
+}
+
+Camera CsmStaticCache::ScrollCamera(const Camera& cached, const glm::ivec2& texels) const
+{
+    /* the shift is a whole number of texels, so the depth that stays in the window is exactly the same */
+    const glm::vec2 shift = glm::vec2{texels} * 2.0f / (f32)m_Resolution;
+
+    Camera scrolled = cached;
+    scrolled.SetProjection(glm::translate(glm::mat4{1.0f}, glm::vec3{-shift, 0.0f}) * cached.GetProjection());
+
+    return scrolled;
+}
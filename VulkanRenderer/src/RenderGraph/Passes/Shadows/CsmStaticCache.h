@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Settings.h"
+#include "Core/Camera.h"
+#include "RenderGraph/RGResource.h"
+
+#include <CoreLib/core.h>
+#include <CoreLib/Containers/Span.h>
+#include <CoreLib/Math/Geometry.h>
+
+#include <array>
+
+class DeletionQueue;
+
+namespace RG
+{
+class Graph;
+}
+
+/* depth of the static shadow casters of each cascade is kept between the frames, and only the dynamic casters
+ * are drawn over its copy every frame. A cascade keeps the (slightly enlarged) shadow camera its static depth
+ * was drawn with, for as long as that camera still covers the cascade well, and neither the light
+ * nor the geometry under the cascade change.
+ * When the main camera moves, the cascade window scrolls by whole texels instead of being redrawn:
+ * the cached depth is addressed toroidally (clipmap-style), so only the border strips that the scroll
+ * exposed are drawn, and the rest of the depth stays where it is */
+class CsmStaticCache
+{
+public:
+    /* a rectangle of the cascade window, in texels */
+    struct Rect
+    {
+        glm::uvec2 Offset{0};
+        glm::uvec2 Size{0};
+
+        bool operator==(const Rect&) const = default;
+    };
+    /* a part of a window rectangle that does not wrap around in the toroidally addressed cache layer */
+    struct CacheRegion
+    {
+        glm::uvec2 Offset{0};
+        glm::uvec2 CacheOffset{0};
+        glm::uvec2 Size{0};
+    };
+    using CacheRegions = std::array<CacheRegion, 4>;
+    enum class UpdateType : u8
+    {
+        None, Scroll, Full
+    };
+
+    /* cached cascades are made larger by this share of their extent, so that they can follow the main camera */
+    static constexpr f32 EXTENT_MARGIN = 0.15f;
+    /* the depth range of cached cascades is padded by this share of their extent on both sides, because
+     * scrolling cannot follow the main camera along the light direction */
+    static constexpr f32 DEPTH_MARGIN = 1.0f;
+    /* a cascade that needs less than this share of the cached extent would waste too much resolution */
+    static constexpr f32 MIN_EXTENT_RATIO = 0.7f;
+    /* cosine of the largest change of the light direction that the cached depth is still good for */
+    static constexpr f32 MIN_LIGHT_DIRECTION_COS = 0.99999f;
+    /* a cascade that still covers what it has to is not scrolled by fewer texels than this */
+    static constexpr u32 MIN_SCROLL_TEXELS = 8;
+    /* a cascade scrolls at most once in that many frames, unless it no longer covers what it has to;
+     * cascades are staggered by their index, so that the far ones do not scroll on the same frame */
+    static constexpr std::array<u32, SHADOW_CASCADES> UPDATE_PERIODS = {1, 1, 2, 4};
+public:
+    CsmStaticCache() = default;
+    explicit CsmStaticCache(u32 resolution);
+    static CsmStaticCache Create(RG::Graph& graph, DeletionQueue& deletionQueue);
+
+    /* `cameras` and `corners` are the shadow cameras and the main camera frustum slices that the cascades need
+     * this frame, `changedBounds` are world-space bounds of the geometry that was added, moved or removed */
+    void Prepare(Span<const Camera> cameras, Span<const FrustumCorners> corners, const glm::vec3& lightDirection,
+        Span<const AABB> changedBounds);
+    /* all cascades are redrawn on the next `Prepare` */
+    void Invalidate();
+
+    UpdateType GetUpdate(u32 cascade) const { return m_Cascades[cascade].Update; }
+    /* the window rectangles of the static depth of the cascade that have to be drawn this frame */
+    Span<const Rect> GetStrips(u32 cascade) const;
+    /* both the static and the dynamic casters of the cascade are drawn with this camera */
+    const Camera& GetCamera(u32 cascade) const { return m_Cascades[cascade].Camera; }
+    /* the camera that draws only the `strip` of the cascade window, into an image of the strip size */
+    Camera GetStripCamera(u32 cascade, const Rect& strip) const;
+    /* the cache texel of the window texel `w` is `(w + origin) mod resolution` */
+    const glm::uvec2& GetOrigin(u32 cascade) const { return m_Cascades[cascade].Origin; }
+    /* splits the window `rect` into the parts that are contiguous in the cache layer, returns the part count */
+    u32 GetCacheRegions(u32 cascade, const Rect& rect, CacheRegions& regions) const;
+
+    u32 GetResolution() const { return m_Resolution; }
+    /* the cached depth of cascade `i` is in the layer `i` */
+    RG::PersistentImageResource GetStaticDepth() const { return m_StaticDepth; }
+private:
+    static bool Covers(const Camera& cached, const Camera& camera, const FrustumCorners& corners);
+    static bool IsAffected(const Camera& cached, Span<const AABB> changedBounds);
+    glm::ivec2 ScrollTexels(const Camera& cached, const FrustumCorners& corners) const;
+    Camera ScrollCamera(const Camera& cached, const glm::ivec2& texels) const;
+private:
+    struct Cascade
+    {
+        Camera Camera{CameraType::Orthographic};
+        glm::uvec2 Origin{0};
+        UpdateType Update{UpdateType::Full};
+        std::array<Rect, 2> Strips{};
+        u32 StripCount{0};
+    };
+    std::array<Cascade, SHADOW_CASCADES> m_Cascades{};
+    u32 m_Resolution{SHADOW_MAP_RESOLUTION};
+    u64 m_Frame{0};
+    bool m_IsValid{false};
+    glm::vec3 m_LightDirection{0.0f};
+    RG::PersistentImageResource m_StaticDepth{};
+};
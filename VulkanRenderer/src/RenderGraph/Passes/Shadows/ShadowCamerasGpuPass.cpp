@@ -43,12 +43,14 @@ Passes::ShadowCamerasGpu::PassData& Passes::ShadowCamerasGpu::addToGraph(StringI
                 u32 ShadowSize;
                 u32 CascadeCount;
                 f32 MaxShadowDistance;
+                f32 SplitLambda;
                 glm::vec3 LightDirection;
             };
             PushConstant pushConstant = {
                 .ShadowSize = SHADOW_MAP_RESOLUTION,
                 .CascadeCount = SHADOW_CASCADES,
                 .MaxShadowDistance = *CVars::Get().GetF32CVar("Renderer.Limits.MaxShadowDistance"_hsv),
+                .SplitLambda = info.SplitLambda,
                 .LightDirection = info.LightDirection
             };
 
@@ -10,6 +10,8 @@ struct ExecutionInfo
     RG::BufferResource DepthMinMax{};
     RG::BufferResource View{};
     glm::vec3 LightDirection{};
+    /* 0 is for logarithmic splits and 1 is for uniform splits, see `ShadowUtils::cascadeSplits` */
+    f32 SplitLambda{0.0f};
 };
 
 struct PassData
@@ -4,6 +4,8 @@
 
 #include "Settings.h"
 
+#include <CoreLib/Math/CoreMath.h>
+
 namespace
 {
 ShadowProjectionBounds projectionBoundsSphereWorld(const FrustumCorners& frustumCorners, const AABB& geometryBounds)
@@ -42,6 +44,43 @@ ShadowProjectionBounds projectionBoundsSphereWorld(const FrustumCorners& frustum
 
 namespace ShadowUtils
 {
+CascadeSplits cascadeSplits(const CascadeSplitInfo& info)
+{
+    ASSERT(info.CascadeCount > 0 && info.CascadeCount <= SHADOW_CASCADES,
+        "Cascade count must be in range [1, {}]", SHADOW_CASCADES)
+
+    /* the range of a degenerate cascade, relative to its near depth */
+    static constexpr f32 MIN_DEPTH_RATIO = 1.001f;
+
+    const f32 cameraFar = std::max(info.Far, info.Near);
+    f32 near = info.Near;
+    f32 far = cameraFar;
+    /* no geometry was visible, if the depth range is empty */
+    if (info.DepthMin < info.DepthMax)
+    {
+        near = std::clamp(info.DepthMin, info.Near, cameraFar);
+        far = std::clamp(info.DepthMax, near, cameraFar);
+    }
+    far = std::max(far, near * MIN_DEPTH_RATIO);
+
+    CascadeSplits splits = {};
+    splits.Near = near;
+    for (u32 i = 0; i < info.CascadeCount; i++)
+    {
+        /* https://developer.nvidia.com/gpugems/gpugems3/
+         * part-ii-light-and-shadows/chapter-10-parallel-split-shadow-maps-programmable-gpus */
+        const f32 iOverN = (f32)(i + 1) / (f32)info.CascadeCount;
+        const f32 cLog = near * std::pow(far / near, iOverN);
+        const f32 cUniform = near + (far - near) * iOverN;
+
+        splits.Far[i] = Math::lerp(cLog, cUniform, info.Lambda);
+    }
+    /* the last split is exactly at the far depth */
+    splits.Far[info.CascadeCount - 1] = far;
+
+    return splits;
+}
+
 Camera shadowCameraStable(const FrustumCorners& frustumCorners, const AABB& geometryBounds,
     const glm::vec3& lightDirection, const glm::vec3& up)
 {
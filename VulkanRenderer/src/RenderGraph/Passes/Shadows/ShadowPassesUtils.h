@@ -1,10 +1,37 @@
 #pragma once
 
 #include "ShadowPassesCommon.h"
+#include "Settings.h"
 #include "Core/Camera.h"
 
+#include <array>
+
 namespace ShadowUtils
 {
+struct CascadeSplitInfo
+{
+    /* view depth range of the main camera, limited by the max shadow distance */
+    f32 Near{0.1f};
+    f32 Far{100.0f};
+    /* view depth range of the visible geometry, from the depth reduction; not used if empty */
+    f32 DepthMin{0.0f};
+    f32 DepthMax{0.0f};
+    /* 0 is for logarithmic splits and 1 is for uniform splits */
+    f32 Lambda{0.0f};
+    u32 CascadeCount{SHADOW_CASCADES};
+};
+
+struct CascadeSplits
+{
+    /* view depth where the first cascade starts */
+    f32 Near{0.0f};
+    /* view depth where each cascade ends */
+    std::array<f32, SHADOW_CASCADES> Far{};
+};
+
+/* the cpu reference of the splits that `createShadowCameras` shader computes */
+CascadeSplits cascadeSplits(const CascadeSplitInfo& info);
+
 Camera shadowCameraStable(const FrustumCorners& frustumCorners, const AABB& geometryBounds,
     const glm::vec3& lightDirection, const glm::vec3& up);
 Camera shadowCamera(const FrustumCorners& frustumCorners, const AABB& geometryBounds,
@@ -21,6 +21,7 @@
 
 #include "Imgui/ImguiUI.h"
 #include "Light/LightFrustumCuller.h"
+#include "Light/LightClusterCache.h"
 #include "Light/LightZBinner.h"
 #include "Light/SH.h"
 #include "RenderGraph/RGCommon.h"
@@ -87,6 +88,7 @@
 #include <AssetLib/Scenes/Scene/SceneMeta.h>
 #include <AssetLib/Io/Compression/Lz4AssetCompressor.h>
 #include <AssetLib/Io/Compression/RawAssetCompressor.h>
+#include <AssetLib/Io/Compression/ZstdAssetCompressor.h>
 #include <AssetLib/Io/IoInterface/CombinedAssetIoInterface.h>
 #include <AssetLib/Io/IoInterface/SeparateAssetIoInterface.h>
 #include <CoreLib/Math/Random.h>
@@ -113,10 +115,24 @@ void Renderer::Init()
         m_AssetIoInterface = std::make_shared<lux::assetlib::io::SeparateAssetIoInterface>();
     else
         m_AssetIoInterface = std::make_shared<lux::assetlib::io::CombinedAssetIoInterface>();
-    if (*CVars::Get().GetI32CVar("Assets.IoCompression"_hsv) == 0)
+    const i32 assetCompression = *CVars::Get().GetI32CVar("Assets.IoCompression"_hsv);
+    if (assetCompression == 0)
+    {
         m_AssetCompressor = std::make_shared<lux::assetlib::io::Lz4AssetCompressor>();
+    }
+    else if (assetCompression == 2)
+    {
+        auto zstd = std::make_shared<lux::assetlib::io::ZstdAssetCompressor>();
+        auto dictionariesLoad = zstd->LoadDictionaries(lux::assetlib::io::ZstdAssetCompressor::GetDictionariesDirectory(
+            *CVars::Get().GetStringCVar("Path.AssetsBaked"_hsv)));
+        if (!dictionariesLoad.has_value())
+            LUX_LOG_ERROR("Failed to load compression dictionaries: {}", dictionariesLoad.error());
+        m_AssetCompressor = std::move(zstd);
+    }
     else
+    {
         m_AssetCompressor = std::make_shared<lux::assetlib::io::RawAssetCompressor>();
+    }
 
     m_ImportCtx = std::make_shared<lux::import::Context>(lux::import::Context{
         .InitialDirectory = *CVars::Get().GetStringCVar("Path.Assets"_hsv),
@@ -132,6 +148,7 @@ void Renderer::Init()
 
     m_AssetSystem.Init(m_ImportCtx);
     m_AssetSystem.SetAssetsDirectory(*CVars::Get().GetStringCVar("Path.Assets"_hsv));
+    m_AssetSystem.SetAssetIndexPath(*CVars::Get().GetStringCVar("Path.AssetIndex"_hsv));
 
     m_ShaderAssetManager = std::make_unique<lux::ShaderAssetManager>(m_AssetSystem);
     m_AssetSystem.RegisterAssetManager(lux::assetlib::shader::ASSET_TYPE, *m_ShaderAssetManager);
@@ -229,6 +246,9 @@ void Renderer::InitRenderGraph()
     //    *CVars::Get().GetStringCVar("Path.Assets"_hsv) + "models/lights_test/scene.gltf");
     
     m_Scene = std::make_unique<Scene>(Device::DeletionQueue(), *m_SceneAssetManager);
+    m_LightZBinner = LightZBinner::Create(Device::DeletionQueue());
+    m_LightClusterCache = LightClusterCache::Create(Device::DeletionQueue());
+    m_CsmStaticCache = CsmStaticCache::Create(*m_Graph, Device::DeletionQueue());
     m_SceneBucketList.Init(*m_Scene);
     m_OpaqueSet.Init("Opaque"_hsv, *m_Scene, m_SceneBucketList, {
         ScenePassCreateInfo{
@@ -236,17 +256,7 @@ void Renderer::InitRenderGraph()
             .BucketCreateInfos = {
                 {
                     .Name = "Opaque material"_hsv,
-                    .Filter = [this](const lux::SceneGeometryInfo& geometry, SceneRenderObjectHandle renderObject) {
-                        const u32 material = geometry.RenderObjects[renderObject.Index].Material;
-                        if (material == lux::SceneRenderObject::INVALID)
-                            return false;
-                        const lux::MaterialAsset* materialAsset = m_MaterialAssetManager->Get(
-                            geometry.MaterialsCpu[material].Handle);
-                        if (materialAsset == nullptr)
-                            return false;
-                        
-                        return materialAsset->AlphaMode == lux::MaterialAlphaMode::Opaque;
-                    }
+                    .Predicate = SceneBucketPredicate::Has(SceneRenderObjectFlags::Opaque),
                 }
             }
         },
@@ -255,17 +265,7 @@ void Renderer::InitRenderGraph()
             .BucketCreateInfos = {
                 {
                     .Name = "Opaque material"_hsv,
-                    .Filter = [this](const lux::SceneGeometryInfo& geometry, SceneRenderObjectHandle renderObject) {
-                        const u32 material = geometry.RenderObjects[renderObject.Index].Material;
-                        if (material == lux::SceneRenderObject::INVALID)
-                            return false;
-                        const lux::MaterialAsset* materialAsset = m_MaterialAssetManager->Get(
-                            geometry.MaterialsCpu[material].Handle);
-                        if (materialAsset == nullptr)
-                            return false;
-                        
-                        return materialAsset->AlphaMode == lux::MaterialAlphaMode::Opaque;
-                    }
+                    .Predicate = SceneBucketPredicate::Has(SceneRenderObjectFlags::Opaque),
                 }
             }
         },
@@ -274,31 +274,25 @@ void Renderer::InitRenderGraph()
             .BucketCreateInfos = {
                 {
                     .Name = "Opaque material"_hsv,
-                    .Filter = [](const lux::SceneGeometryInfo& geometry, SceneRenderObjectHandle renderObject) {
-                        return renderObject.Index < 1;
-                    },
+                    .Predicate = {.FirstRenderObject = 0, .RenderObjectCount = 1},
                 },
                 {
                     .Name = "Opaque material2"_hsv,
-                    .Filter = [this](const lux::SceneGeometryInfo& geometry, SceneRenderObjectHandle renderObject) {
-                        const u32 material = geometry.RenderObjects[renderObject.Index].Material;
-                        if (material == lux::SceneRenderObject::INVALID)
-                            return false;
-                        const lux::MaterialAsset* materialAsset = m_MaterialAssetManager->Get(
-                            geometry.MaterialsCpu[material].Handle);
-                        if (materialAsset == nullptr)
-                            return false;
-                        
-                        return materialAsset->AlphaMode == lux::MaterialAlphaMode::Opaque && renderObject.Index > 1;
+                    .Predicate = {
+                        .Mask = SceneRenderObjectFlags::Opaque,
+                        .Value = SceneRenderObjectFlags::Opaque,
+                        .FirstRenderObject = 2
                     },
                     .ShaderOverrides = ShaderDefines({ShaderDefine("TEST"_hsv)})
                 }
             }
         },
-        Passes::SceneCsm::getScenePassCreateInfo("Shadow"_hsv, *m_MaterialAssetManager),
-    }, Device::DeletionQueue());
+        Passes::SceneCsm::getStaticScenePassCreateInfo("ShadowStatic"_hsv),
+        Passes::SceneCsm::getDynamicScenePassCreateInfo("Shadow"_hsv),
+    }, *m_MaterialAssetManager, Device::DeletionQueue());
 
     m_ShadowMultiviewVisibility.Init(m_OpaqueSet);
+    m_ShadowStaticMultiviewVisibility.Init(m_OpaqueSet);
     m_PrimaryVisibility.Init(m_OpaqueSet);
     
     /* initial submit */
@@ -318,10 +312,10 @@ void Renderer::InitRenderGraph()
         ctx.CommandList.SetCommandBuffer(cmd);
         
         m_Scenes.push_back(
-            m_SceneAssetManager->LoadResource(
+            m_SceneAssetManager->LoadResourceAsync(
                 {.Path = *CVars::Get().GetStringCVar("Path.Assets"_hsv) + "models/hotReloadTest/scene.gltf"}));
         m_Scenes.push_back(
-            m_SceneAssetManager->LoadResource(
+            m_SceneAssetManager->LoadResourceAsync(
                 {.Path = *CVars::Get().GetStringCVar("Path.Assets"_hsv) + "models/flight_helmet/scene.gltf"}));
         
         lux::SceneInstanceHandle instance = m_Scene->Instantiate(m_Scenes.front(), {
@@ -550,7 +544,9 @@ void Renderer::SetupRenderGraph()
         .Name = "OpaquePrimary"_hsv,
         .ViewInfo = SceneViewInfo(
             m_Graph->GetGlobalResources().PrimaryViewInfoResource,
-            (VisibilityFlags)m_Graph->GetGlobalResources().PrimaryViewInfo.Camera.VisibilityFlags)
+            (VisibilityFlags)m_Graph->GetGlobalResources().PrimaryViewInfo.Camera.VisibilityFlags),
+        .CullFrustum = Frustum::FromViewProjection(
+            m_Graph->GetGlobalResources().PrimaryViewInfo.Camera.ViewProjection)
     };
     
     m_OpaqueSetPrimaryVisibility = m_PrimaryVisibility.AddVisibility(m_OpaqueSetPrimaryView);
@@ -577,17 +573,21 @@ void Renderer::SetupRenderGraph()
     else
         metaUgb = &RenderGraphVBuffer(vbuffer, color, depth);
 
-    std::swap(
-        m_MinMaxDepthReductionsNextFrame[GetFrameContext().FrameNumber],
-        m_MinMaxDepthReductions[GetFrameContext().FrameNumber]);
+    /* gpu shadow cameras read the depth reduction of the current frame, and do not need it read back */
+    if (!CVars::Get().GetI32CVar("Renderer.UseGpuShadowCameras"_hsv).value_or(false))
+    {
+        std::swap(
+            m_MinMaxDepthReductionsNextFrame[GetFrameContext().FrameNumber],
+            m_MinMaxDepthReductions[GetFrameContext().FrameNumber]);
+
+        m_Graph->Export(
+            metaUgb->DrawPassViewAttachments.GetMinMaxDepthReduction(m_OpaqueSetPrimaryView.Name),
+            m_MinMaxDepthReductionsNextFrame[GetFrameContext().FrameNumber],
+            Device::DeletionQueue());
+    }
 
     ImageResource minMaxDepth =
         m_PrimaryVisibilityResources.Hiz[primaryVisibilityIndex];
-    
-    m_Graph->Export(
-        metaUgb->DrawPassViewAttachments.GetMinMaxDepthReduction(m_OpaqueSetPrimaryView.Name),
-        m_MinMaxDepthReductionsNextFrame[GetFrameContext().FrameNumber],
-        Device::DeletionQueue());
 
     m_Graph->Export(m_PrimaryVisibilityResources.Hiz[primaryVisibilityIndex],
         m_PrimaryHizPrevious[GetFrameContext().FrameNumber], Device::DeletionQueue());
@@ -756,6 +756,7 @@ void Renderer::UpdateGlobalRenderGraphResources()
         *CVars::Get().GetF32CVar("Renderer.Limits.MaxLightCullDistance"_hsv);
     primaryView.Shading.DirectionalLightCount = m_Scene->Lights().DirectionalLightCount();
     primaryView.Shading.PointLightCount = m_Scene->Lights().PointLightCount();
+    primaryView.Shading.SpotLightCount = m_Scene->Lights().SpotLightCount();
     // todo: toC VAR
     primaryView.Shading.LightCullingUseZBins = true;
     primaryView.Shading.LightCullTileCount =
@@ -857,7 +858,8 @@ void Renderer::UpdateGlobalRenderGraphResources()
     }).Destination;
 }
 
-RG::CsmData Renderer::RenderGraphShadows(const ScenePass& scenePass, const lux::CommonLight& directionalLight)
+RG::CsmData Renderer::RenderGraphShadows(const ScenePass& staticPass, const ScenePass& dynamicPass,
+    const lux::CommonLight& directionalLight)
 {
     using namespace RG;
 
@@ -884,27 +886,69 @@ RG::CsmData Renderer::RenderGraphShadows(const ScenePass& scenePass, const lux::
         }
     }
     
-    auto& csmInit = Passes::SceneCsm::addToGraph("CSM"_hsv,
-        *m_Graph, {
-            .Pass = &scenePass,
-            .Geometry = &m_SceneGeometryRGResources,
-            .MultiviewVisibility = &m_ShadowMultiviewVisibility,
-            .MainCamera = m_Camera.get(),
-            .DirectionalLight = DirectionalLight{{
-                .Direction = directionalLight.PositionDirection,
-                .Color = directionalLight.Color,
-                .Intensity = directionalLight.Intensity,
-                .Radius = directionalLight.Radius
-            }},
-            .ShadowMin = shadowMin,
-            .ShadowMax = shadowMax,
-            .DepthMinMaxBuffer = m_DepthMinMaxCurrentFrame,
-            .CreateCamerasInGpu = useGpuShadowCameras,
-            .StabilizeCascades = false
-        });
+    /* occlusion culling reprojects the hiz of the previous frame, and so needs the cameras it was built with */
+    const bool occlusionCullShadows = !useGpuShadowCameras &&
+        CVars::Get().GetI32CVar("Renderer.Shadows.OcclusionCull"_hsv).value_or(false);
+
+    const Passes::SceneCsm::ExecutionInfo csmInfo = {
+        .StaticPass = &staticPass,
+        .DynamicPass = &dynamicPass,
+        .Geometry = &m_SceneGeometryRGResources,
+        .StaticMultiviewVisibility = &m_ShadowStaticMultiviewVisibility,
+        .MultiviewVisibility = &m_ShadowMultiviewVisibility,
+        .StaticCache = &m_CsmStaticCache,
+        .ChangedBounds = m_Scene->ChangedBounds(),
+        .MainCamera = m_Camera.get(),
+        .DirectionalLight = DirectionalLight{{
+            .Direction = directionalLight.PositionDirection,
+            .Color = directionalLight.Color,
+            .Intensity = directionalLight.Intensity,
+            .Radius = directionalLight.Radius
+        }},
+        .ShadowMin = shadowMin,
+        .ShadowMax = shadowMax,
+        .DepthMinMaxBuffer = m_DepthMinMaxCurrentFrame,
+        .CreateCamerasInGpu = useGpuShadowCameras,
+        .PreviousHiz = occlusionCullShadows ? &m_CsmHiz[GetPreviousFrameNumber()] : nullptr,
+        .StabilizeCascades = false
+    };
+    auto& csmInit = Passes::SceneCsm::addToGraph("CSM"_hsv, *m_Graph, csmInfo);
+
+    /* static casters are drawn only into the strips of the cached depth that have to be updated */
+    const SceneDrawPassViewAttachments* staticAttachments = nullptr;
+    if (!csmInit.StaticMetaPassDescriptions.empty())
+    {
+        m_ShadowStaticMultiviewVisibilityResources = SceneVisibilityPassesResources::FromSceneMultiviewVisibility(
+            *m_Graph, m_SceneGeometryRGResources, m_ShadowStaticMultiviewVisibility);
+        
+        auto& staticMeta = Passes::SceneMetaDraw::addToGraph("MetaCsmStaticPass"_hsv,
+            *m_Graph, {
+                .MultiviewVisibility = &m_ShadowStaticMultiviewVisibility,
+                .Resources = &m_ShadowStaticMultiviewVisibilityResources,
+                .DrawPasses = csmInit.StaticMetaPassDescriptions
+            });
+        staticAttachments = &staticMeta.DrawPassViewAttachments;
+    }
+    Passes::SceneCsm::addDynamicToGraph("CSM"_hsv, *m_Graph, csmInit, csmInfo, staticAttachments);
 
     m_ShadowMultiviewVisibilityResources = SceneVisibilityPassesResources::FromSceneMultiviewVisibility(
         *m_Graph, m_SceneGeometryRGResources, m_ShadowMultiviewVisibility);
+    if (occlusionCullShadows)
+    {
+        const Passes::SceneCsm::CascadesHiz& previousHiz = m_CsmHiz[GetPreviousFrameNumber()];
+        for (u32 i = 0; i < SHADOW_CASCADES; i++)
+        {
+            const u32 visibilityIndex = m_ShadowMultiviewVisibility.VisibilityHandleToIndex(
+                csmInit.MetaPassDescriptions[i].Visibility);
+            m_ShadowMultiviewVisibilityResources.HizPrevious[visibilityIndex] =
+                previousHiz.Hiz[i].HasValue() ?
+                m_Graph->ImportPersistent(StringId("CsmHiz.Previous.{}", i), previousHiz.Hiz[i]) :
+                m_Graph->Import(StringId("CsmHiz.Dummy.{}", i),
+                    images::Default::GetCopy(images::DefaultKind::White, GetFrameContext().DeletionQueue),
+                    ImageLayout::Readonly
+                );
+        }
+    }
     
     auto& meta = Passes::SceneMetaDraw::addToGraph("MetaCsmPass"_hsv,
         *m_Graph, {
@@ -913,7 +957,20 @@ RG::CsmData Renderer::RenderGraphShadows(const ScenePass& scenePass, const lux::
             .DrawPasses = csmInit.MetaPassDescriptions
         });
 
-    Passes::SceneCsm::mergeCsm(*m_Graph, csmInit, scenePass, meta.DrawPassViewAttachments);
+    if (occlusionCullShadows)
+    {
+        Passes::SceneCsm::CascadesHiz& hiz = m_CsmHiz[GetFrameContext().FrameNumber];
+        for (u32 i = 0; i < SHADOW_CASCADES; i++)
+        {
+            const u32 visibilityIndex = m_ShadowMultiviewVisibility.VisibilityHandleToIndex(
+                csmInit.MetaPassDescriptions[i].Visibility);
+            m_Graph->Export(m_ShadowMultiviewVisibilityResources.Hiz[visibilityIndex], hiz.Hiz[i],
+                Device::DeletionQueue());
+            hiz.Cameras[i] = csmInit.CascadeViewInfos[i].AsViewInfoGPU().Camera;
+        }
+    }
+
+    Passes::SceneCsm::mergeCsm(*m_Graph, csmInit, dynamicPass, meta.DrawPassViewAttachments);
 
     Passes::ImGuiArrayTexture::addToGraph("Csm atlas"_hsv, *m_Graph, csmInit.CsmData.ShadowMap,
         Passes::ImGuiArrayTexture::DrawAs::Atlas, Passes::ChannelComposition::RComposition());
@@ -984,6 +1041,7 @@ SceneDrawPassDescription Renderer::RenderGraphForwardPbrDescription(RG::ImageRes
             .DirectionalLights = m_Graph->Import(
                 "DirectionalLights"_hsv, m_Scene->Lights().GetBuffers().DirectionalLights),
             .PointLights = m_Graph->Import("PointLights"_hsv, m_Scene->Lights().GetBuffers().PointLights),
+            .SpotLights = m_Graph->Import("SpotLights"_hsv, m_Scene->Lights().GetBuffers().SpotLights),
             .SSAO = {.SSAO = m_Ssao},
             .IBL = {
                 .IrradianceSH = renderAtmosphere ? 
@@ -1099,6 +1157,7 @@ RG::ImageResource Renderer::RenderGraphVBufferPbr(RG::ImageResource vbuffer, RG:
         .ViewInfo = viewInfo,
         .DirectionalLights = m_Graph->Import("DirectionalLights"_hsv, m_Scene->Lights().GetBuffers().DirectionalLights),
         .PointLights = m_Graph->Import("PointLights"_hsv, m_Scene->Lights().GetBuffers().PointLights),
+        .SpotLights = m_Graph->Import("SpotLights"_hsv, m_Scene->Lights().GetBuffers().SpotLights),
         .SSAO = {.SSAO = m_Ssao},
         .IBL = {
             .IrradianceSH = renderAtmosphere ? m_SkyIrradianceSHResource :
@@ -1118,6 +1177,7 @@ RG::ImageResource Renderer::RenderGraphVBufferPbr(RG::ImageResource vbuffer, RG:
 
 Passes::SceneMetaDraw::PassData& Renderer::RenderGraphForwardPass(RG::ImageResource& color, RG::ImageResource& depth)
 {
+    auto& shadowStaticPass = m_OpaqueSet.FindPass("ShadowStatic"_hsv);
     auto& shadowPass = m_OpaqueSet.FindPass("Shadow"_hsv);
     auto* depthPrepass = m_OpaqueSet.TryFindPass("DepthPrepass"_hsv);
     auto& pbrPass = m_OpaqueSet.FindPass("ForwardPbr"_hsv);
@@ -1134,7 +1194,7 @@ Passes::SceneMetaDraw::PassData& Renderer::RenderGraphForwardPass(RG::ImageResou
     }
 
     if (m_SunLight != nullptr)
-        m_CsmData = RenderGraphShadows(shadowPass, *m_SunLight);
+        m_CsmData = RenderGraphShadows(shadowStaticPass, shadowPass, *m_SunLight);
     
     auto& meta = Passes::SceneMetaDraw::addToGraph("MetaUgb"_hsv,
         *m_Graph, {
@@ -1151,6 +1211,7 @@ Passes::SceneMetaDraw::PassData& Renderer::RenderGraphForwardPass(RG::ImageResou
 Passes::SceneMetaDraw::PassData& Renderer::RenderGraphVBuffer(RG::ImageResource& vbuffer, RG::ImageResource& color, 
     RG::ImageResource& depth)
 {
+    auto& shadowStaticPass = m_OpaqueSet.FindPass("ShadowStatic"_hsv);
     auto& shadowPass = m_OpaqueSet.FindPass("Shadow"_hsv);
     auto& vbufferPass = m_OpaqueSet.FindPass("Vbuffer"_hsv);
     
@@ -1163,7 +1224,7 @@ Passes::SceneMetaDraw::PassData& Renderer::RenderGraphVBuffer(RG::ImageResource&
     m_DepthMinMaxCurrentFrame = meta.DrawPassViewAttachments.GetMinMaxDepthReduction(m_OpaqueSetPrimaryView.Name);
 
     if (m_SunLight != nullptr)
-        m_CsmData = RenderGraphShadows(shadowPass, *m_SunLight);
+        m_CsmData = RenderGraphShadows(shadowStaticPass, shadowPass, *m_SunLight);
 
     depth = meta.DrawPassViewAttachments.Get(m_OpaqueSetPrimaryView.Name, vbufferPass.Name()).Depth->Resource;
     vbuffer = meta.DrawPassViewAttachments.Get(m_OpaqueSetPrimaryView.Name, vbufferPass.Name()).Colors[0].Resource;
@@ -1221,9 +1282,8 @@ Renderer::TileLightsInfo Renderer::RenderGraphCullLightsTiled(StringId baseName,
         BufferResource ZBins{};
     };
 
-    auto zbins = LightZBinner::ZBinLights(m_Scene->Lights(), *GetFrameContext().PrimaryCamera);
-    BufferResource zbinsResource = Passes::Upload::addToGraph(baseName.Concatenate("Upload.Light.ZBins"), *m_Graph,
-        zbins.Bins);
+    m_LightZBinner.ZBinLights(m_Scene->Lights(), *GetFrameContext().PrimaryCamera, GetFrameContext());
+    BufferResource zbinsResource = m_Graph->Import(baseName.Concatenate("Light.ZBins"), m_LightZBinner.GetBins(GetFrameContext()));
     auto& tilesSetup = Passes::LightTilesSetup::addToGraph(baseName.Concatenate("Tiles.Setup"), *m_Graph, {
         .ViewInfo =  m_Graph->GetGlobalResources().PrimaryViewInfoResource
     });
@@ -1232,6 +1292,7 @@ Renderer::TileLightsInfo Renderer::RenderGraphCullLightsTiled(StringId baseName,
         .Tiles = tilesSetup.Tiles, 
         .Depth = depth,
         .PointLights = m_Graph->Import("PointLights"_hsv, m_Scene->Lights().GetBuffers().PointLights),
+        .SpotLights = m_Graph->Import("SpotLights"_hsv, m_Scene->Lights().GetBuffers().SpotLights),
     });
     auto& visualizeTiles = Passes::LightTilesVisualize::addToGraph(baseName.Concatenate("Tiles.Visualize"), *m_Graph, {
         .ViewInfo = m_Graph->GetGlobalResources().PrimaryViewInfoResource,
@@ -1257,15 +1318,30 @@ Renderer::ClusterLightsInfo Renderer::RenderGraphCullLightsClustered(StringId ba
         BufferResource Clusters{};
     };
     
-    auto& clustersSetup = Passes::LightClustersSetup::addToGraph(baseName.Concatenate("Clusters.Setup"), *m_Graph, {
-        .ViewInfo = m_Graph->GetGlobalResources().PrimaryViewInfoResource
-    });
+    const LightClusterCache::Update clustersUpdate = m_LightClusterCache.Prepare(m_Scene->Lights(),
+        *GetFrameContext().PrimaryCamera, GetFrameContext());
+    BufferResource clusters = m_Graph->Import(baseName.Concatenate("Clusters"), m_LightClusterCache.GetClusters());
+    BufferResource clusterVisibility = m_Graph->Import(baseName.Concatenate("Clusters.Visibility"),
+        m_LightClusterCache.GetClusterVisibility());
+    if (clustersUpdate.SetupClusters)
+    {
+        auto& clustersSetup = Passes::LightClustersSetup::addToGraph(baseName.Concatenate("Clusters.Setup"), *m_Graph, {
+            .ViewInfo = m_Graph->GetGlobalResources().PrimaryViewInfoResource,
+            .Clusters = clusters,
+            .ClusterVisibility = clusterVisibility
+        });
+        clusters = clustersSetup.Clusters;
+        clusterVisibility = clustersSetup.ClusterVisibility;
+    }
     auto& binLightsClusters = Passes::LightClustersBin::addToGraph(baseName.Concatenate("Clusters.Bin"), *m_Graph, {
         .ViewInfo = m_Graph->GetGlobalResources().PrimaryViewInfoResource,
-        .Clusters = clustersSetup.Clusters,
-        .ClusterVisibility = clustersSetup.ClusterVisibility,
+        .Clusters = clusters,
+        .ClusterVisibility = clusterVisibility,
         .Depth = depth,
         .PointLights = m_Graph->Import("PointLights"_hsv, m_Scene->Lights().GetBuffers().PointLights),
+        .SpotLights = m_Graph->Import("SpotLights"_hsv, m_Scene->Lights().GetBuffers().SpotLights),
+        .Generation = clustersUpdate.Generation,
+        .DirtyLights = clustersUpdate.DirtyLights
     });
 
     auto& visualizeClusters = Passes::LightClustersVisualize::addToGraph(baseName.Concatenate("Clusters.Visualize"),
@@ -1835,6 +1911,7 @@ void Renderer::OnUpdate()
     m_OpaqueSet.OnUpdate(GetFrameContext());
 
     m_ShadowMultiviewVisibility.OnUpdate(GetFrameContext());
+    m_ShadowStaticMultiviewVisibility.OnUpdate(GetFrameContext());
     m_PrimaryVisibility.OnUpdate(GetFrameContext());
 
     struct InstanceWithLife
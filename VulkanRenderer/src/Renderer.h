@@ -9,6 +9,8 @@
 #include "Core/Camera.h"
 #include "RenderGraph/RGGraph.h"
 #include "FrameContext.h"
+#include "Light/LightClusterCache.h"
+#include "Light/LightZBinner.h"
 #include "Assets/AssetSystem.h"
 #include "Assets/Images/ImageAssetManager.h"
 #include "Renderer/RGAssets.h"
@@ -16,9 +18,11 @@
 #include "RenderGraph/Passes/Clouds/VerticalProfile/VPCloudPass.h"
 #include "RenderGraph/Passes/Scene/SceneGeometryRGResources.h"
 #include "RenderGraph/Passes/Scene/Visibility/SceneVisibilityPassesCommon.h"
+#include "RenderGraph/Passes/Shadows/CsmStaticCache.h"
 #include "RenderGraph/Passes/SceneDraw/SceneDrawPassesCommon.h"
 #include "RenderGraph/Passes/SceneDraw/PBR/ExposurePass.h"
 #include "RenderGraph/Passes/SceneDraw/PBR/TonemappingPass.h"
+#include "RenderGraph/Passes/SceneDraw/Shadow/SceneCsmPass.h"
 #include "RenderGraph/Visualization/RGMermaidExporter.h"
 #include "Vulkan/Device.h"
 #include "Rendering/Swapchain.h"
@@ -91,7 +95,8 @@ private:
     void SetupRenderGraph();
     void UpdateGlobalRenderGraphResources();
 
-    RG::CsmData RenderGraphShadows(const ScenePass& scenePass, const lux::CommonLight& directionalLight);
+    RG::CsmData RenderGraphShadows(const ScenePass& staticPass, const ScenePass& dynamicPass,
+        const lux::CommonLight& directionalLight);
     Passes::SceneMetaDraw::PassData& RenderGraphDepthPrepass(RG::ImageResource depth, const ScenePass& scenePass);
     SceneDrawPassDescription RenderGraphDepthPrepassDescription(RG::ImageResource depth, const ScenePass& scenePass);
     SceneDrawPassDescription RenderGraphForwardPbrDescription(RG::ImageResource color, RG::ImageResource depth,
@@ -253,6 +258,8 @@ private:
     std::vector<lux::SceneHandle> m_Scenes;
     lux::SceneHandle m_Lights{};
     std::unique_ptr<Scene> m_Scene;
+    LightZBinner m_LightZBinner;
+    LightClusterCache m_LightClusterCache;
     SceneGeometryRGResources m_SceneGeometryRGResources;
     SceneBucketList m_SceneBucketList;
     SceneRenderObjectSet m_OpaqueSet;
@@ -262,8 +269,12 @@ private:
     std::array<RG::PersistentBufferResource, BUFFERED_FRAMES> m_MinMaxDepthReductions{};
     std::array<RG::PersistentBufferResource, BUFFERED_FRAMES> m_MinMaxDepthReductionsNextFrame{};
     SceneMultiviewVisibility m_ShadowMultiviewVisibility{};
+    SceneMultiviewVisibility m_ShadowStaticMultiviewVisibility{};
     SceneMultiviewVisibility m_PrimaryVisibility{};
     SceneVisibilityPassesResources m_ShadowMultiviewVisibilityResources{};
+    SceneVisibilityPassesResources m_ShadowStaticMultiviewVisibilityResources{};
+    CsmStaticCache m_CsmStaticCache{};
+    std::array<Passes::SceneCsm::CascadesHiz, BUFFERED_FRAMES> m_CsmHiz{};
     SceneVisibilityPassesResources m_PrimaryVisibilityResources{};
 
     std::array<RG::PersistentImageResource, BUFFERED_FRAMES> m_PrimaryHizPrevious{};
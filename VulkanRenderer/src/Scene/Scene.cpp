@@ -4,7 +4,11 @@
 
 #include "FrameContext.h"
 #include "ResourceUploader.h"
+#include "cvars/CVarSystem.h"
 #include "Assets/Materials/MaterialAssetManager.h"
+#include "Core/Camera.h"
+
+#include <CoreLib/Math/Frustum.h>
 
 Scene::Scene(DeletionQueue& deletionQueue, lux::SceneAssetManager& sceneAssetManager)
     : m_SceneAssetManager(&sceneAssetManager)
@@ -40,6 +44,9 @@ lux::SceneInstanceHandle Scene::Instantiate(lux::SceneHandle scene, const SceneI
 
 void Scene::InstantiateHandle(lux::SceneInstanceHandle handle, const SceneInstantiationData& instantiationData)
 {
+    if (handle >= m_NewInstanceIndices.size())
+        m_NewInstanceIndices.resize(handle + 1, NOT_PENDING_INSTANCE);
+    m_NewInstanceIndices[handle] = (u32)m_NewInstances.size();
     m_NewInstances.push_back({
         .Instance = handle,
         .InstantiationData = instantiationData
@@ -48,13 +55,15 @@ void Scene::InstantiateHandle(lux::SceneInstanceHandle handle, const SceneInstan
 
 void Scene::Delete(lux::SceneInstanceHandle instance)
 {
-    auto it = std::ranges::find_if(m_NewInstances, [&instance](auto& newInstance) {
-        return instance == newInstance.Instance;
-    });
-    const bool isJustAdded = it != m_NewInstances.end();
+    const bool isJustAdded =
+        instance < m_NewInstanceIndices.size() && m_NewInstanceIndices[instance] != NOT_PENDING_INSTANCE;
     if (isJustAdded)
     {
-        m_NewInstances.erase(it);
+        const u32 index = m_NewInstanceIndices[instance];
+        std::swap(m_NewInstances[index], m_NewInstances.back());
+        m_NewInstanceIndices[m_NewInstances[index].Instance] = index;
+        m_NewInstances.pop_back();
+        m_NewInstanceIndices[instance] = NOT_PENDING_INSTANCE;
         return;
     }
 
@@ -64,12 +73,17 @@ void Scene::Delete(lux::SceneInstanceHandle instance)
 
 void Scene::OnUpdate(FrameContext& ctx)
 {
+    m_ChangedBounds.clear();
+    m_SpawnUploadBudget = {
+        .BudgetBytes = (u64)CVars::Get().GetI32CVar("Scene.Streaming.UploadBudgetBytes"_hsv).value_or(0)
+    };
     HandleSpawnAndSweep(ctx, /*reclaimHandles*/true);
     HandleReplacements(ctx);
     HandleMaterialUpdates(ctx);
     
     UpdateHierarchy(ctx);
     m_Lights.OnUpdate(ctx);
+    RequestTextureMips(ctx);
 }
 
 lux::SceneInstanceHandle Scene::RegisterSceneInstance(lux::SceneHandle scene)
@@ -96,9 +110,31 @@ Scene::NewInstanceData Scene::AddToHierarchy(lux::SceneInstanceHandle instance,
     const SceneGeometry::AddInstanceResult addResult = m_Geometry.AddInstance(sceneAsset, instance, ctx);
     m_MaxRenderObjectIndex = std::max(
         m_MaxRenderObjectIndex, addResult.FirstRenderObject + (u32)sceneAsset.Geometry.RenderObjects.size());
+    m_RenderObjectLocalBounds.resize(m_MaxRenderObjectIndex);
+    m_RenderObjectIsDynamic.resize(m_MaxRenderObjectIndex);
+    m_RenderObjectInstances.resize(m_MaxRenderObjectIndex);
+    m_RenderObjectMaterials.resize(m_MaxRenderObjectIndex);
+    for (auto&& [i, renderObject] : std::views::enumerate(sceneAsset.Geometry.RenderObjects))
+    {
+        m_RenderObjectLocalBounds[addResult.FirstRenderObject + i] = renderObject.BoundingBox;
+        m_RenderObjectInstances[addResult.FirstRenderObject + i] = instance;
+        m_RenderObjectMaterials[addResult.FirstRenderObject + i] = renderObject.Material;
+        m_RenderObjectIsDynamic[addResult.FirstRenderObject + i] =
+            renderObject.SkinIndex != lux::SceneRenderObject::INVALID || renderObject.BlendShapeCount > 0;
+    }
 
-    for (auto& node : instanceHierarchy.Nodes)
+    /* the nodes with an animated transform, or with an animated parent, move every frame */
+    std::vector<bool> isNodeAnimated(instanceHierarchy.Nodes.size());
+    for (auto& animation : instanceHierarchy.Animations)
+        isNodeAnimated[animation.Node.Handle] =
+            animation.TranslationChannel != lux::SceneHierarchyAnimation::INVALID ||
+            animation.OrientationChannel != lux::SceneHierarchyAnimation::INVALID ||
+            animation.ScaleChannel != lux::SceneHierarchyAnimation::INVALID;
+
+    for (auto&& [nodeIndex, node] : std::views::enumerate(instanceHierarchy.Nodes))
     {
+        if (node.Parent != lux::SceneHierarchyHandle::INVALID && isNodeAnimated[node.Parent.Handle])
+            isNodeAnimated[nodeIndex] = true;
         const bool isTopLevel = node.Parent == lux::SceneHierarchyHandle::INVALID;
         lux::SceneHierarchyPayload payload = {};
         switch (node.Type)
@@ -106,6 +142,10 @@ Scene::NewInstanceData Scene::AddToHierarchy(lux::SceneInstanceHandle instance,
         case lux::SceneHierarchyNodeType::Mesh:
             {
                 auto& mesh = node.Payload.Mesh;
+                if (isNodeAnimated[nodeIndex])
+                    for (u32 renderObject = 0; renderObject < mesh.RenderObjectCount; renderObject++)
+                        m_RenderObjectIsDynamic[addResult.FirstRenderObject + mesh.FirstRenderObject + renderObject] =
+                            true;
                 payload.Mesh = {
                     .FirstRenderObject = mesh.FirstRenderObject + addResult.FirstRenderObject,
                     .RenderObjectCount = mesh.RenderObjectCount,
@@ -210,6 +250,11 @@ void Scene::HandleReplacements(FrameContext& ctx)
     for (auto&& [original, replacement] : m_ReplacedScenes)
     {
         auto& originalInstances = m_ScenesMap[original].Instances;
+        /* the scene was deleted (or failed to stream in) before its instances were spawned */
+        if (!replacement.IsValid())
+            for (const lux::SceneInstanceHandle instance : originalInstances)
+                if (instance < m_NewInstanceIndices.size() && m_NewInstanceIndices[instance] != NOT_PENDING_INSTANCE)
+                    Delete(instance);
         for (auto& node : m_HierarchyInfo.Nodes)
         {
             if (originalInstances.contains(node.Instance) && !reinstantiationData.contains(node.Instance))
@@ -257,21 +302,41 @@ void Scene::HandleSpawnAndSweep(FrameContext& ctx, bool reclaimHandles)
 
 void Scene::Spawn(FrameContext& ctx)
 {
-    for (auto&& [instanceHandle, instantiationData] : m_NewInstances)
+    /* the instances whose scene is still streaming, or that do not fit into the upload budget of this frame,
+     * stay pending, so both the large scenes and the many instances are spread over multiple frames */
+    std::vector<InstantiationInfo> deferredInstances;
+    for (auto& newInstance : m_NewInstances)
     {
+        auto&& [instanceHandle, instantiationData] = newInstance;
         auto& instance = m_ActiveInstances[instanceHandle];
-        if (!m_ScenesMap[instance.Scene].HasGeometry)
+        auto& sceneInfo = m_ScenesMap[instance.Scene];
+        bool canSpawn = m_SceneAssetManager->IsLoaded(instance.Scene);
+        if (canSpawn)
+        {
+            const lux::SceneGeometryInfo& geometry = m_SceneAssetManager->Get(instance.Scene)->Geometry;
+            canSpawn = m_SpawnUploadBudget.TrySpend(geometry.GetInstanceUploadSizeBytes() +
+                (sceneInfo.HasGeometry ? 0 : geometry.GetUploadSizeBytes()));
+        }
+        if (!canSpawn)
+        {
+            m_NewInstanceIndices[instanceHandle] = (u32)deferredInstances.size();
+            deferredInstances.push_back(newInstance);
+            continue;
+        }
+        
+        if (!sceneInfo.HasGeometry)
         {
             m_Geometry.Add(*m_SceneAssetManager->Get(instance.Scene), ctx);
-            m_ScenesMap[instance.Scene].HasGeometry = true;
+            sceneInfo.HasGeometry = true;
         }
 
         if (instanceHandle >= m_InstanceIsAlive.size())
             m_InstanceIsAlive.resize(instanceHandle + 1);
         m_InstanceIsAlive[instanceHandle] = true;
         m_InstanceAddedSignal.Emit(AddToHierarchy(instanceHandle, instantiationData.Transform, ctx));
+        m_NewInstanceIndices[instanceHandle] = NOT_PENDING_INSTANCE;
     }
-    m_NewInstances.clear();
+    m_NewInstances = std::move(deferredInstances);
 }
 
 void Scene::Sweep(bool reclaimHandles)
@@ -348,6 +413,16 @@ void Scene::Sweep(bool reclaimHandles)
         {
             if (node.Type == lux::SceneHierarchyNodeType::Light)
                 m_Lights.Delete(node.Payload.Light.Index);
+            if (node.Type == lux::SceneHierarchyNodeType::Mesh)
+                for (u32 renderObject = 0; renderObject < node.Payload.Mesh.RenderObjectCount; renderObject++)
+                {
+                    const u32 globalIndex = node.Payload.Mesh.FirstRenderObject + renderObject;
+                    if (!m_Bvh.Contains(globalIndex))
+                        continue;
+                    if (!m_RenderObjectIsDynamic[globalIndex])
+                        m_ChangedBounds.push_back(m_Bvh.PrimitiveBounds(globalIndex));
+                    m_Bvh.Remove(globalIndex);
+                }
             continue;
         }
         
@@ -392,6 +467,18 @@ void updateRenderObject(Buffer renderObjects, u32 renderObjectIndex,
         renderObjectIndex * sizeof(RenderObjectGPU) + offsetof(RenderObjectGPU, Transform));
 }
 
+AABB transformBounds(const AABB& bounds, const glm::mat4& transform)
+{
+    /* Arvo's method: the extent of the transformed box is the extent scaled by the absolute matrix */
+    const glm::vec3 center = glm::vec3{transform * glm::vec4{(bounds.Min + bounds.Max) * 0.5f, 1.0f}};
+    const glm::vec3 extent = glm::mat3{
+        glm::abs(glm::vec3{transform[0]}),
+        glm::abs(glm::vec3{transform[1]}),
+        glm::abs(glm::vec3{transform[2]})} * ((bounds.Max - bounds.Min) * 0.5f);
+
+    return {.Min = center - extent, .Max = center + extent};
+}
+
 void updateJointMatrix(Buffer jointMatrices, u32 jointIndex, const glm::mat4& transform, ResourceUploader& uploader)
 {
     uploader.UpdateBuffer(
@@ -419,7 +506,8 @@ void updateLight(lux::CommonLight& light, const glm::mat4& transform)
         light.PositionDirection = transform * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
         break;
     case lux::LightType::Spot:
-        ASSERT(false, "Spot light is not implemented")
+        light.PositionDirection = transform * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        light.SpotLightData.Direction = glm::normalize(transform * glm::vec4(0.0f, 0.0f, -1.0f, 0.0f));
         break;
     }
 }
@@ -487,6 +575,9 @@ void Scene::UpdateTransforms(FrameContext& ctx)
             *ctx.ResourceUploader);
     }
 
+    /* instance bounds are only re-merged for instances that had any of their render objects moved */
+    std::vector<bool> instanceBoundsDirty(m_InstanceIsAlive.size());
+    bool anyInstanceBoundsDirty = false;
     for (auto&& [i, node] : std::views::enumerate(nodes))
     {
         switch (node.Type)
@@ -498,6 +589,27 @@ void Scene::UpdateTransforms(FrameContext& ctx)
                 {
                     const u32 globalIndex = mesh.FirstRenderObject + renderObjectIndex;
                     auto& previousTransform = m_RenderObjectPreviousTransforms[globalIndex];
+                    const bool isNew = !m_Bvh.Contains(globalIndex);
+                    if (isNew || previousTransform != transforms[i])
+                    {
+                        const AABB bounds = transformBounds(m_RenderObjectLocalBounds[globalIndex], transforms[i]);
+                        /* dynamic render objects are drawn every frame, so they do not change the cached shadows */
+                        const bool isStatic = !m_RenderObjectIsDynamic[globalIndex];
+                        if (isNew)
+                        {
+                            m_Bvh.Insert(globalIndex, bounds);
+                        }
+                        else
+                        {
+                            if (isStatic)
+                                m_ChangedBounds.push_back(m_Bvh.PrimitiveBounds(globalIndex));
+                            m_Bvh.Update(globalIndex, bounds);
+                        }
+                        if (isStatic)
+                            m_ChangedBounds.push_back(bounds);
+                        instanceBoundsDirty[node.Instance] = true;
+                        anyInstanceBoundsDirty = true;
+                    }
                     updateRenderObject(Geometry().RenderObjects.GetUnderlyingBuffer(), globalIndex,
                         previousTransform, transforms[i], *ctx.ResourceUploader);
                     m_RenderObjectPreviousTransforms[globalIndex] = transforms[i];
@@ -512,6 +624,64 @@ void Scene::UpdateTransforms(FrameContext& ctx)
             break;
         }
     }
+
+    m_Bvh.Refit();
+
+    if (anyInstanceBoundsDirty)
+        UpdateInstanceBounds(instanceBoundsDirty);
+}
+
+void Scene::UpdateInstanceBounds(const std::vector<bool>& dirtyInstances)
+{
+    static constexpr AABB EMPTY_BOUNDS = {
+        .Min = glm::vec3{std::numeric_limits<f32>::max()},
+        .Max = glm::vec3{std::numeric_limits<f32>::lowest()}};
+
+    m_InstanceBounds.resize(dirtyInstances.size(), EMPTY_BOUNDS);
+    for (u32 instance = 0; instance < dirtyInstances.size(); instance++)
+        if (dirtyInstances[instance])
+            m_InstanceBounds[instance] = EMPTY_BOUNDS;
+
+    for (auto& node : m_HierarchyInfo.Nodes)
+    {
+        if (node.Type != lux::SceneHierarchyNodeType::Mesh || !dirtyInstances[node.Instance])
+            continue;
+        
+        auto& mesh = node.Payload.Mesh;
+        AABB& bounds = m_InstanceBounds[node.Instance];
+        for (u32 renderObjectIndex = 0; renderObjectIndex < mesh.RenderObjectCount; renderObjectIndex++)
+            bounds = bounds.Merge(m_Bvh.PrimitiveBounds(mesh.FirstRenderObject + renderObjectIndex));
+    }
+}
+
+void Scene::RequestTextureMips(FrameContext& ctx)
+{
+    if (!ctx.PrimaryCamera)
+        return;
+
+    /* the textures are assumed to span the whole render object, so the screen size of a material is the largest
+     * projected diameter of the bounding spheres of the render objects in the view that use it */
+    const Camera& camera = *ctx.PrimaryCamera;
+    const f32 pixelsPerUnit = (f32)ctx.Resolution.y / (2.0f * std::tan(camera.GetFov() * 0.5f));
+    const Frustum frustum = Frustum::FromViewProjection(camera.GetViewProjection());
+    std::unordered_map<lux::SceneHandle, std::vector<f32>> materialScreenSizes;
+    m_Bvh.QueryFrustum(frustum.Planes, [&](u32 renderObject) {
+        const lux::SceneInstanceHandle instance = m_RenderObjectInstances[renderObject];
+        std::vector<f32>& screenSizes = materialScreenSizes[m_ActiveInstances[instance].Scene];
+        const u32 material = m_RenderObjectMaterials[renderObject];
+        if (material >= screenSizes.size())
+            screenSizes.resize(material + 1, 0.0f);
+
+        const AABB& bounds = m_Bvh.PrimitiveBounds(renderObject);
+        const f32 radius = glm::length(bounds.Max - bounds.Min) * 0.5f;
+        const f32 distance = glm::length((bounds.Max + bounds.Min) * 0.5f - camera.GetPosition());
+        const f32 screenSize = distance <= radius ?
+            std::numeric_limits<f32>::max() : 2.0f * radius / distance * pixelsPerUnit;
+        screenSizes[material] = std::max(screenSizes[material], screenSize);
+    });
+
+    for (auto&& [sceneHandle, screenSizes] : materialScreenSizes)
+        m_SceneAssetManager->RequestTextureMips(sceneHandle, screenSizes);
 }
 
 void Scene::HandleMaterialUpdates(FrameContext& ctx)
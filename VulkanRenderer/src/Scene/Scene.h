@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Assets/Scenes/SceneAssetManager.h"
+#include "SceneBvh.h"
 #include "SceneGeometry.h"
 #include "SceneLight.h"
 #include "CoreLib/Containers/FreeList.h"
@@ -36,6 +37,16 @@ public:
     const SceneLight& Lights() const { return m_Lights; }
     SceneLight& Lights() { return m_Lights; }
 
+    /* world-space bounds of render objects, primitives are render object indices */
+    const SceneBvh& Bvh() const { return m_Bvh; }
+    /* world-space bounds of all render objects of a scene instance */
+    const AABB& InstanceBounds(lux::SceneInstanceHandle instance) const { return m_InstanceBounds[instance]; }
+    /* world-space bounds of the static render objects that were added, moved (both old and new bounds)
+     * or removed during the last update */
+    Span<const AABB> ChangedBounds() const { return m_ChangedBounds; }
+    /* skinned, blend shape and transform-animated render objects change every frame */
+    bool IsRenderObjectDynamic(u32 renderObject) const { return m_RenderObjectIsDynamic[renderObject]; }
+
     Signal<NewInstanceData>& GetInstanceAddedSignal() { return m_InstanceAddedSignal; }
     Signal<DeletedInstanceData>& GetInstanceDeletedSignal() { return m_InstanceDeletedSignal; }
     
@@ -66,7 +77,9 @@ private:
     void UpdateHierarchy(FrameContext& ctx);
     void UpdateAnimations(FrameContext& ctx);
     void UpdateTransforms(FrameContext& ctx);
+    void UpdateInstanceBounds(const std::vector<bool>& dirtyInstances);
     void HandleMaterialUpdates(FrameContext& ctx);
+    void RequestTextureMips(FrameContext& ctx);
 private:
     lux::SceneAssetManager* m_SceneAssetManager{};
     SceneGeometry m_Geometry{};
@@ -74,6 +87,15 @@ private:
     
     lux::SceneHierarchyInfo m_HierarchyInfo{};
     std::vector<glm::mat4> m_RenderObjectPreviousTransforms;
+    std::vector<AABB> m_RenderObjectLocalBounds;
+    std::vector<bool> m_RenderObjectIsDynamic;
+    std::vector<lux::SceneInstanceHandle> m_RenderObjectInstances;
+    /* the index of the material in the scene asset of the instance */
+    std::vector<u32> m_RenderObjectMaterials;
+    SceneBvh m_Bvh{};
+    /* indexed by scene instance handle */
+    std::vector<AABB> m_InstanceBounds;
+    std::vector<AABB> m_ChangedBounds;
     
     SignalHandler<lux::SceneAssetManager::SceneDeletedInfo> m_SceneDeletedHandler;
     SignalHandler<lux::SceneAssetManager::SceneReplacedInfo> m_SceneReplacedHandler;
@@ -98,6 +120,11 @@ private:
         SceneInstantiationData InstantiationData{};
     };
     std::vector<InstantiationInfo> m_NewInstances;
+    /* shared by all spawns of a frame, including the respawns of the replaced scenes */
+    lux::AssetUploadBudget m_SpawnUploadBudget{};
+    /* index into `m_NewInstances` for each scene instance handle that is waiting to be spawned */
+    static constexpr u32 NOT_PENDING_INSTANCE = ~0u;
+    std::vector<u32> m_NewInstanceIndices;
     std::vector<lux::SceneInstanceHandle> m_DeletedInstances;
 
     struct ReplacementsInfo
@@ -3,7 +3,7 @@
 #include "SceneBucket.h"
 
 SceneBucket::SceneBucket(const SceneBucketCreateInfo& createInfo)
-    : Filter(createInfo.Filter), ShaderOverrides(createInfo.ShaderOverrides), m_Name(createInfo.Name)
+    : Predicate(createInfo.Predicate), ShaderOverrides(createInfo.ShaderOverrides), m_Name(createInfo.Name)
 {
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SceneBucketPredicateTable.h"
 #include "SceneGeometry.h"
 #include "RenderGraph/Passes/Generated/Types/DrawInfoUniform.generated.h"
 #include "RenderGraph/Passes/Generated/Types/MeshletBucketInfoUniform.generated.h"
@@ -20,9 +21,6 @@ struct SceneMeshletHandle
     u32 Index{0};
 };
 
-using SceneBucketBits = u64;
-static constexpr u32 MAX_BUCKETS_PER_SET = std::numeric_limits<SceneBucketBits>::digits;
-
 struct SceneMeshletBucketInfo : gen::MeshletBucketInfo
 {
 };
@@ -35,9 +33,8 @@ static constexpr SceneBucketHandle INVALID_SCENE_BUCKET{~0u};
 
 struct SceneBucketCreateInfo
 {
-    using FilterFn = std::function<bool(const lux::SceneGeometryInfo& geometry, SceneRenderObjectHandle renderObject)>;
     StringId Name{};
-    FilterFn Filter{};
+    SceneBucketPredicate Predicate{};
     ShaderOverrides ShaderOverrides{};
 };
 
@@ -55,8 +52,7 @@ public:
     SceneBucketHandle Handle() const { return m_Id; }
     StringId Name() const { return m_Name; }
 public:
-    using FilterFn = SceneBucketCreateInfo::FilterFn;
-    FilterFn Filter{};
+    SceneBucketPredicate Predicate{};
     mutable ShaderOverrides ShaderOverrides{};
 private:
     SceneBucketHandle m_Id{~0lu};
@@ -66,7 +62,6 @@ private:
 class SceneBucketList
 {
 public:
-    using FilterFn = SceneBucket::FilterFn;
     void Init(const Scene& scene);
 
     SceneBucketHandle CreateBucket(const SceneBucketCreateInfo& createInfo);
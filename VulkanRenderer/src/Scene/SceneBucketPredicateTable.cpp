@@ -0,0 +1,80 @@
+#include "rendererpch.h"
+
+#include "SceneBucketPredicateTable.h"
+
+void SceneBucketPredicateTable::Compile(Span<const SceneBucketPredicate> predicates,
+    Span<const SceneBucketBits> exclusiveGroups)
+{
+    ASSERT(predicates.size() <= MAX_BUCKETS_PER_SET,
+        "Cannot have more than {} buckets per set, but got {}", MAX_BUCKETS_PER_SET, predicates.size())
+
+    m_FlagsToBuckets = {};
+    m_RangedBuckets.clear();
+    m_RangedBucketsMask = {};
+    m_ExclusiveGroups.assign(exclusiveGroups.begin(), exclusiveGroups.end());
+
+    for (u32 bucketIndex = 0; bucketIndex < predicates.size(); bucketIndex++)
+    {
+        const SceneBucketPredicate& predicate = predicates[bucketIndex];
+        for (u32 flags = 0; flags < m_FlagsToBuckets.size(); flags++)
+            if ((SceneRenderObjectFlags(flags) & predicate.Mask) == predicate.Value)
+                m_FlagsToBuckets[flags].Set(bucketIndex);
+
+        if (predicate.IsRanged())
+        {
+            m_RangedBuckets.push_back({
+                .Bit = bucketIndex,
+                .FirstRenderObject = predicate.FirstRenderObject,
+                /* clamp, so that the range check in `BucketBits` never wraps around */
+                .RenderObjectCount = std::min(predicate.RenderObjectCount, ~0u - predicate.FirstRenderObject)
+            });
+            m_RangedBucketsMask.Set(bucketIndex);
+        }
+    }
+}
+
+SceneBucketBits SceneBucketPredicateTable::BucketBits(SceneRenderObjectFlags flags, u32 renderObjectIndex) const
+{
+    SceneBucketBits bucketBits = m_FlagsToBuckets[(u32)flags];
+    if (bucketBits.Intersects(m_RangedBucketsMask))
+    {
+        for (auto& ranged : m_RangedBuckets)
+        {
+            /* unsigned wrap-around makes this a single comparison */
+            const bool inRange = renderObjectIndex - ranged.FirstRenderObject < ranged.RenderObjectCount;
+            if (!inRange)
+                bucketBits.Reset(ranged.Bit);
+        }
+    }
+    ASSERT(IsUnambiguous(bucketBits), "Ambiguous bucket")
+
+    return bucketBits;
+}
+
+void SceneBucketPredicateTable::BucketBits(Span<const SceneRenderObjectFlags> flags, u32 firstRenderObject,
+    Span<SceneBucketBits> bucketBits) const
+{
+    ASSERT(flags.size() == bucketBits.size())
+
+    if (m_RangedBuckets.empty())
+    {
+        for (u32 i = 0; i < flags.size(); i++)
+            bucketBits[i] = m_FlagsToBuckets[(u32)flags[i]];
+        for (u32 i = 0; i < flags.size(); i++)
+            ASSERT(IsUnambiguous(bucketBits[i]), "Ambiguous bucket")
+
+        return;
+    }
+
+    for (u32 i = 0; i < flags.size(); i++)
+        bucketBits[i] = BucketBits(flags[i], firstRenderObject + i);
+}
+
+bool SceneBucketPredicateTable::IsUnambiguous(const SceneBucketBits& bucketBits) const
+{
+    for (auto& group : m_ExclusiveGroups)
+        if ((bucketBits & group).Count() > 1)
+            return false;
+
+    return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <CoreLib/core.h>
+#include <CoreLib/Containers/Span.h>
+#include <CoreLib/Containers/WideBitSet.h>
+
+#include <array>
+#include <vector>
+
+/* must match `BUCKETS_PER_SET` in `core/geometry.slang` */
+static constexpr u32 MAX_BUCKETS_PER_SET = 128;
+using SceneBucketBits = lux::WideBitSet<MAX_BUCKETS_PER_SET>;
+
+/* material and mesh properties of a render object that scene buckets can filter on */
+enum class SceneRenderObjectFlags : u8
+{
+    None = 0,
+    HasMaterial = BIT(0),
+    Opaque      = BIT(1),
+    AlphaMask   = BIT(2),
+    Translucent = BIT(3),
+    TwoSided    = BIT(4),
+    Skinned     = BIT(5),
+    BlendShapes = BIT(6),
+    /* geometry is deformed every frame (skinned or has blend shapes) */
+    Dynamic     = BIT(7),
+};
+CREATE_ENUM_FLAGS_OPERATORS(SceneRenderObjectFlags)
+static constexpr u32 SCENE_RENDER_OBJECT_FLAG_COUNT = 8;
+
+/* accepts render objects with `(flags & Mask) == Value` and whose index (within its scene) is
+ * in `[FirstRenderObject, FirstRenderObject + RenderObjectCount)` */
+struct SceneBucketPredicate
+{
+    SceneRenderObjectFlags Mask{SceneRenderObjectFlags::None};
+    SceneRenderObjectFlags Value{SceneRenderObjectFlags::None};
+    u32 FirstRenderObject{0};
+    u32 RenderObjectCount{~0u};
+
+    static constexpr SceneBucketPredicate Has(SceneRenderObjectFlags flags) { return {.Mask = flags, .Value = flags}; }
+    constexpr bool IsRanged() const { return FirstRenderObject != 0 || RenderObjectCount != ~0u; }
+};
+
+/* all bucket predicates of a render object set compiled into a single lookup table, so that the bucket
+ * bits of a render object is a single load (and a few more bitwise ops for index-ranged buckets) */
+class SceneBucketPredicateTable
+{
+public:
+    /* `predicates[i]` corresponds to the bit `i` of the resulting `SceneBucketBits`,
+     * each of `exclusiveGroups` is a mask of buckets of which at most one may accept a render object */
+    void Compile(Span<const SceneBucketPredicate> predicates, Span<const SceneBucketBits> exclusiveGroups = {});
+
+    SceneBucketBits BucketBits(SceneRenderObjectFlags flags, u32 renderObjectIndex) const;
+    /* batched version for `flags` of the consecutive render objects starting at `firstRenderObject` */
+    void BucketBits(Span<const SceneRenderObjectFlags> flags, u32 firstRenderObject,
+        Span<SceneBucketBits> bucketBits) const;
+private:
+    bool IsUnambiguous(const SceneBucketBits& bucketBits) const;
+private:
+    std::array<SceneBucketBits, 1 << SCENE_RENDER_OBJECT_FLAG_COUNT> m_FlagsToBuckets{};
+    struct RangedBucket
+    {
+        u32 Bit{};
+        u32 FirstRenderObject{};
+        u32 RenderObjectCount{};
+    };
+    std::vector<RangedBucket> m_RangedBuckets;
+    SceneBucketBits m_RangedBucketsMask{};
+    std::vector<SceneBucketBits> m_ExclusiveGroups;
+};
@@ -0,0 +1,491 @@
+#include "rendererpch.h"
+
+#include "SceneBvh.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+AABB emptyAabb()
+{
+    return {
+        .Min = glm::vec3{std::numeric_limits<f32>::infinity()},
+        .Max = glm::vec3{-std::numeric_limits<f32>::infinity()}};
+}
+
+bool isEmpty(const AABB& bounds)
+{
+    return glm::any(glm::greaterThan(bounds.Min, bounds.Max));
+}
+
+f32 surfaceArea(const AABB& bounds)
+{
+    if (isEmpty(bounds))
+        return 0.0f;
+
+    const glm::vec3 extent = bounds.Max - bounds.Min;
+
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+glm::vec3 centroid(const AABB& bounds)
+{
+    return (bounds.Min + bounds.Max) * 0.5f;
+}
+}
+
+void SceneBvh::Build(Span<const AABB> bounds)
+{
+    m_PrimitiveBounds.assign(bounds.begin(), bounds.end());
+    m_PrimitiveIsLive.assign(bounds.size(), true);
+    m_LivePrimitiveCount = (u32)bounds.size();
+
+    RebuildAll();
+}
+
+void SceneBvh::Insert(u32 primitive, const AABB& bounds)
+{
+    EnsurePrimitiveCapacity(primitive);
+    ASSERT(!m_PrimitiveIsLive[primitive], "Primitive {} is already in bvh", primitive)
+
+    m_PrimitiveBounds[primitive] = bounds;
+    m_PrimitiveIsLive[primitive] = true;
+    m_LivePrimitiveCount++;
+
+    /* the new leaf owns a new slot at the end of `m_Primitives` */
+    const u32 leaf = AllocateNode();
+    m_Nodes[leaf].Bounds = bounds;
+    m_Nodes[leaf].FirstPrimitive = (u32)m_Primitives.size();
+    m_Nodes[leaf].PrimitiveCount = 1;
+    m_Nodes[leaf].BuiltArea = surfaceArea(bounds);
+    m_PrimitiveLeaf[primitive] = leaf;
+    m_PrimitiveSlot[primitive] = (u32)m_Primitives.size();
+    m_Primitives.push_back(primitive);
+
+    if (m_Root == INVALID_NODE)
+    {
+        m_Root = leaf;
+        return;
+    }
+
+    /* the new parent takes the place of the sibling, it keeps the bounds of the sibling until the next refit,
+     * so that the queries still see the sibling subtree */
+    const u32 sibling = FindInsertionSibling(bounds);
+    const u32 parent = AllocateNode();
+    const u32 oldParent = m_Nodes[sibling].Parent;
+    m_Nodes[parent] = {
+        .Bounds = m_Nodes[sibling].Bounds,
+        .Parent = oldParent,
+        .Left = sibling,
+        .Right = leaf,
+        .FirstPrimitive = m_Nodes[sibling].FirstPrimitive,
+        .PrimitiveCount = m_Nodes[sibling].PrimitiveCount,
+        .BuiltArea = surfaceArea(m_Nodes[sibling].Bounds.Merge(bounds))};
+    m_Nodes[sibling].Parent = parent;
+    m_Nodes[leaf].Parent = parent;
+    if (oldParent == INVALID_NODE)
+        m_Root = parent;
+    else if (m_Nodes[oldParent].Left == sibling)
+        m_Nodes[oldParent].Left = parent;
+    else
+        m_Nodes[oldParent].Right = parent;
+
+    m_DirtyLeaves.push_back(leaf);
+}
+
+void SceneBvh::Remove(u32 primitive)
+{
+    ASSERT(Contains(primitive), "Primitive {} is not in bvh", primitive)
+
+    m_PrimitiveIsLive[primitive] = false;
+    m_LivePrimitiveCount--;
+
+    /* swap-and-pop within the leaf range, the leaf keeps owning the now unused slot */
+    const u32 leaf = m_PrimitiveLeaf[primitive];
+    Node& node = m_Nodes[leaf];
+    const u32 slot = m_PrimitiveSlot[primitive];
+    const u32 lastSlot = node.FirstPrimitive + node.PrimitiveCount - 1;
+    std::swap(m_Primitives[slot], m_Primitives[lastSlot]);
+    m_PrimitiveSlot[m_Primitives[slot]] = slot;
+    node.PrimitiveCount--;
+
+    m_PrimitiveLeaf[primitive] = INVALID_NODE;
+    m_DirtyLeaves.push_back(leaf);
+}
+
+void SceneBvh::Update(u32 primitive, const AABB& bounds)
+{
+    ASSERT(Contains(primitive), "Primitive {} is not in bvh", primitive)
+
+    m_PrimitiveBounds[primitive] = bounds;
+    m_DirtyLeaves.push_back(m_PrimitiveLeaf[primitive]);
+}
+
+SceneBvh::RefitStats SceneBvh::Refit(f32 rebuildAreaRatio)
+{
+    RefitStats stats = {};
+    const u32 unusedSlots = (u32)m_Primitives.size() - m_LivePrimitiveCount;
+    if (unusedSlots >= MIN_UNUSED_PRIMITIVE_SLOTS_TO_REBUILD && unusedSlots > m_LivePrimitiveCount)
+    {
+        RebuildAll();
+        stats.FullRebuild = true;
+
+        return stats;
+    }
+
+    std::ranges::sort(m_DirtyLeaves);
+    const auto [first, last] = std::ranges::unique(m_DirtyLeaves);
+    m_DirtyLeaves.erase(first, last);
+
+    std::vector<u32> degradedSubtrees;
+    for (const u32 leaf : m_DirtyLeaves)
+    {
+        Node& leafNode = m_Nodes[leaf];
+        AABB bounds = emptyAabb();
+        for (u32 i = 0; i < leafNode.PrimitiveCount; i++)
+            bounds = bounds.Merge(m_PrimitiveBounds[m_Primitives[leafNode.FirstPrimitive + i]]);
+        leafNode.Bounds = bounds;
+        stats.RefitNodes++;
+
+        /* propagate up until the bounds stop changing, remembering the topmost degraded node on the way */
+        u32 degraded = INVALID_NODE;
+        for (u32 node = leafNode.Parent; node != INVALID_NODE; node = m_Nodes[node].Parent)
+        {
+            Node& parent = m_Nodes[node];
+            const AABB merged = m_Nodes[parent.Left].Bounds.Merge(m_Nodes[parent.Right].Bounds);
+            if (merged.Min == parent.Bounds.Min && merged.Max == parent.Bounds.Max)
+                break;
+
+            parent.Bounds = merged;
+            stats.RefitNodes++;
+            if (parent.BuiltArea > 0.0f && surfaceArea(merged) > rebuildAreaRatio * parent.BuiltArea)
+                degraded = node;
+        }
+        if (degraded != INVALID_NODE)
+            degradedSubtrees.push_back(degraded);
+    }
+    m_DirtyLeaves.clear();
+
+    /* rebuild only the outermost degraded subtrees, nested ones are rebuilt as a part of them */
+    std::ranges::sort(degradedSubtrees);
+    const auto [firstDegraded, lastDegraded] = std::ranges::unique(degradedSubtrees);
+    degradedSubtrees.erase(firstDegraded, lastDegraded);
+    auto hasDegradedAncestor = [&](u32 node) {
+        for (u32 ancestor = m_Nodes[node].Parent; ancestor != INVALID_NODE; ancestor = m_Nodes[ancestor].Parent)
+            if (std::ranges::binary_search(degradedSubtrees, ancestor))
+                return true;
+
+        return false;
+    };
+    std::vector<u32> toRebuild;
+    for (const u32 node : degradedSubtrees)
+        if (!hasDegradedAncestor(node))
+            toRebuild.push_back(node);
+
+    /* a degraded root is rebuilt as a whole, which also drops the unused slots */
+    if (toRebuild.size() == 1 && toRebuild.front() == m_Root)
+    {
+        RebuildAll();
+        stats.FullRebuild = true;
+
+        return stats;
+    }
+    for (const u32 node : toRebuild)
+        RebuildSubtree(node);
+    stats.RebuiltSubtrees = (u32)toRebuild.size();
+
+    return stats;
+}
+
+void SceneBvh::Rebuild()
+{
+    RebuildAll();
+}
+
+bool SceneBvh::Contains(u32 primitive) const
+{
+    return primitive < m_PrimitiveIsLive.size() && m_PrimitiveIsLive[primitive];
+}
+
+f32 SceneBvh::SahCost() const
+{
+    if (m_Root == INVALID_NODE)
+        return 0.0f;
+    const f32 rootArea = surfaceArea(m_Nodes[m_Root].Bounds);
+    if (rootArea == 0.0f)
+        return 0.0f;
+
+    f32 cost = 0.0f;
+    std::vector<u32> stack = {m_Root};
+    while (!stack.empty())
+    {
+        const Node& node = m_Nodes[stack.back()];
+        stack.pop_back();
+        if (node.IsLeaf())
+        {
+            cost += surfaceArea(node.Bounds) * (f32)node.PrimitiveCount;
+            continue;
+        }
+        cost += surfaceArea(node.Bounds);
+        stack.push_back(node.Left);
+        stack.push_back(node.Right);
+    }
+
+    return cost / rootArea;
+}
+
+SceneBvh::RaycastHit SceneBvh::Raycast(const glm::vec3& origin, const glm::vec3& direction, f32 maxDistance) const
+{
+    const glm::vec3 inverseDirection = 1.0f / direction;
+
+    return Raycast(origin, direction, maxDistance, [&](u32 primitive, f32 closest) {
+        return RayAabbDistance(m_PrimitiveBounds[primitive], origin, inverseDirection, closest);
+    });
+}
+
+f32 SceneBvh::RayAabbDistance(const AABB& bounds, const glm::vec3& origin, const glm::vec3& inverseDirection,
+    f32 maxDistance)
+{
+    static constexpr f32 MISS = std::numeric_limits<f32>::infinity();
+    if (isEmpty(bounds))
+        return MISS;
+
+    const glm::vec3 tMin = (bounds.Min - origin) * inverseDirection;
+    const glm::vec3 tMax = (bounds.Max - origin) * inverseDirection;
+    const glm::vec3 tNear = glm::min(tMin, tMax);
+    const glm::vec3 tFar = glm::max(tMin, tMax);
+    const f32 entry = std::max({tNear.x, tNear.y, tNear.z, 0.0f});
+    const f32 exit = std::min({tFar.x, tFar.y, tFar.z});
+
+    return entry <= exit && entry <= maxDistance ? entry : MISS;
+}
+
+void SceneBvh::RebuildAll()
+{
+    m_Nodes.clear();
+    m_FreeNodes.clear();
+    m_DirtyLeaves.clear();
+    m_Root = INVALID_NODE;
+
+    m_Primitives.clear();
+    m_Primitives.reserve(m_LivePrimitiveCount);
+    for (u32 primitive = 0; primitive < m_PrimitiveIsLive.size(); primitive++)
+        if (m_PrimitiveIsLive[primitive])
+            m_Primitives.push_back(primitive);
+    m_PrimitiveLeaf.assign(m_PrimitiveBounds.size(), INVALID_NODE);
+    m_PrimitiveSlot.assign(m_PrimitiveBounds.size(), INVALID_NODE);
+
+    if (m_Primitives.empty())
+        return;
+
+    m_Root = AllocateNode();
+    BuildNode(m_Root, 0, (u32)m_Primitives.size());
+}
+
+u32 SceneBvh::FindInsertionSibling(const AABB& bounds) const
+{
+    /* greedy descent: a node is paired with the new leaf if that is cheaper than pushing the leaf into any
+     * of its children; the cost of a choice is the area of the new parent plus the area
+     * the ancestors grow by */
+    u32 node = m_Root;
+    f32 inheritedCost = 0.0f;
+    while (!m_Nodes[node].IsLeaf())
+    {
+        const Node& current = m_Nodes[node];
+        const f32 mergedArea = surfaceArea(current.Bounds.Merge(bounds));
+        const f32 pairCost = mergedArea + inheritedCost;
+        const f32 childInheritedCost = inheritedCost + mergedArea - surfaceArea(current.Bounds);
+
+        auto childCost = [&](u32 child) {
+            const AABB& childBounds = m_Nodes[child].Bounds;
+            const f32 childMergedArea = surfaceArea(childBounds.Merge(bounds));
+            if (m_Nodes[child].IsLeaf())
+                return childMergedArea + childInheritedCost;
+
+            return childMergedArea - surfaceArea(childBounds) + childInheritedCost;
+        };
+        const f32 leftCost = childCost(current.Left);
+        const f32 rightCost = childCost(current.Right);
+        if (pairCost <= leftCost && pairCost <= rightCost)
+            break;
+
+        node = leftCost <= rightCost ? current.Left : current.Right;
+        inheritedCost = childInheritedCost;
+    }
+
+    return node;
+}
+
+void SceneBvh::BuildNode(u32 node, u32 firstPrimitive, u32 primitiveCount)
+{
+    const auto primitivesBegin = m_Primitives.begin() + firstPrimitive;
+    const auto primitivesEnd = primitivesBegin + primitiveCount;
+
+    AABB bounds = emptyAabb();
+    AABB centroidBounds = emptyAabb();
+    for (auto it = primitivesBegin; it != primitivesEnd; ++it)
+    {
+        bounds = bounds.Merge(m_PrimitiveBounds[*it]);
+        const glm::vec3 center = centroid(m_PrimitiveBounds[*it]);
+        centroidBounds = centroidBounds.Merge({.Min = center, .Max = center});
+    }
+
+    {
+        Node& toBuild = m_Nodes[node];
+        toBuild.Bounds = bounds;
+        toBuild.Left = INVALID_NODE;
+        toBuild.Right = INVALID_NODE;
+        toBuild.FirstPrimitive = firstPrimitive;
+        toBuild.PrimitiveCount = primitiveCount;
+        toBuild.BuiltArea = surfaceArea(bounds);
+    }
+
+    if (primitiveCount <= MAX_LEAF_PRIMITIVES)
+    {
+        for (u32 i = 0; i < primitiveCount; i++)
+        {
+            const u32 primitive = m_Primitives[firstPrimitive + i];
+            m_PrimitiveLeaf[primitive] = node;
+            m_PrimitiveSlot[primitive] = firstPrimitive + i;
+        }
+
+        return;
+    }
+
+    const glm::vec3 centroidExtent = centroidBounds.Max - centroidBounds.Min;
+    u32 axis = 0;
+    if (centroidExtent.y > centroidExtent[axis])
+        axis = 1;
+    if (centroidExtent.z > centroidExtent[axis])
+        axis = 2;
+
+    u32 leftCount = 0;
+    if (centroidExtent[axis] > 0.0f)
+    {
+        const f32 binScale = (f32)SAH_BINS / centroidExtent[axis];
+        const f32 binOrigin = centroidBounds.Min[axis];
+        auto binIndex = [&](u32 primitive) {
+            const f32 bin = (centroid(m_PrimitiveBounds[primitive])[axis] - binOrigin) * binScale;
+            return std::min(SAH_BINS - 1, (u32)bin);
+        };
+
+        struct Bin
+        {
+            AABB Bounds{emptyAabb()};
+            u32 Count{0};
+        };
+        std::array<Bin, SAH_BINS> bins{};
+        for (auto it = primitivesBegin; it != primitivesEnd; ++it)
+        {
+            Bin& bin = bins[binIndex(*it)];
+            bin.Bounds = bin.Bounds.Merge(m_PrimitiveBounds[*it]);
+            bin.Count++;
+        }
+
+        /* cost of splitting after each bin: A(left) * N(left) + A(right) * N(right) */
+        std::array<f32, SAH_BINS - 1> splitCosts{};
+        AABB sweepBounds = emptyAabb();
+        u32 sweepCount = 0;
+        for (u32 i = 0; i < SAH_BINS - 1; i++)
+        {
+            sweepBounds = sweepBounds.Merge(bins[i].Bounds);
+            sweepCount += bins[i].Count;
+            splitCosts[i] = surfaceArea(sweepBounds) * (f32)sweepCount;
+        }
+        sweepBounds = emptyAabb();
+        sweepCount = 0;
+        for (u32 i = SAH_BINS - 1; i > 0; i--)
+        {
+            sweepBounds = sweepBounds.Merge(bins[i].Bounds);
+            sweepCount += bins[i].Count;
+            splitCosts[i - 1] += surfaceArea(sweepBounds) * (f32)sweepCount;
+        }
+
+        const u32 bestSplit = (u32)std::distance(splitCosts.begin(), std::ranges::min_element(splitCosts));
+        leftCount = (u32)std::distance(primitivesBegin, std::partition(primitivesBegin, primitivesEnd,
+            [&](u32 primitive) { return binIndex(primitive) <= bestSplit; }));
+    }
+
+    /* all centroids are in the same bin (or at the same point), fallback to a median split */
+    if (leftCount == 0 || leftCount == primitiveCount)
+    {
+        leftCount = primitiveCount / 2;
+        std::nth_element(primitivesBegin, primitivesBegin + leftCount, primitivesEnd, [&](u32 a, u32 b) {
+            return centroid(m_PrimitiveBounds[a])[axis] < centroid(m_PrimitiveBounds[b])[axis];
+        });
+    }
+
+    const u32 left = AllocateNode();
+    const u32 right = AllocateNode();
+    m_Nodes[node].Left = left;
+    m_Nodes[node].Right = right;
+    m_Nodes[left].Parent = node;
+    m_Nodes[right].Parent = node;
+
+    BuildNode(left, firstPrimitive, leftCount);
+    BuildNode(right, firstPrimitive + leftCount, primitiveCount - leftCount);
+}
+
+void SceneBvh::RebuildSubtree(u32 node)
+{
+    /* the subtree owns the range of `m_Primitives` it was built over (nested subtrees are rebuilt within their
+     * own ranges, and inserted leaves get new slots at the end), so the subtree is rebuilt in place
+     * if its primitives still fit into that range, and at the end of `m_Primitives` otherwise */
+    std::vector<u32> primitives;
+    std::vector<u32> stack = {node};
+    while (!stack.empty())
+    {
+        const u32 current = stack.back();
+        stack.pop_back();
+        const Node& currentNode = m_Nodes[current];
+        if (currentNode.IsLeaf())
+        {
+            for (u32 i = 0; i < currentNode.PrimitiveCount; i++)
+                primitives.push_back(m_Primitives[currentNode.FirstPrimitive + i]);
+        }
+        else
+        {
+            stack.push_back(currentNode.Left);
+            stack.push_back(currentNode.Right);
+        }
+        if (current != node)
+            m_FreeNodes.push_back(current);
+    }
+
+    u32 firstPrimitive = m_Nodes[node].FirstPrimitive;
+    if (primitives.size() > m_Nodes[node].PrimitiveCount)
+    {
+        firstPrimitive = (u32)m_Primitives.size();
+        m_Primitives.resize(m_Primitives.size() + primitives.size());
+    }
+    std::ranges::copy(primitives, m_Primitives.begin() + firstPrimitive);
+    BuildNode(node, firstPrimitive, (u32)primitives.size());
+}
+
+void SceneBvh::EnsurePrimitiveCapacity(u32 primitive)
+{
+    if (primitive < m_PrimitiveBounds.size())
+        return;
+
+    m_PrimitiveBounds.resize(primitive + 1, emptyAabb());
+    m_PrimitiveIsLive.resize(primitive + 1, false);
+    m_PrimitiveLeaf.resize(primitive + 1, INVALID_NODE);
+    m_PrimitiveSlot.resize(primitive + 1, INVALID_NODE);
+}
+
+u32 SceneBvh::AllocateNode()
+{
+    if (!m_FreeNodes.empty())
+    {
+        const u32 node = m_FreeNodes.back();
+        m_FreeNodes.pop_back();
+        m_Nodes[node] = {};
+
+        return node;
+    }
+
+    m_Nodes.emplace_back();
+
+    return (u32)m_Nodes.size() - 1;
+}
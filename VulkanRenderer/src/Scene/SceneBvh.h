@@ -0,0 +1,267 @@
+#pragma once
+
+#include <CoreLib/core.h>
+#include <CoreLib/Containers/Span.h>
+#include <CoreLib/Math/Geometry.h>
+
+#include <limits>
+#include <vector>
+
+/* bounding volume hierarchy over world-space bounds of scene render objects (primitives);
+ * built top-down with binned SAH, new primitives are inserted as leaves next to the node that is the cheapest
+ * to pair them with, refit incrementally from dirty primitives, subtrees whose surface area grew too much
+ * since they were built are rebuilt on refit */
+class SceneBvh
+{
+public:
+    static constexpr u32 INVALID_NODE = ~0u;
+    static constexpr u32 MAX_LEAF_PRIMITIVES = 4;
+    static constexpr u32 SAH_BINS = 16;
+    static constexpr f32 DEFAULT_REBUILD_AREA_RATIO = 1.5f;
+    /* the whole hierarchy is rebuilt on refit, once the unused slots of `Primitives()` outnumber the used ones */
+    static constexpr u32 MIN_UNUSED_PRIMITIVE_SLOTS_TO_REBUILD = 64;
+
+    struct Node
+    {
+        AABB Bounds{};
+        u32 Parent{INVALID_NODE};
+        u32 Left{INVALID_NODE};
+        u32 Right{INVALID_NODE};
+        /* for leaves, the range of `Primitives()` this leaf owns; for inner nodes,
+         * the range the subtree was built over */
+        u32 FirstPrimitive{0};
+        u32 PrimitiveCount{0};
+        /* surface area of `Bounds` when the subtree was (re)built */
+        f32 BuiltArea{0.0f};
+
+        bool IsLeaf() const { return Left == INVALID_NODE; }
+    };
+    struct RaycastHit
+    {
+        u32 Primitive{INVALID_NODE};
+        f32 Distance{std::numeric_limits<f32>::infinity()};
+
+        bool IsHit() const { return Primitive != INVALID_NODE; }
+    };
+    struct RefitStats
+    {
+        u32 RefitNodes{0};
+        u32 RebuiltSubtrees{0};
+        bool FullRebuild{false};
+    };
+public:
+    /* `bounds[i]` are the bounds of primitive `i` */
+    void Build(Span<const AABB> bounds);
+
+    /* like `Update`, the bounds of the ancestors of the new primitive are only refit on the next `Refit` */
+    void Insert(u32 primitive, const AABB& bounds);
+    void Remove(u32 primitive);
+    void Update(u32 primitive, const AABB& bounds);
+    RefitStats Refit(f32 rebuildAreaRatio = DEFAULT_REBUILD_AREA_RATIO);
+    void Rebuild();
+
+    bool Contains(u32 primitive) const;
+    const AABB& PrimitiveBounds(u32 primitive) const { return m_PrimitiveBounds[primitive]; }
+    u32 PrimitiveCount() const { return m_LivePrimitiveCount; }
+    u32 Root() const { return m_Root; }
+    const Node& GetNode(u32 node) const { return m_Nodes[node]; }
+    Span<const u32> Primitives() const { return m_Primitives; }
+    /* SAH cost of the hierarchy (traversal and intersection costs are 1), relative to the root area */
+    f32 SahCost() const;
+
+    template <typename Fn>
+    requires requires (Fn fn, u32 primitive) { fn(primitive); }
+    void QueryAabb(const AABB& bounds, Fn&& callback) const;
+    /* `planes` point inside, primitives that are at least partially inside all of them are reported */
+    template <typename Fn>
+    requires requires (Fn fn, u32 primitive) { fn(primitive); }
+    void QueryFrustum(Span<const Plane> planes, Fn&& callback) const;
+    /* `intersect(primitive, maxDistance)` returns the distance to the primitive (or infinity on a miss),
+     * it is only called for primitives whose bounds are hit closer than the current closest hit;
+     * only the hits closer than `maxDistance` are reported */
+    template <typename Fn>
+    requires requires (Fn fn, u32 primitive, f32 maxDistance) { { fn(primitive, maxDistance) } -> std::same_as<f32>; }
+    RaycastHit Raycast(const glm::vec3& origin, const glm::vec3& direction, f32 maxDistance, Fn&& intersect) const;
+    /* raycast against primitive bounds */
+    RaycastHit Raycast(const glm::vec3& origin, const glm::vec3& direction, f32 maxDistance) const;
+
+    static f32 RayAabbDistance(const AABB& bounds, const glm::vec3& origin, const glm::vec3& inverseDirection,
+        f32 maxDistance);
+private:
+    void RebuildAll();
+    u32 FindInsertionSibling(const AABB& bounds) const;
+    void BuildNode(u32 node, u32 firstPrimitive, u32 primitiveCount);
+    void RebuildSubtree(u32 node);
+    void EnsurePrimitiveCapacity(u32 primitive);
+    u32 AllocateNode();
+private:
+    std::vector<Node> m_Nodes;
+    std::vector<u32> m_FreeNodes;
+    u32 m_Root{INVALID_NODE};
+    std::vector<u32> m_Primitives;
+
+    std::vector<AABB> m_PrimitiveBounds;
+    std::vector<u32> m_PrimitiveLeaf;
+    std::vector<u32> m_PrimitiveSlot;
+    std::vector<bool> m_PrimitiveIsLive;
+    u32 m_LivePrimitiveCount{0};
+
+    std::vector<u32> m_DirtyLeaves;
+};
+
+template <typename Fn>
+requires requires (Fn fn, u32 primitive) { fn(primitive); }
+void SceneBvh::QueryAabb(const AABB& bounds, Fn&& callback) const
+{
+    if (m_Root == INVALID_NODE)
+        return;
+
+    auto overlaps = [](const AABB& a, const AABB& b) {
+        return glm::all(glm::lessThanEqual(a.Min, b.Max)) && glm::all(glm::lessThanEqual(b.Min, a.Max));
+    };
+
+    std::vector<u32> stack = {m_Root};
+    while (!stack.empty())
+    {
+        const Node& node = m_Nodes[stack.back()];
+        stack.pop_back();
+        if (!overlaps(node.Bounds, bounds))
+            continue;
+
+        if (!node.IsLeaf())
+        {
+            stack.push_back(node.Left);
+            stack.push_back(node.Right);
+            continue;
+        }
+
+        for (u32 i = 0; i < node.PrimitiveCount; i++)
+        {
+            const u32 primitive = m_Primitives[node.FirstPrimitive + i];
+            if (overlaps(m_PrimitiveBounds[primitive], bounds))
+                callback(primitive);
+        }
+    }
+}
+
+template <typename Fn>
+requires requires (Fn fn, u32 primitive) { fn(primitive); }
+void SceneBvh::QueryFrustum(Span<const Plane> planes, Fn&& callback) const
+{
+    if (m_Root == INVALID_NODE)
+        return;
+
+    enum class Containment : u8 { Outside, Intersects, Inside };
+    auto classify = [&planes](const AABB& bounds) {
+        const glm::vec3 center = (bounds.Min + bounds.Max) * 0.5f;
+        const glm::vec3 extent = (bounds.Max - bounds.Min) * 0.5f;
+        Containment containment = Containment::Inside;
+        for (auto& plane : planes)
+        {
+            const f32 distance = plane.SignedDistance(center);
+            const f32 radius = glm::dot(extent, glm::abs(plane.Normal));
+            if (distance < -radius)
+                return Containment::Outside;
+            if (distance < radius)
+                containment = Containment::Intersects;
+        }
+
+        return containment;
+    };
+
+    struct StackEntry
+    {
+        u32 Node{INVALID_NODE};
+        bool IsInside{false};
+    };
+    std::vector<StackEntry> stack = {{.Node = m_Root}};
+    while (!stack.empty())
+    {
+        const StackEntry entry = stack.back();
+        stack.pop_back();
+        const Node& node = m_Nodes[entry.Node];
+
+        /* once a node is fully inside, its whole subtree is reported without any more tests */
+        bool isInside = entry.IsInside;
+        if (!isInside)
+        {
+            const Containment containment = classify(node.Bounds);
+            if (containment == Containment::Outside)
+                continue;
+            isInside = containment == Containment::Inside;
+        }
+
+        if (!node.IsLeaf())
+        {
+            stack.push_back({.Node = node.Left, .IsInside = isInside});
+            stack.push_back({.Node = node.Right, .IsInside = isInside});
+            continue;
+        }
+
+        for (u32 i = 0; i < node.PrimitiveCount; i++)
+        {
+            const u32 primitive = m_Primitives[node.FirstPrimitive + i];
+            if (isInside || classify(m_PrimitiveBounds[primitive]) != Containment::Outside)
+                callback(primitive);
+        }
+    }
+}
+
+template <typename Fn>
+requires requires (Fn fn, u32 primitive, f32 maxDistance) { { fn(primitive, maxDistance) } -> std::same_as<f32>; }
+SceneBvh::RaycastHit SceneBvh::Raycast(const glm::vec3& origin, const glm::vec3& direction, f32 maxDistance,
+    Fn&& intersect) const
+{
+    RaycastHit hit = {.Distance = maxDistance};
+    if (m_Root == INVALID_NODE)
+        return hit;
+
+    const glm::vec3 inverseDirection = 1.0f / direction;
+    struct StackEntry
+    {
+        u32 Node{INVALID_NODE};
+        f32 Distance{0.0f};
+    };
+    std::vector<StackEntry> stack;
+    const f32 rootDistance = RayAabbDistance(m_Nodes[m_Root].Bounds, origin, inverseDirection, hit.Distance);
+    if (rootDistance < hit.Distance)
+        stack.push_back({.Node = m_Root, .Distance = rootDistance});
+
+    while (!stack.empty())
+    {
+        const StackEntry entry = stack.back();
+        stack.pop_back();
+        if (entry.Distance >= hit.Distance)
+            continue;
+
+        const Node& node = m_Nodes[entry.Node];
+        if (node.IsLeaf())
+        {
+            for (u32 i = 0; i < node.PrimitiveCount; i++)
+            {
+                const u32 primitive = m_Primitives[node.FirstPrimitive + i];
+                if (RayAabbDistance(m_PrimitiveBounds[primitive], origin, inverseDirection, hit.Distance) >=
+                    hit.Distance)
+                    continue;
+                const f32 distance = intersect(primitive, hit.Distance);
+                if (distance < hit.Distance)
+                    hit = {.Primitive = primitive, .Distance = distance};
+            }
+            continue;
+        }
+
+        /* visit the closer child first */
+        StackEntry left = {.Node = node.Left};
+        StackEntry right = {.Node = node.Right};
+        left.Distance = RayAabbDistance(m_Nodes[node.Left].Bounds, origin, inverseDirection, hit.Distance);
+        right.Distance = RayAabbDistance(m_Nodes[node.Right].Bounds, origin, inverseDirection, hit.Distance);
+        if (left.Distance < right.Distance)
+            std::swap(left, right);
+        if (left.Distance < hit.Distance)
+            stack.push_back(left);
+        if (right.Distance < hit.Distance)
+            stack.push_back(right);
+    }
+
+    return hit;
+}
@@ -48,6 +48,37 @@ void writeSuballocation(BufferArena arena, const std::vector<T>& data,
     offsets.Suballocations[(u32)bufferType] = suballocation.Handle;
     ctx.ResourceUploader->UpdateBuffer(suballocation.Buffer, data, suballocation.Description.Offset);
 }
+
+/* the stream is decompressed from the baked geometry buffer straight into the upload staging memory */
+void writeStreamSuballocation(BufferArena arena, const lux::SceneGeometryInfo& geometry,
+    lux::SceneGeometryStreamType stream, SceneGeometry::SceneInfoOffsets& offsets, FrameContext& ctx)
+{
+    static_assert((u32)lux::SceneGeometryStreamType::Position == (u32)SceneGeometry::SceneInfoOffsetType::Position);
+    static_assert((u32)lux::SceneGeometryStreamType::Normal == (u32)SceneGeometry::SceneInfoOffsetType::Normal);
+    static_assert((u32)lux::SceneGeometryStreamType::Tangent == (u32)SceneGeometry::SceneInfoOffsetType::Tangent);
+    static_assert((u32)lux::SceneGeometryStreamType::Uv == (u32)SceneGeometry::SceneInfoOffsetType::Uv);
+    static_assert((u32)lux::SceneGeometryStreamType::Joint == (u32)SceneGeometry::SceneInfoOffsetType::Joint);
+    static_assert((u32)lux::SceneGeometryStreamType::Weight == (u32)SceneGeometry::SceneInfoOffsetType::Weight);
+    static_assert((u32)lux::SceneGeometryStreamType::Index == (u32)SceneGeometry::SceneInfoOffsetType::Index);
+
+    const u64 sizeBytes = geometry.GetStreamSizeBytes(stream);
+    if (sizeBytes == 0)
+        return;
+    const u32 elementSizeBytes = lux::SceneGeometryInfo::STREAM_ELEMENT_SIZES[(u32)stream];
+    const BufferSuballocation suballocation = suballocateResizeIfFailed(arena,
+        sizeBytes, elementSizeBytes, ctx.Cmd);
+    offsets.ElementOffsets[(u32)stream] = (u32)(suballocation.Description.Offset / elementSizeBytes);
+    offsets.Suballocations[(u32)stream] = suballocation.Handle;
+    std::byte* staging = ctx.ResourceUploader->MapBuffer<std::byte>({
+        .Buffer = suballocation.Buffer,
+        .Description = {
+            .SizeBytes = sizeBytes,
+            .Offset = suballocation.Description.Offset
+        }
+    });
+    if (!geometry.ReadStream(stream, Span(staging, sizeBytes)))
+        std::memset(staging, 0, sizeBytes);
+}
 }
 
 SceneGeometry SceneGeometry::CreateEmpty(DeletionQueue& deletionQueue)
@@ -155,13 +186,13 @@ void SceneGeometry::Add(const lux::SceneAsset& scene, FrameContext& ctx)
     auto& geometry = scene.Geometry;
 
     SceneInfoOffsets sceneInfoOffsets = {};
-    writeSuballocation(Attributes, geometry.Positions, Position, sceneInfoOffsets, ctx);
-    writeSuballocation(Attributes, geometry.Normals, Normal, sceneInfoOffsets, ctx);
-    writeSuballocation(Attributes, geometry.Tangents, Tangent, sceneInfoOffsets, ctx);
-    writeSuballocation(Attributes, geometry.UVs, Uv, sceneInfoOffsets, ctx);
-    writeSuballocation(Attributes, geometry.Joints, Joint, sceneInfoOffsets, ctx);
-    writeSuballocation(Attributes, geometry.Weights, Weight, sceneInfoOffsets, ctx);
-    writeSuballocation(Indices, geometry.Indices, Index, sceneInfoOffsets, ctx);
+    writeStreamSuballocation(Attributes, geometry, lux::SceneGeometryStreamType::Position, sceneInfoOffsets, ctx);
+    writeStreamSuballocation(Attributes, geometry, lux::SceneGeometryStreamType::Normal, sceneInfoOffsets, ctx);
+    writeStreamSuballocation(Attributes, geometry, lux::SceneGeometryStreamType::Tangent, sceneInfoOffsets, ctx);
+    writeStreamSuballocation(Attributes, geometry, lux::SceneGeometryStreamType::Uv, sceneInfoOffsets, ctx);
+    writeStreamSuballocation(Attributes, geometry, lux::SceneGeometryStreamType::Joint, sceneInfoOffsets, ctx);
+    writeStreamSuballocation(Attributes, geometry, lux::SceneGeometryStreamType::Weight, sceneInfoOffsets, ctx);
+    writeStreamSuballocation(Indices, geometry, lux::SceneGeometryStreamType::Index, sceneInfoOffsets, ctx);
 
     std::vector<MeshletBoundsGPU> meshletBounds;
     std::vector<MeshletGPU> meshlets;
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Assets/Scenes/SceneAsset.h"
+
+#include <CoreLib/core.h>
+#include <CoreLib/Containers/Span.h>
+
+/* maps scene instances to the slots they own in a densely packed (swap-and-pop) array,
+ * removing an instance costs O(slots of that instance) regardless of the total instance count */
+class SceneInstanceSlots
+{
+public:
+    u32 Add(lux::SceneInstanceHandle instance);
+    /* `onMove(from, to)` is called for every slot that has to be moved to fill the hole,
+     * the caller is expected to shrink its arrays to `Count()` afterwards */
+    template <typename Fn>
+    requires requires (Fn fn, u32 from, u32 to) { fn(from, to); }
+    void Remove(lux::SceneInstanceHandle instance, Fn&& onMove);
+
+    u32 Count() const { return (u32)m_SlotOwners.size(); }
+    bool Contains(lux::SceneInstanceHandle instance) const;
+    Span<const u32> InstanceSlots(lux::SceneInstanceHandle instance) const;
+    lux::SceneInstanceHandle SlotOwner(u32 slot) const { return m_SlotOwners[slot].Instance; }
+
+    /* `fn(instance, slots)` is called for every instance that owns at least one slot */
+    template <typename Fn>
+    requires requires (Fn fn, lux::SceneInstanceHandle instance, Span<const u32> slots) { fn(instance, slots); }
+    void ForEachInstance(Fn&& fn) const;
+private:
+    struct SlotOwnerInfo
+    {
+        lux::SceneInstanceHandle Instance{};
+        u32 IndexInInstance{};
+    };
+    std::vector<SlotOwnerInfo> m_SlotOwners;
+    /* scene instance handles are dense free-list indices, so they are used to index this directly */
+    std::vector<std::vector<u32>> m_InstanceSlots;
+};
+
+inline u32 SceneInstanceSlots::Add(lux::SceneInstanceHandle instance)
+{
+    if (instance >= m_InstanceSlots.size())
+        m_InstanceSlots.resize(instance + 1);
+
+    const u32 slot = (u32)m_SlotOwners.size();
+    auto& slots = m_InstanceSlots[instance];
+    m_SlotOwners.push_back({.Instance = instance, .IndexInInstance = (u32)slots.size()});
+    slots.push_back(slot);
+
+    return slot;
+}
+
+template <typename Fn>
+requires requires (Fn fn, u32 from, u32 to) { fn(from, to); }
+void SceneInstanceSlots::Remove(lux::SceneInstanceHandle instance, Fn&& onMove)
+{
+    if (instance >= m_InstanceSlots.size())
+        return;
+
+    /* the slots of the removed instance may get moved while it is being removed (if they are at the very end),
+     * so they are always re-read instead of being cached; going backwards means that a freshly added instance
+     * at the end of the array is removed without any moves */
+    auto& slots = m_InstanceSlots[instance];
+    for (i32 i = (i32)slots.size() - 1; i >= 0; i--)
+    {
+        const u32 hole = slots[i];
+        const u32 last = (u32)m_SlotOwners.size() - 1;
+        if (hole != last)
+        {
+            const SlotOwnerInfo lastOwner = m_SlotOwners[last];
+            m_SlotOwners[hole] = lastOwner;
+            m_InstanceSlots[lastOwner.Instance][lastOwner.IndexInInstance] = hole;
+            onMove(last, hole);
+        }
+        m_SlotOwners.pop_back();
+    }
+    slots.clear();
+}
+
+template <typename Fn>
+requires requires (Fn fn, lux::SceneInstanceHandle instance, Span<const u32> slots) { fn(instance, slots); }
+void SceneInstanceSlots::ForEachInstance(Fn&& fn) const
+{
+    for (u32 instance = 0; instance < m_InstanceSlots.size(); instance++)
+        if (!m_InstanceSlots[instance].empty())
+            fn(instance, Span<const u32>(m_InstanceSlots[instance]));
+}
+
+inline bool SceneInstanceSlots::Contains(lux::SceneInstanceHandle instance) const
+{
+    return instance < m_InstanceSlots.size() && !m_InstanceSlots[instance].empty();
+}
+
+inline Span<const u32> SceneInstanceSlots::InstanceSlots(lux::SceneInstanceHandle instance) const
+{
+    if (instance >= m_InstanceSlots.size())
+        return {};
+
+    return m_InstanceSlots[instance];
+}
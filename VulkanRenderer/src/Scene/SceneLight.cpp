@@ -25,6 +25,12 @@ SceneLight SceneLight::CreateEmpty(DeletionQueue& deletionQueue)
             .Usage = BufferUsage::Ordinary | BufferUsage::Storage | BufferUsage::Source
         },
     }, deletionQueue);
+    light.m_Buffers.SpotLights = Device::CreateBuffer({
+        .Description = {
+            .SizeBytes = sizeof(SpotLight),
+            .Usage = BufferUsage::Ordinary | BufferUsage::Storage | BufferUsage::Source
+        },
+    }, deletionQueue);
 
     return light;
 }
@@ -43,6 +49,7 @@ void SceneLight::OnUpdate(FrameContext& ctx)
 {
     u32 directionalLightIndex = 0;
     u32 pointLightIndex = 0;
+    u32 spotLightIndex = 0;
     for (auto& light : m_VisibleLights)
     {
         if (light.IsSun)
@@ -59,14 +66,16 @@ void SceneLight::OnUpdate(FrameContext& ctx)
             pointLightIndex++;
             break;
         case lux::LightType::Spot:
-            ASSERT(false, "Spot light is not supported")
+            UpdateSpotLight(light, spotLightIndex, ctx);
+            spotLightIndex++;
             break;
         }
     }
 
     m_CachedLightsInfo = {
         .DirectionalLightCount = directionalLightIndex,
-        .PointLightCount = pointLightIndex
+        .PointLightCount = pointLightIndex,
+        .SpotLightCount = spotLightIndex
     };
 }
 
@@ -107,3 +116,31 @@ void SceneLight::UpdatePointLight(lux::CommonLight& light, u32 lightIndex, Frame
         pointLight,
         lightIndex * sizeof(pointLight));
 }
+
+void SceneLight::UpdateSpotLight(lux::CommonLight& light, u32 lightIndex, FrameContext& ctx)
+{
+    const f32 cosInner = std::cos(lux::SpotLightData::DequantizeAngle(light.SpotLightData.InnerAngle));
+    const f32 outerAngle = lux::SpotLightData::DequantizeAngle(light.SpotLightData.OuterAngle);
+    const f32 cosOuter = std::cos(outerAngle);
+    const f32 angleScale = 1.0f / std::max(cosInner - cosOuter, 1e-3f);
+    const SpotLight spotLight = {{
+        .Position = light.PositionDirection,
+        .Color = light.Color,
+        .Intensity = light.Intensity,
+        .Radius = light.Radius,
+        .Direction = light.SpotLightData.Direction,
+        .AngleScale = angleScale,
+        .AngleOffset = -cosOuter * angleScale,
+        .CosOuterAngle = cosOuter,
+        .SinOuterAngle = std::sin(outerAngle)
+    }};
+    ::buffers::grow(m_Buffers.SpotLights, sizeof(spotLight) * (lightIndex + 1), ctx.Cmd);
+    if (m_CachedSpotLights.size() <= lightIndex)
+        m_CachedSpotLights.resize(lightIndex + 1);
+    else if (m_CachedSpotLights[lightIndex] == spotLight)
+        return;
+    m_CachedSpotLights[lightIndex] = spotLight;
+    ctx.ResourceUploader->UpdateBuffer(m_Buffers.SpotLights,
+        spotLight,
+        lightIndex * sizeof(spotLight));
+}
@@ -2,6 +2,7 @@
 
 #include "Assets/Scenes/SceneAsset.h"
 #include "Light/Light.h"
+#include "Light/LightSphereCuller.h"
 #include "Rendering/Buffer/Buffer.h"
 
 #include <CoreLib/Containers/SlotMapType.h>
@@ -16,6 +17,7 @@ public:
     {
         Buffer DirectionalLights{};
         Buffer PointLights{};
+        Buffer SpotLights{};
     };
 public:
     static SceneLight CreateEmpty(DeletionQueue& deletionQueue);
@@ -27,9 +29,12 @@ public:
     const lux::CommonLight& Get(u32 index) const { return m_Lights[index]; }
     const Buffers& GetBuffers() const { return m_Buffers; }
     const std::vector<lux::CommonLight>& VisibleLights() const { return m_VisibleLights; }
+    /* point light bounds in structure-of-arrays layout, refilled by `LightFrustumCuller` every cull */
+    LightSphereCuller& PointLightSpheres() { return m_PointLightSpheres; }
 
     u32 DirectionalLightCount() const { return m_CachedLightsInfo.DirectionalLightCount; }
     u32 PointLightCount() const { return m_CachedLightsInfo.PointLightCount; }
+    u32 SpotLightCount() const { return m_CachedLightsInfo.SpotLightCount; }
     
     auto begin() const { return m_Lights.begin(); }
     auto end() const { return m_Lights.end(); }
@@ -40,12 +45,15 @@ private:
     void OnUpdate(FrameContext& ctx);
     void UpdateDirectionalLight(lux::CommonLight& light, u32 lightIndex, FrameContext& ctx);
     void UpdatePointLight(lux::CommonLight& light, u32 lightIndex, FrameContext& ctx);
+    void UpdateSpotLight(lux::CommonLight& light, u32 lightIndex, FrameContext& ctx);
 private:
     lux::SlotMap<lux::CommonLight> m_Lights;
     
     std::vector<lux::CommonLight> m_VisibleLights;
+    LightSphereCuller m_PointLightSpheres;
     std::vector<DirectionalLight> m_CachedDirectionalLights;
     std::vector<PointLight> m_CachedPointLights;
+    std::vector<SpotLight> m_CachedSpotLights;
     LightsInfo m_CachedLightsInfo{};
 
     Buffers m_Buffers{};
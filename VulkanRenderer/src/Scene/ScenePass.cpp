@@ -23,20 +23,6 @@ void ScenePass::AddBuckets(Span<const SceneBucketCreateInfo> buckets)
         MAX_BUCKETS_PER_SET, maxHandle - minHandle)
 }
 
-SceneBucketHandle ScenePass::Filter(const lux::SceneGeometryInfo& geometry, SceneRenderObjectHandle renderObject)
-{
-    SceneBucketHandle bucketToAssignTo = INVALID_SCENE_BUCKET;
-    for (auto bucketHandle : m_BucketHandles)
-    {
-        if (!m_BucketList->GetBucket(bucketHandle).Filter(geometry, renderObject))
-            continue;
-        ASSERT(bucketToAssignTo == INVALID_SCENE_BUCKET, "Ambiguous bucket")
-        bucketToAssignTo = bucketHandle;
-    }
-
-    return bucketToAssignTo;
-}
-
 const SceneBucket& ScenePass::FindBucket(StringId name) const
 {
     const SceneBucket* bucket = TryFindBucket(name);
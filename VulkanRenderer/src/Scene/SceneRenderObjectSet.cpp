@@ -4,19 +4,74 @@
 
 #include "FrameContext.h"
 #include "ResourceUploader.h"
+#include "Assets/Materials/MaterialAssetManager.h"
 #include "cvars/CVarSystem.h"
 #include "Rendering/Buffer/BufferUtility.h"
 
+namespace
+{
+SceneRenderObjectFlags getMaterialFlags(const lux::MaterialAsset* material)
+{
+    if (material == nullptr)
+        return SceneRenderObjectFlags::None;
+
+    SceneRenderObjectFlags flags = SceneRenderObjectFlags::HasMaterial;
+    switch (material->AlphaMode)
+    {
+    case lux::MaterialAlphaMode::Opaque:
+        flags |= SceneRenderObjectFlags::Opaque;
+        break;
+    case lux::MaterialAlphaMode::Mask:
+        flags |= SceneRenderObjectFlags::AlphaMask;
+        break;
+    case lux::MaterialAlphaMode::Translucent:
+        flags |= SceneRenderObjectFlags::Translucent;
+        break;
+    }
+    if (material->DoubleSided)
+        flags |= SceneRenderObjectFlags::TwoSided;
+
+    return flags;
+}
+
+SceneRenderObjectFlags getRenderObjectFlags(const lux::SceneRenderObject& renderObject, bool isDynamic,
+    Span<const SceneRenderObjectFlags> materialFlags)
+{
+    SceneRenderObjectFlags flags = renderObject.Material == lux::SceneRenderObject::INVALID ?
+        SceneRenderObjectFlags::None : materialFlags[renderObject.Material];
+    if (renderObject.SkinIndex != lux::SceneRenderObject::INVALID)
+        flags |= SceneRenderObjectFlags::Skinned;
+    if (renderObject.BlendShapeCount > 0)
+        flags |= SceneRenderObjectFlags::BlendShapes;
+    if (isDynamic)
+        flags |= SceneRenderObjectFlags::Dynamic;
+
+    return flags;
+}
+}
+
 void SceneRenderObjectSet::Init(StringId name, Scene& scene, SceneBucketList& bucketList,
-    Span<const ScenePassCreateInfo> passes, DeletionQueue& deletionQueue)
+    Span<const ScenePassCreateInfo> passes, const lux::MaterialAssetManager& materialAssetManager,
+    DeletionQueue& deletionQueue)
 {
     m_Scene = &scene;
+    m_MaterialAssetManager = &materialAssetManager;
     m_FirstBucket = bucketList.Count();
     m_Name = name;
     m_Passes.reserve(passes.size());
     for (auto& pass : passes)
         m_Passes.emplace_back(pass, bucketList);
     m_BucketCount = bucketList.Count() - m_FirstBucket;
+    m_BucketMeshletCounts.resize(m_BucketCount);
+
+    std::vector<SceneBucketPredicate> predicates(m_BucketCount);
+    for (u32 i = 0; i < m_BucketCount; i++)
+        predicates[i] = bucketList.GetBucket(m_FirstBucket + i).Predicate;
+    std::vector<SceneBucketBits> passBuckets(m_Passes.size());
+    for (u32 i = 0; i < m_Passes.size(); i++)
+        for (auto bucket : m_Passes[i].BucketHandles())
+            passBuckets[i].Set(BucketHandleToIndex(bucket));
+    m_BucketPredicates.Compile(predicates, passBuckets);
     
     m_NewInstanceHandler = SignalHandler<NewInstanceData>([this](const NewInstanceData& instanceData) {
         OnNewSceneInstance(instanceData);
@@ -55,6 +110,21 @@ void SceneRenderObjectSet::OnUpdate(FrameContext& ctx)
     ctx.ResourceUploader->UpdateBuffer(m_BucketBits.Buffer, m_BucketBitsCpu);
 }
 
+void SceneRenderObjectSet::CullInstances(Span<const Frustum> frustums, SceneRenderObjectRanges& ranges) const
+{
+    m_InstanceSlots.ForEachInstance([&](lux::SceneInstanceHandle instance, Span<const u32> slots) {
+        const AABB& bounds = m_Scene->InstanceBounds(instance);
+        for (auto& frustum : frustums)
+        {
+            if (frustum.Intersects(bounds))
+            {
+                ranges.AddSlots(slots);
+                return;
+            }
+        }
+    });
+}
+
 const ScenePass& SceneRenderObjectSet::FindPass(StringId name) const
 {
     const ScenePass* pass = TryFindPass(name);
@@ -76,63 +146,70 @@ void SceneRenderObjectSet::OnNewSceneInstance(const NewInstanceData& instanceDat
 {
     const lux::SceneGeometryInfo& geometry = instanceData.Scene->Geometry;
 
-    static constexpr u32 INVALID_ID = ~0u;
-    SceneInstanceInfo addedInstanceInfo = {.FirstRenderObject = INVALID_ID};
+    SceneInstanceInfo addedInstanceInfo = {};
+
+    std::vector<SceneRenderObjectFlags> materialFlags(geometry.MaterialsCpu.size());
+    for (u32 materialIndex = 0; materialIndex < geometry.MaterialsCpu.size(); materialIndex++)
+        materialFlags[materialIndex] = getMaterialFlags(
+            m_MaterialAssetManager->Get(geometry.MaterialsCpu[materialIndex].Handle));
+    std::vector<SceneRenderObjectFlags> renderObjectFlags(geometry.RenderObjects.size());
+    for (u32 renderObjectIndex = 0; renderObjectIndex < geometry.RenderObjects.size(); renderObjectIndex++)
+        renderObjectFlags[renderObjectIndex] = getRenderObjectFlags(geometry.RenderObjects[renderObjectIndex],
+            m_Scene->IsRenderObjectDynamic(instanceData.RenderObjectsOffset + renderObjectIndex), materialFlags);
+    std::vector<SceneBucketBits> renderObjectBucketBits(geometry.RenderObjects.size());
+    m_BucketPredicates.BucketBits(renderObjectFlags, 0, renderObjectBucketBits);
     
     for (u32 renderObjectIndex = 0; renderObjectIndex < geometry.RenderObjects.size(); renderObjectIndex++)
     {
         const SceneRenderObjectHandle handle = {.Index = renderObjectIndex};
-        SceneBucketBits bucketBits = {};
-        for (auto& pass : m_Passes)
-        {
-            SceneBucketHandle bucket = pass.Filter(geometry, handle);
-            if (bucket == INVALID_SCENE_BUCKET)
-                continue;
-            bucket = bucket - m_FirstBucket;
-            ASSERT(bucket < MAX_BUCKETS_PER_SET)
-            bucketBits |= 1llu << bucket;
-        }
+        const SceneBucketBits& bucketBits = renderObjectBucketBits[renderObjectIndex];
 
-        if (bucketBits != 0)
+        if (bucketBits.Any())
         {
             auto& renderObject = geometry.RenderObjects[renderObjectIndex];
             const SceneRenderObjectHandle globalHandle = {.Index = handle.Index + instanceData.RenderObjectsOffset};
-            u32 renderObjectCpuIndex = (u32)m_RenderObjectsCpu.size();
+            const u32 slot = m_InstanceSlots.Add(instanceData.Instance);
+            ASSERT(slot == m_RenderObjectsCpu.size(), "Render object slots are out of sync")
             m_RenderObjectsCpu.push_back(globalHandle);
             m_BucketBitsCpu.push_back(bucketBits);
+            m_MeshletCountsCpu.push_back(renderObject.MeshletCount);
             m_MeshletCount += renderObject.MeshletCount;
+            bucketBits.ForEachSetBit([&](u32 bucket) {
+                m_BucketMeshletCounts[bucket] += renderObject.MeshletCount;
+            });
             u32 trianglesCount = 0;
             for (u32 meshletIndex = 0; meshletIndex < renderObject.MeshletCount; meshletIndex++)
                 trianglesCount += geometry.Meshlets[renderObject.FirstMeshlet + meshletIndex].IndexCount / 3;
             m_TriangleCount += trianglesCount;
             
-            if (addedInstanceInfo.FirstRenderObject == INVALID_ID)
-                addedInstanceInfo.FirstRenderObject = renderObjectCpuIndex;
-            addedInstanceInfo.RenderObjectCount += 1;
             addedInstanceInfo.MeshletCount += renderObject.MeshletCount;
             addedInstanceInfo.TriangleCount += trianglesCount;
         }
     }
 
-    m_InstancesInfo.emplace(instanceData.Instance, addedInstanceInfo);
+    if (instanceData.Instance >= m_InstancesInfo.size())
+        m_InstancesInfo.resize(instanceData.Instance + 1);
+    m_InstancesInfo[instanceData.Instance] = addedInstanceInfo;
 }
 
 void SceneRenderObjectSet::OnDeletedSceneInstance(const DeletedInstanceData& instanceData)
 {
-    const SceneInstanceInfo& sceneInstance = m_InstancesInfo.at(instanceData.Instance);
-
-    m_RenderObjectsCpu.erase(
-        m_RenderObjectsCpu.begin() + sceneInstance.FirstRenderObject,
-        m_RenderObjectsCpu.begin() + sceneInstance.FirstRenderObject + sceneInstance.RenderObjectCount);
-    m_BucketBitsCpu.erase(
-        m_BucketBitsCpu.begin() + sceneInstance.FirstRenderObject,
-        m_BucketBitsCpu.begin() + sceneInstance.FirstRenderObject + sceneInstance.RenderObjectCount);
+    SceneInstanceInfo& sceneInstance = m_InstancesInfo[instanceData.Instance];
+
+    for (u32 slot : m_InstanceSlots.InstanceSlots(instanceData.Instance))
+        m_BucketBitsCpu[slot].ForEachSetBit([&](u32 bucket) {
+            m_BucketMeshletCounts[bucket] -= m_MeshletCountsCpu[slot];
+        });
+    m_InstanceSlots.Remove(instanceData.Instance, [this](u32 from, u32 to) {
+        m_RenderObjectsCpu[to] = m_RenderObjectsCpu[from];
+        m_BucketBitsCpu[to] = m_BucketBitsCpu[from];
+        m_MeshletCountsCpu[to] = m_MeshletCountsCpu[from];
+    });
+    m_RenderObjectsCpu.resize(m_InstanceSlots.Count());
+    m_BucketBitsCpu.resize(m_InstanceSlots.Count());
+    m_MeshletCountsCpu.resize(m_InstanceSlots.Count());
     m_MeshletCount -= sceneInstance.MeshletCount;
     m_TriangleCount -= sceneInstance.TriangleCount;
 
-    for (auto& instanceInfo : m_InstancesInfo | std::views::values)
-        if (instanceInfo.FirstRenderObject > sceneInstance.FirstRenderObject)
-            instanceInfo.FirstRenderObject -= sceneInstance.RenderObjectCount;
-    
-    m_InstancesInfo.erase(instanceData.Instance);
+    sceneInstance = {};
 }
@@ -1,16 +1,23 @@
 #pragma once
 
 #include "Scene.h"
+#include "SceneInstanceSlots.h"
 #include "ScenePass.h"
+#include "Visibility/SceneRenderObjectRanges.h"
 #include "Rendering/Buffer/PushBuffer.h"
 
 #include <CoreLib/String/StringId.h>
 
+namespace lux
+{
+class MaterialAssetManager;
+}
+
 class SceneRenderObjectSet
 {
 public:
     void Init(StringId name, Scene& scene, SceneBucketList& bucketList, Span<const ScenePassCreateInfo> passes,
-        DeletionQueue& deletionQueue);
+        const lux::MaterialAssetManager& materialAssetManager, DeletionQueue& deletionQueue);
 
     void OnUpdate(FrameContext& ctx);
 
@@ -21,6 +28,8 @@ public:
     u32 BucketCount() const { return m_BucketCount; }
     u32 MeshletCount() const { return m_MeshletCount; }
     u32 TriangleCount() const { return m_TriangleCount; }
+    /* the meshlet count of the render objects of each bucket, indexed by bucket index */
+    Span<const u32> BucketMeshletCounts() const { return m_BucketMeshletCounts; }
 
     const std::vector<ScenePass>& Passes() const { return m_Passes; }
     
@@ -29,6 +38,9 @@ public:
 
     const SceneGeometry& Geometry() const { return m_Scene->Geometry(); }
 
+    /* adds the slots of scene instances whose bounds intersect any of the `frustums` */
+    void CullInstances(Span<const Frustum> frustums, SceneRenderObjectRanges& ranges) const;
+
     const ScenePass& FindPass(StringId name) const;
     const ScenePass* TryFindPass(StringId name) const;
     
@@ -46,20 +58,24 @@ private:
     u32 m_TriangleCount{0};
 
     const Scene* m_Scene{nullptr};
+    const lux::MaterialAssetManager* m_MaterialAssetManager{nullptr};
+    SceneBucketPredicateTable m_BucketPredicates{};
 
     SignalHandler<NewInstanceData> m_NewInstanceHandler;
     SignalHandler<DeletedInstanceData> m_DeletedInstanceHandler;
     std::vector<SceneRenderObjectHandle> m_RenderObjectsCpu;
     std::vector<SceneBucketBits> m_BucketBitsCpu;
+    std::vector<u32> m_MeshletCountsCpu;
+    std::vector<u32> m_BucketMeshletCounts;
     std::vector<ScenePass> m_Passes;
+    SceneInstanceSlots m_InstanceSlots;
     struct SceneInstanceInfo
     {
-        u32 FirstRenderObject{};
-        u32 RenderObjectCount{};
         u32 MeshletCount{};
         u32 TriangleCount{};
     };
-    std::unordered_map<u32, SceneInstanceInfo> m_InstancesInfo;
+    /* indexed by scene instance handle */
+    std::vector<SceneInstanceInfo> m_InstancesInfo;
 
     StringId m_Name{};
 };
@@ -0,0 +1,41 @@
+#include "rendererpch.h"
+
+#include "MeshletCone.h"
+
+MeshletCone MeshletCone::FromQuantized(i8 axisX, i8 axisY, i8 axisZ, i8 cutoff)
+{
+    const bool hasCone = cutoff < NO_CONE_CUTOFF;
+
+    return {
+        .Axis = hasCone ? glm::normalize(glm::vec3{axisX, axisY, axisZ} / 127.0f) : glm::vec3{0.0f},
+        .Cutoff = (f32)cutoff / 127.0f,
+        .HasCone = hasCone};
+}
+
+MeshletCone MeshletCone::Transform(const glm::mat4& transform) const
+{
+    if (!HasCone)
+        return *this;
+
+    MeshletCone transformed = *this;
+    transformed.Axis = glm::normalize(glm::vec3{transform * glm::vec4{Axis, 0.0f}});
+
+    return transformed;
+}
+
+bool MeshletCone::IsVisible(const glm::vec3& origin, f32 radius) const
+{
+    if (!HasCone)
+        return true;
+
+    return glm::dot(origin, Axis) < Cutoff * glm::length(origin) + radius;
+}
+
+bool MeshletCone::IsVisibleOrthographic() const
+{
+    if (!HasCone)
+        return true;
+
+    /* the view direction is -z everywhere */
+    return -Axis.z < Cutoff;
+}
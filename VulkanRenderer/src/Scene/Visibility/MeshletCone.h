@@ -0,0 +1,27 @@
+#pragma once
+
+#include <CoreLib/types.h>
+
+#include <glm/glm.hpp>
+
+/* the cone of the triangle normals of a meshlet: the whole meshlet faces away from the view if the direction
+ * of the view to it is within the cone. This is the cpu reference of the cone culling of `meshletVisibility.slang`,
+ * the cone is stored quantized in `MeshletBounds` */
+struct MeshletCone
+{
+    /* the quantized cutoff of the meshlets whose normals do not fit into a hemisphere */
+    static constexpr i8 NO_CONE_CUTOFF = 127;
+
+    glm::vec3 Axis{0.0f};
+    f32 Cutoff{1.0f};
+    bool HasCone{false};
+
+    static MeshletCone FromQuantized(i8 axisX, i8 axisY, i8 axisZ, i8 cutoff);
+
+    /* `transform` has to be a rigid transform with an optional uniform scale */
+    MeshletCone Transform(const glm::mat4& transform) const;
+    /* the cone and `origin`, the center of the meshlet bounding sphere, are in view space */
+    bool IsVisible(const glm::vec3& origin, f32 radius) const;
+    /* the cone is in view space */
+    bool IsVisibleOrthographic() const;
+};
@@ -0,0 +1,47 @@
+#include "rendererpch.h"
+
+#include "SceneDrawRanges.h"
+
+void SceneDrawRanges::Init(u32 viewCount, Span<const u32> bucketMeshletCounts, const SceneBucketBits& bucketsMask)
+{
+    m_BucketCount = (u32)bucketMeshletCounts.size();
+    m_BucketsMask = bucketsMask & SceneBucketBits::FirstN(m_BucketCount);
+    m_Ranges.resize(viewCount * m_BucketCount);
+
+    u32 offset = 0;
+    for (u32 view = 0; view < viewCount; view++)
+    {
+        for (u32 bucket = 0; bucket < m_BucketCount; bucket++)
+        {
+            const u32 capacity = m_BucketsMask.Test(bucket) ? bucketMeshletCounts[bucket] : 0;
+            m_Ranges[RangeIndex(view, bucket)] = {.Offset = offset, .Capacity = capacity};
+            offset += capacity;
+        }
+    }
+    m_DrawCount = offset;
+}
+
+void SceneDrawRanges::Compact(Span<const Element> elements, Span<u32> draws, Span<u32> counts) const
+{
+    ASSERT(draws.size() >= m_DrawCount && counts.size() >= m_Ranges.size(),
+        "Not enough space for {} draws in {} ranges", m_DrawCount, m_Ranges.size())
+
+    const u32 viewCount = m_BucketCount == 0 ? 0 : (u32)m_Ranges.size() / m_BucketCount;
+    std::fill_n(counts.begin(), m_Ranges.size(), 0u);
+    for (u32 elementIndex = 0; elementIndex < elements.size(); elementIndex++)
+    {
+        const Element& element = elements[elementIndex];
+        const SceneBucketBits buckets = element.Buckets & m_BucketsMask;
+        element.Views.ForEachSetBit([&](u32 view) {
+            if (view >= viewCount)
+                return;
+            buckets.ForEachSetBit([&](u32 bucket) {
+                const u32 rangeIndex = RangeIndex(view, bucket);
+                const SceneDrawRange& range = m_Ranges[rangeIndex];
+                ASSERT(counts[rangeIndex] < range.Capacity, "Draw range of view {} and bucket {} overflows",
+                    view, bucket)
+                draws[range.Offset + counts[rangeIndex]++] = elementIndex;
+            });
+        });
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "SceneVisibility.h"
+#include "Scene/SceneBucketPredicateTable.h"
+
+#include <vector>
+
+struct SceneDrawRange
+{
+    /* index of the first draw command of the range in the draw buffer */
+    u32 Offset{0};
+    u32 Capacity{0};
+
+    auto operator<=>(const SceneDrawRange&) const = default;
+};
+
+/* densely packed ranges of the draw commands of every view and bucket in a single draw buffer,
+ * with a single count buffer of one count per range. The ranges are laid out view after view,
+ * by exclusive prefix scan of the bucket capacities */
+class SceneDrawRanges
+{
+public:
+    /* the capacity of a bucket is the meshlet count of its render objects (`bucketMeshletCounts`),
+     * the buckets outside of `bucketsMask` get empty ranges */
+    void Init(u32 viewCount, Span<const u32> bucketMeshletCounts, const SceneBucketBits& bucketsMask);
+
+    /* cpu reference of `createDrawCommands.slang`: writes the index of every element to the range of each of its
+     * views and buckets, and counts the writes in `counts`; unlike on gpu, the draws of a range keep the order of
+     * `elements` */
+    struct Element
+    {
+        SceneViewMask Views{};
+        SceneBucketBits Buckets{};
+    };
+    void Compact(Span<const Element> elements, Span<u32> draws, Span<u32> counts) const;
+
+    u32 RangeIndex(u32 view, u32 bucket) const { return view * m_BucketCount + bucket; }
+    const SceneDrawRange& Get(u32 view, u32 bucket) const { return m_Ranges[RangeIndex(view, bucket)]; }
+    /* indexed by `RangeIndex` */
+    Span<const SceneDrawRange> Ranges() const { return m_Ranges; }
+    u32 BucketCount() const { return m_BucketCount; }
+    const SceneBucketBits& BucketsMask() const { return m_BucketsMask; }
+    /* the total capacity of all ranges */
+    u32 DrawCount() const { return m_DrawCount; }
+private:
+    std::vector<SceneDrawRange> m_Ranges;
+    SceneBucketBits m_BucketsMask{};
+    u32 m_BucketCount{0};
+    u32 m_DrawCount{0};
+};
@@ -22,6 +22,9 @@ SceneVisibilityHandle SceneMultiviewVisibility::AddVisibility(const SceneView& v
     }
 
     m_Visibilities[m_ViewCount] = view;
+    if (!view.CullFrustum.has_value() && view.ViewInfo.IsViewInfoGPU())
+        m_Visibilities[m_ViewCount].CullFrustum = Frustum::FromViewProjection(
+            view.ViewInfo.AsViewInfoGPU().Camera.ViewProjection);
     
     const SceneVisibilityHandle toReturn {.Handle = m_ViewCount};
     m_ViewCount++;
@@ -36,6 +39,27 @@ const SceneView& SceneMultiviewVisibility::View(SceneVisibilityHandle handle) co
     return m_Visibilities[handle];
 }
 
+void SceneMultiviewVisibility::CullInstances(SceneRenderObjectRanges& ranges) const
+{
+    ranges.Clear();
+
+    std::array<Frustum, MAX_VIEWS> frustums;
+    for (u32 i = 0; i < m_ViewCount; i++)
+    {
+        /* the view's camera only exists on gpu, so nothing can be culled */
+        if (!m_Visibilities[i].CullFrustum.has_value())
+        {
+            ranges.AddRange(0, m_Set->RenderObjectCount());
+            ranges.Compact();
+            return;
+        }
+        frustums[i] = *m_Visibilities[i].CullFrustum;
+    }
+
+    m_Set->CullInstances(Span<const Frustum>(frustums.data(), m_ViewCount), ranges);
+    ranges.Compact();
+}
+
 const SceneRenderObjectSet& SceneMultiviewVisibility::ObjectSet() const
 {
     return *m_Set;
@@ -8,7 +8,7 @@
 class SceneMultiviewVisibility
 {
 public:
-    static constexpr u32 MAX_VIEWS = 32;
+    static constexpr u32 MAX_VIEWS = MAX_SCENE_VISIBILITY_VIEWS;
 public:
     void Init(const SceneRenderObjectSet& set);
     void OnUpdate(FrameContext& ctx);
@@ -17,6 +17,10 @@ public:
     u32 VisibilityHandleToIndex(SceneVisibilityHandle handle) const { return handle.Handle; }
 
     const SceneView& View(SceneVisibilityHandle handle) const;
+
+    /* coarse cpu culling of whole scene instances against all views,
+     * `ranges` get the render object slots that may be visible in at least one of them */
+    void CullInstances(SceneRenderObjectRanges& ranges) const;
     
     u32 VisibilityCount() const { return m_ViewCount; }
     const SceneRenderObjectSet& ObjectSet() const;
@@ -0,0 +1,57 @@
+#include "rendererpch.h"
+
+#include "SceneRenderObjectRanges.h"
+
+#include <algorithm>
+
+void SceneRenderObjectRanges::Clear()
+{
+    m_Ranges.clear();
+    m_SlotCount = 0;
+}
+
+void SceneRenderObjectRanges::AddRange(u32 first, u32 count)
+{
+    if (count == 0)
+        return;
+
+    m_SlotCount += count;
+    if (!m_Ranges.empty() && m_Ranges.back().First + m_Ranges.back().Count == first)
+    {
+        m_Ranges.back().Count += count;
+        return;
+    }
+
+    m_Ranges.push_back({.First = first, .Count = count});
+}
+
+void SceneRenderObjectRanges::AddSlots(Span<const u32> slots)
+{
+    for (u32 slot : slots)
+        AddRange(slot, 1);
+}
+
+void SceneRenderObjectRanges::Compact()
+{
+    std::ranges::sort(m_Ranges, {}, &SceneRenderObjectRange::First);
+
+    u32 last = 0;
+    for (u32 i = 1; i < m_Ranges.size(); i++)
+    {
+        SceneRenderObjectRange& current = m_Ranges[last];
+        if (current.First + current.Count == m_Ranges[i].First)
+            current.Count += m_Ranges[i].Count;
+        else
+            m_Ranges[++last] = m_Ranges[i];
+    }
+    if (!m_Ranges.empty())
+        m_Ranges.resize(last + 1);
+
+    u32 offset = 0;
+    for (auto& range : m_Ranges)
+    {
+        range.CompactedOffset = offset;
+        offset += range.Count;
+    }
+    ASSERT(offset == m_SlotCount, "Render object ranges overlap")
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <CoreLib/core.h>
+#include <CoreLib/Containers/Span.h>
+
+#include <vector>
+
+struct SceneRenderObjectRange
+{
+    u32 First{0};
+    u32 Count{0};
+    /* index of the first slot of this range in the list of all slots of all ranges */
+    u32 CompactedOffset{0};
+
+    auto operator<=>(const SceneRenderObjectRange&) const = default;
+};
+
+/* list of non-overlapping ranges of render object set slots */
+class SceneRenderObjectRanges
+{
+public:
+    void Clear();
+    void AddRange(u32 first, u32 count);
+    /* adds runs of consecutive slots, `slots` must not repeat the slots that were already added */
+    void AddSlots(Span<const u32> slots);
+    /* sorts the ranges, merges the adjacent ones and assigns `CompactedOffset`s */
+    void Compact();
+
+    Span<const SceneRenderObjectRange> Ranges() const { return m_Ranges; }
+    u32 SlotCount() const { return m_SlotCount; }
+private:
+    std::vector<SceneRenderObjectRange> m_Ranges;
+    u32 m_SlotCount{0};
+};
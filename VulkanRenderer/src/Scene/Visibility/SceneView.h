@@ -2,8 +2,11 @@
 
 #include "ViewInfoGPU.h"
 
+#include <CoreLib/Math/Frustum.h>
 #include <CoreLib/String/StringId.h>
 
+#include <optional>
+
 class SceneViewInfo
 {
 public:
@@ -45,5 +48,8 @@ struct SceneView
 {
     StringId Name{};
     SceneViewInfo ViewInfo{};
+    /* used for coarse cpu culling of whole scene instances; filled automatically for views with cpu-side
+     * `ViewInfoGPU`, views that have neither are never culled on cpu */
+    std::optional<Frustum> CullFrustum{};
     auto operator==(const SceneView& other) const { return Name == other.Name; }
 };
\ No newline at end of file
@@ -2,8 +2,14 @@
 
 #include "SceneView.h"
 
+#include <CoreLib/Containers/WideBitSet.h>
+
 using SceneVisibilityBucket = u64;
 
+/* must match `MAX_VISIBILITY_VIEWS` in `scene/visibility/visibility.slang` */
+static constexpr u32 MAX_SCENE_VISIBILITY_VIEWS = 128;
+using SceneViewMask = lux::WideBitSet<MAX_SCENE_VISIBILITY_VIEWS>;
+
 struct SceneVisibilityHandle
 {
     static constexpr u32 INVALID = ~0lu;
@@ -11,6 +11,8 @@ void Settings::initCvars()
     // todo: mark as readonly once i know how to enforce it 
     CVarString assetsPath("Path.Assets"_hsv, "Base path to assets", "../assets/");
     CVarString assetsBakedPath("Path.AssetsBaked"_hsv, "Base path to baked assets", "../assets/baked");
+    CVarString assetIndexPath("Path.AssetIndex"_hsv, "Path to the cached scan of the assets directory",
+        (std::filesystem::path(assetsBakedPath.Get()) / "assets.index").generic_string());
     CVarString shadersPath("Path.Shaders"_hsv, "Relative path to shaders", "shaders/");
     CVarString shadersPathFull("Path.Shaders.Full"_hsv, "Full path to shaders", 
         (std::filesystem::path(assetsPath.Get()) / shadersPath.Get()).generic_string());
@@ -21,7 +23,7 @@ void Settings::initCvars()
         "possible values are 0 (separate files, default) and 1 (combined files)", 0);
     CVarI32 assetCompressionType("Assets.IoCompression"_hsv,
         "Which type of asset compression should be used "
-        "possible values are 0 (lz4, default) and 1 (raw)", 0);
+        "possible values are 0 (lz4, default), 1 (raw) and 2 (zstd)", 0);
 
     CVarI32 shaderHotReloading("Renderer.Shaders.HotReload"_hsv,
         "Flag if shader hot reloading is enabled possible values are 0 (disabled) and 1 (enabled, default)", (i32)true);
@@ -32,6 +34,16 @@ void Settings::initCvars()
     CVarI32 resourceUploaderStagingLifetime("Uploader.StagingLifetime"_hsv,
         "The lifetime of staging buffer, in frames",
         300);
+    CVarI32 sceneStreamingUploadBudget("Scene.Streaming.UploadBudgetBytes"_hsv,
+        "The amount of streamed scene geometry and scene instance data uploaded per frame, in bytes, "
+        "the first spawned instance of a frame is uploaded even if it exceeds the budget",
+        32 * 1024 * 1024);
+    CVarI32 textureStreamingVramBudget("Textures.Streaming.VramBudgetMiB"_hsv,
+        "The amount of memory the streamed textures can occupy, in MiB",
+        1024);
+    CVarI32 textureStreamingUploadBudget("Textures.Streaming.UploadBudgetBytes"_hsv,
+        "The amount of streamed texture mipmaps read and uploaded per frame, in bytes",
+        16 * 1024 * 1024);
 
     /* main rendering settings */
     CVarI32 depthPrepass("Renderer.DepthPrepass"_hsv,
@@ -40,7 +52,12 @@ void Settings::initCvars()
         "Flag if renderer uses forward shading as main rendering pass "
         "possible values are 0 (disabled, default) and 1 (enabled)", (i32)false);
     CVarI32 gpuShadowCameras("Renderer.UseGpuShadowCameras"_hsv,
-        "Flag if renderer create shadow cameras on gpu "
+        "Flag if renderer create shadow cameras on gpu, which bypasses the static cascades cache "
+        "and the shadow occlusion culling, as both need the cameras on cpu "
+        "possible values are 0 (disabled, default) and 1 (enabled)", (i32)false);
+    CVarI32 shadowOcclusionCulling("Renderer.Shadows.OcclusionCull"_hsv,
+        "Flag if shadow casters are occlusion culled by the cascades of the previous frame, "
+        "works only with shadow cameras created on cpu "
         "possible values are 0 (disabled) and 1 (enabled, default)", (i32)true);
     CVarI32 atmosphereRendering("Renderer.Atmosphere"_hsv,
         "Flag if renderer should render sky as physically correct atmosphere "
@@ -24,6 +24,8 @@ enum class VisibilityFlags : u32
     ClampDepth      = BIT(1),
     OcclusionCull   = BIT(2),
     IsPrimaryView   = BIT(3),
+    /* meshlets that face away from the view are culled, it is only for the views of passes that cull back faces */
+    ConeCull        = BIT(4),
 };
 
 CREATE_ENUM_FLAGS_OPERATORS(VisibilityFlags)
@@ -0,0 +1,9 @@
+{
+  "name": "lightClustersUpdate",
+  "entryPoints": [
+    {
+      "name": "updateLightsClusters",
+      "path": "light/culling/lightCulling.slang"
+    }
+  ]
+}
\ No newline at end of file
@@ -4,6 +4,7 @@ IncludeDir["glm"]			    = "%{wks.location}/vendor/glm"
 IncludeDir["stb"]		        = "%{wks.location}/vendor/stb"
 IncludeDir["vma"]		        = "%{wks.location}/vendor/vma"
 IncludeDir["lz4"]		        = "%{wks.location}/vendor/lz4/include"
+IncludeDir["zstd"]		        = "%{wks.location}/vendor/zstd/lib"
 IncludeDir["nlohmann-json"]	    = "%{wks.location}/vendor/nlohmann-json"
 IncludeDir["glaze"]	            = "%{wks.location}/vendor/glaze/include"
 IncludeDir["tracy"]	            = "%{wks.location}/vendor/tracy/include"
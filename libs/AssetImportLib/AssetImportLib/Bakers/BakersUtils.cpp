@@ -1,5 +1,6 @@
 #include "BakersUtils.h"
 
+#include <AssetLib/Io/Compression/AssetCompressor.h>
 #include <AssetLib/Io/IoInterface/AssetIoInterface.h>
 #include <AssetImportLib/Importers/ImportContext.h>
 
@@ -31,4 +32,10 @@ AssetPaths getPostBakePaths(const assetlib::AssetMetadata& metadata, std::string
         .BinaryPath = std::move(binaryPath),
     };
 }
+
+bool isCompressionOutdated(const assetlib::AssetMetadata& metadata, const Context& ctx)
+{
+    return metadata.Io.CompressionGuid == ctx.Compressor->GetGuid() &&
+        metadata.Io.CompressionVersion != ctx.Compressor->GetVersion();
+}
 }
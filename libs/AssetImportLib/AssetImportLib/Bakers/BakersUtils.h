@@ -21,4 +21,6 @@ std::filesystem::path getPostBakePath(const assetlib::AssetMetadata& metadata, s
     const Context& ctx);
 AssetPaths getPostBakePaths(const assetlib::AssetMetadata& metadata, std::string_view postBakeExtension,
     const Context& ctx);
+/* the asset was baked by the current compressor, but with an older layout of its data */
+bool isCompressionOutdated(const assetlib::AssetMetadata& metadata, const Context& ctx);
 }
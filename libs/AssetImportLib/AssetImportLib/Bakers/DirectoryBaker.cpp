@@ -0,0 +1,226 @@
+#include "DirectoryBaker.h"
+
+#include <AssetLib/Shaders/ShaderLoadInfo.h>
+#include <AssetImportLib/Bakers/BakersDispatcher.h>
+#include <AssetImportLib/Importers/Import.h>
+#include <AssetImportLib/Importers/ImportContext.h>
+#include <AssetImportLib/Importers/Images/ImageImporter.h>
+#include <AssetImportLib/Importers/Scenes/SceneImporter.h>
+#include <AssetImportLib/Importers/Shaders/ShaderImporter.h>
+#include <CoreLib/Log.h>
+#include <CoreLib/Jobs/ThreadPool.h>
+#include <CoreLib/Utils/HashFileUtils.h>
+#include <CoreLib/Utils/HashUtils.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+
+namespace lux::import
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+/* the assets of a stage reference the assets of the previous ones (scenes create materials that reference images),
+ * so the stages are baked one after another, and the files of a stage are baked in parallel */
+enum class BakeStage : u8
+{
+    Shaders, Images, Scenes, MaxVal
+};
+
+std::optional<BakeStage> getBakeStage(const fs::path& path)
+{
+    std::optional<BakeStage> stage = std::nullopt;
+    BakersDispatcher dispatcher(path);
+    dispatcher.Dispatch({SHADER_ASSET_LOAD_EXTENSION}, [&](const fs::path&) {
+        stage = BakeStage::Shaders;
+    });
+    dispatcher.Dispatch(IMAGE_ASSET_RAW_EXTENSIONS, [&](const fs::path&) {
+        stage = BakeStage::Images;
+    });
+    dispatcher.Dispatch({SCENE_ASSET_RAW_EXTENSIONS}, [&](const fs::path&) {
+        stage = BakeStage::Scenes;
+    });
+
+    return stage;
+}
+
+/* the files are sorted, so that the job list is the same on every run */
+std::array<std::vector<fs::path>, (u32)BakeStage::MaxVal> collectBakeJobs(const fs::path& directory)
+{
+    std::array<std::vector<fs::path>, (u32)BakeStage::MaxVal> jobs;
+    for (const auto& file : fs::recursive_directory_iterator(directory))
+    {
+        if (file.is_directory())
+            continue;
+
+        if (const std::optional<BakeStage> stage = getBakeStage(file.path()); stage.has_value())
+            jobs[(u32)*stage].push_back(file.path());
+    }
+    for (auto& stageJobs : jobs)
+        std::ranges::sort(stageJobs);
+
+    return jobs;
+}
+
+bool shaderNeedsBaking(const std::shared_ptr<Context>& ctx, const DirectoryBakeSettings& settings,
+    const fs::path& path)
+{
+    auto shaderLoadInfoRead = assetlib::shader::readLoadInfo(path);
+    if (!shaderLoadInfoRead.has_value())
+        return false;
+
+    return std::ranges::any_of(shaderLoadInfoRead->Variants, [&](auto& variant) {
+        return ShaderImporter(ctx, {
+            .Variant = StringId::FromString(variant.Name),
+            .IncludePaths = {settings.ShaderIncludeDirectory.string()}}).NeedsBaking(path);
+    });
+}
+
+bool needsBaking(const std::shared_ptr<Context>& ctx, const DirectoryBakeSettings& settings, BakeStage stage,
+    const fs::path& path)
+{
+    switch (stage)
+    {
+    case BakeStage::Shaders:
+        return shaderNeedsBaking(ctx, settings, path);
+    case BakeStage::Images:
+        return ImageImporter(ctx, {}).NeedsBaking(path);
+    case BakeStage::Scenes:
+        return SceneImporter(ctx).NeedsBaking(path);
+    default:
+        return false;
+    }
+}
+
+bool bakeShader(const std::shared_ptr<Context>& ctx, const DirectoryBakeSettings& settings, const fs::path& path)
+{
+    auto shaderLoadInfoRead = assetlib::shader::readLoadInfo(path);
+    if (!shaderLoadInfoRead.has_value())
+        return false;
+    
+    bool baked = true;
+    for (auto& variant : shaderLoadInfoRead->Variants)
+    {
+        ShaderImportSettings shaderImportSettings{
+            .Variant = StringId::FromString(variant.Name),
+            .IncludePaths = {settings.ShaderIncludeDirectory.string()},
+        };
+        
+        ShaderImporter importer(ctx, shaderImportSettings);
+        if (!importer.NeedsBaking(path))
+            continue;
+        
+        auto imported = importer.Import(path);
+        if (!imported)
+        {
+            LUX_LOG_ERROR("Failed to import shader file: {} ({})", imported.error(), path.string());
+            baked = false;
+        }
+    }
+
+    return baked;
+}
+
+bool bakeImage(const std::shared_ptr<Context>& ctx, const fs::path& path)
+{
+    auto imported = ImageImporter(ctx, {}).Import(path);
+    if (!imported)
+        LUX_LOG_ERROR("Failed to import image file: {} ({})", imported.error(), path.string());
+
+    return imported.has_value();
+}
+
+bool bakeScene(const std::shared_ptr<Context>& ctx, const fs::path& path)
+{
+    auto imported = SceneImporter(ctx).Import(path);
+    if (!imported)
+        LUX_LOG_ERROR("Failed to import scene file: {} ({})", imported.error(), path.string());
+
+    return imported.has_value();
+}
+
+bool bake(const std::shared_ptr<Context>& ctx, const DirectoryBakeSettings& settings, BakeStage stage,
+    const fs::path& path)
+{
+    switch (stage)
+    {
+    case BakeStage::Shaders:
+        return bakeShader(ctx, settings, path);
+    case BakeStage::Images:
+        return bakeImage(ctx, path);
+    case BakeStage::Scenes:
+        return bakeScene(ctx, path);
+    default:
+        return false;
+    }
+}
+}
+
+void bakeDirectory(const std::shared_ptr<Context>& ctx, const DirectoryBakeSettings& settings)
+{
+    const u32 threadCount = settings.Jobs != 0 ?
+        settings.Jobs : std::max(std::thread::hardware_concurrency(), 1u);
+    /* the calling thread takes part in the bake, so there is one worker less than threads */
+    ThreadPool pool(threadCount - 1);
+    /* the importers and the compressors run their own parallel work on the global pool */
+    ThreadPool::ScopedGlobal scopedGlobal(pool);
+
+    /* only the files that need baking are counted, so the progress is not taken by the files that are up to date */
+    auto jobs = collectBakeJobs(ctx->InitialDirectory);
+    u32 jobCount = 0;
+    for (u32 stage = 0; stage < (u32)BakeStage::MaxVal; stage++)
+    {
+        auto& stageJobs = jobs[stage];
+        std::vector<u8> stageJobsNeeded(stageJobs.size());
+        pool.ParallelFor((u32)stageJobs.size(), 1, [&](u32, u32 begin, u32 end) {
+            for (u32 i = begin; i < end; i++)
+                stageJobsNeeded[i] = needsBaking(ctx, settings, (BakeStage)stage, stageJobs[i]);
+        });
+        std::vector<fs::path> neededJobs;
+        for (u32 i = 0; i < stageJobs.size(); i++)
+            if (stageJobsNeeded[i])
+                neededJobs.push_back(std::move(stageJobs[i]));
+        stageJobs = std::move(neededJobs);
+        jobCount += (u32)stageJobs.size();
+    }
+    LUX_LOG_INFO("Baking {} files with {} threads", jobCount, threadCount);
+
+    std::atomic<u32> jobsDone = 0;
+    for (u32 stage = 0; stage < (u32)BakeStage::MaxVal; stage++)
+    {
+        const auto& stageJobs = jobs[stage];
+        pool.ParallelFor((u32)stageJobs.size(), 1, [&](u32, u32 begin, u32 end) {
+            for (u32 i = begin; i < end; i++)
+            {
+                const bool baked = bake(ctx, settings, (BakeStage)stage, stageJobs[i]);
+                const u32 done = jobsDone.fetch_add(1) + 1;
+                if (baked)
+                    LUX_LOG_INFO("[{}/{}] Baked file: {}", done, jobCount, stageJobs[i].string());
+                else
+                    LUX_LOG_ERROR("[{}/{}] Failed to bake file: {}", done, jobCount, stageJobs[i].string());
+            }
+        });
+    }
+}
+
+u64 hashDirectory(const std::filesystem::path& directory)
+{
+    std::vector<fs::path> files;
+    for (const auto& file : fs::recursive_directory_iterator(directory))
+        if (!file.is_directory())
+            files.push_back(file.path());
+    std::ranges::sort(files);
+
+    u64 hash = Hash::FNV_OFFSET_BASIS;
+    for (const fs::path& file : files)
+    {
+        Hash::combine(hash, Hash::string(fs::relative(file, directory).generic_string()));
+        Hash::combine(hash, Hash::murmur3b32File(file).value_or(0));
+    }
+
+    return hash;
+}
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <CoreLib/types.h>
+
+#include <filesystem>
+#include <memory>
+
+namespace lux::import
+{
+struct Context;
+
+struct DirectoryBakeSettings
+{
+    /* 0 means all cores; the parallel work of the importers and the compressors is limited by it as well */
+    u32 Jobs{0};
+    std::filesystem::path ShaderIncludeDirectory{};
+};
+
+/* bakes the files of the initial directory of the context that are not baked yet;
+ * the baked files are the same for any job count */
+void bakeDirectory(const std::shared_ptr<Context>& ctx, const DirectoryBakeSettings& settings);
+/* combined hash of the contents and the relative paths of all files of the directory */
+u64 hashDirectory(const std::filesystem::path& directory);
+}
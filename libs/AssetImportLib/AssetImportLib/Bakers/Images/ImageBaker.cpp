@@ -35,7 +35,7 @@ IoResult<std::filesystem::path> ImageBaker::BakeToFile(assetlib::ImageMeta& meta
         for (u32 layer = 0; layer < baked->Header.Layers; layer++)
             binarySizeBytes += mip[layer];
     
-    auto packedImage = assetlib::image::pack(*baked, *m_Ctx->Compressor);
+    auto packedImage = assetlib::image::pack(*baked, *m_Ctx->Compressor, m_Ctx->HeaderEncoding);
     CHECK_RETURN_IO_ERROR_PROPAGATE(packedImage)
     
     IoResult<u64> saveResult = m_Ctx->Io->WriteHeader(meta.Metadata, packedImage->Header);
@@ -55,7 +55,8 @@ IoResult<std::filesystem::path> ImageBaker::BakeToFile(assetlib::ImageMeta& meta
         .IoMode = m_Ctx->Io->GetName(),
         .CompressionMode = m_Ctx->Compressor->GetName(),
         .IoGuid = m_Ctx->Io->GetGuid(),
-        .CompressionGuid = m_Ctx->Compressor->GetGuid()
+        .CompressionGuid = m_Ctx->Compressor->GetGuid(),
+        .CompressionVersion = m_Ctx->Compressor->GetVersion()
     };
     CHECK_RETURN_IO_ERROR_PROPAGATE(Importer::UpdatePackedMetadataSilent(
         metaPath, assetlib::image::packMeta(meta), "image"))
@@ -83,6 +84,9 @@ bool ImageBaker::NeedsBaking(const std::filesystem::path& metaPath) const
     if (lastBaked < fs::last_write_time(metaPath) || lastBaked < fs::last_write_time(rawPath))
         return true;
 
+    if (isCompressionOutdated(metaRead->Metadata, *m_Ctx))
+        return true;
+
     IoResult<assetlib::AssetCustomHeaderType> assetFileRead = m_Ctx->Io->ReadHeader(metaRead->Metadata);
     if (!assetFileRead.has_value())
         return true;
@@ -53,7 +53,7 @@ IoResult<std::filesystem::path> SceneBaker::BakeToFile(assetlib::SceneMeta& meta
     auto baked = Bake(meta);
     CHECK_RETURN_IO_ERROR_PROPAGATE(baked)
     
-    auto packedScene = assetlib::scene::pack(*baked);
+    auto packedScene = assetlib::scene::pack(*baked, m_Ctx->HeaderEncoding);
     CHECK_RETURN_IO_ERROR_PROPAGATE(packedScene)
     
     IoResult<u64> saveResult = m_Ctx->Io->WriteHeader(meta.Metadata, packedScene->Header);
@@ -67,7 +67,8 @@ IoResult<std::filesystem::path> SceneBaker::BakeToFile(assetlib::SceneMeta& meta
         .IoMode = m_Ctx->Io->GetName(),
         .CompressionMode = m_Ctx->Compressor->GetName(),
         .IoGuid = m_Ctx->Io->GetGuid(),
-        .CompressionGuid = m_Ctx->Compressor->GetGuid()
+        .CompressionGuid = m_Ctx->Compressor->GetGuid(),
+        .CompressionVersion = m_Ctx->Compressor->GetVersion()
     };
     CHECK_RETURN_IO_ERROR_PROPAGATE(Importer::UpdatePackedMetadataSilent(
         metaPath, assetlib::scene::packMeta(meta), "scene"))
@@ -95,6 +96,9 @@ bool SceneBaker::NeedsBaking(const std::filesystem::path& metaPath) const
     if (lastBaked < fs::last_write_time(metaPath) || lastBaked < fs::last_write_time(rawPath))
         return true;
 
+    if (isCompressionOutdated(metaRead->Metadata, *m_Ctx))
+        return true;
+
     const auto readHeader = assetlib::scene::readScene(metaRead->Metadata);
     if (!readHeader.has_value())
         return true;
@@ -556,7 +560,9 @@ void processLight(ProcessContext& ctx, tinygltf::Model&, tinygltf::Light& light)
         .Type = lightType,
         .Color = (glm::vec3)*(glm::dvec3*)light.color.data(),
         .Intensity = (f32)light.intensity,
-        .Range = light.range > 0 ? (f32)light.range : UNLIMITED_RANGE
+        .Range = light.range > 0 ? (f32)light.range : UNLIMITED_RANGE,
+        .InnerConeAngle = (f32)light.spot.innerConeAngle,
+        .OuterConeAngle = (f32)light.spot.outerConeAngle
     });
 }
 
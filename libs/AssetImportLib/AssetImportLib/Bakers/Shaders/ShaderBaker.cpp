@@ -53,16 +53,18 @@ u64 getShaderVariantDefinesHash(const assetlib::ShaderLoadInfo::Variant& variant
     return definesHash;
 }
 
+/* slang global sessions and sessions are not thread safe, so each thread that bakes shaders has its own ones,
+ * and the bakers on different threads compile at once */
 slang::IGlobalSession& getGlobalSession()
 {
-    static std::once_flag once = {};
-    static ::Slang::ComPtr<slang::IGlobalSession> globalSession;
-
-    std::call_once(once, []()
+    thread_local const ::Slang::ComPtr<slang::IGlobalSession> globalSession = []()
     {
-        const auto res = slang::createGlobalSession(globalSession.writeRef());
+        ::Slang::ComPtr<slang::IGlobalSession> session;
+        const auto res = slang::createGlobalSession(session.writeRef());
         ASSERT(!SLANG_FAILED(res), "Failed to create slang-api global session")
-    });
+
+        return session;
+    }();
 
     return *globalSession;
 }
@@ -70,8 +72,8 @@ slang::IGlobalSession& getGlobalSession()
 slang::ISession& getSession(const ShaderImportSettings& settings, const assetlib::ShaderLoadInfo::Variant& variant)
 {
     /* slang sessions must be unique for each #define list */
-    static std::unordered_map<u64, ::Slang::ComPtr<slang::ISession>> sessions;
-    static const SlangProfileID PROFILE_ID = getGlobalSession().findProfile("spirv_1_6");
+    thread_local std::unordered_map<u64, ::Slang::ComPtr<slang::ISession>> sessions;
+    thread_local const SlangProfileID PROFILE_ID = getGlobalSession().findProfile("spirv_1_6");
 
     u64 definesHash = getShaderVariantDefinesHash(variant, settings.DefinesHash);
     
@@ -1238,7 +1240,7 @@ IoResult<std::filesystem::path> ShaderBaker::BakeToFile(assetlib::ShaderMeta& me
     auto baked = Bake(meta, *shaderLoadRead);
     CHECK_RETURN_IO_ERROR_PROPAGATE(baked)
 
-    auto packedShader = assetlib::shader::pack(*baked, *m_Ctx->Compressor);
+    auto packedShader = assetlib::shader::pack(*baked, *m_Ctx->Compressor, m_Ctx->HeaderEncoding);
     CHECK_RETURN_IO_ERROR_PROPAGATE(packedShader)
     
     IoResult<u64> saveResult = m_Ctx->Io->WriteHeader(meta.Metadata, packedShader->Header);
@@ -1258,7 +1260,8 @@ IoResult<std::filesystem::path> ShaderBaker::BakeToFile(assetlib::ShaderMeta& me
         .IoMode = m_Ctx->Io->GetName(),
         .CompressionMode = m_Ctx->Compressor->GetName(),
         .IoGuid = m_Ctx->Io->GetGuid(),
-        .CompressionGuid = m_Ctx->Compressor->GetGuid()
+        .CompressionGuid = m_Ctx->Compressor->GetGuid(),
+        .CompressionVersion = m_Ctx->Compressor->GetVersion()
     };
     CHECK_RETURN_IO_ERROR_PROPAGATE(Importer::UpdatePackedMetadataSilent(
         metaPath, assetlib::shader::packMeta(meta), "shader"))
@@ -1286,6 +1289,9 @@ bool ShaderBaker::NeedsBaking(const std::filesystem::path& metaPath) const
     if (lastBaked < fs::last_write_time(metaPath) || lastBaked < fs::last_write_time(rawPath))
         return true;
 
+    if (isCompressionOutdated(metaRead->Metadata, *m_Ctx))
+        return true;
+
     const auto readHeader = assetlib::shader::readHeader(metaRead->Metadata);
     if (!readHeader.has_value())
         return true;
@@ -1330,7 +1336,7 @@ IoResult<assetlib::ShaderAsset> ShaderBaker::Bake(const assetlib::ShaderMeta& me
     
     auto variant = findShaderVariant(loadInfo, m_Settings->Variant);
     ASSERT(variant.has_value())
-     slang::ISession& session = getSession(*m_Settings, *variant);
+    slang::ISession& session = getSession(*m_Settings, *variant);
     
     ::Slang::ComPtr<slang::IBlob> diagnosticsBlob;
     std::vector<slang::IModule*> shaderModules;
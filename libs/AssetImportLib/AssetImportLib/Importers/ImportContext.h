@@ -22,5 +22,7 @@ struct Context
     std::filesystem::path BakedDirectory{};
     assetlib::io::AssetIoInterface* Io{nullptr};
     assetlib::io::AssetCompressor* Compressor{nullptr};
+    /* json headers are slower to read, but are useful for debugging */
+    assetlib::io::AssetHeaderEncoding HeaderEncoding{assetlib::io::AssetHeaderEncoding::Binary};
 };
 }
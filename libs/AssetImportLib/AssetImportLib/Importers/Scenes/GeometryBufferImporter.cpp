@@ -54,7 +54,7 @@ ImportResult<assetlib::AssetId> GeometryBufferImporter::Export(const assetlib::G
     auto metadataRead = assetlib::sceneGeometry::readMeta(*metadataPath);
     CHECK_RETURN_IMPORT_ERROR_PROPAGATE(metadataRead)
     
-    auto packedGeometry = assetlib::sceneGeometry::pack(asset, *m_Ctx->Compressor);
+    auto packedGeometry = assetlib::sceneGeometry::pack(asset, *m_Ctx->Compressor, m_Ctx->HeaderEncoding);
     CHECK_RETURN_IMPORT_ERROR_PROPAGATE(packedGeometry)
     
     IoResult<u64> saveResult = m_Ctx->Io->WriteHeader(metadataRead->Metadata, packedGeometry->Header);
@@ -72,7 +72,7 @@ ImportResult<assetlib::AssetId> GeometryBufferImporter::Export(const assetlib::G
     metadataRead->Metadata.Io.CompressionMode = m_Ctx->Compressor->GetName();
     metadataRead->Metadata.Io.IoGuid = m_Ctx->Io->GetGuid();
     metadataRead->Metadata.Io.CompressionGuid = m_Ctx->Compressor->GetGuid();
-    metadataRead->Metadata.Io.CompressionGuid = m_Ctx->Compressor->GetGuid();
+    metadataRead->Metadata.Io.CompressionVersion = m_Ctx->Compressor->GetVersion();
     metadataRead->SourceHash = m_MetadataHint.SourceHash;
     metadataRead->SourceUri = m_MetadataHint.SourceUri;
     CHECK_RETURN_IMPORT_ERROR_PROPAGATE(Importer::UpdatePackedMetadataSilent(
@@ -86,6 +86,9 @@ bool GeometryBufferImporter::NeedsBaking(const std::filesystem::path& path) cons
     auto metaRead = assetlib::sceneGeometry::readMeta(GetMetaPath(path));
     if (!metaRead.has_value())
         return true;
+
+    if (isCompressionOutdated(metaRead->Metadata, *m_Ctx))
+        return true;
     
     return metaRead->SourceHash != SceneImporter::CalculateGeometryBufferHash(path, metaRead->SourceUri);
 }
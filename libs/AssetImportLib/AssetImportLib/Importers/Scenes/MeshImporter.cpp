@@ -34,7 +34,7 @@ ImportResult<assetlib::AssetId> MeshImporter::Export(const assetlib::MeshAsset&
     auto metadataRead = assetlib::sceneMesh::readMeta(*metadataPath);
     CHECK_RETURN_IMPORT_ERROR_PROPAGATE(metadataRead)
     
-    auto packedMesh = assetlib::sceneMesh::pack(asset);
+    auto packedMesh = assetlib::sceneMesh::pack(asset, m_Ctx->HeaderEncoding);
     CHECK_RETURN_IMPORT_ERROR_PROPAGATE(packedMesh)
     
     IoResult<u64> saveResult = m_Ctx->Io->WriteHeader(metadataRead->Metadata, packedMesh->Header);
@@ -34,6 +34,7 @@ struct AssetIoMetadata
     std::string CompressionMode{};
     Guid IoGuid{};
     Guid CompressionGuid{};
+    u32 CompressionVersion{1};
 };
 
 struct AssetMetadata
@@ -37,21 +37,23 @@ io::IoResult<std::vector<std::byte>> readImageData(const ImageHeader& header, co
         dataOffset += metadata.Io.BinarySizeBytesChunksCompressed[i];
     const u64 dataSize = metadata.Io.BinarySizeBytesChunksCompressed[imageDataCompressedSizeIndex];
     
-    std::vector<std::byte> imageData(dataSize);
-    auto result = io.ReadBinaryChunk(metadata, imageData.data(), dataOffset, imageData.size());
+    auto result = io.MapBinaryChunk(metadata, dataOffset, dataSize);
     ASSETLIB_CHECK_RETURN_IO_ERROR(result.has_value(), io::IoError::ErrorCode::FailedToLoad,
         "Assetlib: Failed to read: {} ({})", result.error(), metadata.Io.BinaryFile.string())
 
-    imageData = compressor.Decompress(imageData, header.MipmapSizes[mipmap][layer]);
+    const u64 sizeBytes = header.MipmapSizes[mipmap][layer];
+    auto data = compressor.Decompress(result->Data, sizeBytes);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(data.size() == sizeBytes, io::IoError::ErrorCode::WrongFormat,
+        "Assetlib: Failed to decompress mipmap {} layer {}: {}", mipmap, layer, metadata.Io.BinaryFile.string())
 
-    return imageData;
+    return data;
 }
 
-io::IoResult<AssetPacked> pack(const ImageAsset& image, io::AssetCompressor& compressor)
+io::IoResult<AssetPacked> pack(const ImageAsset& image, io::AssetCompressor& compressor,
+    io::AssetHeaderEncoding headerEncoding)
 {
-    auto header = glz::write_json(image.Header);
-    ASSETLIB_CHECK_RETURN_IO_ERROR(header.has_value(), io::IoError::ErrorCode::GeneralError,
-        "Assetlib: Failed to pack: {}", glz::format_error(header.error()))
+    auto header = io::packHeader(image.Header, headerEncoding);
+    ASSETLIB_CHECK_RETURN_IO_ERROR_PROPAGATE(header)
 
     std::vector<u64> packedImageDataBinarySizeBytesChunks((u64)image.Header.Mipmaps * image.Header.Layers);
     std::vector<std::byte> imageData;
@@ -45,6 +45,7 @@ io::IoResult<ImageHeader> readHeader(const AssetMetadata& metadata);
 io::IoResult<std::vector<std::byte>> readImageData(const ImageHeader& header, const AssetMetadata& metadata,
     u32 mipmap, u32 layer, io::AssetIoInterface& io, io::AssetCompressor& compressor);
 
-io::IoResult<AssetPacked> pack(const ImageAsset& image, io::AssetCompressor& compressor);
+io::IoResult<AssetPacked> pack(const ImageAsset& image, io::AssetCompressor& compressor,
+    io::AssetHeaderEncoding headerEncoding = io::AssetHeaderEncoding::Binary);
 }
 }
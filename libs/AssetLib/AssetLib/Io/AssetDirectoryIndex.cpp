@@ -0,0 +1,192 @@
+﻿#include "AssetDirectoryIndex.h"
+
+#include <AssetLib/Reflection/AssetlibReflectionUtility.inl>
+#include <CoreLib/Jobs/ThreadPool.h>
+#include <CoreLib/Utils/FileUtils.h>
+
+#include <cstring>
+
+template <> struct ::glz::meta<lux::assetlib::io::AssetDirectoryIndexEntry> : lux::assetlib::reflection::CamelCase {};
+template <> struct ::glz::meta<lux::assetlib::io::AssetDirectoryIndex> : lux::assetlib::reflection::CamelCase {};
+
+namespace fs = std::filesystem;
+
+namespace lux::assetlib::io
+{
+namespace
+{
+constexpr u32 PARSE_CHUNK_SIZE = 16;
+constexpr u64 INDEX_PREFIX_SIZE = ASSET_DIRECTORY_INDEX_MAGIC.size() + sizeof ASSET_DIRECTORY_INDEX_VERSION;
+
+struct MetadataFile
+{
+    std::string Path{};
+    u64 SizeBytes{};
+    i64 LastWriteTime{};
+};
+
+std::optional<MetadataFile> toMetadataFile(const fs::directory_entry& file)
+{
+    std::error_code error;
+    if (file.is_directory(error) || !isMetadataPath(file.path()))
+        return std::nullopt;
+
+    MetadataFile metadataFile = {};
+    metadataFile.SizeBytes = file.file_size(error);
+    if (error)
+        return std::nullopt;
+    metadataFile.LastWriteTime = file.last_write_time(error).time_since_epoch().count();
+    if (error)
+        return std::nullopt;
+    metadataFile.Path = fs::weakly_canonical(file.path(), error).generic_string();
+    if (error)
+        return std::nullopt;
+
+    return metadataFile;
+}
+
+void findMetadataFiles(const fs::path& directory, std::vector<MetadataFile>& files)
+{
+    std::error_code error;
+    for (auto it = fs::recursive_directory_iterator(directory, error);
+        !error && it != fs::recursive_directory_iterator(); it.increment(error))
+        if (auto file = toMetadataFile(*it); file.has_value())
+            files.push_back(std::move(*file));
+}
+
+/* every subdirectory is walked by a separate task, on every level, so that the work is split
+ * no matter how deep the metadata files are nested */
+void findMetadataFilesParallel(const fs::path& directory, std::vector<MetadataFile>& files)
+{
+    std::vector<fs::path> subdirectories;
+    std::error_code error;
+    for (auto it = fs::directory_iterator(directory, error);
+        !error && it != fs::directory_iterator(); it.increment(error))
+    {
+        /* the recursive walk does not follow directory symlinks either */
+        if (it->is_symlink(error) && it->is_directory(error))
+            continue;
+        if (it->is_directory(error))
+            subdirectories.push_back(it->path());
+        else if (auto file = toMetadataFile(*it); file.has_value())
+            files.push_back(std::move(*file));
+    }
+
+    std::vector<std::vector<MetadataFile>> subdirectoryFiles(subdirectories.size());
+    ThreadPool::Global().ParallelFor((u32)subdirectories.size(), 1, [&](u32, u32 begin, u32 end)
+    {
+        for (u32 i = begin; i < end; i++)
+            findMetadataFilesParallel(subdirectories[i], subdirectoryFiles[i]);
+    });
+    for (auto& subdirectory : subdirectoryFiles)
+        files.insert(files.end(), std::make_move_iterator(subdirectory.begin()),
+            std::make_move_iterator(subdirectory.end()));
+}
+}
+
+AssetDirectoryIndex scanAssetDirectory(const std::filesystem::path& directory, const AssetDirectoryIndex* previous,
+    AssetDirectoryScanMode mode, AssetDirectoryScanStats* stats)
+{
+    std::vector<MetadataFile> files;
+    if (mode == AssetDirectoryScanMode::Serial)
+        findMetadataFiles(directory, files);
+    else
+        findMetadataFilesParallel(directory, files);
+
+    std::unordered_map<std::string_view, const AssetDirectoryIndexEntry*> previousEntries;
+    if (previous != nullptr)
+    {
+        previousEntries.reserve(previous->Entries.size());
+        for (auto& entry : previous->Entries)
+            previousEntries.emplace(entry.MetadataPath, &entry);
+    }
+
+    std::vector<std::optional<AssetDirectoryIndexEntry>> entries(files.size());
+    std::atomic<u32> parsedCount = 0;
+    std::atomic<u32> reusedCount = 0;
+    const auto scanFiles = [&](u32, u32 begin, u32 end)
+    {
+        for (u32 i = begin; i < end; i++)
+        {
+            MetadataFile& file = files[i];
+            if (auto it = previousEntries.find(file.Path); it != previousEntries.end() &&
+                it->second->SizeBytes == file.SizeBytes && it->second->LastWriteTime == file.LastWriteTime)
+            {
+                entries[i] = *it->second;
+                reusedCount.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            parsedCount.fetch_add(1, std::memory_order_relaxed);
+            auto metadata = readBaseAssetMetadata(file.Path);
+            if (!metadata.has_value())
+                continue;
+
+            entries[i] = AssetDirectoryIndexEntry{
+                .MetadataPath = std::move(file.Path),
+                .SizeBytes = file.SizeBytes,
+                .LastWriteTime = file.LastWriteTime,
+                .Metadata = std::move(*metadata)
+            };
+        }
+    };
+    if (mode == AssetDirectoryScanMode::Serial)
+        scanFiles(0, 0, (u32)files.size());
+    else
+        ThreadPool::Global().ParallelFor((u32)files.size(), PARSE_CHUNK_SIZE, scanFiles);
+
+    AssetDirectoryIndex index = {};
+    index.Entries.reserve(entries.size());
+    for (auto& entry : entries)
+        if (entry.has_value())
+            index.Entries.push_back(std::move(*entry));
+    std::ranges::sort(index.Entries, {}, &AssetDirectoryIndexEntry::MetadataPath);
+
+    if (stats != nullptr)
+        *stats = {.ParsedCount = parsedCount.load(), .ReusedCount = reusedCount.load()};
+
+    return index;
+}
+
+IoResult<AssetDirectoryIndex> readAssetDirectoryIndex(const std::filesystem::path& path)
+{
+    auto read = readFileToString(path);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(read.has_value(), IoError::ErrorCode::FailedToOpen,
+        "Assetlib: Failed to open asset directory index: {}", path.string())
+    ASSETLIB_CHECK_RETURN_IO_ERROR(read->size() >= INDEX_PREFIX_SIZE && read->starts_with(ASSET_DIRECTORY_INDEX_MAGIC),
+        IoError::ErrorCode::WrongFormat, "Assetlib: Asset directory index has unexpected format: {}", path.string())
+
+    u32 version = 0;
+    std::memcpy(&version, read->data() + ASSET_DIRECTORY_INDEX_MAGIC.size(), sizeof version);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(version == ASSET_DIRECTORY_INDEX_VERSION, IoError::ErrorCode::WrongFormat,
+        "Assetlib: Asset directory index has unexpected version. Expected {}, got {}",
+        ASSET_DIRECTORY_INDEX_VERSION, version)
+
+    auto beve = glz::read_beve<AssetDirectoryIndex>(std::string_view(*read).substr(INDEX_PREFIX_SIZE));
+    ASSETLIB_CHECK_RETURN_IO_ERROR(beve.has_value(), IoError::ErrorCode::GeneralError,
+        "Assetlib: Failed to read asset directory index: {}", glz::format_error(beve.error()))
+
+    return std::move(*beve);
+}
+
+IoResult<void> writeAssetDirectoryIndex(const std::filesystem::path& path, const AssetDirectoryIndex& index)
+{
+    auto beve = glz::write_beve(index);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(beve.has_value(), IoError::ErrorCode::GeneralError,
+        "Assetlib: Failed to pack asset directory index: {}", glz::format_error(beve.error()))
+
+    std::string packed;
+    packed.reserve(INDEX_PREFIX_SIZE + beve->size());
+    packed.append(ASSET_DIRECTORY_INDEX_MAGIC);
+    packed.append((const char*)&ASSET_DIRECTORY_INDEX_VERSION, sizeof ASSET_DIRECTORY_INDEX_VERSION);
+    packed.append(*beve);
+
+    std::error_code error;
+    fs::create_directories(path.parent_path(), error);
+    const auto written = writeStringToFile(path, packed);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(written.has_value(), IoError::ErrorCode::FailedToCreate,
+        "Assetlib: Failed to write asset directory index: {}", path.string())
+
+    return {};
+}
+}
@@ -0,0 +1,42 @@
+﻿#pragma once
+
+#include <AssetLib/Io/AssetIo.h>
+
+namespace lux::assetlib::io
+{
+/* metadata file found by the scan of an assets directory, with the size and the write time it was parsed at */
+struct AssetDirectoryIndexEntry
+{
+    std::string MetadataPath{};
+    u64 SizeBytes{};
+    i64 LastWriteTime{};
+    AssetMetadata Metadata{};
+};
+
+/* the scan result is kept between runs, so that the metadata files that did not change are not parsed again */
+struct AssetDirectoryIndex
+{
+    std::vector<AssetDirectoryIndexEntry> Entries{};
+};
+
+enum class AssetDirectoryScanMode : u8
+{
+    Serial, Parallel
+};
+
+struct AssetDirectoryScanStats
+{
+    u32 ParsedCount{0};
+    u32 ReusedCount{0};
+};
+
+/* entries are sorted by metadata path, which is weakly canonical and generic.
+ * Entries of `previous` are reused for the metadata files that have the same size and write time */
+AssetDirectoryIndex scanAssetDirectory(const std::filesystem::path& directory, const AssetDirectoryIndex* previous,
+    AssetDirectoryScanMode mode, AssetDirectoryScanStats* stats = nullptr);
+
+static constexpr std::string_view ASSET_DIRECTORY_INDEX_MAGIC = "LUXINDEX";
+static constexpr u32 ASSET_DIRECTORY_INDEX_VERSION = 1;
+IoResult<AssetDirectoryIndex> readAssetDirectoryIndex(const std::filesystem::path& path);
+IoResult<void> writeAssetDirectoryIndex(const std::filesystem::path& path, const AssetDirectoryIndex& index);
+}
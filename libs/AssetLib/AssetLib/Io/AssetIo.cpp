@@ -30,8 +30,16 @@ IoResult<AssetMetadata> readBaseAssetMetadata(const std::filesystem::path& path)
     return assetMetadata.Metadata;
 }
 
+AssetHeaderEncoding getAssetHeaderEncoding(std::string_view header)
+{
+    return header.starts_with(ASSET_BINARY_HEADER_MAGIC) ? AssetHeaderEncoding::Binary : AssetHeaderEncoding::Json;
+}
+
 std::string getAssetHeaderFormatted(std::string_view header)
 {
+    if (getAssetHeaderEncoding(header) == AssetHeaderEncoding::Binary)
+        return std::string{header};
+    
     return glz::prettify_json(header);
 }
 }
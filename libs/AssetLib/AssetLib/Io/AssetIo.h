@@ -25,7 +25,20 @@ struct IoError
 template <typename T>
 using IoResult = Result<T, IoError>;
 
+/* the binary headers are read without text parsing, json stays for debugging and for the handwritten assets */
+enum class AssetHeaderEncoding : u8
+{
+    Json, Binary
+};
+/* binary headers start with the magic and the version, followed by glaze beve */
+static constexpr std::string_view ASSET_BINARY_HEADER_MAGIC = "LUXBHEAD";
+static constexpr u32 ASSET_BINARY_HEADER_VERSION = 1;
+static constexpr u64 ASSET_BINARY_HEADER_PREFIX_SIZE =
+    ASSET_BINARY_HEADER_MAGIC.size() + sizeof ASSET_BINARY_HEADER_VERSION;
+AssetHeaderEncoding getAssetHeaderEncoding(std::string_view header);
+
 IoResult<AssetMetadata> readBaseAssetMetadata(const std::filesystem::path& path);
+/* prettifies json headers, binary headers are returned as is */
 std::string getAssetHeaderFormatted(std::string_view header);
 }
 
@@ -1,9 +1,12 @@
 ﻿#pragma once
 
+#include <AssetLib/Assetlib.h>
 #include <CoreLib/Containers/Span.h>
 #include <CoreLib/Containers/Guid.h>
 
+#include <cstring>
 #include <string>
+#include <vector>
 
 namespace lux::assetlib::io
 {
@@ -12,11 +15,37 @@ class AssetCompressor
 public:
     virtual ~AssetCompressor() = default;
     virtual std::vector<std::byte> Compress(Span<const std::byte> data) = 0;
+    /* lets the compressor tune itself for the assets of `type` (e.g. by a dictionary) */
+    virtual std::vector<std::byte> CompressForType(Span<const std::byte> data, const AssetTypeMetadata& type)
+    {
+        return Compress(data);
+    }
     virtual std::vector<std::byte> Decompress(Span<const std::byte> data, u64 decompressedSize) = 0;
+    /* decompresses `destination.size()` bytes starting at `offsetBytes` of the decompressed data,
+     * returns false if the data is corrupt or the range is out of its bounds */
+    virtual bool DecompressRange(Span<const std::byte> data, u64 decompressedSize, u64 offsetBytes,
+        Span<std::byte> destination);
+    /* true if `DecompressRange` does not decompress the whole data, so it is cheap to call for small ranges */
+    virtual bool SupportsRangeDecompression() const { return false; }
+
+    /* version of the compressed data layout, recorded in the asset metadata, the assets
+     * compressed with another version have to be rebaked */
+    virtual u32 GetVersion() const { return 1; }
 
     virtual const std::string& GetName() const = 0;
     virtual const Guid& GetGuid() const = 0;
 };
+
+inline bool AssetCompressor::DecompressRange(Span<const std::byte> data, u64 decompressedSize, u64 offsetBytes,
+    Span<std::byte> destination)
+{
+    const std::vector<std::byte> unpacked = Decompress(data, decompressedSize);
+    if (unpacked.size() != decompressedSize || offsetBytes + destination.size() > decompressedSize)
+        return false;
+    std::memcpy(destination.data(), unpacked.data() + offsetBytes, destination.size());
+
+    return true;
+}
 }
 
 #define DEFINE_ASSET_COMPRESSOR_NAME(_x, _guid) \
@@ -1,16 +1,96 @@
 ﻿#include "Lz4AssetCompressor.h"
 
+#include <CoreLib/Jobs/ThreadPool.h>
+
 #include <lz4.h>
 
+#include <atomic>
+#include <cstring>
+#include <optional>
+
 namespace lux::assetlib::io
 {
+namespace
+{
+constexpr u32 LZ4_BLOCKS_MAGIC = 0x4b4c424c; /* 'LBLK' */
+struct Lz4BlocksHeader
+{
+    u32 Magic{LZ4_BLOCKS_MAGIC};
+    u32 Version{Lz4AssetCompressor::VERSION};
+    u32 BlockSizeBytes{0};
+    u32 BlockCount{0};
+};
+
+struct Lz4Blocks
+{
+    u32 BlockSizeBytes{0};
+    /* offsets of the compressed blocks in the chunk, with the end of the last block at the back */
+    std::vector<u64> Offsets{};
+};
+
+u32 blockCount(u64 sizeBytes, u32 blockSizeBytes)
+{
+    return (u32)((sizeBytes + blockSizeBytes - 1) / blockSizeBytes);
+}
+
+/* the table has to agree with both the decompressed and the compressed sizes,
+ * so a version 1 chunk is never mistaken for a block table */
+std::optional<Lz4Blocks> readBlocks(Span<const std::byte> data, u64 decompressedSize)
+{
+    Lz4BlocksHeader header = {};
+    if (data.size() < sizeof header)
+        return std::nullopt;
+    std::memcpy(&header, data.data(), sizeof header);
+    if (header.Magic != LZ4_BLOCKS_MAGIC || header.Version != Lz4AssetCompressor::VERSION || header.BlockSizeBytes == 0 ||
+        header.BlockCount != blockCount(decompressedSize, header.BlockSizeBytes))
+        return std::nullopt;
+
+    const u64 tableSizeBytes = (u64)header.BlockCount * sizeof(u32);
+    if (data.size() < sizeof header + tableSizeBytes)
+        return std::nullopt;
+
+    Lz4Blocks blocks = {.BlockSizeBytes = header.BlockSizeBytes};
+    blocks.Offsets.resize(header.BlockCount + 1);
+    blocks.Offsets[0] = sizeof header + tableSizeBytes;
+    for (u32 i = 0; i < header.BlockCount; i++)
+    {
+        u32 blockSizeCompressed = 0;
+        std::memcpy(&blockSizeCompressed, data.data() + sizeof header + i * sizeof(u32), sizeof(u32));
+        blocks.Offsets[i + 1] = blocks.Offsets[i] + blockSizeCompressed;
+    }
+    if (blocks.Offsets.back() != data.size())
+        return std::nullopt;
+
+    return blocks;
+}
+}
+
 std::vector<std::byte> Lz4AssetCompressor::Compress(Span<const std::byte> data)
 {
-    const u32 compressedSizeBound = LZ4_compressBound((i32)data.size());
-    std::vector<std::byte> compressed(compressedSizeBound);
-    const u32 compressedSize = LZ4_compress_default((const char*)data.data(), (char*)compressed.data(),
-        (i32)data.size(), (i32)compressedSizeBound);
-    compressed.resize(compressedSize);
+    const Lz4BlocksHeader header = {
+        .BlockSizeBytes = BLOCK_SIZE_BYTES,
+        .BlockCount = blockCount(data.size(), BLOCK_SIZE_BYTES)};
+    const u32 blockSizeBound = LZ4_compressBound((i32)BLOCK_SIZE_BYTES);
+
+    /* every block is compressed to its own slot first, and the slots are packed together after */
+    std::vector<std::byte> slots((u64)header.BlockCount * blockSizeBound);
+    std::vector<u32> blockSizesCompressed(header.BlockCount);
+    ThreadPool::Global().ParallelFor(header.BlockCount, 1, [&](u32 block, u32, u32) {
+        const u64 offset = (u64)block * BLOCK_SIZE_BYTES;
+        const u32 size = (u32)std::min<u64>(BLOCK_SIZE_BYTES, data.size() - offset);
+        blockSizesCompressed[block] = (u32)LZ4_compress_default((const char*)data.data() + offset,
+            (char*)slots.data() + (u64)block * blockSizeBound, (i32)size, (i32)blockSizeBound);
+    });
+
+    const u64 tableSizeBytes = blockSizesCompressed.size() * sizeof(u32);
+    std::vector<std::byte> compressed(sizeof header + tableSizeBytes);
+    std::memcpy(compressed.data(), &header, sizeof header);
+    std::memcpy(compressed.data() + sizeof header, blockSizesCompressed.data(), tableSizeBytes);
+    for (u32 block = 0; block < header.BlockCount; block++)
+    {
+        const std::byte* slot = slots.data() + (u64)block * blockSizeBound;
+        compressed.insert(compressed.end(), slot, slot + blockSizesCompressed[block]);
+    }
 
     return compressed;
 }
@@ -18,9 +98,71 @@ std::vector<std::byte> Lz4AssetCompressor::Compress(Span<const std::byte> data)
 std::vector<std::byte> Lz4AssetCompressor::Decompress(Span<const std::byte> data, u64 decompressedSize)
 {
     std::vector<std::byte> unpacked(decompressedSize);
-    LZ4_decompress_safe((const char*)data.data(), (char*)unpacked.data(), (i32)data.size(), (i32)decompressedSize);
+    if (!DecompressRange(data, decompressedSize, 0, unpacked))
+        return {};
 
     return unpacked;
 }
-}
 
+bool Lz4AssetCompressor::DecompressRange(Span<const std::byte> data, u64 decompressedSize, u64 offsetBytes,
+    Span<std::byte> destination)
+{
+    if (offsetBytes + destination.size() > decompressedSize)
+        return false;
+    if (destination.empty())
+        return true;
+
+    const std::optional<Lz4Blocks> blocks = readBlocks(data, decompressedSize);
+    if (!blocks.has_value())
+    {
+        const bool isWhole = destination.size() == decompressedSize;
+        std::vector<std::byte> unpacked(isWhole ? 0 : decompressedSize);
+        char* target = isWhole ? (char*)destination.data() : (char*)unpacked.data();
+        const i32 unpackedSize = LZ4_decompress_safe((const char*)data.data(), target, (i32)data.size(),
+            (i32)decompressedSize);
+        if (unpackedSize != (i32)decompressedSize)
+            return false;
+        if (!isWhole)
+            std::memcpy(destination.data(), unpacked.data() + offsetBytes, destination.size());
+
+        return true;
+    }
+
+    /* only the blocks that overlap the range are decompressed; the blocks that are inside of it
+     * are decompressed in place, and the ones on its edges go through a temporary block */
+    const u64 rangeEnd = offsetBytes + destination.size();
+    const u32 firstBlock = (u32)(offsetBytes / blocks->BlockSizeBytes);
+    const u32 lastBlock = (u32)((rangeEnd - 1) / blocks->BlockSizeBytes);
+    std::atomic_bool isCorrupt = false;
+    ThreadPool::Global().ParallelFor(lastBlock - firstBlock + 1, 1, [&](u32 index, u32, u32) {
+        const u32 block = firstBlock + index;
+        const u64 blockOffset = (u64)block * blocks->BlockSizeBytes;
+        const u32 blockSize = (u32)std::min<u64>(blocks->BlockSizeBytes, decompressedSize - blockOffset);
+        const char* source = (const char*)data.data() + blocks->Offsets[block];
+        const i32 sourceSize = (i32)(blocks->Offsets[block + 1] - blocks->Offsets[block]);
+
+        if (blockOffset >= offsetBytes && blockOffset + blockSize <= rangeEnd)
+        {
+            const i32 unpackedSize = LZ4_decompress_safe(source,
+                (char*)destination.data() + (blockOffset - offsetBytes), sourceSize, (i32)blockSize);
+            if (unpackedSize != (i32)blockSize)
+                isCorrupt.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        std::vector<std::byte> unpacked(blockSize);
+        const i32 unpackedSize = LZ4_decompress_safe(source, (char*)unpacked.data(), sourceSize, (i32)blockSize);
+        if (unpackedSize != (i32)blockSize)
+        {
+            isCorrupt.store(true, std::memory_order_relaxed);
+            return;
+        }
+        const u64 copyBegin = std::max(blockOffset, offsetBytes);
+        const u64 copyEnd = std::min(blockOffset + blockSize, rangeEnd);
+        std::memcpy(destination.data() + (copyBegin - offsetBytes), unpacked.data() + (copyBegin - blockOffset),
+            copyEnd - copyBegin);
+    });
+
+    return !isCorrupt.load(std::memory_order_relaxed);
+}
+}
@@ -3,11 +3,23 @@
 
 namespace lux::assetlib::io
 {
+/* the data is split into independent blocks of `BLOCK_SIZE_BYTES`, that are compressed and decompressed in parallel,
+ * the chunk starts with a small header and a table of compressed block sizes:
+ * | magic | version | block size | block count | compressed size of each block | blocks |
+ * the chunks without the header are single lz4 blocks of version 1 */
 class Lz4AssetCompressor final : public AssetCompressor
 {
 public:
+    static constexpr u32 BLOCK_SIZE_BYTES = 256u * 1024;
+    static constexpr u32 VERSION = 2;
+
     std::vector<std::byte> Compress(Span<const std::byte> data) override;
     std::vector<std::byte> Decompress(Span<const std::byte> data, u64 decompressedSize) override;
+    bool DecompressRange(Span<const std::byte> data, u64 decompressedSize, u64 offsetBytes,
+        Span<std::byte> destination) override;
+    bool SupportsRangeDecompression() const override { return true; }
+
+    u32 GetVersion() const override { return VERSION; }
 
     DEFINE_ASSET_COMPRESSOR_NAME("Lz4", "1dc6c11f-8401-4d3a-9f04-0bfff98d0e6f"_guid)
 };
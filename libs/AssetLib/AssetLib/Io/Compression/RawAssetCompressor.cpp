@@ -1,5 +1,7 @@
 ﻿#include "RawAssetCompressor.h"
 
+#include <cstring>
+
 namespace lux::assetlib::io
 {
 std::vector<std::byte> RawAssetCompressor::Compress(Span<const std::byte> data)
@@ -11,4 +13,14 @@ std::vector<std::byte> RawAssetCompressor::Decompress(Span<const std::byte> data
 {
     return {data.begin(), data.end()};
 }
+
+bool RawAssetCompressor::DecompressRange(Span<const std::byte> data, u64 decompressedSize, u64 offsetBytes,
+    Span<std::byte> destination)
+{
+    if (data.size() != decompressedSize || offsetBytes + destination.size() > decompressedSize)
+        return false;
+    std::memcpy(destination.data(), data.data() + offsetBytes, destination.size());
+
+    return true;
+}
 }
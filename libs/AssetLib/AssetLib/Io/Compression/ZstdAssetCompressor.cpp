@@ -0,0 +1,246 @@
+﻿#include "ZstdAssetCompressor.h"
+
+#include <CoreLib/Utils/FileUtils.h>
+#include <CoreLib/Utils/HashUtils.h>
+
+#include <zstd.h>
+#include <zdict.h>
+
+#include <algorithm>
+#include <fstream>
+#include <ranges>
+
+namespace lux::assetlib::io
+{
+namespace
+{
+/* dictionaries only pay off for small data */
+constexpr u64 MAX_SAMPLE_SIZE_BYTES = 128llu * 1024;
+
+std::filesystem::path dictionaryPath(const std::filesystem::path& directory, std::string_view name)
+{
+    std::filesystem::path path = directory / name;
+    path += ZstdAssetCompressor::DICTIONARY_EXTENSION;
+
+    return path;
+}
+
+/* the previous dictionaries of a type are named `<type>-<dictionary id>` */
+bool isPreviousDictionary(const std::string& name, u32 dictionaryId)
+{
+    const std::string suffix = std::format("-{}", dictionaryId);
+
+    return name.size() > suffix.size() && name.ends_with(suffix);
+}
+
+IoResult<void> writeDictionary(const std::filesystem::path& path, Span<const std::byte> dictionary)
+{
+    std::ofstream out(path, std::ios::binary);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(out.good(), IoError::ErrorCode::FailedToCreate,
+        "Assetlib: Failed to create dictionary: {}", path.string())
+    out.write((const char*)dictionary.data(), (isize)dictionary.size());
+
+    return {};
+}
+}
+
+ZstdAssetCompressor::ZstdAssetCompressor() : ZstdAssetCompressor(CreateInfo{})
+{
+}
+
+ZstdAssetCompressor::ZstdAssetCompressor(const CreateInfo& createInfo)
+    : m_Level(std::clamp(createInfo.Level, ZSTD_minCLevel(), ZSTD_maxCLevel())),
+    m_CollectSamples(createInfo.CollectSamples), m_MaxSamplesSizeBytes(createInfo.MaxSamplesSizeBytes)
+{
+}
+
+ZstdAssetCompressor::~ZstdAssetCompressor()
+{
+    for (auto* dictionary : m_CompressionDictionaries | std::views::values)
+        ZSTD_freeCDict(dictionary);
+    for (auto* dictionary : m_DecompressionDictionaries | std::views::values)
+        ZSTD_freeDDict(dictionary);
+}
+
+std::vector<std::byte> ZstdAssetCompressor::Compress(Span<const std::byte> data)
+{
+    std::vector<std::byte> compressed(ZSTD_compressBound(data.size()));
+    const u64 compressedSize = ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(),
+        m_Level);
+    compressed.resize(ZSTD_isError(compressedSize) ? 0 : compressedSize);
+
+    return compressed;
+}
+
+std::vector<std::byte> ZstdAssetCompressor::CompressForType(Span<const std::byte> data,
+    const AssetTypeMetadata& type)
+{
+    if (m_CollectSamples)
+        CollectSample(type.Name, data);
+
+    const auto it = m_CompressionDictionaries.find(type.Name);
+    if (it == m_CompressionDictionaries.end())
+        return Compress(data);
+
+    ZSTD_CCtx* context = ZSTD_createCCtx();
+    std::vector<std::byte> compressed(ZSTD_compressBound(data.size()));
+    const u64 compressedSize = ZSTD_compress_usingCDict(context, compressed.data(), compressed.size(),
+        data.data(), data.size(), it->second);
+    ZSTD_freeCCtx(context);
+    compressed.resize(ZSTD_isError(compressedSize) ? 0 : compressedSize);
+
+    return compressed;
+}
+
+std::vector<std::byte> ZstdAssetCompressor::Decompress(Span<const std::byte> data, u64 decompressedSize)
+{
+    std::vector<std::byte> unpacked(decompressedSize);
+
+    ZSTD_DDict* dictionary = nullptr;
+    if (const u32 dictionaryId = ZSTD_getDictID_fromFrame(data.data(), data.size()); dictionaryId != 0)
+    {
+        const auto it = m_DecompressionDictionaries.find(dictionaryId);
+        if (it == m_DecompressionDictionaries.end())
+            return {};
+        dictionary = it->second;
+    }
+
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    const u64 unpackedSize = dictionary ?
+        ZSTD_decompress_usingDDict(context, unpacked.data(), unpacked.size(), data.data(), data.size(), dictionary) :
+        ZSTD_decompressDCtx(context, unpacked.data(), unpacked.size(), data.data(), data.size());
+    ZSTD_freeDCtx(context);
+    if (ZSTD_isError(unpackedSize) || unpackedSize != decompressedSize)
+        return {};
+
+    return unpacked;
+}
+
+void ZstdAssetCompressor::AddDictionary(const std::string& typeName, Span<const std::byte> dictionary)
+{
+    if (const auto it = m_CompressionDictionaries.find(typeName); it != m_CompressionDictionaries.end())
+        ZSTD_freeCDict(it->second);
+    m_CompressionDictionaries[typeName] = ZSTD_createCDict(dictionary.data(), dictionary.size(), m_Level);
+
+    /* the assets compressed with the replaced dictionary are still readable */
+    AddDecompressionDictionary(dictionary);
+}
+
+void ZstdAssetCompressor::AddDecompressionDictionary(Span<const std::byte> dictionary)
+{
+    const u32 dictionaryId = ZDICT_getDictID(dictionary.data(), dictionary.size());
+    if (!m_DecompressionDictionaries.contains(dictionaryId))
+        m_DecompressionDictionaries.emplace(dictionaryId, ZSTD_createDDict(dictionary.data(), dictionary.size()));
+}
+
+IoResult<void> ZstdAssetCompressor::LoadDictionaries(const std::filesystem::path& directory)
+{
+    if (!std::filesystem::exists(directory))
+        return {};
+
+    for (const auto& file : std::filesystem::directory_iterator(directory))
+    {
+        if (file.path().extension() != DICTIONARY_EXTENSION)
+            continue;
+
+        auto dictionary = readFileToBytes(file.path());
+        ASSETLIB_CHECK_RETURN_IO_ERROR(dictionary.has_value(), IoError::ErrorCode::FailedToOpen,
+            "Assetlib: Failed to read dictionary: {}", file.path().string())
+        const u32 dictionaryId = ZDICT_getDictID(dictionary->data(), dictionary->size());
+        ASSETLIB_CHECK_RETURN_IO_ERROR(dictionaryId != 0, IoError::ErrorCode::WrongFormat,
+            "Assetlib: Not a zstd dictionary: {}", file.path().string())
+
+        const std::string name = file.path().stem().string();
+        if (isPreviousDictionary(name, dictionaryId))
+            AddDecompressionDictionary(*dictionary);
+        else
+            AddDictionary(name, *dictionary);
+    }
+
+    return {};
+}
+
+IoResult<void> ZstdAssetCompressor::TrainDictionaries(const std::filesystem::path& directory,
+    u32 dictionarySizeBytes)
+{
+    std::lock_guard lock(m_SamplesMutex);
+
+    std::filesystem::create_directories(directory);
+    for (auto& [typeName, samples] : m_Samples)
+    {
+        std::vector<std::vector<std::byte>> samplesData;
+        samplesData.reserve(samples.Data.size());
+        for (auto& sample : samples.Data | std::views::values)
+            samplesData.push_back(std::move(sample));
+        const std::vector<std::byte> dictionary = TrainDictionary(samplesData, dictionarySizeBytes);
+        if (dictionary.empty())
+            continue;
+
+        /* the assets baked with the current dictionary reference it by its id, so it is kept */
+        const std::filesystem::path path = dictionaryPath(directory, typeName);
+        if (auto current = readFileToBytes(path); current.has_value())
+        {
+            const u32 currentId = ZDICT_getDictID(current->data(), current->size());
+            if (currentId != 0 && currentId != ZDICT_getDictID(dictionary.data(), dictionary.size()))
+            {
+                auto previousWrite = writeDictionary(
+                    dictionaryPath(directory, std::format("{}-{}", typeName, currentId)), *current);
+                ASSETLIB_CHECK_RETURN_IO_ERROR_PROPAGATE(previousWrite)
+            }
+        }
+        auto dictionaryWrite = writeDictionary(path, dictionary);
+        ASSETLIB_CHECK_RETURN_IO_ERROR_PROPAGATE(dictionaryWrite)
+
+        AddDictionary(typeName, dictionary);
+    }
+    m_Samples.clear();
+
+    return {};
+}
+
+std::vector<std::byte> ZstdAssetCompressor::TrainDictionary(Span<const std::vector<std::byte>> samples,
+    u32 dictionarySizeBytes)
+{
+    std::vector<std::byte> samplesData;
+    std::vector<usize> samplesSizes;
+    samplesSizes.reserve(samples.size());
+    for (auto& sample : samples)
+    {
+        samplesData.append_range(sample);
+        samplesSizes.push_back(sample.size());
+    }
+
+    std::vector<std::byte> dictionary(dictionarySizeBytes);
+    const usize dictionarySize = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(),
+        samplesData.data(), samplesSizes.data(), (u32)samplesSizes.size());
+    dictionary.resize(ZDICT_isError(dictionarySize) ? 0 : dictionarySize);
+
+    return dictionary;
+}
+
+std::filesystem::path ZstdAssetCompressor::GetDictionariesDirectory(const std::filesystem::path& bakedDirectory)
+{
+    return bakedDirectory / "dictionaries";
+}
+
+void ZstdAssetCompressor::CollectSample(const std::string& typeName, Span<const std::byte> data)
+{
+    if (data.empty() || data.size() > MAX_SAMPLE_SIZE_BYTES)
+        return;
+
+    const u64 hash = Hash::bytes(data.data(), (u32)data.size());
+    std::lock_guard lock(m_SamplesMutex);
+    Samples& samples = m_Samples[typeName];
+    if (hash >= samples.SmallestDroppedHash)
+        return;
+    samples.Data.emplace(hash, std::vector<std::byte>(data.begin(), data.end()));
+    samples.SizeBytes += data.size();
+    while (samples.SizeBytes > m_MaxSamplesSizeBytes)
+    {
+        const auto largest = std::prev(samples.Data.end());
+        samples.SmallestDroppedHash = largest->first;
+        samples.SizeBytes -= largest->second.size();
+        samples.Data.erase(largest);
+    }
+}
+}
@@ -0,0 +1,86 @@
+﻿#pragma once
+#include "AssetCompressor.h"
+
+#include <AssetLib/Io/AssetIo.h>
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace lux::assetlib::io
+{
+/* slower to compress than lz4, but with much better ratios on small assets, especially with a dictionary.
+ * The dictionaries are trained per asset type, from the data the compressor has seen, and every compressed frame
+ * records the id of its dictionary, so one compressor decompresses the assets of any type */
+class ZstdAssetCompressor final : public AssetCompressor
+{
+public:
+    static constexpr i32 DEFAULT_LEVEL = 9;
+    static constexpr u32 DEFAULT_DICTIONARY_SIZE_BYTES = 112640;
+    static constexpr u64 DEFAULT_MAX_SAMPLES_SIZE_BYTES = 16llu * 1024 * 1024;
+    static constexpr std::string_view DICTIONARY_EXTENSION = ".zdict";
+    struct CreateInfo
+    {
+        i32 Level{DEFAULT_LEVEL};
+        /* keep the data compressed by `CompressForType` to train dictionaries on */
+        bool CollectSamples{false};
+        /* the samples kept per asset type, zstd wants at most ~100x the dictionary size of them */
+        u64 MaxSamplesSizeBytes{DEFAULT_MAX_SAMPLES_SIZE_BYTES};
+    };
+public:
+    ZstdAssetCompressor();
+    explicit ZstdAssetCompressor(const CreateInfo& createInfo);
+    ~ZstdAssetCompressor() override;
+    ZstdAssetCompressor(const ZstdAssetCompressor&) = delete;
+    ZstdAssetCompressor& operator=(const ZstdAssetCompressor&) = delete;
+    ZstdAssetCompressor(ZstdAssetCompressor&&) = delete;
+    ZstdAssetCompressor& operator=(ZstdAssetCompressor&&) = delete;
+
+    std::vector<std::byte> Compress(Span<const std::byte> data) override;
+    std::vector<std::byte> CompressForType(Span<const std::byte> data, const AssetTypeMetadata& type) override;
+    /* returns an empty vector if the data is corrupt or its dictionary is not loaded */
+    std::vector<std::byte> Decompress(Span<const std::byte> data, u64 decompressedSize) override;
+
+    /* the dictionaries have to be added before the compressor is used from several threads */
+    void AddDictionary(const std::string& typeName, Span<const std::byte> dictionary);
+    /* loads every dictionary of `directory`: `<type>.zdict` is the dictionary the assets of the type
+     * are compressed with, and `<type>-<dictionary id>.zdict` are its previous dictionaries,
+     * that are only used to decompress the assets baked before the type was retrained */
+    IoResult<void> LoadDictionaries(const std::filesystem::path& directory);
+    /* trains a dictionary for every asset type with enough collected samples, writes it to `directory`
+     * and starts using it; the replaced dictionary is kept under its id */
+    IoResult<void> TrainDictionaries(const std::filesystem::path& directory,
+        u32 dictionarySizeBytes = DEFAULT_DICTIONARY_SIZE_BYTES);
+    /* returns an empty dictionary if there are too few samples */
+    static std::vector<std::byte> TrainDictionary(Span<const std::vector<std::byte>> samples,
+        u32 dictionarySizeBytes = DEFAULT_DICTIONARY_SIZE_BYTES);
+    static std::filesystem::path GetDictionariesDirectory(const std::filesystem::path& bakedDirectory);
+
+    DEFINE_ASSET_COMPRESSOR_NAME("Zstd", "12887c0b-4550-4f6b-823d-fde6448042e4"_guid)
+private:
+    void AddDecompressionDictionary(Span<const std::byte> dictionary);
+    void CollectSample(const std::string& typeName, Span<const std::byte> data);
+private:
+    i32 m_Level{DEFAULT_LEVEL};
+    bool m_CollectSamples{false};
+    u64 m_MaxSamplesSizeBytes{DEFAULT_MAX_SAMPLES_SIZE_BYTES};
+    std::unordered_map<std::string, ZSTD_CDict_s*> m_CompressionDictionaries;
+    /* by the dictionary id */
+    std::unordered_map<u32, ZSTD_DDict_s*> m_DecompressionDictionaries;
+
+    /* the samples with the largest hashes are dropped over the budget, and so are all the later samples
+     * with a hash not smaller than a dropped one, so that the kept samples are always the hash-sorted prefix
+     * that fits the budget, and the dictionaries do not depend on the order the assets were baked in */
+    struct Samples
+    {
+        std::multimap<u64, std::vector<std::byte>> Data{};
+        u64 SizeBytes{0};
+        u64 SmallestDroppedHash{~0llu};
+    };
+    std::unordered_map<std::string, Samples> m_Samples;
+    std::mutex m_SamplesMutex;
+};
+}
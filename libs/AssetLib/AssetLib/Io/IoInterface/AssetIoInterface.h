@@ -3,8 +3,17 @@
 #include <AssetLib/Io/AssetIo.h>
 #include <CoreLib/Containers/Span.h>
 
+#include <memory>
+
 namespace lux::assetlib::io
 {
+/* a view of a binary chunk, the memory it points to stays alive as long as the view does */
+struct BinaryChunkView
+{
+    std::shared_ptr<const void> Owner{};
+    Span<const std::byte> Data{};
+};
+
 class AssetIoInterface
 {
 public:
@@ -15,6 +24,11 @@ public:
     virtual IoResult<AssetCustomHeaderType> ReadHeader(const AssetMetadata& metadata) = 0;
     virtual IoResult<void> ReadBinaryChunk(const AssetMetadata& metadata, std::byte* destination, u64 offsetBytes,
         u64 sizeBytes) = 0;
+    /* the view stays valid even if the asset is written again while it is alive */
+    virtual IoResult<BinaryChunkView> MapBinaryChunk(const AssetMetadata& metadata, u64 offsetBytes,
+        u64 sizeBytes) = 0;
+    /* the file was changed outside of this interface, and whatever was read from it before is stale */
+    virtual void OnFileModified(const std::filesystem::path&) {}
 
     virtual std::string GetHeaderExtension(std::string_view preferred) const = 0;
     virtual std::string GetBinariesExtension() const = 0;
@@ -1,5 +1,6 @@
 ﻿#include "CombinedAssetIoInterface.h"
 
+#include <cstring>
 #include <fstream>
 
 namespace fs = std::filesystem;
@@ -13,6 +14,7 @@ constexpr std::string_view ASSET_COMBINED_FILE_EXTENSION = "gbin";
 constexpr u64 ASSET_COMBINED_FILE_VERSION = 1llu;
 constexpr u32 ASSET_COMBINED_FILE_MAGIC_LENGTH = (u32)ASSET_COMBINED_FILE_MAGIC.length();
 static_assert(ASSET_COMBINED_FILE_MAGIC_LENGTH == 8);
+constexpr u64 ASSET_COMBINED_FILE_PREFIX_SIZE = ASSET_COMBINED_FILE_MAGIC_LENGTH + sizeof ASSET_COMBINED_FILE_VERSION;
 }
 
 IoResult<u64> CombinedAssetIoInterface::WriteHeader(const AssetMetadata& metadata, const AssetCustomHeaderType& header)
@@ -28,6 +30,7 @@ IoResult<u64> CombinedAssetIoInterface::WriteHeader(const AssetMetadata& metadat
     ASSETLIB_CHECK_RETURN_IO_ERROR(success, IoError::ErrorCode::FailedToCreate,
         "Assetlib: Failed to create path directory: {}", path.string())
 
+    m_MappedFiles.Evict(path);
     std::ofstream out(path, std::ios::out | std::ios::binary);
     ASSETLIB_CHECK_RETURN_IO_ERROR(out.good(), IoError::ErrorCode::FailedToCreate,
         "Assetlib: Failed to create file: {}", path.string())
@@ -49,6 +52,7 @@ IoResult<u64> CombinedAssetIoInterface::WriteBinaryChunk(const AssetMetadata& me
     const fs::path& path = metadata.Io.HeaderFile;
     ASSETLIB_CHECK_RETURN_IO_ERROR(!path.empty(), IoError::ErrorCode::FailedToCreate, "Assetlib: File path is not set")
 
+    m_MappedFiles.Evict(path);
     std::ofstream out(path, std::ios::binary | std::ios::ate);
     ASSETLIB_CHECK_RETURN_IO_ERROR(out.good(), IoError::ErrorCode::FailedToOpen,
         "Assetlib: Failed to open file: {}", path.string())
@@ -62,50 +66,58 @@ IoResult<u64> CombinedAssetIoInterface::WriteBinaryChunk(const AssetMetadata& me
 
 IoResult<AssetCustomHeaderType> CombinedAssetIoInterface::ReadHeader(const AssetMetadata& metadata)
 {
-    std::ifstream in(metadata.Io.HeaderFile, std::ios::binary);
-    ASSETLIB_CHECK_RETURN_IO_ERROR(in.good(), IoError::ErrorCode::FailedToOpen,
+    const auto file = m_MappedFiles.Get(metadata.Io.HeaderFile);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(file.has_value(), IoError::ErrorCode::FailedToOpen,
         "Assetlib: Failed to open combined asset file: {}", metadata.Io.HeaderFile.string())
+    ASSETLIB_CHECK_RETURN_IO_ERROR(file->Data.size() >= ASSET_COMBINED_FILE_PREFIX_SIZE + metadata.Io.HeaderSizeBytes,
+        IoError::ErrorCode::WrongFormat,
+        "Assetlib: Combined asset file is too small: {}", metadata.Io.HeaderFile.string())
 
-    std::string assetMagicString = std::string(ASSET_COMBINED_FILE_MAGIC);
-    in.read(assetMagicString.data(), (isize)assetMagicString.size());
+    const std::string_view assetMagicString((const char*)file->Data.data(), ASSET_COMBINED_FILE_MAGIC_LENGTH);
     ASSETLIB_CHECK_RETURN_IO_ERROR(assetMagicString == ASSET_COMBINED_FILE_MAGIC, IoError::ErrorCode::WrongFormat,
         "Assetlib: Combined asset file does not include expected magic. Expected {}, got {}",
         ASSET_COMBINED_FILE_MAGIC, assetMagicString)
 
     u64 version = 0;
-    in.read((char*)&version, sizeof version);
+    std::memcpy(&version, file->Data.data() + ASSET_COMBINED_FILE_MAGIC_LENGTH, sizeof version);
     ASSETLIB_CHECK_RETURN_IO_ERROR(version == ASSET_COMBINED_FILE_VERSION, IoError::ErrorCode::WrongFormat,
         "Assetlib: Combined asset file has unexpected version. Expected {}, got {}",
         ASSET_COMBINED_FILE_VERSION, version)
 
-    std::string headerString(metadata.Io.HeaderSizeBytes, 0);
-    in.read(headerString.data(), (isize)metadata.Io.HeaderSizeBytes);
-
-    return headerString;
+    return std::string((const char*)file->Data.data() + ASSET_COMBINED_FILE_PREFIX_SIZE, metadata.Io.HeaderSizeBytes);
 }
 
 IoResult<void> CombinedAssetIoInterface::ReadBinaryChunk(const AssetMetadata& metadata, std::byte* destination, 
     u64 offsetBytes, u64 sizeBytes)
 {
-    const isize headerSizeBytes = (isize)metadata.Io.HeaderSizeBytes;
+    const auto chunk = MapBinaryChunk(metadata, offsetBytes, sizeBytes);
+    ASSETLIB_CHECK_RETURN_IO_ERROR_PROPAGATE(chunk)
+
+    std::memcpy(destination, chunk->Data.data(), sizeBytes);
+
+    return {};
+}
+
+IoResult<BinaryChunkView> CombinedAssetIoInterface::MapBinaryChunk(const AssetMetadata& metadata,
+    u64 offsetBytes, u64 sizeBytes)
+{
     const fs::path& binaryPath = metadata.Io.BinaryFile;
 
-    std::ifstream binaryIn(binaryPath, std::ios::binary);
-    ASSETLIB_CHECK_RETURN_IO_ERROR(binaryIn.good(), IoError::ErrorCode::FailedToOpen,
+    const auto file = m_MappedFiles.Get(binaryPath);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(file.has_value(), IoError::ErrorCode::FailedToOpen,
         "Assetlib: Failed to open binary file: {}", binaryPath.string())
-    const isize totalFileSize = binaryIn.tellg();
-    ASSETLIB_CHECK_RETURN_IO_ERROR(totalFileSize - offsetBytes - headerSizeBytes >= sizeBytes,
+
+    const u64 chunkOffset = ASSET_COMBINED_FILE_PREFIX_SIZE + metadata.Io.HeaderSizeBytes + offsetBytes;
+    ASSETLIB_CHECK_RETURN_IO_ERROR(file->Data.size() >= chunkOffset && file->Data.size() - chunkOffset >= sizeBytes,
         IoError::ErrorCode::FailedToLoad,
         "Assetlib: Failed to read binary chunk: total file size is less then offset + size: {}", binaryPath.string())
 
-    binaryIn.seekg((isize)(
-        ASSET_COMBINED_FILE_MAGIC_LENGTH +
-        sizeof ASSET_COMBINED_FILE_VERSION +
-        metadata.Io.HeaderSizeBytes +
-        offsetBytes), std::ios::beg);
-    binaryIn.read((char*)destination, (isize)sizeBytes);
+    return BinaryChunkView{.Owner = file->Owner, .Data = file->Data.subspan(chunkOffset, sizeBytes)};
+}
 
-    return {};
+void CombinedAssetIoInterface::OnFileModified(const std::filesystem::path& path)
+{
+    m_MappedFiles.Evict(path);
 }
 
 std::string CombinedAssetIoInterface::GetHeaderExtension(std::string_view preferred) const
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "AssetIoInterface.h"
+#include "MappedAssetFiles.h"
 
 namespace lux::assetlib::io
 {
@@ -11,10 +12,15 @@ public:
     IoResult<AssetCustomHeaderType> ReadHeader(const AssetMetadata& metadata) override;
     IoResult<void> ReadBinaryChunk(const AssetMetadata& metadata, std::byte* destination, u64 offsetBytes,
         u64 sizeBytes) override;
+    IoResult<BinaryChunkView> MapBinaryChunk(const AssetMetadata& metadata, u64 offsetBytes,
+        u64 sizeBytes) override;
+    void OnFileModified(const std::filesystem::path& path) override;
     
     std::string GetHeaderExtension(std::string_view preferred) const override;
     std::string GetBinariesExtension() const override;
 
     DEFINE_ASSET_IO_INTERFACE_NAME("Combined", "6ca189c5-4e11-4bd1-98a9-7749d3cd3f55"_guid)
+private:
+    MappedAssetFiles m_MappedFiles;
 };
 }
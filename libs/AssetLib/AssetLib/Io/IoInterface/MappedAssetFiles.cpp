@@ -0,0 +1,66 @@
+﻿#include "MappedAssetFiles.h"
+
+#include <CoreLib/Platform/MappedFile/MappedFile.h>
+
+namespace lux::assetlib::io
+{
+namespace
+{
+/* the same file can come with different separators from the metadata and from the file watcher */
+std::string getKey(const std::filesystem::path& path)
+{
+    return path.lexically_normal().generic_string();
+}
+}
+
+IoResult<BinaryChunkView> MappedAssetFiles::Get(const std::filesystem::path& path)
+{
+    std::string key = getKey(path);
+
+    std::lock_guard lock(m_Mutex);
+
+    if (auto it = m_Files.find(key); it != m_Files.end())
+    {
+        m_Lru.splice(m_Lru.begin(), m_Lru, it->second.LruPosition);
+
+        return BinaryChunkView{.Owner = it->second.Mapping, .Data = it->second.Data};
+    }
+
+    const std::optional<platform::MappedFile> file = platform::mapFile(path);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(file.has_value(), IoError::ErrorCode::FailedToOpen,
+        "Assetlib: Failed to map file: {}", path.string())
+    std::shared_ptr<const void> mapping(file->Data, [file = *file](const void*) { platform::unmapFile(file); });
+    const Span<const std::byte> data(file->Data, file->SizeBytes);
+
+    if (m_Files.size() >= m_MaxMappedFiles && !m_Lru.empty())
+    {
+        m_Files.erase(m_Lru.back());
+        m_Lru.pop_back();
+    }
+    m_Lru.push_front(key);
+    m_Files.emplace(std::move(key), Entry{
+        .Mapping = mapping,
+        .Data = data,
+        .LruPosition = m_Lru.begin()});
+
+    return BinaryChunkView{.Owner = std::move(mapping), .Data = data};
+}
+
+void MappedAssetFiles::Evict(const std::filesystem::path& path)
+{
+    std::lock_guard lock(m_Mutex);
+    const auto it = m_Files.find(getKey(path));
+    if (it == m_Files.end())
+        return;
+
+    m_Lru.erase(it->second.LruPosition);
+    m_Files.erase(it);
+}
+
+bool MappedAssetFiles::IsCached(const std::filesystem::path& path)
+{
+    std::lock_guard lock(m_Mutex);
+
+    return m_Files.contains(getKey(path));
+}
+}
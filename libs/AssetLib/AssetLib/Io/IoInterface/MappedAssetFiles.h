@@ -0,0 +1,46 @@
+﻿#pragma once
+
+#include <AssetLib/Io/IoInterface/AssetIoInterface.h>
+
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace lux::assetlib::io
+{
+/* keeps the mappings of the recently read asset files, so that the chunks of a file are read from a single mapping
+ * without any system calls; past `maxMappedFiles` the least recently read file is dropped, and it is unmapped
+ * once its last view is gone. The files are not checked for changes on read: a file has to be evicted
+ * when it is written or changed on disk */
+class MappedAssetFiles
+{
+public:
+    static constexpr u32 DEFAULT_MAX_MAPPED_FILES = 256;
+public:
+    explicit MappedAssetFiles(u32 maxMappedFiles = DEFAULT_MAX_MAPPED_FILES) : m_MaxMappedFiles(maxMappedFiles) {}
+    MappedAssetFiles(const MappedAssetFiles&) = delete;
+    MappedAssetFiles& operator=(const MappedAssetFiles&) = delete;
+    MappedAssetFiles(MappedAssetFiles&&) = delete;
+    MappedAssetFiles& operator=(MappedAssetFiles&&) = delete;
+    ~MappedAssetFiles() = default;
+
+    /* a view of the whole file */
+    IoResult<BinaryChunkView> Get(const std::filesystem::path& path);
+    /* only drops the cache entry, the views that are alive keep the old mapping */
+    void Evict(const std::filesystem::path& path);
+    bool IsCached(const std::filesystem::path& path);
+private:
+    struct Entry
+    {
+        std::shared_ptr<const void> Mapping;
+        Span<const std::byte> Data{};
+        std::list<std::string>::iterator LruPosition{};
+    };
+    std::mutex m_Mutex;
+    std::unordered_map<std::string, Entry> m_Files;
+    /* the most recently read file is at the front */
+    std::list<std::string> m_Lru;
+    u32 m_MaxMappedFiles{DEFAULT_MAX_MAPPED_FILES};
+};
+}
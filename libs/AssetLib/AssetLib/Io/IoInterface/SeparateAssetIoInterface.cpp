@@ -2,6 +2,7 @@
 
 #include <CoreLib/Utils/FileUtils.h>
 
+#include <cstring>
 #include <fstream>
 
 namespace fs = std::filesystem;
@@ -16,6 +17,7 @@ IoResult<u64> SeparateAssetIoInterface::WriteHeader(const AssetMetadata& metadat
     ASSETLIB_CHECK_RETURN_IO_ERROR(!headerPath.empty(), IoError::ErrorCode::FailedToCreate,
         "Assetlib: File paths are not set: header: {}", headerPath.string())
 
+    m_MappedFiles.Evict(binaryPath);
     if (fs::exists(binaryPath))
         fs::remove(binaryPath);
 
@@ -24,7 +26,7 @@ IoResult<u64> SeparateAssetIoInterface::WriteHeader(const AssetMetadata& metadat
     ASSETLIB_CHECK_RETURN_IO_ERROR(success, IoError::ErrorCode::FailedToCreate,
         "Assetlib: Failed to create header directory: {}", headerPath.string())
 
-    std::ofstream headerOut(headerPath, std::ios::out);
+    std::ofstream headerOut(headerPath, std::ios::out | std::ios::binary);
     ASSETLIB_CHECK_RETURN_IO_ERROR(headerOut.good(), IoError::ErrorCode::FailedToCreate,
         "Assetlib: Failed to create header file: {}", headerPath.string())
 
@@ -51,6 +53,7 @@ IoResult<u64> SeparateAssetIoInterface::WriteBinaryChunk(const AssetMetadata& me
             "Assetlib: Failed to create binary directory: {}", binaryPath.string())
     }
 
+    m_MappedFiles.Evict(binaryPath);
     std::ofstream binaryOut(binaryPath, std::ios::binary | std::ios::ate);
     ASSETLIB_CHECK_RETURN_IO_ERROR(binaryOut.good(), IoError::ErrorCode::FailedToOpen,
         "Assetlib: Failed to open binary file: {}", binaryPath.string())
@@ -71,22 +74,33 @@ IoResult<AssetCustomHeaderType> SeparateAssetIoInterface::ReadHeader(const Asset
 
 IoResult<void> SeparateAssetIoInterface::ReadBinaryChunk(const AssetMetadata& metadata, std::byte* destination, 
     u64 offsetBytes, u64 sizeBytes)
+{
+    const auto chunk = MapBinaryChunk(metadata, offsetBytes, sizeBytes);
+    ASSETLIB_CHECK_RETURN_IO_ERROR_PROPAGATE(chunk)
+
+    std::memcpy(destination, chunk->Data.data(), sizeBytes);
+
+    return {};
+}
+
+IoResult<BinaryChunkView> SeparateAssetIoInterface::MapBinaryChunk(const AssetMetadata& metadata,
+    u64 offsetBytes, u64 sizeBytes)
 {
     const fs::path& binaryPath = metadata.Io.BinaryFile;
 
-    std::ifstream binaryIn(binaryPath, std::ios::binary | std::ios::ate);
-    ASSETLIB_CHECK_RETURN_IO_ERROR(binaryIn.good(), IoError::ErrorCode::FailedToOpen,
+    const auto file = m_MappedFiles.Get(binaryPath);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(file.has_value(), IoError::ErrorCode::FailedToOpen,
         "Assetlib: Failed to open binary file: {}", binaryPath.string())
-
-    const isize totalFileSize = binaryIn.tellg();
-    ASSETLIB_CHECK_RETURN_IO_ERROR(totalFileSize - offsetBytes >= sizeBytes,
+    ASSETLIB_CHECK_RETURN_IO_ERROR(file->Data.size() >= offsetBytes && file->Data.size() - offsetBytes >= sizeBytes,
         IoError::ErrorCode::FailedToLoad,
         "Assetlib: Failed to read binary chunk: total file size is less then offset + size: {}", binaryPath.string())
 
-    binaryIn.seekg((isize)offsetBytes, std::ios::beg);
-    binaryIn.read((char*)destination, (isize)sizeBytes);
+    return BinaryChunkView{.Owner = file->Owner, .Data = file->Data.subspan(offsetBytes, sizeBytes)};
+}
 
-    return {};
+void SeparateAssetIoInterface::OnFileModified(const std::filesystem::path& path)
+{
+    m_MappedFiles.Evict(path);
 }
 
 std::string SeparateAssetIoInterface::GetHeaderExtension(std::string_view preferred) const
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "AssetIoInterface.h"
+#include "MappedAssetFiles.h"
 
 namespace lux::assetlib::io
 {
@@ -11,10 +12,15 @@ public:
     IoResult<AssetCustomHeaderType> ReadHeader(const AssetMetadata& metadata) override;
     IoResult<void> ReadBinaryChunk(const AssetMetadata& metadata, std::byte* destination, u64 offsetBytes,
         u64 sizeBytes) override;
+    IoResult<BinaryChunkView> MapBinaryChunk(const AssetMetadata& metadata, u64 offsetBytes,
+        u64 sizeBytes) override;
+    void OnFileModified(const std::filesystem::path& path) override;
     
     std::string GetHeaderExtension(std::string_view preferred) const override;
     std::string GetBinariesExtension() const override;
     
     DEFINE_ASSET_IO_INTERFACE_NAME("Separate", "a463a68f-5504-43d4-9d92-563105704240"_guid)
+private:
+    MappedAssetFiles m_MappedFiles;
 };
 }
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <AssetLib/Assetlib.h>
+#include <AssetLib/Io/AssetIo.h>
 #include <CoreLib/Containers/Guid.h>
 
+#include <cstring>
+
 #include "CorelibReflectionUtility.inl"
 #include "ImageFormatReflection.inl"
 
@@ -20,6 +23,58 @@ template <> struct ::glz::meta<lux::assetlib::AssetTypeMetadata> : lux::assetlib
 template <> struct ::glz::meta<lux::assetlib::AssetIoMetadata> : lux::assetlib::reflection::CamelCase {};
 template <> struct ::glz::meta<lux::assetlib::AssetMetadata> : lux::assetlib::reflection::CamelCase {};
 
+namespace lux::assetlib::io
+{
+template <typename T>
+IoResult<AssetCustomHeaderType> packHeader(const T& header, AssetHeaderEncoding encoding)
+{
+	if (encoding == AssetHeaderEncoding::Json)
+	{
+		auto json = glz::write_json(header);
+		ASSETLIB_CHECK_RETURN_IO_ERROR(json.has_value(), IoError::ErrorCode::GeneralError,
+			"Assetlib: Failed to pack: {}", glz::format_error(json.error()))
+		return std::move(*json);
+	}
+
+	auto beve = glz::write_beve(header);
+	ASSETLIB_CHECK_RETURN_IO_ERROR(beve.has_value(), IoError::ErrorCode::GeneralError,
+		"Assetlib: Failed to pack: {}", glz::format_error(beve.error()))
+
+	AssetCustomHeaderType packed;
+	packed.reserve(ASSET_BINARY_HEADER_PREFIX_SIZE + beve->size());
+	packed.append(ASSET_BINARY_HEADER_MAGIC);
+	packed.append((const char*)&ASSET_BINARY_HEADER_VERSION, sizeof ASSET_BINARY_HEADER_VERSION);
+	packed.append(*beve);
+
+	return packed;
+}
+
+template <typename T>
+IoResult<T> unpackHeader(std::string_view header)
+{
+	if (getAssetHeaderEncoding(header) == AssetHeaderEncoding::Json)
+	{
+		auto json = glz::read_json<T>(header);
+		ASSETLIB_CHECK_RETURN_IO_ERROR(json.has_value(), IoError::ErrorCode::GeneralError,
+			"Assetlib: Failed to read: {}", glz::format_error(json.error(), header))
+		return std::move(*json);
+	}
+
+	ASSETLIB_CHECK_RETURN_IO_ERROR(header.size() >= ASSET_BINARY_HEADER_PREFIX_SIZE, IoError::ErrorCode::WrongFormat,
+		"Assetlib: Binary header is too small")
+	u32 version = 0;
+	std::memcpy(&version, header.data() + ASSET_BINARY_HEADER_MAGIC.size(), sizeof version);
+	ASSETLIB_CHECK_RETURN_IO_ERROR(version == ASSET_BINARY_HEADER_VERSION, IoError::ErrorCode::WrongFormat,
+		"Assetlib: Binary header has unexpected version. Expected {}, got {}", ASSET_BINARY_HEADER_VERSION, version)
+
+	auto beve = glz::read_beve<T>(header.substr(ASSET_BINARY_HEADER_PREFIX_SIZE));
+	ASSETLIB_CHECK_RETURN_IO_ERROR(beve.has_value(), IoError::ErrorCode::GeneralError,
+		"Assetlib: Failed to read: {}", glz::format_error(beve.error()))
+
+	return std::move(*beve);
+}
+}
+
 #define DEFINE_BASIC_METADATA_READ(metaType, metaOutput, pathParameter) \
 	using namespace io; \
 	metaType metaOutput = {}; \
@@ -40,6 +95,5 @@ template <> struct ::glz::meta<lux::assetlib::AssetMetadata> : lux::assetlib::re
 	auto headerRead = readFileToString((metadataParameter).Io.HeaderFile); \
 	ASSETLIB_CHECK_RETURN_IO_ERROR(headerRead.has_value(), io::IoError::ErrorCode::GeneralError, \
 		"Assetlib: Failed to read header file: {}", (metadataParameter).Io.HeaderFile.string()) \
-	const auto resultOutput = glz::read_json<headerType>(*headerRead); \
-	ASSETLIB_CHECK_RETURN_IO_ERROR(result.has_value(), io::IoError::ErrorCode::GeneralError, \
-		"Assetlib: Failed to read: {}", glz::format_error(result.error(), *headerRead))
\ No newline at end of file
+	const auto resultOutput = io::unpackHeader<headerType>(*headerRead); \
+	ASSETLIB_CHECK_RETURN_IO_ERROR_PROPAGATE(resultOutput)
\ No newline at end of file
@@ -1,5 +1,7 @@
 ﻿#include "GeometryBufferAsset.h"
 
+#include "GeometryBufferMeta.h"
+
 #include <AssetLib/Io/Compression/AssetCompressor.h>
 #include <AssetLib/Io/IoInterface/AssetIoInterface.h>
 #include <AssetLib/Reflection/AssetlibReflectionUtility.inl>
@@ -39,23 +41,47 @@ io::IoResult<std::vector<std::byte>> readBufferData(const GeometryBufferHeader&
     constexpr u64 dataOffset = 0;
     const u64 dataSize = metadata.Io.BinarySizeBytesCompressed;
     
-    std::vector<std::byte> bufferData(dataSize);
-    auto result = io.ReadBinaryChunk(metadata, bufferData.data(), dataOffset, bufferData.size());
+    auto result = io.MapBinaryChunk(metadata, dataOffset, dataSize);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(result.has_value(), io::IoError::ErrorCode::FailedToLoad,
+        "Assetlib: Failed to read: {} ({})", result.error(), metadata.Io.BinaryFile.string())
+
+    auto data = compressor.Decompress(result->Data, header.SizeBytes);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(data.size() == header.SizeBytes, io::IoError::ErrorCode::WrongFormat,
+        "Assetlib: Failed to decompress: {}", metadata.Io.BinaryFile.string())
+
+    return data;
+}
+
+io::IoResult<void> readBufferDataRange(const GeometryBufferHeader& header, const AssetMetadata& metadata,
+    io::AssetIoInterface& io, io::AssetCompressor& compressor, u64 offsetBytes, Span<std::byte> destination)
+{
+    ASSETLIB_CHECK_RETURN_IO_ERROR(offsetBytes + destination.size() <= header.SizeBytes,
+        io::IoError::ErrorCode::WrongFormat,
+        "Assetlib: Range [{}, {}) is out of buffer bounds ({}): {}", offsetBytes, offsetBytes + destination.size(),
+        header.SizeBytes, metadata.Io.BinaryFile.string())
+    
+    constexpr u64 dataOffset = 0;
+    const u64 dataSize = metadata.Io.BinarySizeBytesCompressed;
+    
+    auto result = io.MapBinaryChunk(metadata, dataOffset, dataSize);
     ASSETLIB_CHECK_RETURN_IO_ERROR(result.has_value(), io::IoError::ErrorCode::FailedToLoad,
         "Assetlib: Failed to read: {} ({})", result.error(), metadata.Io.BinaryFile.string())
 
-    bufferData = compressor.Decompress(bufferData, header.SizeBytes);
+    const bool decompressed = compressor.DecompressRange(result->Data, header.SizeBytes, offsetBytes, destination);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(decompressed, io::IoError::ErrorCode::WrongFormat,
+        "Assetlib: Failed to decompress range [{}, {}): {}", offsetBytes, offsetBytes + destination.size(),
+        metadata.Io.BinaryFile.string())
 
-    return bufferData;
+    return {};
 }
 
-io::IoResult<AssetPacked> pack(const GeometryBufferAsset& geometry, io::AssetCompressor& compressor)
+io::IoResult<AssetPacked> pack(const GeometryBufferAsset& geometry, io::AssetCompressor& compressor,
+    io::AssetHeaderEncoding headerEncoding)
 {
-    auto header = glz::write_json(geometry.Header);
-    ASSETLIB_CHECK_RETURN_IO_ERROR(header.has_value(), io::IoError::ErrorCode::GeneralError,
-        "Assetlib: Failed to pack: {}", glz::format_error(header.error()))
+    auto header = io::packHeader(geometry.Header, headerEncoding);
+    ASSETLIB_CHECK_RETURN_IO_ERROR_PROPAGATE(header)
 
-    auto compressed = compressor.Compress(geometry.Data);
+    auto compressed = compressor.CompressForType(geometry.Data, getTypeMetadata());
     u64 compressedSize = compressed.size();
     
     return AssetPacked{
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <AssetLib/Io/AssetIo.h>
 #include <CoreLib/core.h>
+#include <CoreLib/Containers/Span.h>
 #include <CoreLib/Math/Transform.h>
 
 namespace lux::assetlib
@@ -103,7 +104,11 @@ namespace sceneGeometry
 io::IoResult<GeometryBufferHeader> readHeader(const AssetMetadata& metadata);
 io::IoResult<std::vector<std::byte>> readBufferData(const GeometryBufferHeader& header, const AssetMetadata& metadata,
     io::AssetIoInterface& io, io::AssetCompressor& compressor);
+/* decompresses `destination.size()` bytes at `offsetBytes` of the buffer data straight into `destination` */
+io::IoResult<void> readBufferDataRange(const GeometryBufferHeader& header, const AssetMetadata& metadata,
+    io::AssetIoInterface& io, io::AssetCompressor& compressor, u64 offsetBytes, Span<std::byte> destination);
 
-io::IoResult<AssetPacked> pack(const GeometryBufferAsset& geometry, io::AssetCompressor& compressor);
+io::IoResult<AssetPacked> pack(const GeometryBufferAsset& geometry, io::AssetCompressor& compressor,
+    io::AssetHeaderEncoding headerEncoding = io::AssetHeaderEncoding::Binary);
 }
 }
\ No newline at end of file
@@ -44,11 +44,10 @@ io::IoResult<MeshAsset> readMesh(const AssetMetadata& metadata)
     return *result;
 }
 
-io::IoResult<AssetPacked> pack(const MeshAsset& mesh)
+io::IoResult<AssetPacked> pack(const MeshAsset& mesh, io::AssetHeaderEncoding headerEncoding)
 {
-    auto header = glz::write_json(mesh);
-    ASSETLIB_CHECK_RETURN_IO_ERROR(header.has_value(), io::IoError::ErrorCode::GeneralError,
-        "Assetlib: Failed to pack: {}", glz::format_error(header.error()))
+    auto header = io::packHeader(mesh, headerEncoding);
+    ASSETLIB_CHECK_RETURN_IO_ERROR_PROPAGATE(header)
 
     return AssetPacked{
         .Header = std::move(*header),
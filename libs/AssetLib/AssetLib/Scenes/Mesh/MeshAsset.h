@@ -74,6 +74,7 @@ namespace sceneMesh
 {
 io::IoResult<MeshAsset> readMesh(const AssetMetadata& metadata);
 
-io::IoResult<AssetPacked> pack(const MeshAsset& mesh);
+io::IoResult<AssetPacked> pack(const MeshAsset& mesh,
+    io::AssetHeaderEncoding headerEncoding = io::AssetHeaderEncoding::Binary);
 }
 }  
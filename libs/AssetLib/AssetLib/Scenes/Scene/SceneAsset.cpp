@@ -47,11 +47,10 @@ io::IoResult<SceneAsset> readScene(const AssetMetadata& metadata)
     return *result;
 }
 
-io::IoResult<AssetPacked> pack(const SceneAsset& scene)
+io::IoResult<AssetPacked> pack(const SceneAsset& scene, io::AssetHeaderEncoding headerEncoding)
 {
-    auto packed = glz::write_json(scene);
-    ASSETLIB_CHECK_RETURN_IO_ERROR(packed.has_value(), io::IoError::ErrorCode::GeneralError,
-        "Assetlib: Failed to pack: {}", glz::format_error(packed.error()))
+    auto packed = io::packHeader(scene, headerEncoding);
+    ASSETLIB_CHECK_RETURN_IO_ERROR_PROPAGATE(packed)
     
     return AssetPacked{
         .Header = std::move(*packed),
@@ -48,7 +48,9 @@ struct SceneAssetLight
     glm::vec3 Color{1.0f};
     f32 Intensity{1.0f};
     f32 Range{1.0f};
-    // todo: spotlight
+    /* spot light only, in radians, defaults are the same as in gltf */
+    f32 InnerConeAngle{0.0f};
+    f32 OuterConeAngle{0.78539816f};
 };
 
 struct SceneAssetMeshlet
@@ -144,7 +146,8 @@ namespace scene
 {
 io::IoResult<SceneAsset> readScene(const AssetMetadata& metadata);
 
-io::IoResult<AssetPacked> pack(const SceneAsset& scene);
+io::IoResult<AssetPacked> pack(const SceneAsset& scene,
+    io::AssetHeaderEncoding headerEncoding = io::AssetHeaderEncoding::Binary);
 }
 
 }
\ No newline at end of file
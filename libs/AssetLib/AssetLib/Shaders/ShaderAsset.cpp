@@ -1,5 +1,7 @@
 #include "ShaderAsset.h"
 
+#include "ShaderMeta.h"
+
 #include <AssetLib/Io/Compression/AssetCompressor.h>
 #include <AssetLib/Io/IoInterface/AssetIoInterface.h>
 #include <AssetLib/Reflection/AssetlibReflectionUtility.inl>
@@ -35,23 +37,24 @@ io::IoResult<ShaderHeader> readHeader(const AssetMetadata& metadata)
 io::IoResult<std::vector<std::byte>> readSpirv(const ShaderHeader&, const AssetMetadata& metadata,
     io::AssetIoInterface& io, io::AssetCompressor& compressor)
 {
-    std::vector<std::byte> spirv(metadata.Io.BinarySizeBytesCompressed);
-    auto result = io.ReadBinaryChunk(metadata, spirv.data(), 0, spirv.size());
+    auto result = io.MapBinaryChunk(metadata, 0, metadata.Io.BinarySizeBytesCompressed);
     ASSETLIB_CHECK_RETURN_IO_ERROR(result.has_value(), io::IoError::ErrorCode::FailedToLoad,
         "Assetlib: Failed to read: {} ({})", result.error(), metadata.Io.BinaryFile.string())
 
-    spirv = compressor.Decompress(spirv, metadata.Io.BinarySizeBytes);
-    
+    auto spirv = compressor.Decompress(result->Data, metadata.Io.BinarySizeBytes);
+    ASSETLIB_CHECK_RETURN_IO_ERROR(spirv.size() == metadata.Io.BinarySizeBytes, io::IoError::ErrorCode::WrongFormat,
+        "Assetlib: Failed to decompress: {}", metadata.Io.BinaryFile.string())
+
     return spirv;
 }
 
-io::IoResult<AssetPacked> pack(const ShaderAsset& shader, io::AssetCompressor& compressor)
+io::IoResult<AssetPacked> pack(const ShaderAsset& shader, io::AssetCompressor& compressor,
+    io::AssetHeaderEncoding headerEncoding)
 {
-    auto header = glz::write_json(shader.Header);
-    ASSETLIB_CHECK_RETURN_IO_ERROR(header.has_value(), io::IoError::ErrorCode::GeneralError,
-        "Assetlib: Failed to pack: {}", glz::format_error(header.error()))
+    auto header = io::packHeader(shader.Header, headerEncoding);
+    ASSETLIB_CHECK_RETURN_IO_ERROR_PROPAGATE(header)
 
-    auto spirv = compressor.Compress(shader.Spirv);
+    auto spirv = compressor.CompressForType(shader.Spirv, getTypeMetadata());
     const u64 spirvSize = spirv.size();
 
     return AssetPacked{
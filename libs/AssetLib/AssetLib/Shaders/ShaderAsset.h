@@ -157,7 +157,8 @@ io::IoResult<ShaderHeader> readHeader(const AssetMetadata& metadata);
 io::IoResult<std::vector<std::byte>> readSpirv(const ShaderHeader& header, const AssetMetadata& metadata,
     io::AssetIoInterface& io, io::AssetCompressor& compressor);
 
-io::IoResult<AssetPacked> pack(const ShaderAsset& shader, io::AssetCompressor& compressor);
+io::IoResult<AssetPacked> pack(const ShaderAsset& shader, io::AssetCompressor& compressor,
+    io::AssetHeaderEncoding headerEncoding = io::AssetHeaderEncoding::Binary);
 }
 }
 
@@ -17,6 +17,7 @@ project "AssetLib"
     
     externalincludedirs {
         IncludeDir["lz4"],
+        IncludeDir["zstd"],
         IncludeDir["glaze"],
         IncludeDir["glm"],
         IncludeDir["volk"],
@@ -29,5 +30,6 @@ project "AssetLib"
 
     links {
         "lz4",
+        "zstd",
         "CoreLib",
     }
\ No newline at end of file
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <CoreLib/types.h>
+
+#include <array>
+#include <bit>
+
+namespace lux
+{
+/* fixed-size bitset of `Bits` bits, stored as little-endian 64-bit words;
+ * bit `i` lives in the 32-bit word `i / 32`, so that the memory layout matches shader-side `uint[Bits / 32]`.
+ * All operations are plain loops over a compile-time number of words, which compilers turn into SIMD ops */
+template <u32 Bits>
+class WideBitSet
+{
+    static_assert(Bits > 0 && Bits % 64 == 0, "WideBitSet size must be a multiple of 64");
+public:
+    static constexpr u32 BITS = Bits;
+    static constexpr u32 WORD_BITS = 64;
+    static constexpr u32 WORD_COUNT = Bits / WORD_BITS;
+    using Word = u64;
+public:
+    constexpr WideBitSet() = default;
+    /* sets the lowest 64 bits */
+    constexpr WideBitSet(u64 lowBits) { m_Words[0] = lowBits; }
+
+    static constexpr WideBitSet Bit(u32 index);
+    /* all bits in `[0, count)` are set */
+    static constexpr WideBitSet FirstN(u32 count);
+    static constexpr WideBitSet All() { return ~WideBitSet{}; }
+
+    constexpr bool Test(u32 index) const { return (m_Words[index / WORD_BITS] >> (index % WORD_BITS)) & 1; }
+    constexpr WideBitSet& Set(u32 index);
+    constexpr WideBitSet& Reset(u32 index);
+
+    constexpr bool Any() const;
+    constexpr bool None() const { return !Any(); }
+    constexpr u32 Count() const;
+    /* index of the lowest set bit, `BITS` if none */
+    constexpr u32 FirstSetBit() const;
+    /* same as `(*this & other).Any()`, without materializing the intersection */
+    constexpr bool Intersects(const WideBitSet& other) const;
+
+    template <typename Fn>
+    requires requires (Fn fn, u32 index) { fn(index); }
+    constexpr void ForEachSetBit(Fn&& fn) const;
+
+    constexpr Word GetWord(u32 index) const { return m_Words[index]; }
+    constexpr void SetWord(u32 index, Word word) { m_Words[index] = word; }
+
+    constexpr WideBitSet operator~() const;
+    constexpr WideBitSet& operator|=(const WideBitSet& other);
+    constexpr WideBitSet& operator&=(const WideBitSet& other);
+    constexpr WideBitSet& operator^=(const WideBitSet& other);
+    /* `*this &= ~other` */
+    constexpr WideBitSet& AndNot(const WideBitSet& other);
+
+    friend constexpr WideBitSet operator|(WideBitSet a, const WideBitSet& b) { return a |= b; }
+    friend constexpr WideBitSet operator&(WideBitSet a, const WideBitSet& b) { return a &= b; }
+    friend constexpr WideBitSet operator^(WideBitSet a, const WideBitSet& b) { return a ^= b; }
+
+    constexpr bool operator==(const WideBitSet&) const = default;
+private:
+    std::array<Word, WORD_COUNT> m_Words{};
+};
+
+template <u32 Bits>
+constexpr WideBitSet<Bits> WideBitSet<Bits>::Bit(u32 index)
+{
+    WideBitSet bitSet;
+    bitSet.Set(index);
+
+    return bitSet;
+}
+
+template <u32 Bits>
+constexpr WideBitSet<Bits> WideBitSet<Bits>::FirstN(u32 count)
+{
+    WideBitSet bitSet;
+    for (u32 i = 0; i < WORD_COUNT; i++)
+    {
+        const u32 firstBit = i * WORD_BITS;
+        if (count >= firstBit + WORD_BITS)
+            bitSet.m_Words[i] = ~Word{0};
+        else if (count > firstBit)
+            bitSet.m_Words[i] = (Word{1} << (count - firstBit)) - 1;
+    }
+
+    return bitSet;
+}
+
+template <u32 Bits>
+constexpr WideBitSet<Bits>& WideBitSet<Bits>::Set(u32 index)
+{
+    m_Words[index / WORD_BITS] |= Word{1} << (index % WORD_BITS);
+
+    return *this;
+}
+
+template <u32 Bits>
+constexpr WideBitSet<Bits>& WideBitSet<Bits>::Reset(u32 index)
+{
+    m_Words[index / WORD_BITS] &= ~(Word{1} << (index % WORD_BITS));
+
+    return *this;
+}
+
+template <u32 Bits>
+constexpr bool WideBitSet<Bits>::Any() const
+{
+    Word any = 0;
+    for (u32 i = 0; i < WORD_COUNT; i++)
+        any |= m_Words[i];
+
+    return any != 0;
+}
+
+template <u32 Bits>
+constexpr u32 WideBitSet<Bits>::Count() const
+{
+    u32 count = 0;
+    for (u32 i = 0; i < WORD_COUNT; i++)
+        count += (u32)std::popcount(m_Words[i]);
+
+    return count;
+}
+
+template <u32 Bits>
+constexpr u32 WideBitSet<Bits>::FirstSetBit() const
+{
+    for (u32 i = 0; i < WORD_COUNT; i++)
+        if (m_Words[i] != 0)
+            return i * WORD_BITS + (u32)std::countr_zero(m_Words[i]);
+
+    return BITS;
+}
+
+template <u32 Bits>
+constexpr bool WideBitSet<Bits>::Intersects(const WideBitSet& other) const
+{
+    Word any = 0;
+    for (u32 i = 0; i < WORD_COUNT; i++)
+        any |= m_Words[i] & other.m_Words[i];
+
+    return any != 0;
+}
+
+template <u32 Bits>
+template <typename Fn>
+requires requires (Fn fn, u32 index) { fn(index); }
+constexpr void WideBitSet<Bits>::ForEachSetBit(Fn&& fn) const
+{
+    for (u32 i = 0; i < WORD_COUNT; i++)
+    {
+        Word word = m_Words[i];
+        while (word != 0)
+        {
+            fn(i * WORD_BITS + (u32)std::countr_zero(word));
+            word &= word - 1;
+        }
+    }
+}
+
+template <u32 Bits>
+constexpr WideBitSet<Bits> WideBitSet<Bits>::operator~() const
+{
+    WideBitSet bitSet;
+    for (u32 i = 0; i < WORD_COUNT; i++)
+        bitSet.m_Words[i] = ~m_Words[i];
+
+    return bitSet;
+}
+
+template <u32 Bits>
+constexpr WideBitSet<Bits>& WideBitSet<Bits>::operator|=(const WideBitSet& other)
+{
+    for (u32 i = 0; i < WORD_COUNT; i++)
+        m_Words[i] |= other.m_Words[i];
+
+    return *this;
+}
+
+template <u32 Bits>
+constexpr WideBitSet<Bits>& WideBitSet<Bits>::operator&=(const WideBitSet& other)
+{
+    for (u32 i = 0; i < WORD_COUNT; i++)
+        m_Words[i] &= other.m_Words[i];
+
+    return *this;
+}
+
+template <u32 Bits>
+constexpr WideBitSet<Bits>& WideBitSet<Bits>::operator^=(const WideBitSet& other)
+{
+    for (u32 i = 0; i < WORD_COUNT; i++)
+        m_Words[i] ^= other.m_Words[i];
+
+    return *this;
+}
+
+template <u32 Bits>
+constexpr WideBitSet<Bits>& WideBitSet<Bits>::AndNot(const WideBitSet& other)
+{
+    for (u32 i = 0; i < WORD_COUNT; i++)
+        m_Words[i] &= ~other.m_Words[i];
+
+    return *this;
+}
+}
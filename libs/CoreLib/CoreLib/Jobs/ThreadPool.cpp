@@ -0,0 +1,150 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace lux
+{
+namespace
+{
+    /* nested `ParallelFor` calls are the only way to have several jobs in flight */
+    constexpr u32 MAX_EXPECTED_PARALLEL_JOBS = 64;
+
+    std::atomic<ThreadPool*> globalOverride = nullptr;
+}
+
+ThreadPool::ThreadPool(std::optional<u32> workerCount)
+{
+    const u32 count = workerCount.value_or(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+
+    m_ParallelJobs.reserve(MAX_EXPECTED_PARALLEL_JOBS);
+    m_Workers.reserve(count);
+    for (u32 i = 0; i < count; i++)
+        m_Workers.emplace_back([this]()
+        {
+            WorkerLoop();
+        });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Exit = true;
+    }
+    m_Cv.notify_all();
+    for (auto& worker : m_Workers)
+        worker.join();
+}
+
+ThreadPool& ThreadPool::Global()
+{
+    if (ThreadPool* pool = globalOverride.load(std::memory_order_acquire))
+        return *pool;
+
+    static ThreadPool pool;
+
+    return pool;
+}
+
+ThreadPool::ScopedGlobal::ScopedGlobal(ThreadPool& pool)
+    : m_Previous(globalOverride.exchange(&pool, std::memory_order_acq_rel))
+{
+}
+
+ThreadPool::ScopedGlobal::~ScopedGlobal()
+{
+    globalOverride.store(m_Previous, std::memory_order_release);
+}
+
+std::future<void> ThreadPool::Submit(std::function<void()>&& task)
+{
+    std::packaged_task<void()> packagedTask(std::move(task));
+    std::future<void> future = packagedTask.get_future();
+    if (m_Workers.empty())
+    {
+        packagedTask();
+        return future;
+    }
+
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Tasks.push(std::move(packagedTask));
+    }
+    m_Cv.notify_one();
+
+    return future;
+}
+
+void ThreadPool::RunParallelJob(ParallelJob& job)
+{
+    {
+        std::lock_guard lock(m_Mutex);
+        m_ParallelJobs.push_back(&job);
+    }
+    m_Cv.notify_all();
+
+    RunChunks(job);
+
+    /* no new helpers can join after the job is removed, then wait for the ones that are still running chunks */
+    std::unique_lock lock(m_Mutex);
+    m_ParallelJobs.erase(std::ranges::find(m_ParallelJobs, &job));
+    m_HelperCv.wait(lock, [&job]() { return job.Helpers == 0; });
+}
+
+void ThreadPool::RunChunks(ParallelJob& job)
+{
+    for (;;)
+    {
+        const u32 chunk = job.NextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= job.ChunkCount)
+            return;
+        job.Invoke(job.Fn, chunk, chunk * job.ChunkSize, std::min(job.Count, (chunk + 1) * job.ChunkSize));
+    }
+}
+
+void ThreadPool::WorkerLoop()
+{
+    for (;;)
+    {
+        std::unique_lock lock(m_Mutex);
+        m_Cv.wait(lock, [this]()
+        {
+            if (m_Exit || !m_Tasks.empty())
+                return true;
+            return std::ranges::any_of(m_ParallelJobs, [](const ParallelJob* job)
+            {
+                return job->NextChunk.load(std::memory_order_relaxed) < job->ChunkCount;
+            });
+        });
+        if (m_Exit)
+            return;
+
+        /* parallel jobs have someone waiting on them, so they go first */
+        auto it = std::ranges::find_if(m_ParallelJobs, [](const ParallelJob* job)
+        {
+            return job->NextChunk.load(std::memory_order_relaxed) < job->ChunkCount;
+        });
+        if (it != m_ParallelJobs.end())
+        {
+            ParallelJob& job = **it;
+            job.Helpers++;
+            lock.unlock();
+
+            RunChunks(job);
+
+            /* `job` lives on the stack of the `ParallelFor` caller, it must not be touched after this */
+            lock.lock();
+            job.Helpers--;
+            lock.unlock();
+            m_HelperCv.notify_all();
+            continue;
+        }
+
+        std::packaged_task<void()> task = std::move(m_Tasks.front());
+        m_Tasks.pop();
+        lock.unlock();
+
+        task();
+    }
+}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <CoreLib/types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace lux
+{
+/* fixed set of worker threads for short cpu-heavy tasks.
+ * `ParallelFor` does not allocate, and the calling thread takes part in it,
+ * so it is fine to call it from inside of another task */
+class ThreadPool
+{
+public:
+    /* no `workerCount` means one worker less than there are hardware threads,
+     * and with 0 workers everything runs on the calling thread */
+    explicit ThreadPool(std::optional<u32> workerCount = std::nullopt);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /* pool shared by the engine and the tools */
+    static ThreadPool& Global();
+    /* makes `Global()` return `pool` while it is alive, so that a tool runs all of the parallel work of the libraries
+     * it calls with its own thread count; it must not be created while other threads use `Global()` */
+    class ScopedGlobal
+    {
+    public:
+        explicit ScopedGlobal(ThreadPool& pool);
+        ~ScopedGlobal();
+        ScopedGlobal(const ScopedGlobal&) = delete;
+        ScopedGlobal& operator=(const ScopedGlobal&) = delete;
+        ScopedGlobal(ScopedGlobal&&) = delete;
+        ScopedGlobal& operator=(ScopedGlobal&&) = delete;
+    private:
+        ThreadPool* m_Previous{nullptr};
+    };
+
+    u32 WorkerCount() const { return (u32)m_Workers.size(); }
+    /* number of threads that can run chunks of a `ParallelFor` at once */
+    u32 Concurrency() const { return WorkerCount() + 1; }
+
+    std::future<void> Submit(std::function<void()>&& task);
+
+    /* calls `fn(chunkIndex, begin, end)` for every `chunkSize` sized chunk of [0, count) and waits for all of them;
+     * chunk indices are in [0, ChunkCount(count, chunkSize)) */
+    template <typename Fn>
+    void ParallelFor(u32 count, u32 chunkSize, Fn&& fn);
+    static constexpr u32 ChunkCount(u32 count, u32 chunkSize) { return (count + chunkSize - 1) / chunkSize; }
+private:
+    struct ParallelJob
+    {
+        void* Fn{nullptr};
+        void (*Invoke)(void* fn, u32 chunkIndex, u32 begin, u32 end){nullptr};
+        u32 Count{0};
+        u32 ChunkSize{0};
+        u32 ChunkCount{0};
+        std::atomic<u32> NextChunk{0};
+        /* workers that are still inside of this job, guarded by `m_Mutex` */
+        u32 Helpers{0};
+    };
+    void RunParallelJob(ParallelJob& job);
+    static void RunChunks(ParallelJob& job);
+    void WorkerLoop();
+private:
+    std::vector<std::thread> m_Workers;
+    std::queue<std::packaged_task<void()>> m_Tasks;
+    /* jobs of `ParallelFor` calls in flight, the storage is reserved upfront */
+    std::vector<ParallelJob*> m_ParallelJobs;
+    std::condition_variable m_Cv;
+    /* signaled when a worker leaves a parallel job */
+    std::condition_variable m_HelperCv;
+    std::mutex m_Mutex;
+    bool m_Exit{false};
+};
+
+template <typename Fn>
+void ThreadPool::ParallelFor(u32 count, u32 chunkSize, Fn&& fn)
+{
+    chunkSize = std::max(chunkSize, 1u);
+    const u32 chunkCount = ChunkCount(count, chunkSize);
+    if (chunkCount == 0)
+        return;
+    if (chunkCount == 1 || m_Workers.empty())
+    {
+        for (u32 chunk = 0; chunk < chunkCount; chunk++)
+            fn(chunk, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+        return;
+    }
+
+    using FnType = std::remove_reference_t<Fn>;
+    ParallelJob job = {};
+    job.Fn = (void*)&fn;
+    job.Invoke = [](void* fnAddress, u32 chunkIndex, u32 begin, u32 end)
+    {
+        (*(FnType*)fnAddress)(chunkIndex, begin, end);
+    };
+    job.Count = count;
+    job.ChunkSize = chunkSize;
+    job.ChunkCount = chunkCount;
+    RunParallelJob(job);
+}
+}
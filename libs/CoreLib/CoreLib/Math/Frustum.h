@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Geometry.h"
+
+#include <array>
+
+/* world-space view frustum as 6 planes that point inside */
+struct Frustum
+{
+    static constexpr u32 PLANE_COUNT = 6;
+    std::array<Plane, PLANE_COUNT> Planes{};
+
+    /* extracts the planes of the clip volume `-w <= x, y <= w, 0 <= z <= w` (Gribb-Hartmann),
+     * reversed and infinite depth are supported: a degenerate depth plane never culls anything */
+    static Frustum FromViewProjection(const glm::mat4& viewProjection);
+
+    bool Intersects(const AABB& bounds) const;
+    bool Intersects(const Sphere& sphere) const;
+    bool Intersects(const Cone& cone) const;
+};
+
+inline Frustum Frustum::FromViewProjection(const glm::mat4& viewProjection)
+{
+    const glm::mat4 transposed = glm::transpose(viewProjection);
+    const std::array<glm::vec4, PLANE_COUNT> equations = {
+        transposed[3] + transposed[0],
+        transposed[3] - transposed[0],
+        transposed[3] + transposed[1],
+        transposed[3] - transposed[1],
+        transposed[2],
+        transposed[3] - transposed[2],
+    };
+
+    Frustum frustum = {};
+    for (u32 i = 0; i < PLANE_COUNT; i++)
+    {
+        const glm::vec3 normal = glm::vec3{equations[i]};
+        const f32 length = glm::length(normal);
+        if (length < 1e-12f)
+        {
+            frustum.Planes[i] = {.Normal = glm::vec3{0.0f}, .Offset = 0.0f};
+            continue;
+        }
+        frustum.Planes[i] = {.Normal = normal / length, .Offset = equations[i].w / length};
+    }
+
+    return frustum;
+}
+
+inline bool Frustum::Intersects(const AABB& bounds) const
+{
+    const glm::vec3 center = (bounds.Min + bounds.Max) * 0.5f;
+    const glm::vec3 extent = (bounds.Max - bounds.Min) * 0.5f;
+    for (auto& plane : Planes)
+        if (plane.SignedDistance(center) < -glm::dot(extent, glm::abs(plane.Normal)))
+            return false;
+
+    return true;
+}
+
+inline bool Frustum::Intersects(const Sphere& sphere) const
+{
+    for (auto& plane : Planes)
+        if (plane.SignedDistance(sphere.Center) < -sphere.Radius)
+            return false;
+
+    return true;
+}
+
+inline bool Frustum::Intersects(const Cone& cone) const
+{
+    for (auto& plane : Planes)
+        if (cone.Extent(plane.Normal) + plane.Offset < 0.0f)
+            return false;
+
+    return true;
+}
@@ -27,6 +27,25 @@ struct Sphere
     Sphere Merge(const Sphere& other) const;
 };
 
+/* volume lit by a spot light: the points within `Height` of the apex and within `HalfAngle` of the axis.
+ * It is bounded both by the flat capped cone and by a sphere, the tests use whichever is tighter */
+struct Cone
+{
+    glm::vec3 Apex{0.0f};
+    glm::vec3 Axis{0.0f, 0.0f, -1.0f};
+    f32 Height{1.0f};
+    f32 CosHalfAngle{1.0f};
+    f32 SinHalfAngle{0.0f};
+
+    static Cone FromHalfAngle(const glm::vec3& apex, const glm::vec3& axis, f32 height, f32 halfAngle);
+
+    Sphere BoundingSphere() const;
+    /* max of `dot(point, direction)` over the cone, `direction` has to be normalized */
+    f32 Extent(const glm::vec3& direction) const;
+    bool Intersects(const Sphere& sphere) const;
+    Cone Transform(const glm::mat4& transform) const;
+};
+
 struct Plane
 {
     glm::vec3 Normal{0.0f, 1.0f, 0.0f};
@@ -118,3 +137,68 @@ inline Plane Plane::ByPointAndNormal(const glm::vec3& point, const glm::vec3& no
 
     return plane;
 }
+
+inline Cone Cone::FromHalfAngle(const glm::vec3& apex, const glm::vec3& axis, f32 height, f32 halfAngle)
+{
+    return {
+        .Apex = apex,
+        .Axis = glm::normalize(axis),
+        .Height = height,
+        .CosHalfAngle = std::cos(halfAngle),
+        .SinHalfAngle = std::sin(halfAngle)};
+}
+
+inline Sphere Cone::BoundingSphere() const
+{
+    /* wide cones are bounded by the sphere around the cap rim,
+     * narrow ones by the sphere through the apex and the cap rim (see "Cull that cone" by Bart Wronski) */
+    static constexpr f32 COS_QUARTER_PI = 0.70710678f;
+    if (CosHalfAngle < COS_QUARTER_PI)
+        return {
+            .Center = Apex + Axis * (Height * CosHalfAngle),
+            .Radius = Height * SinHalfAngle};
+
+    const f32 radius = Height / (2.0f * CosHalfAngle);
+
+    return {
+        .Center = Apex + Axis * radius,
+        .Radius = radius};
+}
+
+inline f32 Cone::Extent(const glm::vec3& direction) const
+{
+    const f32 alongAxis = glm::dot(direction, Axis);
+    const f32 capRadius = Height * SinHalfAngle / std::max(CosHalfAngle, 1e-6f);
+    const f32 coneExtent = std::max(
+        glm::dot(direction, Apex),
+        glm::dot(direction, Apex + Axis * Height) + capRadius * std::sqrt(std::max(0.0f, 1.0f - alongAxis * alongAxis)));
+
+    const Sphere sphere = BoundingSphere();
+
+    return std::min(coneExtent, glm::dot(direction, sphere.Center) + sphere.Radius);
+}
+
+inline bool Cone::Intersects(const Sphere& sphere) const
+{
+    const glm::vec3 toCenter = sphere.Center - Apex;
+    const f32 distance2 = glm::dot(toCenter, toCenter);
+    const f32 alongAxis = glm::dot(toCenter, Axis);
+    const f32 distanceToSide =
+        CosHalfAngle * std::sqrt(std::max(0.0f, distance2 - alongAxis * alongAxis)) - alongAxis * SinHalfAngle;
+
+    const bool outsideAngle = distanceToSide > sphere.Radius;
+    const bool outsideFront = alongAxis > sphere.Radius + Height;
+    const bool outsideBack = alongAxis < -sphere.Radius;
+    const bool outsideRange = distance2 > (Height + sphere.Radius) * (Height + sphere.Radius);
+
+    return !(outsideAngle || outsideFront || outsideBack || outsideRange);
+}
+
+inline Cone Cone::Transform(const glm::mat4& transform) const
+{
+    Cone cone = *this;
+    cone.Apex = glm::vec3(transform * glm::vec4(Apex, 1.0f));
+    cone.Axis = glm::normalize(glm::vec3(transform * glm::vec4(Axis, 0.0f)));
+
+    return cone;
+}
@@ -0,0 +1,19 @@
+﻿#pragma once
+
+#include <CoreLib/types.h>
+
+#include <filesystem>
+#include <optional>
+
+namespace platform
+{
+    /* read-only mapping of a whole file, it does not keep the file open */
+    struct MappedFile
+    {
+        const std::byte* Data{nullptr};
+        u64 SizeBytes{0};
+    };
+
+    std::optional<MappedFile> mapFile(const std::filesystem::path& path);
+    void unmapFile(const MappedFile& file);
+}
@@ -0,0 +1,47 @@
+﻿#include "WindowsInclude.h"
+
+#include <CoreLib/core.h>
+#include <CoreLib/Platform/MappedFile/MappedFile.h>
+
+namespace platform
+{
+    std::optional<MappedFile> mapFile(const std::filesystem::path& path)
+    {
+        const HANDLE file = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return std::nullopt;
+
+        LARGE_INTEGER size = {};
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return std::nullopt;
+        }
+        /* empty files cannot be mapped */
+        if (size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return MappedFile{};
+        }
+
+        /* the view keeps the mapping and the file alive, so both handles can be closed right away */
+        const HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr)
+            return std::nullopt;
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (view == nullptr)
+            return std::nullopt;
+
+        return MappedFile{.Data = (const std::byte*)view, .SizeBytes = (u64)size.QuadPart};
+    }
+
+    void unmapFile(const MappedFile& file)
+    {
+        if (file.Data != nullptr)
+            UnmapViewOfFile(file.Data);
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <CoreLib/types.h>
+#include <CoreLib/Containers/Span.h>
+
+#include <array>
+#include <bit>
+#include <vector>
+
+namespace lux
+{
+/* maps a float to a key that compares as unsigned integer in the same order as the float itself;
+ * -0.0 sorts before +0.0 and NaNs sort to the ends */
+constexpr u32 floatSortKey(f32 value)
+{
+    const u32 bits = std::bit_cast<u32>(value);
+    const u32 mask = (u32)-(i32)(bits >> 31) | 0x80000000u;
+
+    return bits ^ mask;
+}
+
+/* stable LSD radix sort over 11-bit digits, `order` gets the permutation that sorts `keys`;
+ * digits that are the same for all keys are skipped, `scratch` is only temporary storage
+ * so that the callers can keep it around and not allocate every time */
+inline void radixSortIndices(Span<const u32> keys, std::vector<u32>& order, std::vector<u32>& scratch)
+{
+    static constexpr u32 DIGIT_BITS = 11;
+    static constexpr u32 DIGIT_COUNT = 1u << DIGIT_BITS;
+    static constexpr u32 DIGIT_MASK = DIGIT_COUNT - 1;
+    static constexpr u32 PASS_COUNT = (32 + DIGIT_BITS - 1) / DIGIT_BITS;
+
+    const u32 count = (u32)keys.size();
+    order.resize(count);
+    scratch.resize(count);
+    for (u32 i = 0; i < count; i++)
+        order[i] = i;
+
+    std::array<std::array<u32, DIGIT_COUNT>, PASS_COUNT> histograms{};
+    for (u32 key : keys)
+        for (u32 pass = 0; pass < PASS_COUNT; pass++)
+            histograms[pass][(key >> (pass * DIGIT_BITS)) & DIGIT_MASK]++;
+
+    for (u32 pass = 0; pass < PASS_COUNT; pass++)
+    {
+        auto& histogram = histograms[pass];
+        const u32 shift = pass * DIGIT_BITS;
+        if (count == 0 || histogram[(keys[0] >> shift) & DIGIT_MASK] == count)
+            continue;
+
+        u32 offset = 0;
+        for (u32& bucket : histogram)
+        {
+            const u32 bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for (u32 index : order)
+            scratch[histogram[(keys[index] >> shift) & DIGIT_MASK]++] = index;
+        order.swap(scratch);
+    }
+}
+}
@@ -0,0 +1,119 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <CoreLib/Containers/WideBitSet.h>
+
+#include <bitset>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// NOLINTBEGIN
+
+namespace
+{
+template <u32 Bits>
+std::bitset<Bits> toReference(const lux::WideBitSet<Bits>& bitSet)
+{
+    std::bitset<Bits> reference;
+    for (u32 i = 0; i < Bits; i++)
+        reference[i] = bitSet.Test(i);
+
+    return reference;
+}
+
+template <u32 Bits>
+lux::WideBitSet<Bits> randomBitSet(std::mt19937_64& rng)
+{
+    lux::WideBitSet<Bits> bitSet;
+    for (u32 i = 0; i < lux::WideBitSet<Bits>::WORD_COUNT; i++)
+        bitSet.SetWord(i, rng() & rng());
+
+    return bitSet;
+}
+}
+
+TEST_CASE("WideBitSet", "[Containers][WideBitSet]")
+{
+    using BitSet = lux::WideBitSet<256>;
+    SECTION("Is empty by default")
+    {
+        BitSet bitSet;
+        REQUIRE(bitSet.None());
+        REQUIRE(bitSet.Count() == 0);
+        REQUIRE(bitSet.FirstSetBit() == BitSet::BITS);
+    }
+    SECTION("Can set and reset bits in every word")
+    {
+        BitSet bitSet;
+        for (u32 bit : {0u, 63u, 64u, 127u, 200u, 255u})
+        {
+            bitSet.Set(bit);
+            REQUIRE(bitSet.Test(bit));
+        }
+        REQUIRE(bitSet.Count() == 6);
+        REQUIRE(bitSet.FirstSetBit() == 0);
+        bitSet.Reset(0);
+        REQUIRE(!bitSet.Test(0));
+        REQUIRE(bitSet.FirstSetBit() == 63);
+    }
+    SECTION("Low bits constructor sets the first word only")
+    {
+        BitSet bitSet = 0b101llu;
+        REQUIRE(bitSet.Test(0));
+        REQUIRE(!bitSet.Test(1));
+        REQUIRE(bitSet.Test(2));
+        REQUIRE(bitSet.Count() == 2);
+    }
+    SECTION("FirstN sets exactly n bits")
+    {
+        for (u32 n : {0u, 1u, 63u, 64u, 65u, 128u, 255u, 256u})
+        {
+            const BitSet bitSet = BitSet::FirstN(n);
+            REQUIRE(bitSet.Count() == n);
+            if (n > 0)
+                REQUIRE(bitSet.Test(n - 1));
+            if (n < BitSet::BITS)
+                REQUIRE(!bitSet.Test(n));
+        }
+        REQUIRE(BitSet::All().Count() == BitSet::BITS);
+    }
+    SECTION("Has the memory layout of 32-bit shader words")
+    {
+        BitSet bitSet;
+        bitSet.Set(33).Set(130);
+        std::array<u32, BitSet::BITS / 32> words{};
+        static_assert(sizeof(words) == sizeof(BitSet));
+        std::memcpy(words.data(), &bitSet, sizeof(bitSet));
+        REQUIRE(words[1] == 1u << 1);
+        REQUIRE(words[4] == 1u << 2);
+    }
+    SECTION("Bitwise ops match std::bitset")
+    {
+        std::mt19937_64 rng(42);
+        for (u32 iteration = 0; iteration < 256; iteration++)
+        {
+            const BitSet a = randomBitSet<BitSet::BITS>(rng);
+            const BitSet b = randomBitSet<BitSet::BITS>(rng);
+            const auto refA = toReference(a);
+            const auto refB = toReference(b);
+
+            REQUIRE(toReference(a | b) == (refA | refB));
+            REQUIRE(toReference(a & b) == (refA & refB));
+            REQUIRE(toReference(a ^ b) == (refA ^ refB));
+            REQUIRE(toReference(~a) == ~refA);
+            REQUIRE(toReference(BitSet(a).AndNot(b)) == (refA & ~refB));
+            REQUIRE(a.Count() == refA.count());
+            REQUIRE(a.Any() == refA.any());
+            REQUIRE(a.Intersects(b) == (refA & refB).any());
+
+            std::vector<u32> setBits;
+            a.ForEachSetBit([&setBits](u32 bit) { setBits.push_back(bit); });
+            std::vector<u32> expectedBits;
+            for (u32 i = 0; i < BitSet::BITS; i++)
+                if (refA[i])
+                    expectedBits.push_back(i);
+            REQUIRE(setBits == expectedBits);
+            REQUIRE(a.FirstSetBit() == (expectedBits.empty() ? BitSet::BITS : expectedBits.front()));
+        }
+    }
+}
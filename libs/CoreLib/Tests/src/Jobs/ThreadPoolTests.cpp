@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <CoreLib/Jobs/ThreadPool.h>
+
+#include <numeric>
+
+// NOLINTBEGIN
+
+TEST_CASE("ThreadPool", "[Jobs][ThreadPool]")
+{
+    lux::ThreadPool pool(3);
+    REQUIRE(pool.WorkerCount() == 3);
+    REQUIRE(pool.Concurrency() == 4);
+
+    SECTION("ParallelFor visits every element exactly once")
+    {
+        std::vector<std::atomic<u32>> visits(10001);
+        std::vector<std::atomic<u32>> chunks(lux::ThreadPool::ChunkCount(10001, 64));
+        /* catch2 assertions are not thread safe */
+        std::atomic<bool> chunksMatch{true};
+        pool.ParallelFor(10001, 64, [&](u32 chunk, u32 begin, u32 end)
+        {
+            if (begin != chunk * 64)
+                chunksMatch = false;
+            chunks[chunk]++;
+            for (u32 i = begin; i < end; i++)
+                visits[i]++;
+        });
+        for (auto& visit : visits)
+            REQUIRE(visit == 1);
+        REQUIRE(chunksMatch);
+        for (auto& chunk : chunks)
+            REQUIRE(chunk == 1);
+    }
+    SECTION("Empty ParallelFor does nothing")
+    {
+        bool called = false;
+        pool.ParallelFor(0, 16, [&](u32, u32, u32) { called = true; });
+        REQUIRE(!called);
+    }
+    SECTION("Nested ParallelFor does not deadlock")
+    {
+        std::atomic<u32> sum{0};
+        pool.ParallelFor(16, 1, [&](u32, u32, u32)
+        {
+            pool.ParallelFor(100, 7, [&](u32, u32 begin, u32 end)
+            {
+                sum += end - begin;
+            });
+        });
+        REQUIRE(sum == 1600);
+    }
+    SECTION("Submitted tasks run")
+    {
+        std::vector<u32> results(32);
+        std::vector<std::future<void>> futures;
+        for (u32 i = 0; i < results.size(); i++)
+            futures.push_back(pool.Submit([&results, i]() { results[i] = i * i; }));
+        for (auto& future : futures)
+            future.wait();
+        for (u32 i = 0; i < results.size(); i++)
+            REQUIRE(results[i] == i * i);
+    }
+    SECTION("Pool without workers runs everything on the calling thread")
+    {
+        lux::ThreadPool serial(0);
+        REQUIRE(serial.Concurrency() == 1);
+        const std::thread::id caller = std::this_thread::get_id();
+        bool onCaller = true;
+        serial.ParallelFor(100, 7, [&](u32, u32, u32) { onCaller = onCaller && std::this_thread::get_id() == caller; });
+        serial.Submit([&]() { onCaller = onCaller && std::this_thread::get_id() == caller; }).wait();
+        REQUIRE(onCaller);
+    }
+    SECTION("Scoped global replaces the global pool while it is alive")
+    {
+        lux::ThreadPool& global = lux::ThreadPool::Global();
+        {
+            lux::ThreadPool::ScopedGlobal scopedGlobal(pool);
+            REQUIRE(&lux::ThreadPool::Global() == &pool);
+        }
+        REQUIRE(&lux::ThreadPool::Global() == &global);
+    }
+}
@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <CoreLib/Math/Frustum.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
+// NOLINTBEGIN
+
+namespace
+{
+/* same as the renderer's perspective camera */
+glm::mat4 infiniteReverseDepthProjection(f32 fovY, f32 aspect, f32 near)
+{
+    const f32 tanHalfFov = std::tan(fovY * 0.5f);
+    glm::mat4 projection(0.0f);
+    projection[0][0] = 1.0f / (aspect * tanHalfFov);
+    projection[1][1] = 1.0f / tanHalfFov;
+    projection[2][3] = -1.0f;
+    projection[3][2] = near;
+
+    return projection;
+}
+
+AABB pointBounds(const glm::vec3& point)
+{
+    return {.Min = point, .Max = point};
+}
+
+/* -1 if the point is clearly outside of the clip volume, 1 if it is clearly inside, 0 if it is too close to call */
+i32 clipClassify(const glm::mat4& viewProjection, const glm::vec3& point)
+{
+    const glm::vec4 clip = viewProjection * glm::vec4{point, 1.0f};
+    const f32 epsilon = 1e-3f * std::abs(clip.w);
+    const f32 margins[] = {clip.w + clip.x, clip.w - clip.x, clip.w + clip.y, clip.w - clip.y, clip.z, clip.w - clip.z};
+    f32 minMargin = std::numeric_limits<f32>::max();
+    for (f32 margin : margins)
+        minMargin = std::min(minMargin, margin);
+    if (std::abs(minMargin) < epsilon)
+        return 0;
+
+    return minMargin > 0.0f ? 1 : -1;
+}
+}
+
+TEST_CASE("Frustum", "[Math][Frustum]")
+{
+    const glm::mat4 view = glm::lookAtRH(glm::vec3{0.0f}, glm::vec3{0.0f, 0.0f, -1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+    SECTION("Perspective frustum culls boxes outside")
+    {
+        const Frustum frustum = Frustum::FromViewProjection(
+            glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, 0.1f, 100.0f) * view);
+
+        REQUIRE(frustum.Intersects(AABB{.Min = {-1.0f, -1.0f, -11.0f}, .Max = {1.0f, 1.0f, -9.0f}}));
+        REQUIRE(!frustum.Intersects(AABB{.Min = {-1.0f, -1.0f, 9.0f}, .Max = {1.0f, 1.0f, 11.0f}}));
+        REQUIRE(!frustum.Intersects(AABB{.Min = {-30.0f, -1.0f, -11.0f}, .Max = {-20.0f, 1.0f, -9.0f}}));
+        REQUIRE(!frustum.Intersects(AABB{.Min = {-1.0f, -1.0f, -300.0f}, .Max = {1.0f, 1.0f, -200.0f}}));
+        /* straddles the left plane */
+        REQUIRE(frustum.Intersects(AABB{.Min = {-30.0f, -1.0f, -11.0f}, .Max = {-9.0f, 1.0f, -9.0f}}));
+    }
+    SECTION("Infinite reverse depth never culls by distance")
+    {
+        const Frustum frustum = Frustum::FromViewProjection(
+            infiniteReverseDepthProjection(glm::radians(60.0f), 16.0f / 9.0f, 0.1f) * view);
+
+        REQUIRE(frustum.Intersects(AABB{.Min = {-1.0f, -1.0f, -1e6f}, .Max = {1.0f, 1.0f, -0.9e6f}}));
+        REQUIRE(!frustum.Intersects(AABB{.Min = {-1.0f, -1.0f, 1.0f}, .Max = {1.0f, 1.0f, 2.0f}}));
+        REQUIRE(!frustum.Intersects(AABB{.Min = {-1.0f, -1.0f, -0.05f}, .Max = {1.0f, 1.0f, -0.01f}}));
+        for (auto& plane : frustum.Planes)
+            REQUIRE(!glm::any(glm::isnan(plane.Normal)));
+    }
+    SECTION("Reversed orthographic frustum")
+    {
+        const Frustum frustum = Frustum::FromViewProjection(
+            glm::orthoRH_ZO(-5.0f, 5.0f, -5.0f, 5.0f, 50.0f, 1.0f) * view);
+
+        REQUIRE(frustum.Intersects(AABB{.Min = {-1.0f, -1.0f, -11.0f}, .Max = {1.0f, 1.0f, -9.0f}}));
+        REQUIRE(!frustum.Intersects(AABB{.Min = {6.0f, -1.0f, -11.0f}, .Max = {7.0f, 1.0f, -9.0f}}));
+        REQUIRE(!frustum.Intersects(AABB{.Min = {-1.0f, -1.0f, -0.5f}, .Max = {1.0f, 1.0f, -0.1f}}));
+        REQUIRE(!frustum.Intersects(AABB{.Min = {-1.0f, -1.0f, -80.0f}, .Max = {1.0f, 1.0f, -60.0f}}));
+    }
+    SECTION("Spheres are tested against planes")
+    {
+        const Frustum frustum = Frustum::FromViewProjection(
+            glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, 0.1f, 100.0f) * view);
+
+        REQUIRE(frustum.Intersects(Sphere{.Center = {0.0f, 0.0f, -10.0f}, .Radius = 1.0f}));
+        REQUIRE(frustum.Intersects(Sphere{.Center = {0.0f, 0.0f, 1.0f}, .Radius = 2.0f}));
+        REQUIRE(!frustum.Intersects(Sphere{.Center = {0.0f, 0.0f, 5.0f}, .Radius = 2.0f}));
+    }
+    SECTION("Cones are tested against planes")
+    {
+        const Frustum frustum = Frustum::FromViewProjection(
+            glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, 0.1f, 100.0f) * view);
+
+        /* points into the view */
+        REQUIRE(frustum.Intersects(Cone::FromHalfAngle({0.0f, 0.0f, -5.0f}, {0.0f, 0.0f, -1.0f}, 5.0f,
+            glm::radians(20.0f))));
+        /* behind the camera, pointing away */
+        REQUIRE(!frustum.Intersects(Cone::FromHalfAngle({0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, 50.0f,
+            glm::radians(20.0f))));
+        /* to the left of the view, pointing away; its bounding sphere around the apex would intersect */
+        REQUIRE(!frustum.Intersects(Cone::FromHalfAngle({-12.0f, 0.0f, -10.0f}, {-1.0f, 0.0f, 0.0f}, 10.0f,
+            glm::radians(15.0f))));
+        /* outside of the view, reaching into it */
+        REQUIRE(frustum.Intersects(Cone::FromHalfAngle({-12.0f, 0.0f, -10.0f}, {1.0f, 0.0f, 0.0f}, 10.0f,
+            glm::radians(15.0f))));
+    }
+    SECTION("Point test matches clip space test")
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<f32> position(-50.0f, 50.0f);
+        const glm::mat4 rotatedView = glm::lookAtRH(glm::vec3{3.0f, 4.0f, 5.0f}, glm::vec3{-10.0f, 2.0f, -20.0f},
+            glm::vec3{0.0f, 1.0f, 0.0f});
+        const glm::mat4 viewProjection = glm::perspectiveRH_ZO(glm::radians(70.0f), 1.5f, 0.5f, 60.0f) * rotatedView;
+        const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+
+        for (u32 i = 0; i < 10000; i++)
+        {
+            const glm::vec3 point = {position(rng), position(rng), position(rng)};
+            const i32 expected = clipClassify(viewProjection, point);
+            if (expected == 0)
+                continue;
+            REQUIRE(frustum.Intersects(pointBounds(point)) == (expected > 0));
+        }
+    }
+}
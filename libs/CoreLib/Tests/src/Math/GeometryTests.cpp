@@ -4,6 +4,11 @@
 
 #include <CoreLib/Math/Geometry.h>
 
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+
 // NOLINTBEGIN
 
 TEST_CASE("Geometry AABB", "[Geometry]")
@@ -180,4 +185,101 @@ TEST_CASE("Geometry Plane", "[Geometry]")
     }
 }
 
+namespace
+{
+/* random points of the lit volume: within `Height` of the apex and within the half angle of the axis */
+std::vector<glm::vec3> sampleCone(const Cone& cone, u32 count, std::mt19937& rng)
+{
+    std::uniform_real_distribution<f32> unit(0.0f, 1.0f);
+    const glm::vec3 helper = std::abs(cone.Axis.x) < 0.9f ? glm::vec3{1.0f, 0.0f, 0.0f} : glm::vec3{0.0f, 1.0f, 0.0f};
+    const glm::vec3 tangent = glm::normalize(glm::cross(cone.Axis, helper));
+    const glm::vec3 bitangent = glm::cross(cone.Axis, tangent);
+    const f32 halfAngle = std::atan2(cone.SinHalfAngle, cone.CosHalfAngle);
+
+    std::vector<glm::vec3> points(count);
+    for (auto& point : points)
+    {
+        /* bias towards the boundary, that is where the bounds are tight */
+        const f32 angle = halfAngle * std::sqrt(unit(rng));
+        const f32 distance = cone.Height * std::sqrt(unit(rng));
+        const f32 turn = 2.0f * glm::pi<f32>() * unit(rng);
+        const glm::vec3 direction = cone.Axis * std::cos(angle) +
+            (tangent * std::cos(turn) + bitangent * std::sin(turn)) * std::sin(angle);
+        point = cone.Apex + direction * distance;
+    }
+
+    return points;
+}
+}
+
+TEST_CASE("Geometry Cone", "[Geometry]")
+{
+    const Cone cone = Cone::FromHalfAngle({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -2.0f}, 10.0f, glm::radians(30.0f));
+    REQUIRE_THAT(glm::length(cone.Axis), Catch::Matchers::WithinRel(1.0f, 1e-6f));
+
+    SECTION("Extent along the axis is exact")
+    {
+        REQUIRE_THAT(cone.Extent({0.0f, 0.0f, -1.0f}), Catch::Matchers::WithinRel(10.0f, 1e-5f));
+        REQUIRE_THAT(cone.Extent({0.0f, 0.0f, 1.0f}), Catch::Matchers::WithinAbs(0.0f, 1e-5f));
+    }
+    SECTION("Narrow cone is tighter than a sphere around the apex")
+    {
+        REQUIRE(cone.Extent({1.0f, 0.0f, 0.0f}) < 6.0f);
+        REQUIRE(cone.BoundingSphere().Radius < 6.0f);
+    }
+    SECTION("Bounds contain every point of the cone")
+    {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<f32> direction(-1.0f, 1.0f);
+        for (f32 halfAngle : {5.0f, 30.0f, 44.0f, 46.0f, 70.0f, 89.0f})
+        {
+            const Cone tested = Cone::FromHalfAngle({1.0f, -2.0f, 3.0f}, {0.3f, 0.5f, -1.0f}, 7.0f,
+                glm::radians(halfAngle));
+            const std::vector<glm::vec3> points = sampleCone(tested, 2000, rng);
+            const Sphere sphere = tested.BoundingSphere();
+            for (auto& point : points)
+                REQUIRE(glm::length(point - sphere.Center) <= sphere.Radius * (1.0f + 1e-5f));
+
+            for (u32 i = 0; i < 32; i++)
+            {
+                const glm::vec3 axis = glm::normalize(glm::vec3{direction(rng), direction(rng), direction(rng)});
+                const f32 extent = tested.Extent(axis);
+                for (auto& point : points)
+                    REQUIRE(glm::dot(point, axis) <= extent + 1e-4f);
+            }
+        }
+    }
+    SECTION("Sphere test has no false negatives")
+    {
+        std::mt19937 rng(13);
+        std::uniform_real_distribution<f32> offset(-1.0f, 1.0f);
+        for (auto& point : sampleCone(cone, 2000, rng))
+        {
+            const f32 radius = 0.5f * (offset(rng) + 1.0f);
+            const glm::vec3 center = point + glm::vec3{offset(rng), offset(rng), offset(rng)} * (radius * 0.57f);
+            REQUIRE(cone.Intersects(Sphere{.Center = center, .Radius = radius}));
+        }
+    }
+    SECTION("Sphere test culls spheres outside")
+    {
+        /* behind the apex */
+        REQUIRE(!cone.Intersects(Sphere{.Center = {0.0f, 0.0f, 2.0f}, .Radius = 1.0f}));
+        /* to the side */
+        REQUIRE(!cone.Intersects(Sphere{.Center = {6.0f, 0.0f, -3.0f}, .Radius = 1.0f}));
+        /* past the range */
+        REQUIRE(!cone.Intersects(Sphere{.Center = {0.0f, 0.0f, -12.0f}, .Radius = 1.0f}));
+        REQUIRE(cone.Intersects(Sphere{.Center = {0.0f, 0.0f, -10.5f}, .Radius = 1.0f}));
+    }
+    SECTION("Transform moves apex and axis")
+    {
+        const glm::mat4 transform = glm::translate(glm::mat4{1.0f}, glm::vec3{1.0f, 2.0f, 3.0f}) *
+            glm::rotate(glm::mat4{1.0f}, glm::radians(90.0f), glm::vec3{0.0f, 1.0f, 0.0f});
+        const Cone transformed = cone.Transform(transform);
+        REQUIRE_THAT(transformed.Apex.x, Catch::Matchers::WithinAbs(1.0f, 1e-5f));
+        REQUIRE_THAT(transformed.Apex.z, Catch::Matchers::WithinAbs(3.0f, 1e-5f));
+        REQUIRE_THAT(transformed.Axis.x, Catch::Matchers::WithinAbs(-1.0f, 1e-5f));
+        REQUIRE_THAT(transformed.Axis.z, Catch::Matchers::WithinAbs(0.0f, 1e-5f));
+    }
+}
+
 // NOLINTEND
\ No newline at end of file
@@ -0,0 +1,65 @@
+﻿#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <fstream>
+
+#include <CoreLib/Platform/MappedFile/MappedFile.h>
+
+// NOLINTBEGIN
+
+TEST_CASE("MappedFile", "[Platform][MappedFile]")
+{
+    namespace fs = std::filesystem;
+    fs::path testDir = fs::temp_directory_path();
+    testDir /= "MappedFileTests";
+    fs::create_directory(testDir);
+
+    SECTION("Mapped file has the contents of the file")
+    {
+        const fs::path path = testDir / "file.bin";
+        std::string contents(100'000, 0);
+        for (u32 i = 0; i < contents.size(); i++)
+            contents[i] = (char)(i * 31 + 7);
+        {
+            std::ofstream out(path, std::ios::binary);
+            out.write(contents.data(), (isize)contents.size());
+        }
+
+        const auto file = platform::mapFile(path);
+        REQUIRE(file.has_value());
+        REQUIRE(file->SizeBytes == contents.size());
+        REQUIRE(std::memcmp(file->Data, contents.data(), contents.size()) == 0);
+        platform::unmapFile(*file);
+
+        REQUIRE(fs::remove(path));
+    }
+    SECTION("Empty file maps to an empty view")
+    {
+        const fs::path path = testDir / "empty.bin";
+        std::ofstream(path, std::ios::binary).close();
+
+        const auto file = platform::mapFile(path);
+        REQUIRE(file.has_value());
+        REQUIRE(file->SizeBytes == 0);
+        platform::unmapFile(*file);
+    }
+    SECTION("Missing file cannot be mapped")
+    {
+        REQUIRE_FALSE(platform::mapFile(testDir / "missing.bin").has_value());
+    }
+    SECTION("File can be rewritten after it was unmapped")
+    {
+        const fs::path path = testDir / "rewritten.bin";
+        std::ofstream(path, std::ios::binary) << "first";
+
+        const auto first = platform::mapFile(path);
+        REQUIRE(first.has_value());
+        platform::unmapFile(*first);
+
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << "second";
+        const auto second = platform::mapFile(path);
+        REQUIRE(second.has_value());
+        REQUIRE(std::string_view((const char*)second->Data, second->SizeBytes) == "second");
+        platform::unmapFile(*second);
+    }
+}
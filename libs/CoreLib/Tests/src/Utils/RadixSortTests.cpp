@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <CoreLib/Utils/RadixSort.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+
+// NOLINTBEGIN
+
+TEST_CASE("floatSortKey", "[Utils][RadixSort]")
+{
+    const std::vector<f32> values = {
+        -std::numeric_limits<f32>::infinity(), -1e30f, -2.5f, -1.0f, -1e-30f, -0.0f, 0.0f, 1e-30f, 1.0f, 2.5f, 1e30f,
+        std::numeric_limits<f32>::infinity()};
+    for (u32 i = 1; i < values.size(); i++)
+        REQUIRE(lux::floatSortKey(values[i - 1]) < lux::floatSortKey(values[i]));
+}
+
+TEST_CASE("radixSortIndices", "[Utils][RadixSort]")
+{
+    std::vector<u32> order;
+    std::vector<u32> scratch;
+    SECTION("Empty input")
+    {
+        lux::radixSortIndices({}, order, scratch);
+        REQUIRE(order.empty());
+    }
+    SECTION("Matches stable sort")
+    {
+        std::mt19937 rng(3);
+        for (u32 keyRange : {1u, 16u, 3000u, ~0u})
+        {
+            std::uniform_int_distribution<u32> key(0, keyRange - 1);
+            std::vector<u32> keys(5000);
+            for (auto& k : keys)
+                k = keyRange == ~0u ? rng() : key(rng);
+
+            std::vector<u32> expected(keys.size());
+            std::iota(expected.begin(), expected.end(), 0);
+            std::ranges::stable_sort(expected, std::less<>{}, [&keys](u32 index) { return keys[index]; });
+
+            lux::radixSortIndices(keys, order, scratch);
+            REQUIRE(order == expected);
+        }
+    }
+    SECTION("Sorts floats through sort keys")
+    {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<f32> value(-100.0f, 100.0f);
+        std::vector<f32> values(1000);
+        for (auto& v : values)
+            v = value(rng);
+        std::vector<u32> keys(values.size());
+        for (u32 i = 0; i < values.size(); i++)
+            keys[i] = lux::floatSortKey(values[i]);
+
+        lux::radixSortIndices(keys, order, scratch);
+        for (u32 i = 1; i < order.size(); i++)
+            REQUIRE(values[order[i - 1]] <= values[order[i]]);
+    }
+}
@@ -30,6 +30,7 @@ workspace "VulkanRenderer"
 group "Dependencies"
 include "vendor/glfw"
 include "vendor/lz4"
+include "vendor/zstd.lua"
 include "vendor/meshoptimizer"
 include "vendor/mikktspace"
 include "vendor/imgui"
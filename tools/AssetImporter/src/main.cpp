@@ -4,19 +4,18 @@
 #include <AssetLib/Io/Compression/AssetCompressor.h>
 #include <AssetLib/Io/Compression/Lz4AssetCompressor.h>
 #include <AssetLib/Io/Compression/RawAssetCompressor.h>
+#include <AssetLib/Io/Compression/ZstdAssetCompressor.h>
 #include <AssetLib/Io/IoInterface/CombinedAssetIoInterface.h>
 #include <AssetLib/Io/IoInterface/SeparateAssetIoInterface.h>
 #include <AssetLib/Reflection/AssetlibReflectionUtility.inl>
 #include <AssetImportLib/Importers/ImportContext.h>
 #include <AssetImportLib/Importers/Import.h>
-#include <AssetImportLib/Bakers/BakersDispatcher.h>
-#include <AssetImportLib/Importers/Images/ImageImporter.h>
-#include <AssetImportLib/Importers/Scenes/SceneImporter.h>
-#include <AssetImportLib/Importers/Shaders/ShaderImporter.h>
+#include <AssetImportLib/Bakers/DirectoryBaker.h>
 #include <CoreLib/Log.h>
 #include <CoreLib/Platform/PlatformUtils.h>
 #include <CoreLib/Utils/FileUtils.h>
 
+#include <charconv>
 #include <filesystem>
 #include <memory>
 #include <glaze/glaze.hpp>
@@ -31,6 +30,14 @@ struct ShaderBakerSettings
     std::string IoCompressorName{};
 };
 
+struct ZstdSettings
+{
+    i32 Level{lux::assetlib::io::ZstdAssetCompressor::DEFAULT_LEVEL};
+    /* train a dictionary per asset type on the assets baked by this run, for the next runs to use */
+    bool TrainDictionaries{false};
+    u32 DictionarySizeBytes{lux::assetlib::io::ZstdAssetCompressor::DEFAULT_DICTIONARY_SIZE_BYTES};
+};
+
 struct Config
 {
     std::filesystem::path InitialDirectory{};
@@ -40,9 +47,13 @@ struct Config
     std::optional<lux::Guid> IoInterfaceGuid;
     std::string IoCompressorName;
     std::optional<lux::Guid> IoCompressorGuid;
+    ZstdSettings ZstdSettings{};
+    /* write the headers of the baked assets as json, for debugging */
+    bool JsonHeaders{false};
 };
 
 template <> struct ::glz::meta<ShaderBakerSettings> : lux::assetlib::reflection::CamelCase {}; 
+template <> struct ::glz::meta<ZstdSettings> : lux::assetlib::reflection::CamelCase {};
 template <> struct ::glz::meta<Config> : lux::assetlib::reflection::CamelCase {};
 
 std::optional<Config> readConfig(const std::filesystem::path& path)
@@ -61,6 +72,43 @@ std::optional<Config> readConfig(const std::filesystem::path& path)
     return config;
 }
 
+struct Arguments
+{
+    /* 0 means all cores */
+    u32 Jobs{0};
+    /* log the hash of the baked directory, to compare the bakes with different job counts */
+    bool Hash{false};
+};
+
+std::optional<Arguments> parseArguments(i32 argc, char** argv)
+{
+    Arguments arguments = {};
+    for (i32 i = 1; i < argc; i++)
+    {
+        const std::string_view argument = argv[i];
+        if (argument == "--hash")
+        {
+            arguments.Hash = true;
+        }
+        else if (argument == "--jobs" && i + 1 < argc)
+        {
+            const std::string_view jobs = argv[++i];
+            if (std::from_chars(jobs.data(), jobs.data() + jobs.size(), arguments.Jobs).ec != std::errc{})
+            {
+                LUX_LOG_ERROR("Invalid job count: {}", jobs);
+                return std::nullopt;
+            }
+        }
+        else
+        {
+            LUX_LOG_ERROR("Unknown argument: {}. Usage: AssetImporter [--jobs <count>] [--hash]", argument);
+            return std::nullopt;
+        }
+    }
+
+    return arguments;
+}
+
 i32 main(i32 argc, char** argv)
 {
     using namespace lux::assetlib::io;
@@ -76,6 +124,9 @@ i32 main(i32 argc, char** argv)
     std::optional<Config> config = readConfig(configPath);
     if (!config)
         return 1;
+    const std::optional<Arguments> arguments = parseArguments(argc, argv);
+    if (!arguments)
+        return 1;
 
     StringIdRegistry::Init();
 
@@ -99,6 +150,15 @@ i32 main(i32 argc, char** argv)
         Lz4AssetCompressor::GetNameStatic(),
         Lz4AssetCompressor::GetGuidStatic(),
         [](void*) { return std::make_shared<Lz4AssetCompressor>(); });
+    ioCompressorRegistry.Register(
+        ZstdAssetCompressor::GetNameStatic(),
+        ZstdAssetCompressor::GetGuidStatic(),
+        [](void* arguments) {
+            return std::make_shared<ZstdAssetCompressor>(*(ZstdAssetCompressor::CreateInfo*)arguments);
+        });
+    ZstdAssetCompressor::CreateInfo zstdCreateInfo = {
+        .Level = config->ZstdSettings.Level,
+        .CollectSamples = config->ZstdSettings.TrainDictionaries};
 
     std::shared_ptr<AssetIoInterface> io;
     if (config->IoInterfaceGuid.has_value())
@@ -118,11 +178,12 @@ i32 main(i32 argc, char** argv)
     std::shared_ptr<AssetCompressor> compressor;
     if (config->IoCompressorGuid.has_value())
     {
-        compressor = ioCompressorRegistry.Create(config->IoCompressorName, *config->IoCompressorGuid).value_or(nullptr);
+        compressor = ioCompressorRegistry.Create(config->IoCompressorName, *config->IoCompressorGuid,
+            &zstdCreateInfo).value_or(nullptr);
     }
     else
     {
-        auto createResult = ioCompressorRegistry.Create(config->IoCompressorName);
+        auto createResult = ioCompressorRegistry.Create(config->IoCompressorName, &zstdCreateInfo);
         if (!createResult.has_value())
         {
             if (createResult.error() == AssetIoRegistryCreateError::Ambiguous)
@@ -136,7 +197,9 @@ i32 main(i32 argc, char** argv)
         .InitialDirectory = config->InitialDirectory,
         .BakedDirectory = config->BakedDirectory,
         .Io = io.get(),
-        .Compressor = compressor.get()
+        .Compressor = compressor.get(),
+        .HeaderEncoding = config->JsonHeaders ?
+            AssetHeaderEncoding::Json : AssetHeaderEncoding::Binary
     });
 
     if (!importContext->Io)
@@ -149,58 +212,32 @@ i32 main(i32 argc, char** argv)
         LUX_LOG_ERROR("io compressor is not set");
         return 1;
     }
+
+    std::shared_ptr<ZstdAssetCompressor> zstdCompressor = nullptr;
+    if (compressor->GetGuid() == ZstdAssetCompressor::GetGuidStatic())
+        zstdCompressor = std::static_pointer_cast<ZstdAssetCompressor>(compressor);
+    const fs::path dictionariesDirectory = ZstdAssetCompressor::GetDictionariesDirectory(config->BakedDirectory);
+    if (zstdCompressor)
+    {
+        auto dictionariesLoad = zstdCompressor->LoadDictionaries(dictionariesDirectory);
+        if (!dictionariesLoad.has_value())
+            LUX_LOG_ERROR("Failed to load compression dictionaries: {}", dictionariesLoad.error());
+    }
     
-    for (const auto& file : fs::recursive_directory_iterator(config->InitialDirectory))
+    lux::import::bakeDirectory(importContext, {
+        .Jobs = arguments->Jobs,
+        .ShaderIncludeDirectory = shaderBakerSettings.IncludeDirectory});
+
+    if (zstdCompressor && config->ZstdSettings.TrainDictionaries)
     {
-        if (file.is_directory())
-            continue;
-
-        lux::import::BakersDispatcher dispatcher(file);
-        
-        dispatcher.Dispatch({lux::import::SHADER_ASSET_LOAD_EXTENSION}, [&](const fs::path& path) {
-            auto shaderLoadInfoRead = lux::assetlib::shader::readLoadInfo(path);
-            if (!shaderLoadInfoRead.has_value())
-                return;
-            
-            for (auto& variant : shaderLoadInfoRead->Variants)
-            {
-                lux::import::ShaderImportSettings shaderImportSettings{
-                    .Variant = StringId::FromString(variant.Name),
-                    .IncludePaths = {shaderBakerSettings.IncludeDirectory.string()},
-                };
-                
-                lux::import::ShaderImporter importer(importContext, shaderImportSettings);
-                if (!importer.NeedsBaking(path))
-                    continue;
-                
-                auto imported = importer.Import(path);
-                if (!imported)
-                    LUX_LOG_ERROR("Failed to import shader file: {} ({})", imported.error(), path.string());
-                else
-                    LUX_LOG_INFO("Imported shader file: {}", path.string());
-            }
-        });
-        dispatcher.Dispatch({lux::import::SCENE_ASSET_RAW_EXTENSIONS}, [&](const fs::path& path) {
-            lux::import::SceneImporter importer(importContext);
-            if (!importer.NeedsBaking(path))
-                return;
-
-            auto imported = importer.Import(path);
-            if (!imported)
-                LUX_LOG_ERROR("Failed to import scene file: {} ({})", imported.error(), path.string());
-            else
-                LUX_LOG_INFO("Imported scene file: {}", path.string());
-        });
-        dispatcher.Dispatch(lux::import::IMAGE_ASSET_RAW_EXTENSIONS, [&](const fs::path& path) {
-            lux::import::ImageImporter importer(importContext, {});
-            if (!importer.NeedsBaking(path))
-                return;
-            
-            auto imported = importer.Import(path);
-            if (!imported)
-                LUX_LOG_ERROR("Failed to import image file: {} ({})", imported.error(), path.string());
-            else
-                LUX_LOG_INFO("Imported image file: {}", path.string());
-        });
+        auto dictionariesTrain = zstdCompressor->TrainDictionaries(dictionariesDirectory,
+            config->ZstdSettings.DictionarySizeBytes);
+        if (!dictionariesTrain.has_value())
+            LUX_LOG_ERROR("Failed to train compression dictionaries: {}", dictionariesTrain.error());
+        else
+            LUX_LOG_INFO("Trained compression dictionaries: {}", dictionariesDirectory.string());
     }
+
+    if (arguments->Hash)
+        LUX_LOG_INFO("Baked directory hash: {:016x}", lux::import::hashDirectory(config->BakedDirectory));
 }